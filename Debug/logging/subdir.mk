@@ -4,12 +4,15 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../logging/Diagnostics.cpp \
 ../logging/Logger.cpp 
 
 OBJS += \
+./logging/Diagnostics.o \
 ./logging/Logger.o 
 
 CPP_DEPS += \
+./logging/Diagnostics.d \
 ./logging/Logger.d 
 
 
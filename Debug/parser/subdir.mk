@@ -4,16 +4,43 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../parser/AddressIndex.cpp \
+../parser/BinaryTrace.cpp \
+../parser/ChunkedTokenizer.cpp \
+../parser/CompressedTraceReader.cpp \
 ../parser/MultiStack.cpp \
-../parser/TraceParser.cpp 
+../parser/TraceFilter.cpp \
+../parser/TraceParser.cpp \
+../parser/TraceReader.cpp \
+../parser/TraceSlicer.cpp \
+../parser/TraceTokenizer.cpp \
+../parser/TraceValidator.cpp 
 
 OBJS += \
+./parser/AddressIndex.o \
+./parser/BinaryTrace.o \
+./parser/ChunkedTokenizer.o \
+./parser/CompressedTraceReader.o \
 ./parser/MultiStack.o \
-./parser/TraceParser.o 
+./parser/TraceFilter.o \
+./parser/TraceParser.o \
+./parser/TraceReader.o \
+./parser/TraceSlicer.o \
+./parser/TraceTokenizer.o \
+./parser/TraceValidator.o 
 
 CPP_DEPS += \
+./parser/AddressIndex.d \
+./parser/BinaryTrace.d \
+./parser/ChunkedTokenizer.d \
+./parser/CompressedTraceReader.d \
 ./parser/MultiStack.d \
-./parser/TraceParser.d 
+./parser/TraceFilter.d \
+./parser/TraceParser.d \
+./parser/TraceReader.d \
+./parser/TraceSlicer.d \
+./parser/TraceTokenizer.d \
+./parser/TraceValidator.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -7,16 +7,28 @@ O_SRCS += \
 ../racedetector/HBGraph.o 
 
 CPP_SRCS += \
+../racedetector/BitMatrix.cpp \
+../racedetector/ChainIndex.cpp \
 ../racedetector/HBGraph.cpp \
-../racedetector/UAFDetector.cpp 
+../racedetector/TaskNameTable.cpp \
+../racedetector/UAFDetector.cpp \
+../racedetector/WorkerPool.cpp 
 
 OBJS += \
+./racedetector/BitMatrix.o \
+./racedetector/ChainIndex.o \
 ./racedetector/HBGraph.o \
-./racedetector/UAFDetector.o 
+./racedetector/TaskNameTable.o \
+./racedetector/UAFDetector.o \
+./racedetector/WorkerPool.o 
 
 CPP_DEPS += \
+./racedetector/BitMatrix.d \
+./racedetector/ChainIndex.d \
 ./racedetector/HBGraph.d \
-./racedetector/UAFDetector.d 
+./racedetector/TaskNameTable.d \
+./racedetector/UAFDetector.d \
+./racedetector/WorkerPool.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
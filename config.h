@@ -1,5 +1,5 @@
 // To limit the number of nodes
- #define NODELIMIT 15000
+ #define NODELIMIT 100000
 
 // Flag to give up when reaching nodelimit
 // #define RUNOVERNODELIMIT
@@ -42,6 +42,15 @@
 // To enable MT and Cascaded loop rules
 // #define ADVANCEDRULES
 
+// To compile in the debug output selected with -v/-vcat/-vout
+ #define DIAGNOSTICS
+
+// To read gzip compressed traces (link with -lz)
+ #define ZLIB
+
+// To read zstd compressed traces (link with -lzstd)
+// #define ZSTD
+
 #ifdef SMALL
 typedef int IDType;
 #endif
@@ -1,5 +1,3 @@
-#define TRACEDEBUG
-#define GRAPHDEBUG
 //#define ACCESS
 //#define ADDITIONS
 //#define LOCKS
@@ -0,0 +1,70 @@
+/*
+ * Diagnostics.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <logging/Diagnostics.h>
+
+using namespace std;
+
+// Size of the buffer of the diagnostics file
+#define DIAGBUFFERSIZE (1 << 20)
+
+static const char* categoryNames[NUMOFDIAGCATEGORIES] = {
+	"parse", "rules", "closure", "detection"
+};
+
+static char diagBuffer[DIAGBUFFERSIZE];
+
+int Diagnostics::levels[NUMOFDIAGCATEGORIES] = {DIAG_OFF, DIAG_OFF, DIAG_OFF, DIAG_OFF};
+std::ostream* Diagnostics::out = &cout;
+std::ofstream Diagnostics::file;
+
+bool Diagnostics::setLevel(int level, string categories) {
+	size_t begin = 0;
+	while (begin <= categories.size()) {
+		size_t end = categories.find(',', begin);
+		if (end == string::npos)
+			end = categories.size();
+		string name = categories.substr(begin, end - begin);
+
+		bool found = false;
+		for (int i = 0; i < NUMOFDIAGCATEGORIES; i++) {
+			if (name == "all" || name == categoryNames[i]) {
+				levels[i] = level;
+				found = true;
+			}
+		}
+		if (!found) {
+			cout << "ERROR: Unknown diagnostics category " << name << "\n";
+			return false;
+		}
+		begin = end + 1;
+	}
+	return true;
+}
+
+bool Diagnostics::open(string fileName) {
+	close();
+	if (fileName == "-") {
+		out = &cout;
+		return true;
+	}
+
+	file.rdbuf()->pubsetbuf(diagBuffer, sizeof(diagBuffer));
+	file.open(fileName.c_str(), std::ios::trunc);
+	if (!file.is_open()) {
+		cout << "ERROR: Cannot open diagnostics file " << fileName << endl;
+		out = &cout;
+		return false;
+	}
+	out = &file;
+	return true;
+}
+
+void Diagnostics::close() {
+	if (file.is_open())
+		file.close();
+	out = &cout;
+}
@@ -0,0 +1,81 @@
+/*
+ * Diagnostics.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+
+#include <config.h>
+
+#ifndef DIAGNOSTICS_H_
+#define DIAGNOSTICS_H_
+
+/*
+ * Debug output of the parser and the detector.
+ *
+ * Each message belongs to a category and has a level; it is written only if
+ * the verbosity of its category is at least that level. Messages go to a
+ * buffered file (<trace-file>.diag unless set otherwise), not to stdout.
+ * Without DIAGNOSTICS in config.h all messages are compiled out.
+ */
+
+enum DiagCategory {
+	DIAG_PARSE,		// trace, ops, tasks and threads
+	DIAG_RULES,		// edges added by each HB rule
+	DIAG_CLOSURE,	// iterations of the fixpoint over the rules
+	DIAG_DETECTION,	// UAF and race detection
+	NUMOFDIAGCATEGORIES
+};
+
+enum DiagLevel {
+	DIAG_OFF = 0,
+	DIAG_SUMMARY = 1,	// counts and statistics
+	DIAG_DETAILS = 2,	// per task/thread/edge details
+	DIAG_TRACE = 3		// every op of the trace
+};
+
+class Diagnostics {
+public:
+	// sets the verbosity of all categories in categories (comma separated
+	// names, or "all"). Returns false for an unknown category.
+	static bool setLevel(int level, std::string categories = "all");
+
+	// Sends messages to fileName ("-" is stdout). Returns false if the file
+	// cannot be opened.
+	static bool open(std::string fileName);
+	static void close();
+
+	static bool enabled(DiagCategory category, int level) {
+#ifdef DIAGNOSTICS
+		return levels[category] >= level;
+#else
+		return false;
+#endif
+	}
+
+	static std::ostream& stream() {
+		return *out;
+	}
+
+private:
+	static int levels[NUMOFDIAGCATEGORIES];
+	static std::ostream* out;
+	static std::ofstream file;
+};
+
+// Writes message (a chain of << operands) if category is enabled at level.
+// The operands are not evaluated otherwise.
+#ifdef DIAGNOSTICS
+#define DIAG(category, level, message) \
+	do { \
+		if (Diagnostics::enabled(category, level)) \
+			Diagnostics::stream() << message; \
+	} while (0)
+#else
+#define DIAG(category, level, message) do { } while (0)
+#endif
+
+#endif /* DIAGNOSTICS_H_ */
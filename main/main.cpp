@@ -8,8 +8,10 @@
 #include <iostream>
 #include <cstdlib>
 #include <parser/TraceParser.h>
+#include <parser/TraceFilter.h>
 #include <racedetector/UAFDetector.h>
 #include <logging/Logger.h>
+#include <logging/Diagnostics.h>
 #include <time.h>
 #include <cstring>
 
@@ -49,7 +51,7 @@ std::string convertTime(clock_t startTime, clock_t endTime) {
 int main(int argc, char* argv[]) {
 	if (argc < 2) {
 		cout << "ERROR: Missing input\n";
-		cout << "Input trace-file name as argument 1\n";
+		cout << "Input trace-file name as argument 1 (- for stdin)\n";
 		return -1;
 	}
 
@@ -60,8 +62,17 @@ int main(int argc, char* argv[]) {
 	bool outputAllConflictingOps = false;
 	bool filterUAFInput = false, filterRaceInput = false;
 	bool runDetectorOnTrace = false;
+	bool validateTrace = false;
 	bool multithreadedHB = false;
 	bool richHB = false;
+	string binaryTraceFileName;
+	ClosureKind closure = CLOSURE_ROWS;
+	HBRepresentation representation = HB_MATRIX;
+	string matrixDirectory;
+	int diagLevel = DIAG_OFF;
+	string diagCategories = "all";
+	string diagFileName;
+	string outputPrefix;
 	string outputUAFAllOpsFileName, outputUAFAllOpsUniqueFileName,
 		   outputRacesAllOpsFileName, outputRacesAllOpsUniqueFileName;
 	string filterUAFInputFileName, filterUAFOutputFileName,
@@ -69,10 +80,6 @@ int main(int argc, char* argv[]) {
 	for (int i = 2; i < argc; i++) {
 		if (strcmp(argv[i], "-a") == 0) {
 			outputAllConflictingOps = true;
-			outputUAFAllOpsFileName = traceFileName + ".uaf.allconflictingops";
-			outputUAFAllOpsUniqueFileName = traceFileName + ".uaf.allconflictingops.unique";
-			outputRacesAllOpsFileName = traceFileName + ".race.allconflictingops";
-			outputRacesAllOpsUniqueFileName = traceFileName + ".race.allconflictingops.unique";
 		} else if (strcmp(argv[i], "-fu") == 0) {
 			filterUAFInput = true;
 			filterUAFInputFileName = argv[i+1];
@@ -88,28 +95,180 @@ int main(int argc, char* argv[]) {
 		} else if (strcmp(argv[i], "-rr") == 0) {
 			runDetectorOnTrace = true;
 			richHB = true;
+		} else if (strcmp(argv[i], "-validate") == 0) {
+			validateTrace = true;
+		} else if (strcmp(argv[i], "-regex") == 0) {
+			parser.useRegEx = true;
+		} else if (strcmp(argv[i], "-mmap") == 0) {
+			parser.useMmap = true;
+		} else if (strcmp(argv[i], "-threads") == 0) {
+			if (i+1 >= argc || atoi(argv[i+1]) < 1) {
+				cout << "ERROR: Missing or invalid number of threads for -threads\n";
+				exit(0);
+			}
+			parser.numOfThreads = atoi(argv[i+1]);
+			i++;
+		} else if (strcmp(argv[i], "-filter") == 0) {
+			if (i+1 >= argc) {
+				cout << "ERROR: Missing filters for -filter\n";
+				exit(0);
+			}
+			if (!TraceFilter::parse(argv[i+1], parser.filters))
+				exit(0);
+			i++;
+		} else if (strcmp(argv[i], "-slice") == 0) {
+			if (i+1 >= argc) {
+				cout << "ERROR: Missing alloc op IDs for -slice\n";
+				exit(0);
+			}
+			if (!parser.slicer.addAllocs(argv[i+1]))
+				exit(0);
+			i++;
+		} else if (strcmp(argv[i], "-slicerange") == 0) {
+			if (i+1 >= argc) {
+				cout << "ERROR: Missing address range for -slicerange\n";
+				exit(0);
+			}
+			if (!parser.slicer.addRange(argv[i+1]))
+				exit(0);
+			i++;
+		} else if (strcmp(argv[i], "-closure") == 0) {
+			if (i+1 < argc && strcmp(argv[i+1], "rows") == 0)
+				closure = CLOSURE_ROWS;
+			else if (i+1 < argc && strcmp(argv[i+1], "pairs") == 0)
+				closure = CLOSURE_PAIRS;
+			else if (i+1 < argc && strcmp(argv[i+1], "sweep") == 0)
+				closure = CLOSURE_SWEEP;
+			else if (i+1 < argc && strcmp(argv[i+1], "lazy") == 0)
+				closure = CLOSURE_LAZY;
+			else {
+				cout << "ERROR: Missing or invalid closure for -closure (rows, pairs, sweep, lazy)\n";
+				exit(0);
+			}
+			i++;
+		} else if (strcmp(argv[i], "-hb") == 0) {
+			if (i+1 < argc && strcmp(argv[i+1], "matrix") == 0)
+				representation = HB_MATRIX;
+			else if (i+1 < argc && strcmp(argv[i+1], "chains") == 0)
+				representation = HB_CHAINS;
+			else {
+				cout << "ERROR: Missing or invalid representation for -hb (matrix, chains)\n";
+				exit(0);
+			}
+			i++;
+		} else if (strcmp(argv[i], "-hbdir") == 0) {
+			if (i+1 >= argc) {
+				cout << "ERROR: Missing directory for -hbdir\n";
+				exit(0);
+			}
+			matrixDirectory = argv[i+1];
+			i++;
+		} else if (strcmp(argv[i], "-v") == 0) {
+			if (i+1 >= argc || atoi(argv[i+1]) < DIAG_OFF || atoi(argv[i+1]) > DIAG_TRACE) {
+				cout << "ERROR: Missing or invalid level for -v (0-3)\n";
+				exit(0);
+			}
+			diagLevel = atoi(argv[i+1]);
+			i++;
+		} else if (strcmp(argv[i], "-vcat") == 0) {
+			if (i+1 >= argc) {
+				cout << "ERROR: Missing categories for -vcat\n";
+				exit(0);
+			}
+			diagCategories = argv[i+1];
+			i++;
+		} else if (strcmp(argv[i], "-vout") == 0) {
+			if (i+1 >= argc) {
+				cout << "ERROR: Missing file for -vout\n";
+				exit(0);
+			}
+			diagFileName = argv[i+1];
+			i++;
+		} else if (strcmp(argv[i], "-o") == 0) {
+			if (i+1 >= argc) {
+				cout << "ERROR: Missing prefix for -o\n";
+				exit(0);
+			}
+			outputPrefix = argv[i+1];
+			i++;
+		} else if (strcmp(argv[i], "-srb") == 0) {
+			if (i+1 >= argc) {
+				cout << "ERROR: Missing output file for -srb\n";
+				exit(0);
+			}
+			binaryTraceFileName = argv[i+1];
+			i++;
 		} else {
 			cout << "ERROR: Invalid argument " << argv[i] << "\n";
 			exit(0);
 		}
 	}
+
+	if (outputPrefix.empty()) {
+		if (traceFileName == "-") {
+			cout << "ERROR: Output prefix (-o) needed when reading the trace from stdin\n";
+			exit(0);
+		}
+		outputPrefix = traceFileName;
+	}
+	parser.outputPrefix = outputPrefix;
+	if (diagFileName.empty())
+		diagFileName = outputPrefix + ".diag";
+	if (outputAllConflictingOps) {
+		outputUAFAllOpsFileName = outputPrefix + ".uaf.allconflictingops";
+		outputUAFAllOpsUniqueFileName = outputPrefix + ".uaf.allconflictingops.unique";
+		outputRacesAllOpsFileName = outputPrefix + ".race.allconflictingops";
+		outputRacesAllOpsUniqueFileName = outputPrefix + ".race.allconflictingops.unique";
+	}
+
+	if (diagLevel != DIAG_OFF) {
+#ifndef DIAGNOSTICS
+		cout << "WARNING: Diagnostics are compiled out, rebuild with DIAGNOSTICS defined\n";
+#endif
+		if (!Diagnostics::setLevel(diagLevel, diagCategories))
+			exit(0);
+		if (!Diagnostics::open(diagFileName))
+			exit(0);
+	}
+
+	if (!binaryTraceFileName.empty()) {
+		long long retConvert = parser.convertToBinary(binaryTraceFileName);
+		if (retConvert < 0) {
+			cout << "ERROR while converting the trace\n";
+			return -1;
+		}
+		cout << "Wrote " << retConvert << " ops to " << binaryTraceFileName << "\n";
+		return 0;
+	}
+
+	if (validateTrace) {
+		long long retValidate = parser.validate();
+		if (retValidate < 0) {
+			cout << "ERROR while validating the trace\n";
+			return -1;
+		}
+		return (retValidate == 0 ? 0 : -1);
+	}
+
 	UAFDetector detectorObj;
+	detectorObj.closure = closure;
+	detectorObj.representation = representation;
+	detectorObj.numOfClosureThreads = parser.numOfThreads;
+	detectorObj.matrixDirectory = matrixDirectory;
 
 	clock_t totalStart, totalEnd, tStart, tEnd;
 	totalStart = clock();
 	tStart = totalStart;
 	int retParse = parser.parse(detectorObj);
 	if (retParse == -2) {
-		cout << "Giving up! More than 15k nodes\n";
+		cout << "Giving up! More than " << NODELIMIT << " nodes\n";
 		return -1;
 	} else if (retParse < 0) {
 		cout << "ERROR while parsing the trace\n";
 		return -1;
 	}
 
-#ifdef TRACEDEBUG
-	cout << "map size: " << detectorObj.opIDMap.size() << endl;
-#endif
+	DIAG(DIAG_PARSE, DIAG_SUMMARY, "map size: " << detectorObj.opIDMap.size() << "\n");
 	tEnd = clock();
 	cout << "Time taken for parsing: " << convertTime(tStart, tEnd) << "\n";
 
@@ -129,7 +288,7 @@ int main(int argc, char* argv[]) {
 	tEnd = clock();
 	cout << "Time taken for transitive closure: " << convertTime(tStart, tEnd) << "\n";
 
-	detectorObj.initLog(traceFileName);
+	detectorObj.initLog(outputPrefix);
 	if (runDetectorOnTrace) {
 		tStart = clock();
 		cout << "\nFinding UAF\n";
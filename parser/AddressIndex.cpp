@@ -0,0 +1,109 @@
+/*
+ * AddressIndex.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include "AddressIndex.h"
+#include <algorithm>
+
+using namespace std;
+
+AddressIndex::AddressIndex() {
+}
+
+AddressIndex::~AddressIndex() {
+}
+
+void AddressIndex::addBlock(blockMapType& blocks, IDType op, AddressType base, IDType size) {
+	if (size <= 0)
+		return;
+	set<IDType> ops;
+	ops.insert(op);
+	blocks += make_pair(intervalType::right_open(base, base + size), ops);
+}
+
+void AddressIndex::findBlocks(blockMapType& blocks, AddressType address, set<IDType>& ops) {
+	blockMapType::const_iterator it = blocks.find(address);
+	if (it != blocks.end())
+		ops.insert(it->second.begin(), it->second.end());
+}
+
+void AddressIndex::addAlloc(IDType allocOp, AddressType base, IDType size) {
+	blockDetails block;
+	block.base = base;
+	block.end = base + (size > 0 ? size : 0);
+	allocSizes[allocOp] = block;
+
+	if (size <= 0)
+		emptyAllocs.insert(make_pair(base, allocOp));
+	else
+		addBlock(allocBlocks, allocOp, base, size);
+}
+
+void AddressIndex::addFree(IDType freeOp, AddressType base, IDType size) {
+	addBlock(freeBlocks, freeOp, base, size);
+}
+
+void AddressIndex::addRead(IDType readOp, AddressType address) {
+	readIndex[address].push_back(readOp);
+}
+
+void AddressIndex::addWrite(IDType writeOp, AddressType address) {
+	writeIndex[address].push_back(writeOp);
+}
+
+void AddressIndex::findAllocs(AddressType address, vector<IDType>& allocOps) {
+	set<IDType> ops;
+	findBlocks(allocBlocks, address, ops);
+	allocOps.assign(ops.begin(), ops.end());
+}
+
+void AddressIndex::findFrees(AddressType address, vector<IDType>& freeOps) {
+	set<IDType> ops;
+	findBlocks(freeBlocks, address, ops);
+	freeOps.assign(ops.begin(), ops.end());
+}
+
+void AddressIndex::findAllocsContaining(AddressType base, IDType size, vector<IDType>& allocOps) {
+	AddressType end = base + (size > 0 ? size : 0);
+
+	// Every alloc containing [base, end) contains base. If the range is
+	// empty, an alloc that ends at base also contains it.
+	set<IDType> candidates;
+	findBlocks(allocBlocks, base, candidates);
+	if (size <= 0) {
+		if (base > 0)
+			findBlocks(allocBlocks, base - 1, candidates);
+		pair<multimap<AddressType, IDType>::iterator, multimap<AddressType, IDType>::iterator> range
+			= emptyAllocs.equal_range(base);
+		for (multimap<AddressType, IDType>::iterator it = range.first; it != range.second; it++)
+			candidates.insert(it->second);
+	}
+
+	allocOps.clear();
+	for (set<IDType>::iterator it = candidates.begin(); it != candidates.end(); it++) {
+		blockDetails& block = allocSizes[*it];
+		if (block.base <= base && end <= block.end)
+			allocOps.push_back(*it);
+	}
+}
+
+void AddressIndex::findAccesses(map<AddressType, vector<IDType> >& index,
+		AddressType base, IDType size, vector<IDType>& ops) {
+	ops.clear();
+	if (size <= 0)
+		return;
+	map<AddressType, vector<IDType> >::iterator last = index.lower_bound(base + size);
+	for (map<AddressType, vector<IDType> >::iterator it = index.lower_bound(base); it != last; it++)
+		ops.insert(ops.end(), it->second.begin(), it->second.end());
+	sort(ops.begin(), ops.end());
+}
+
+void AddressIndex::findReads(AddressType base, IDType size, vector<IDType>& readOps) {
+	findAccesses(readIndex, base, size, readOps);
+}
+
+void AddressIndex::findWrites(AddressType base, IDType size, vector<IDType>& writeOps) {
+	findAccesses(writeIndex, base, size, writeOps);
+}
@@ -0,0 +1,81 @@
+/*
+ * AddressIndex.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <map>
+#include <set>
+#include <vector>
+#include <boost/icl/interval_map.hpp>
+
+#include <config.h>
+#include <racedetector/UAFDetector.h>
+
+#ifndef ADDRESSINDEX_H_
+#define ADDRESSINDEX_H_
+
+/*
+ * Index of the memory blocks and accesses seen so far while parsing, used to
+ * relate reads/writes to allocs/frees without scanning every alloc/free.
+ *
+ * A block is [base, base + size). Every alloc and free is kept as its own
+ * generation, keyed by its op ID, so an address that is reused maps to each
+ * alloc/free that covered it up to the current op, as the linear scans did.
+ * All queries return op IDs in increasing order.
+ */
+class AddressIndex {
+public:
+	AddressIndex();
+	virtual ~AddressIndex();
+
+	void addAlloc(IDType allocOp, AddressType base, IDType size);
+	void addFree(IDType freeOp, AddressType base, IDType size);
+	void addRead(IDType readOp, AddressType address);
+	void addWrite(IDType writeOp, AddressType address);
+
+	// allocs/frees whose block contains address
+	void findAllocs(AddressType address, std::vector<IDType>& allocOps);
+	void findFrees(AddressType address, std::vector<IDType>& freeOps);
+
+	// allocs whose block contains the whole of [base, base + size)
+	void findAllocsContaining(AddressType base, IDType size, std::vector<IDType>& allocOps);
+
+	// reads/writes of an address in [base, base + size)
+	void findReads(AddressType base, IDType size, std::vector<IDType>& readOps);
+	void findWrites(AddressType base, IDType size, std::vector<IDType>& writeOps);
+
+private:
+	typedef boost::icl::interval_map<AddressType, std::set<IDType> > blockMapType;
+	typedef boost::icl::interval<AddressType>::type intervalType;
+
+	class blockDetails {
+	public:
+		AddressType base;
+		AddressType end;	// one past the last byte
+
+		blockDetails() {
+			base = 0;
+			end = 0;
+		}
+	};
+
+	// address -> ops whose (non-empty) block contains it
+	blockMapType allocBlocks;
+	blockMapType freeBlocks;
+
+	// alloc op -> its block, and the allocs of 0 bytes by base address
+	std::map<IDType, blockDetails> allocSizes;
+	std::multimap<AddressType, IDType> emptyAllocs;
+
+	// address -> reads/writes of it
+	std::map<AddressType, std::vector<IDType> > readIndex;
+	std::map<AddressType, std::vector<IDType> > writeIndex;
+
+	static void addBlock(blockMapType& blocks, IDType op, AddressType base, IDType size);
+	static void findBlocks(blockMapType& blocks, AddressType address, std::set<IDType>& ops);
+	static void findAccesses(std::map<AddressType, std::vector<IDType> >& index,
+			AddressType base, IDType size, std::vector<IDType>& ops);
+};
+
+#endif /* ADDRESSINDEX_H_ */
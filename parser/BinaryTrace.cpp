@@ -0,0 +1,221 @@
+/*
+ * BinaryTrace.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include "BinaryTrace.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <debugconfig.h>
+
+using namespace std;
+
+// Size of the read buffer of BinaryTraceReader
+#define SRBBUFFERSIZE (1 << 20)
+
+static const char srbMagic[4] = {'S', 'R', 'B', 'T'};
+
+BinaryTraceWriter::BinaryTraceWriter() {
+	file = NULL;
+}
+
+BinaryTraceWriter::~BinaryTraceWriter() {
+	if (file != NULL)
+		fclose(file);
+}
+
+// SRB_PERMIT/SRB_LOCKS flags of the grammar of this build
+static unsigned char grammar() {
+	unsigned char flags = 0;
+#ifdef PERMIT
+	flags |= SRB_PERMIT;
+#endif
+#ifdef LOCKS
+	flags |= SRB_LOCKS;
+#endif
+	return flags;
+}
+
+bool BinaryTraceWriter::open(string fileName) {
+	file = fopen(fileName.c_str(), "wb");
+	if (file == NULL) {
+		cout << "ERROR: Cannot open binary trace " << fileName << " for writing\n";
+		return false;
+	}
+
+	unsigned char header[SRBHEADERSIZE];
+	memset(header, 0, sizeof(header));
+	memcpy(header, srbMagic, sizeof(srbMagic));
+	header[4] = SRBVERSION;
+	header[5] = grammar();
+	return fwrite(header, 1, sizeof(header), file) == sizeof(header);
+}
+
+bool BinaryTraceWriter::writeOp(const TraceTokenizer::tokenType& token) {
+	unsigned char record[SRBMAXRECORDSIZE];
+	size_t length = 0;
+
+	record[length++] = (unsigned char) token.opType;
+	for (unsigned i = 0; i < token.numOfArgs; i++) {
+		unsigned long long value = token.args[i].value;
+		if (token.args[i].kind == TraceTokenizer::HEX_ARG) {
+			for (unsigned b = 0; b < 8; b++)
+				record[length++] = (unsigned char) (value >> (8 * b));
+			continue;
+		}
+		if (token.args[i].kind == TraceTokenizer::INT_ARG) {
+			long long signedValue = (long long) value;
+			value = ((unsigned long long) signedValue << 1) ^ (unsigned long long) (signedValue >> 63);
+		}
+		while (value >= 0x80) {
+			record[length++] = (unsigned char) (value | 0x80);
+			value >>= 7;
+		}
+		record[length++] = (unsigned char) value;
+	}
+	return fwrite(record, 1, length, file) == length;
+}
+
+bool BinaryTraceWriter::close() {
+	bool ret = (fclose(file) == 0);
+	file = NULL;
+	return ret;
+}
+
+BinaryTraceReader::BinaryTraceReader() {
+	fd = -1;
+	buffer = NULL;
+	bufferSize = SRBBUFFERSIZE;
+	position = 0;
+	available = 0;
+	endOfFile = false;
+	recordCount = 0;
+	readError = false;
+}
+
+BinaryTraceReader::~BinaryTraceReader() {
+	if (buffer != NULL)
+		delete[] buffer;
+	if (fd != -1)
+		::close(fd);
+}
+
+bool BinaryTraceReader::isBinaryTrace(string fileName) {
+	char magic[sizeof(srbMagic)];
+	int fd = ::open(fileName.c_str(), O_RDONLY);
+	if (fd == -1)
+		return false;
+	bool ret = (read(fd, magic, sizeof(magic)) == (ssize_t) sizeof(magic)
+			&& memcmp(magic, srbMagic, sizeof(magic)) == 0);
+	::close(fd);
+	return ret;
+}
+
+bool BinaryTraceReader::open(string fileName) {
+	fd = ::open(fileName.c_str(), O_RDONLY);
+	if (fd == -1)
+		return false;
+
+	buffer = new unsigned char[bufferSize];
+	fill();
+	if (available < SRBHEADERSIZE || memcmp(buffer, srbMagic, sizeof(srbMagic)) != 0) {
+		cout << "ERROR: " << fileName << " is not a binary trace\n";
+		return false;
+	}
+	if (buffer[4] != SRBVERSION) {
+		cout << "ERROR: Unsupported version " << (unsigned) buffer[4]
+		     << " of binary trace " << fileName << "\n";
+		return false;
+	}
+	if (buffer[5] != grammar()) {
+		cout << "ERROR: Binary trace " << fileName << " was converted with PERMIT "
+		     << ((buffer[5] & SRB_PERMIT) ? "on" : "off") << " and LOCKS "
+		     << ((buffer[5] & SRB_LOCKS) ? "on" : "off") << ", rebuild with the same config.h\n";
+		return false;
+	}
+	position = SRBHEADERSIZE;
+	return true;
+}
+
+void BinaryTraceReader::fill() {
+	if (endOfFile || available - position >= SRBMAXRECORDSIZE)
+		return;
+
+	memmove(buffer, buffer + position, available - position);
+	available -= position;
+	position = 0;
+	while (available < bufferSize) {
+		ssize_t ret = read(fd, buffer + available, bufferSize - available);
+		if (ret == -1 && errno == EINTR)
+			continue;
+		if (ret == -1) {
+			cout << "ERROR: Cannot read binary trace: " << strerror(errno) << "\n";
+			readError = true;
+		}
+		if (ret <= 0) {
+			endOfFile = true;
+			break;
+		}
+		available += ret;
+	}
+}
+
+bool BinaryTraceReader::getOp(TraceTokenizer::tokenType& token, bool& validOp) {
+	fill();
+	if (position == available)
+		return false;
+
+	recordCount++;
+	validOp = false;
+
+	unsigned numOfArgs;
+	TraceTokenizer::argKind kinds[MAXARGS];
+	token.opType = (OpType) buffer[position++];
+	if (!TraceTokenizer::getArgKinds(token.opType, numOfArgs, kinds)) {
+		cout << "ERROR: Unknown op " << (unsigned) token.opType << " in record "
+			 << recordCount << " of binary trace\n";
+		return true;
+	}
+
+	token.numOfArgs = numOfArgs;
+	for (unsigned i = 0; i < numOfArgs; i++) {
+		TraceTokenizer::fieldType& field = token.args[i];
+		unsigned long long value = 0;
+		field.begin = NULL;
+		field.end = NULL;
+		field.kind = kinds[i];
+
+		if (kinds[i] == TraceTokenizer::HEX_ARG) {
+			if (available - position < 8) {
+				cout << "ERROR: Truncated record " << recordCount << " in binary trace\n";
+				return true;
+			}
+			for (unsigned b = 0; b < 8; b++)
+				value |= (unsigned long long) buffer[position++] << (8 * b);
+		} else {
+			unsigned shift = 0;
+			while (true) {
+				if (position == available || shift > 63) {
+					cout << "ERROR: Truncated record " << recordCount << " in binary trace\n";
+					return true;
+				}
+				unsigned char byte = buffer[position++];
+				value |= (unsigned long long) (byte & 0x7f) << shift;
+				if ((byte & 0x80) == 0)
+					break;
+				shift += 7;
+			}
+			if (kinds[i] == TraceTokenizer::INT_ARG)
+				value = (value >> 1) ^ (0 - (value & 1));
+		}
+		field.value = value;
+	}
+
+	validOp = true;
+	return true;
+}
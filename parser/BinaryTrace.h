@@ -0,0 +1,92 @@
+/*
+ * BinaryTrace.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <string>
+#include <cstdio>
+#include <parser/TraceTokenizer.h>
+
+#include <config.h>
+
+#ifndef BINARYTRACE_H_
+#define BINARYTRACE_H_
+
+/*
+ * Binary trace format (.srb)
+ *
+ * Header (8 bytes):
+ *   "SRBT"				magic
+ *   u8					SRBVERSION
+ *   u8					grammar the trace was converted with (SRB_PERMIT, SRB_LOCKS)
+ *   u16				reserved, 0
+ *
+ * One record per op, laid out by the op's grammar:
+ *   u8					OpType of the op
+ *   for each argument, in the order of the text trace:
+ *     posInt			unsigned LEB128 varint (thread IDs, task IDs, sizes)
+ *     int				zigzag-encoded LEB128 varint (enq priority)
+ *     hex				u64, little endian (addresses, shared variables)
+ *
+ * Task IDs are stored as numbers, so task names that differ only in leading
+ * zeros become the same task.
+ */
+
+#define SRBVERSION 1
+#define SRBHEADERSIZE 8
+#define SRB_PERMIT 0x1
+#define SRB_LOCKS 0x2
+
+// Max size of a record: op byte, 10-byte varints and u64s
+#define SRBMAXRECORDSIZE (1 + 10 * MAXARGS)
+
+class BinaryTraceWriter {
+public:
+	BinaryTraceWriter();
+	virtual ~BinaryTraceWriter();
+
+	// creates fileName and writes the header
+	bool open(std::string fileName);
+	bool writeOp(const TraceTokenizer::tokenType& token);
+	bool close();
+
+private:
+	FILE* file;
+};
+
+class BinaryTraceReader {
+public:
+	BinaryTraceReader();
+	virtual ~BinaryTraceReader();
+
+	// returns true if fileName starts with the magic of a binary trace
+	static bool isBinaryTrace(std::string fileName);
+
+	// opens fileName and checks the header
+	bool open(std::string fileName);
+
+	// Returns false at end of trace. validOp is false if the record is not a
+	// valid op for the grammar this binary was built with.
+	bool getOp(TraceTokenizer::tokenType& token, bool& validOp);
+
+	// True if the trace could not be read to the end
+	bool failed() const {
+		return readError;
+	}
+
+private:
+	int fd;
+	unsigned char* buffer;
+	size_t bufferSize;
+	size_t position;	// next unread byte in buffer
+	size_t available;	// bytes in buffer
+	bool endOfFile;
+	bool readError;
+	long long recordCount;
+
+	// makes sure at least SRBMAXRECORDSIZE bytes are buffered (unless at end of file)
+	void fill();
+};
+
+#endif /* BINARYTRACE_H_ */
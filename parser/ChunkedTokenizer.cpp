@@ -0,0 +1,106 @@
+/*
+ * ChunkedTokenizer.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include "ChunkedTokenizer.h"
+#include <cstring>
+
+#include <debugconfig.h>
+
+using namespace std;
+
+// Bytes of the trace tokenized by one thread per batch
+#define CHUNKSIZE (1 << 20)
+
+ChunkedTokenizer::ChunkedTokenizer(MappedTraceReader* reader, unsigned numOfThreads) {
+	this->reader = reader;
+	this->numOfThreads = numOfThreads;
+
+	current = 0;
+	chunkIndex = 0;
+	recordIndex = 0;
+	startBatch(batches[0]);
+	startBatch(batches[1]);
+	finishBatch(batches[0]);
+}
+
+ChunkedTokenizer::~ChunkedTokenizer() {
+	finishBatch(batches[0]);
+	finishBatch(batches[1]);
+}
+
+void ChunkedTokenizer::startBatch(batchType& batch) {
+	batch.begin = NULL;
+	batch.chunks.resize(numOfThreads);
+	for (unsigned i = 0; i < numOfThreads; i++)
+		batch.chunks[i].clear();
+
+	for (unsigned i = 0; i < numOfThreads; i++) {
+		const char* begin;
+		const char* end;
+		if (!reader->getBlock(CHUNKSIZE, begin, end))
+			break;
+		if (batch.begin == NULL)
+			batch.begin = begin;
+		batch.workers.push_back(thread(tokenizeChunk, begin, end, &batch.chunks[i]));
+	}
+}
+
+void ChunkedTokenizer::finishBatch(batchType& batch) {
+	for (unsigned i = 0; i < batch.workers.size(); i++)
+		batch.workers[i].join();
+	batch.workers.clear();
+}
+
+void ChunkedTokenizer::tokenizeChunk(const char* begin, const char* end, vector<recordType>* records) {
+	// a rough guess of the number of lines, to avoid most reallocations
+	records->reserve((end - begin) / 16);
+
+	const char* position = begin;
+	while (position < end) {
+		const char* newline = (const char*) memchr(position, '\n', end - position);
+
+		records->push_back(recordType());
+		recordType& record = records->back();
+		record.lineBegin = position;
+		record.lineEnd = (newline == NULL) ? end : newline;
+		record.validOp = TraceTokenizer::tokenize(record.lineBegin, record.lineEnd, record.token);
+
+		position = (newline == NULL) ? end : newline + 1;
+	}
+}
+
+bool ChunkedTokenizer::getOp(TraceTokenizer::tokenType& token, bool& validOp,
+		const char*& lineBegin, const char*& lineEnd) {
+	while (true) {
+		batchType& batch = batches[current];
+		if (batch.begin == NULL)
+			return false;
+
+		while (chunkIndex < batch.chunks.size() && recordIndex == batch.chunks[chunkIndex].size()) {
+			chunkIndex++;
+			recordIndex = 0;
+		}
+		if (chunkIndex < batch.chunks.size())
+			break;
+
+		// Done with this batch: switch to the next one (already being
+		// tokenized) and start tokenizing the one after it.
+		current = 1 - current;
+		chunkIndex = 0;
+		recordIndex = 0;
+		finishBatch(batches[current]);
+		if (batches[current].begin != NULL)
+			reader->releaseBefore(batches[current].begin);
+		startBatch(batch);
+	}
+
+	recordType& record = batches[current].chunks[chunkIndex][recordIndex++];
+	token = record.token;
+	validOp = record.validOp;
+	lineBegin = record.lineBegin;
+	lineEnd = record.lineEnd;
+	return true;
+}
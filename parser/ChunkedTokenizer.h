@@ -0,0 +1,66 @@
+/*
+ * ChunkedTokenizer.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <vector>
+#include <thread>
+#include <parser/TraceTokenizer.h>
+#include <parser/TraceReader.h>
+
+#include <config.h>
+
+#ifndef CHUNKEDTOKENIZER_H_
+#define CHUNKEDTOKENIZER_H_
+
+/*
+ * ChunkedTokenizer tokenizes a mapped text trace on several threads.
+ * The trace is read in batches of one line-aligned chunk per thread; each
+ * thread tokenizes its chunk into an array of records. While the parser
+ * consumes the records of one batch, the next batch is being tokenized.
+ * Records are handed out in trace order, so the parser sees the same
+ * sequence of ops as with TraceTokenizer on a single thread.
+ */
+class ChunkedTokenizer {
+public:
+	ChunkedTokenizer(MappedTraceReader* reader, unsigned numOfThreads);
+	virtual ~ChunkedTokenizer();
+
+	// Returns false at end of trace, else the next op and its line
+	bool getOp(TraceTokenizer::tokenType& token, bool& validOp,
+			const char*& lineBegin, const char*& lineEnd);
+
+private:
+	class recordType {
+	public:
+		TraceTokenizer::tokenType token;
+		const char* lineBegin;
+		const char* lineEnd;
+		bool validOp;
+	};
+
+	class batchType {
+	public:
+		std::vector<std::vector<recordType> > chunks;
+		std::vector<std::thread> workers;
+		const char* begin;	// start of the first chunk, NULL if the batch is empty
+	};
+
+	MappedTraceReader* reader;
+	unsigned numOfThreads;
+
+	batchType batches[2];
+	unsigned current;		// batch being consumed
+	size_t chunkIndex;		// next record is batches[current].chunks[chunkIndex][recordIndex]
+	size_t recordIndex;
+
+	// reads the next batch from reader and starts tokenizing it
+	void startBatch(batchType& batch);
+	// waits for the workers of batch
+	void finishBatch(batchType& batch);
+
+	static void tokenizeChunk(const char* begin, const char* end, std::vector<recordType>* records);
+};
+
+#endif /* CHUNKEDTOKENIZER_H_ */
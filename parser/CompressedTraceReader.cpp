@@ -0,0 +1,136 @@
+/*
+ * CompressedTraceReader.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include "CompressedTraceReader.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <debugconfig.h>
+
+using namespace std;
+
+static const unsigned char gzipMagic[2] = {0x1f, 0x8b};
+static const unsigned char zstdMagic[4] = {0x28, 0xb5, 0x2f, 0xfd};
+
+CompressionType getCompressionType(string fileName) {
+	unsigned char magic[4];
+	int fd = ::open(fileName.c_str(), O_RDONLY);
+	if (fd == -1)
+		return NO_COMPRESSION;
+	ssize_t length = read(fd, magic, sizeof(magic));
+	::close(fd);
+
+	if (length >= (ssize_t) sizeof(gzipMagic) && memcmp(magic, gzipMagic, sizeof(gzipMagic)) == 0)
+		return GZIP_COMPRESSION;
+	if (length >= (ssize_t) sizeof(zstdMagic) && memcmp(magic, zstdMagic, sizeof(zstdMagic)) == 0)
+		return ZSTD_COMPRESSION;
+	return NO_COMPRESSION;
+}
+
+#ifdef ZLIB
+GzipTraceReader::GzipTraceReader() {
+	file = NULL;
+}
+
+GzipTraceReader::~GzipTraceReader() {
+	if (file != NULL)
+		gzclose(file);
+}
+
+bool GzipTraceReader::open(string traceFileName) {
+	file = gzopen(traceFileName.c_str(), "rb");
+	if (file == NULL)
+		return false;
+	gzbuffer(file, 1 << 18);
+	return true;
+}
+
+long GzipTraceReader::readBlock(char* buffer, size_t size) {
+	int ret = gzread(file, buffer, size);
+	int error = Z_OK;
+	const char* message = gzerror(file, &error);
+	// a trace cut short ends with Z_BUF_ERROR rather than an error of gzread
+	if (ret < 0 || (ret == 0 && error != Z_OK)) {
+		cout << "ERROR: Cannot decompress trace: " << message << "\n";
+		return -1;
+	}
+	return ret;
+}
+#endif
+
+#ifdef ZSTD
+ZstdTraceReader::ZstdTraceReader() {
+	fd = -1;
+	stream = NULL;
+	inBufferSize = ZSTD_DStreamInSize();
+	inBuffer = new char[inBufferSize];
+	input.src = inBuffer;
+	input.size = 0;
+	input.pos = 0;
+	endOfFile = false;
+	frameLeft = 0;
+}
+
+ZstdTraceReader::~ZstdTraceReader() {
+	delete[] inBuffer;
+	if (stream != NULL)
+		ZSTD_freeDStream(stream);
+	if (fd != -1)
+		::close(fd);
+}
+
+bool ZstdTraceReader::open(string traceFileName) {
+	fd = ::open(traceFileName.c_str(), O_RDONLY);
+	if (fd == -1)
+		return false;
+	stream = ZSTD_createDStream();
+	if (stream == NULL) {
+		cout << "ERROR: Cannot create zstd stream\n";
+		return false;
+	}
+	ZSTD_initDStream(stream);
+	return true;
+}
+
+long ZstdTraceReader::readBlock(char* buffer, size_t size) {
+	ZSTD_outBuffer output = {buffer, size, 0};
+	while (output.pos == 0) {
+		if (input.pos == input.size) {
+			if (endOfFile) {
+				if (frameLeft != 0) {
+					cout << "ERROR: Cannot decompress trace: it ends in the middle of a frame\n";
+					return -1;
+				}
+				return 0;
+			}
+			ssize_t ret = read(fd, inBuffer, inBufferSize);
+			if (ret < 0 && errno == EINTR)
+				continue;
+			if (ret < 0) {
+				cout << "ERROR: Cannot read trace: " << strerror(errno) << "\n";
+				return -1;
+			}
+			if (ret == 0) {
+				endOfFile = true;
+				continue;
+			}
+			input.size = ret;
+			input.pos = 0;
+		}
+
+		size_t ret = ZSTD_decompressStream(stream, &output, &input);
+		if (ZSTD_isError(ret)) {
+			cout << "ERROR: Cannot decompress trace: " << ZSTD_getErrorName(ret) << "\n";
+			return -1;
+		}
+		frameLeft = ret;
+	}
+	return output.pos;
+}
+#endif
@@ -0,0 +1,77 @@
+/*
+ * CompressedTraceReader.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <string>
+#include <parser/TraceReader.h>
+
+#include <config.h>
+
+#ifdef ZLIB
+#include <zlib.h>
+#endif
+#ifdef ZSTD
+#include <zstd.h>
+#endif
+
+#ifndef COMPRESSEDTRACEREADER_H_
+#define COMPRESSEDTRACEREADER_H_
+
+enum CompressionType {
+	NO_COMPRESSION,
+	GZIP_COMPRESSION,
+	ZSTD_COMPRESSION
+};
+
+// Returns the compression of fileName, recognized by its magic bytes
+CompressionType getCompressionType(std::string fileName);
+
+#ifdef ZLIB
+/*
+ * Decompresses a gzip trace while reading it. Concatenated gzip members
+ * are read as one trace. A trace that is cut short or fails its CRC is a
+ * read error.
+ */
+class GzipTraceReader : public BufferedTraceReader {
+public:
+	GzipTraceReader();
+	virtual ~GzipTraceReader();
+
+	bool open(std::string traceFileName);
+
+protected:
+	long readBlock(char* buffer, size_t size);
+
+private:
+	gzFile file;
+};
+#endif
+
+#ifdef ZSTD
+/*
+ * Decompresses a zstd trace while reading it, one input block at a time.
+ */
+class ZstdTraceReader : public BufferedTraceReader {
+public:
+	ZstdTraceReader();
+	virtual ~ZstdTraceReader();
+
+	bool open(std::string traceFileName);
+
+protected:
+	long readBlock(char* buffer, size_t size);
+
+private:
+	int fd;
+	ZSTD_DStream* stream;
+	char* inBuffer;
+	size_t inBufferSize;
+	ZSTD_inBuffer input;
+	bool endOfFile;
+	size_t frameLeft;	// 0 once the last frame read is complete
+};
+#endif
+
+#endif /* COMPRESSEDTRACEREADER_H_ */
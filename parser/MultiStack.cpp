@@ -11,69 +11,91 @@ using namespace std;
 
 MultiStack::MultiStack() {
 	bottom.opID = -1;
-	bottom.opType = "";
-	bottom.taskID = "";
+	bottom.opType = INVALID_OP;
+	bottom.taskID = NOTASK;
 	bottom.threadID = -1;
-
-	stack.push_back(bottom);
 }
 
 MultiStack::~MultiStack() {
 }
 
 void MultiStack::push(stackElementType element) {
-	stack.push_back(element);
+	threadStack& s = stacks[element.threadID];
+	s.positionsOfTask[element.taskID].push_back(s.elements.size());
+	s.elements.push_back(element);
+	s.removed.push_back(false);
 }
 
 MultiStack::stackElementType MultiStack::peek(IDType thread) {
-	for (list<stackElementType>::iterator it = stack.end(); it != stack.begin(); it--) {
-		if (it->threadID == thread)
-			return *it;
-	}
-	return bottom;
+	unordered_map<IDType, threadStack>::iterator it = stacks.find(thread);
+	if (it == stacks.end() || it->second.elements.empty())
+		return bottom;
+	return it->second.elements.back();
 }
 
 MultiStack::stackElementType MultiStack::pop(IDType thread) {
-	for (list<stackElementType>::iterator it = stack.end(); it != stack.begin(); it--) {
-		if (it->threadID == thread) {
-			stackElementType temp = *it;
-			stack.erase(it);
-			return temp;
-		}
-	}
-	return bottom;
+	unordered_map<IDType, threadStack>::iterator it = stacks.find(thread);
+	if (it == stacks.end() || it->second.elements.empty())
+		return bottom;
+
+	threadStack& s = it->second;
+	stackElementType temp = s.elements.back();
+	// the top most element of the thread is the top most one of its task
+	unordered_map<TaskIDType, vector<size_t> >::iterator taskIt = s.positionsOfTask.find(temp.taskID);
+	taskIt->second.pop_back();
+	if (taskIt->second.empty())
+		s.positionsOfTask.erase(taskIt);
+	s.elements.pop_back();
+	s.removed.pop_back();
+	s.trim();
+	return temp;
 }
 
 void MultiStack::stackClear(IDType thread) {
-	while (!isEmpty(thread)) {
-		pop(thread);
-	}
+	unordered_map<IDType, threadStack>::iterator it = stacks.find(thread);
+	if (it != stacks.end())
+		stacks.erase(it);
 }
 
-MultiStack::stackElementType MultiStack::pop(IDType thread, string task) {
-	for (list<stackElementType>::iterator it = stack.end(); it != stack.begin(); it--) {
-		if (it->threadID == thread && (it->taskID).compare(task) == 0) {
-			stackElementType temp = *it;
-			stack.erase(it);
-			return temp;
-		}
-	}
-	return bottom;
+MultiStack::stackElementType MultiStack::pop(IDType thread, TaskIDType task) {
+	unordered_map<IDType, threadStack>::iterator it = stacks.find(thread);
+	if (it == stacks.end())
+		return bottom;
+
+	threadStack& s = it->second;
+	unordered_map<TaskIDType, vector<size_t> >::iterator taskIt = s.positionsOfTask.find(task);
+	if (taskIt == s.positionsOfTask.end() || taskIt->second.empty())
+		return bottom;
+
+	size_t position = taskIt->second.back();
+	taskIt->second.pop_back();
+	if (taskIt->second.empty())
+		s.positionsOfTask.erase(taskIt);
+	stackElementType temp = s.elements[position];
+	s.removed[position] = true;
+	s.trim();
+	return temp;
 }
 
-void MultiStack::stackClear(IDType thread, string task) {
-	if (!isEmpty(thread)) {
-		while (true) {
-			MultiStack::stackElementType top = pop(thread, task);
-			if (isBottom(top))
-				break;
-		}
-	}
+void MultiStack::stackClear(IDType thread, TaskIDType task) {
+	unordered_map<IDType, threadStack>::iterator it = stacks.find(thread);
+	if (it == stacks.end())
+		return;
+
+	threadStack& s = it->second;
+	unordered_map<TaskIDType, vector<size_t> >::iterator taskIt = s.positionsOfTask.find(task);
+	if (taskIt == s.positionsOfTask.end())
+		return;
+
+	for (size_t i = 0; i < taskIt->second.size(); i++)
+		s.removed[taskIt->second[i]] = true;
+	s.positionsOfTask.erase(taskIt);
+	s.trim();
 }
 
 bool MultiStack::isBottom(MultiStack::stackElementType element) {
 	if (element.opID == -1 && element.threadID == -1 &&
-		element.opType.compare("") == 0 && element.taskID.compare("") == 0)
+		element.opType == INVALID_OP && element.taskID == NOTASK)
 		return true;
 	else
 		return false;
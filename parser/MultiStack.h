@@ -5,10 +5,12 @@
  *      Author: shalini
  */
 
-#include <list>
+#include <vector>
 #include <string>
+#include <unordered_map>
 
 #include <config.h>
+#include <racedetector/UAFDetector.h>
 
 #ifndef MULTISTACK_H_
 #define MULTISTACK_H_
@@ -19,11 +21,19 @@ public:
 	virtual ~MultiStack();
 
 	struct stackElementType {
-		std::string opType;
+		OpType opType;
 		IDType opID;
 		IDType nodeID;
 		IDType threadID;
-		std::string taskID;
+		TaskIDType taskID;
+
+		stackElementType() {
+			opType = INVALID_OP;
+			opID = -1;
+			nodeID = -1;
+			threadID = -1;
+			taskID = NOTASK;
+		}
 	};
 
 	// normal push operation
@@ -39,10 +49,10 @@ public:
 	void stackClear(IDType t);
 
 	// pop top most element of thread t and task tt
-	stackElementType pop(IDType t, std::string tt);
+	stackElementType pop(IDType t, TaskIDType tt);
 
 	// remove those entries in the stack that has thread t and task tt
-	void stackClear(IDType t, std::string tt);
+	void stackClear(IDType t, TaskIDType tt);
 
 	bool isBottom(stackElementType element);
 
@@ -50,8 +60,27 @@ public:
 	bool isEmpty(IDType t);
 
 private:
-	// Stack - each element is a pair of threadID and taskID.
-	std::list<stackElementType> stack;
+	// Stack of one thread. An element popped by pop(t, tt) from below the
+	// top is only marked as removed, and dropped once it reaches the top.
+	class threadStack {
+	public:
+		std::vector<stackElementType> elements;
+		std::vector<bool> removed;
+		// positions in elements of the elements of each task, top most last.
+		// A task is dropped once it has no element left.
+		std::unordered_map<TaskIDType, std::vector<size_t> > positionsOfTask;
+
+		// drop the removed elements on top
+		void trim() {
+			while (!removed.empty() && removed.back()) {
+				elements.pop_back();
+				removed.pop_back();
+			}
+		}
+	};
+
+	// thread IDs can be OS thread IDs, so the stacks are not indexed by them
+	std::unordered_map<IDType, threadStack> stacks;
 
 	// element to represent bottom
 	stackElementType bottom;
@@ -0,0 +1,104 @@
+/*
+ * TraceFilter.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include "TraceFilter.h"
+#include <iostream>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <strings.h>
+
+#include <debugconfig.h>
+
+using namespace std;
+
+// Ops dropped by FILTER_LOCKS (see test/scripts/removeLocks.sh)
+static const char* lockOps[] = {
+	"entermonitor", "exitmonitor", "acquire", "release", "wait", "notify", "notifyall"
+};
+
+bool TraceFilter::parse(string names, unsigned& filters) {
+	filters = 0;
+	size_t begin = 0;
+	while (begin <= names.size()) {
+		size_t end = names.find(',', begin);
+		if (end == string::npos)
+			end = names.size();
+		string name = names.substr(begin, end - begin);
+		if (name == "locks")
+			filters |= FILTER_LOCKS;
+		else if (name == "enq")
+			filters |= FILTER_ENQ;
+		else {
+			cout << "ERROR: Unknown filter " << name << " (locks, enq)\n";
+			return false;
+		}
+		begin = end + 1;
+	}
+	return true;
+}
+
+bool TraceFilter::dropLine(unsigned filters, const char* begin, const char* end) {
+	if (!(filters & FILTER_LOCKS))
+		return false;
+
+	const char* p = begin;
+	while (p != end && isspace(*p))
+		p++;
+	if (p == end)
+		return true;
+
+	const char* nameBegin = p;
+	while (p != end && isalpha(*p))
+		p++;
+	size_t length = p - nameBegin;
+	for (unsigned i = 0; i < sizeof(lockOps) / sizeof(lockOps[0]); i++) {
+		if (strlen(lockOps[i]) == length && strncasecmp(lockOps[i], nameBegin, length) == 0)
+			return true;
+	}
+	return false;
+}
+
+bool TraceFilter::rewriteLine(unsigned filters, const char* begin, const char* end, string& line) {
+	if (!(filters & FILTER_ENQ))
+		return false;
+
+	// enq(thread, task, thread, 0x...) becomes enq(thread, task, thread, ...)
+	// with the 4th argument in decimal (see test/scripts/renameCallbacks.sh)
+	const char* p = begin;
+	while (p != end && isspace(*p))
+		p++;
+	if (end - p < 3 || strncasecmp(p, "enq", 3) != 0)
+		return false;
+
+	unsigned commas = 0;
+	while (p != end && commas < 3) {
+		if (*p == ',')
+			commas++;
+		p++;
+	}
+	while (p != end && isspace(*p))
+		p++;
+	if (commas < 3 || end - p < 3 || p[0] != '0' || (p[1] != 'x' && p[1] != 'X'))
+		return false;
+
+	const char* argBegin = p;
+	p += 2;
+	unsigned long long value = 0;
+	while (p != end && isxdigit(*p)) {
+		value = value * 16 + (isdigit(*p) ? *p - '0' : tolower(*p) - 'a' + 10);
+		p++;
+	}
+	if (p == argBegin + 2)
+		return false;
+
+	char text[24];
+	snprintf(text, sizeof(text), "%lld", (long long) value);
+	line.assign(begin, argBegin);
+	line.append(text);
+	line.append(p, end);
+	return true;
+}
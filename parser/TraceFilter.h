@@ -0,0 +1,38 @@
+/*
+ * TraceFilter.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <string>
+
+#include <config.h>
+
+#ifndef TRACEFILTER_H_
+#define TRACEFILTER_H_
+
+// Filters, combined as bit flags
+#define FILTER_LOCKS 0x1	// drop entermonitor, exitmonitor, acquire, release, wait, notify, notifyall and blank lines
+#define FILTER_ENQ 0x2		// accept the 4th argument of enq in hex
+
+/*
+ * Normalizations of raw traces, applied while the trace is read (they used to
+ * be done by the sed scripts in test/scripts, each rewriting the whole trace).
+ * The parser applies them only to lines that are not valid ops, so valid
+ * lines are never looked at twice.
+ */
+class TraceFilter {
+public:
+	// Sets filters from a comma separated list of filter names (locks, enq).
+	// Returns false for an unknown name.
+	static bool parse(std::string names, unsigned& filters);
+
+	// Returns true if the line is dropped by filters
+	static bool dropLine(unsigned filters, const char* begin, const char* end);
+
+	// Rewrites the line into line if one of filters applies to it.
+	// Returns false if the line is unchanged.
+	static bool rewriteLine(unsigned filters, const char* begin, const char* end, std::string& line);
+};
+
+#endif /* TRACEFILTER_H_ */
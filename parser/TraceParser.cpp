@@ -11,6 +11,12 @@
 #include <cassert>
 #include <boost/regex.hpp>
 #include "MultiStack.h"
+#include "TraceTokenizer.h"
+#include "BinaryTrace.h"
+#include "CompressedTraceReader.h"
+#include "TraceFilter.h"
+#include "TraceValidator.h"
+#include <logging/Diagnostics.h>
 
 #include <debugconfig.h>
 
@@ -23,13 +29,22 @@ using namespace std;
  */
 //TraceParser::TraceParser(string traceFileName, Logger *logger) {
 TraceParser::TraceParser(string traceFileName) {
-	traceFile.open(traceFileName.c_str(), ios_base::in);
 	cout << traceFileName << endl;
-	if (!traceFile.is_open()) {
-		cout << "Cannot open trace file\n";
-	}
 
 	traceName = traceFileName;
+	outputPrefix = traceFileName;
+	useRegEx = false;
+	useMmap = false;
+	numOfThreads = 1;
+	filters = 0;
+	lineNumber = 0;
+	droppedLines = 0;
+	rewrittenLines = 0;
+	reader = NULL;
+	binaryReader = NULL;
+	chunkedTokenizer = NULL;
+	lineBegin = NULL;
+	lineEnd = NULL;
 
 	opCount = 0;
 	nodeCount = 0;
@@ -86,41 +101,293 @@ TraceParser::TraceParser(string traceFileName) {
 }
 
 TraceParser::~TraceParser() {
+	if (chunkedTokenizer != NULL)
+		delete chunkedTokenizer;
+	if (reader != NULL)
+		delete reader;
+	if (binaryReader != NULL)
+		delete binaryReader;
 }
 
-//int TraceParser::parse(UAFDetector &detector, Logger *logger) {
-int TraceParser::parse(UAFDetector &detector) {
-	string line;
-	boost::regex reg;
-	boost::cmatch matches;
+/*
+ * Opens the trace: binary traces are recognized by their header, compressed
+ * traces by their magic bytes (and decompressed while parsing), other text
+ * traces are read through the reader selected by useMmap. Mapped text traces
+ * are tokenized on numOfThreads threads, unless they are matched with regex.
+ * Standard input ("-") and pipes can be read only once, so they are always
+ * read as text traces, through a buffer.
+ */
+int TraceParser::openTrace() {
+	bool pipe = PipeTraceReader::isPipe(traceName);
+	if (!pipe && BinaryTraceReader::isBinaryTrace(traceName)) {
+		binaryReader = new BinaryTraceReader();
+		if (!binaryReader->open(traceName)) {
+			cout << "Cannot open trace file\n";
+			return -1;
+		}
+		return 0;
+	}
+
+	CompressionType compression = (pipe ? NO_COMPRESSION : getCompressionType(traceName));
+	if (pipe)
+		reader = new PipeTraceReader();
+	else if (compression == GZIP_COMPRESSION) {
+#ifdef ZLIB
+		reader = new GzipTraceReader();
+#else
+		cout << "ERROR: " << traceName << " is gzip compressed, rebuild with ZLIB defined\n";
+		return -1;
+#endif
+	} else if (compression == ZSTD_COMPRESSION) {
+#ifdef ZSTD
+		reader = new ZstdTraceReader();
+#else
+		cout << "ERROR: " << traceName << " is zstd compressed, rebuild with ZSTD defined\n";
+		return -1;
+#endif
+	} else if (useMmap || (numOfThreads > 1 && !useRegEx))
+		reader = new MappedTraceReader();
+	else
+		reader = new StreamTraceReader();
+
+	if (!reader->open(traceName)) {
+		cout << "Cannot open trace file\n";
+		return -1;
+	}
+
+	if (numOfThreads > 1 && !useRegEx && !pipe && compression == NO_COMPRESSION)
+		chunkedTokenizer = new ChunkedTokenizer((MappedTraceReader*) reader, numOfThreads);
+
+	if (useRegEx) {
+		try {
+			// create boost regex from finalRegEx, ignoring case
+			reg.assign(finalRegEx, boost::regex_constants::icase);
+		}
+		catch (boost::regex_error& e) {
+			cout << finalRegEx << " is not a valid regular expression: \""
+				 << e.what() << "\"" << endl;
+			return -1;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Reads the next op of the trace into token. Returns false at end of trace.
+ * validOp is false if the line (or binary record) is not a valid operation.
+ * Lines that are not valid ops are dropped or rewritten by filters.
+ */
+bool TraceParser::getOp(TraceTokenizer::tokenType& token, bool& validOp) {
+	while (readOp(token, validOp)) {
+		if (validOp || filters == 0 || binaryReader != NULL)
+			return true;
+
+		if (TraceFilter::dropLine(filters, lineBegin, lineEnd)) {
+			droppedLines++;
+			continue;
+		}
+		if (TraceFilter::rewriteLine(filters, lineBegin, lineEnd, filteredLine)) {
+			rewrittenLines++;
+			lineBegin = filteredLine.data();
+			lineEnd = lineBegin + filteredLine.size();
+			validOp = tokenizeLine(token);
+		}
+		return true;
+	}
+	return false;
+}
+
+// Reads the next op of the trace into token, without applying filters
+bool TraceParser::readOp(TraceTokenizer::tokenType& token, bool& validOp) {
+	lineNumber++;
+	if (binaryReader != NULL)
+		return binaryReader->getOp(token, validOp);
+	if (chunkedTokenizer != NULL)
+		return chunkedTokenizer->getOp(token, validOp, lineBegin, lineEnd);
+
+	if (!reader->getLine(lineBegin, lineEnd))
+		return false;
+
+	validOp = tokenizeLine(token);
+	return true;
+}
+
+bool TraceParser::readFailed() const {
+	if (binaryReader != NULL)
+		return binaryReader->failed();
+	return reader != NULL && reader->failed();
+}
+
+// Checks whether the current line is a valid line, using either the tokenizer or finalRegEx
+bool TraceParser::tokenizeLine(TraceTokenizer::tokenType& token) {
+	if (useRegEx)
+		return matchRegEx(lineBegin, lineEnd, token);
+	return TraceTokenizer::tokenize(lineBegin, lineEnd, token);
+}
+
+// Returns the text of the current op (rebuilt from token for binary traces)
+string TraceParser::currentOp(const TraceTokenizer::tokenType& token) {
+	if (binaryReader != NULL)
+		return TraceTokenizer::toString(token);
+	return string(lineBegin, lineEnd);
+}
+
+// Returns the ID of the task named by field, interning the name if it is new
+TaskIDType TraceParser::internTask(UAFDetector& detector, const TraceTokenizer::fieldType& field) {
+	if (field.begin != NULL)
+		return detector.taskNames.intern(field.begin, field.end);
+	return detector.taskNames.intern(field.str());
+}
+
+/*
+ * Writes the trace in the binary format to outFileName.
+ * Returns the number of ops written, -1 on error.
+ */
+long long TraceParser::convertToBinary(string outFileName) {
+	if (openTrace() < 0)
+		return -1;
+
+	BinaryTraceWriter writer;
+	if (!writer.open(outFileName))
+		return -1;
+
+	TraceTokenizer::tokenType token;
+	bool validOp;
+	long long count = 0;
+	while (getOp(token, validOp)) {
+		if (!validOp) {
+			cout << "ERROR: Line in trace file is not valid\n";
+			cout << currentOp(token) << endl;
+			return -1;
+		}
+		if (!writer.writeOp(token)) {
+			cout << "ERROR: Cannot write to " << outFileName << "\n";
+			return -1;
+		}
+		count++;
+	}
+	if (readFailed()) {
+		cout << "ERROR: Cannot read the trace to the end\n";
+		return -1;
+	}
+	if (!writer.close()) {
+		cout << "ERROR: Cannot write to " << outFileName << "\n";
+		return -1;
+	}
+	return count;
+}
+
+/*
+ * Reads the whole trace and reports every line that is not a valid op or
+ * breaks the structure checked by TraceValidator.
+ * Returns the number of violations, -1 if the trace cannot be read.
+ */
+long long TraceParser::validate() {
+	if (openTrace() < 0)
+		return -1;
+
+	TraceValidator validator;
+	TraceTokenizer::tokenType token;
+	vector<string> violations;
+	bool validOp;
+	long long numOfOps = 0;
+	long long numOfViolations = 0;
+	while (getOp(token, validOp)) {
+		if (!validOp) {
+			cout << "ERROR: line " << lineNumber << ": not a valid op\n\t" << currentOp(token) << "\n";
+			numOfViolations++;
+			continue;
+		}
 
-	try {
-		// create boost regex from finalRegEx, ignoring case
-		reg.assign(finalRegEx, boost::regex_constants::icase);
+		numOfOps++;
+		if (validator.checkOp(lineNumber, token, violations))
+			continue;
+		for (unsigned i = 0; i < violations.size(); i++)
+			cout << "ERROR: line " << lineNumber << ": " << violations[i] << "\n";
+		cout << "\t" << currentOp(token) << "\n";
+		numOfViolations += violations.size();
 	}
-	catch (boost::regex_error& e) {
-		cout << finalRegEx << " is not a valid regular expression: \""
-			 << e.what() << "\"" << endl;
+	if (readFailed()) {
+		cout << "ERROR: Cannot read the trace to the end\n";
 		return -1;
 	}
 
-	long long typePos, threadPos;
+	validator.finish(violations);
+	for (unsigned i = 0; i < violations.size(); i++)
+		cout << "ERROR: " << violations[i] << "\n";
+	numOfViolations += violations.size();
+
+	cout << "Checked " << numOfOps << " ops, found " << numOfViolations << " violations\n";
+	return numOfViolations;
+}
+
+/*
+ * Matches line against reg (built from finalRegEx) and fills in token from
+ * the sub-matches, the same way TraceTokenizer::tokenize() would.
+ * The first non-empty sub-match after matches[1] is the type of operation,
+ * the following non-empty sub-matches are its arguments.
+ */
+bool TraceParser::matchRegEx(const char* lineBegin, const char* lineEnd,
+		TraceTokenizer::tokenType& token) {
+	if (!boost::regex_match(lineBegin, lineEnd, matches, reg))
+		return false;
+
+	token.opType = INVALID_OP;
+	token.numOfArgs = 0;
+	for (unsigned i=2; i < matches.size(); i++) {
+		if (!matches[i].matched || matches[i].first == matches[i].second)
+			continue;
+		if (token.opType == INVALID_OP) {
+			token.opType = TraceTokenizer::opTypeFromName(matches[i].first, matches[i].second);
+		} else if (token.numOfArgs < MAXARGS) {
+			token.args[token.numOfArgs].begin = matches[i].first;
+			token.args[token.numOfArgs].end = matches[i].second;
+			token.numOfArgs++;
+		}
+	}
+
+	unsigned numOfArgs;
+	TraceTokenizer::argKind kinds[MAXARGS];
+	if (!TraceTokenizer::getArgKinds(token.opType, numOfArgs, kinds) || numOfArgs != token.numOfArgs)
+		return false;
+	for (unsigned i = 0; i < numOfArgs; i++)
+		TraceTokenizer::decode(token.args[i], kinds[i]);
+	return true;
+}
+
+//int TraceParser::parse(UAFDetector &detector, Logger *logger) {
+int TraceParser::parse(UAFDetector &detector) {
+	if (openTrace() < 0)
+		return -1;
 
 	MultiStack stackForThreadOrder;
 	MultiStack stackForTaskOrder;
 	MultiStack stackForNestingOrder;
 	MultiStack stackForGlobalLoop; // To record whether we saw enterloop for each thread.
 
-	while (getline(traceFile, line)) {
-		// Check whether the line is a valid line according to finalRegEx
-		if (!boost::regex_match(line.c_str(), matches, reg)) {
+	// op type and arguments of the current line
+	TraceTokenizer::tokenType token;
+
+	bool validLine;
+	while (getOp(token, validLine)) {
+		if (!validLine) {
 			cout << "ERROR: Line in trace file is not valid\n";
-			cout << line << endl;
+			cout << currentOp(token) << endl;
 			return -1;
 		}
 		else {
 			opCount++;
-			cout << opCount << " " << line << endl;
+			if (slicer.enabled() && !slicer.keepOp(opCount, token))
+				continue;
+
+			if (Diagnostics::enabled(DIAG_PARSE, DIAG_TRACE)) {
+				Diagnostics::stream() << opCount << " ";
+				if (binaryReader == NULL)
+					Diagnostics::stream().write(lineBegin, lineEnd - lineBegin);
+				else
+					Diagnostics::stream() << currentOp(token);
+				Diagnostics::stream() << "\n";
+			}
 
 			// Temp variables to store details of current operation/block/task/thread.
 			UAFDetector::opDetails opdetails;
@@ -128,1954 +395,2146 @@ int TraceParser::parse(UAFDetector &detector) {
 			IDType threadID;	// stores the threadID of current operation
 			MultiStack::stackElementType stackElement; // stores the details of current operation
 
-			// matches[] contains the substrings that matched subexpressions of the regex.
-			// matches[1] is the complete operation (without prefix or suffix), for e.g., threadinit(0)
-			string OpString(matches[1].first, matches[1].second);
-
-			for (unsigned i=2; i < matches.size(); i++) {
-				string match(matches[i].first, matches[i].second);
-				// find the next non-empty matches[i] after matches[1] - this would be the type of operation.
-				if (!match.empty() && match.compare(" ") != 0) {
-					typePos = i;
-
-					for (unsigned j=typePos+1; j < matches.size(); j++) {
-						string m1(matches[j].first, matches[j].second);
-						// find the next non-empty matches[i] after type of operation.
-						if (!m1.empty() && m1.compare(" ") != 0) {
-							threadID = atoi(m1.c_str());
-							threadPos = j;
-							break;
-						}
-					}
-
-					// Obtain opType and threadID of the current operation
-					opdetails.opType = match;
-					opdetails.threadID = threadID;
+			// Obtain opType and threadID of the current operation
+			threadID = token.args[0].toInt();
+			opdetails.opType = token.opType;
+			opdetails.threadID = threadID;
+
+			// Populate details for stack entry
+			stackElement.opID = opCount;
+			stackElement.opType = token.opType;
+			stackElement.threadID = threadID;
+
+			if (token.opType == THREADINIT_OP) {
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
+#ifdef SANITYCHECK
+				// Sanity check: stack should be empty for threadID
+				assert(stackForThreadOrder.isEmpty(threadID));
+				assert(stackForTaskOrder.isEmpty(threadID));
+#endif
 
-					// Populate details for stack entry
-					stackElement.opID = opCount;
-					stackElement.opType = match;
-					stackElement.threadID = threadID;
+				// Obtain details of current thread
 
-					if (match.compare("threadinit") == 0) {
-						nodeCount++;
-						opdetails.nodeID = nodeCount;
-						stackElement.nodeID = nodeCount;
+				if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+					// If there is no entry for this thread in the threadIDMap, then we did not see
+					// a fork op for this thread.
 
-						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-							UAFDetector::setOfOps set;
-							set.opSet.insert(opCount);
-							detector.nodeIDMap[nodeCount] = set;
-						} else {
-							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.nodeIDMap[nodeCount].printDetails();
-							return -1;
-						}
+					UAFDetector::threadDetails threaddetails;
+					threaddetails.firstOpID = opCount;
+					threaddetails.threadinitOpID = opCount;
+					detector.threadIDMap[threadID] = threaddetails;
+				} else {
+					UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
 #ifdef SANITYCHECK
-						// Sanity check: stack should be empty for threadID
-						assert(stackForThreadOrder.isEmpty(threadID));
-						assert(stackForTaskOrder.isEmpty(threadID));
+					// Sanity check: if there already exists an entry for thread, then this must
+					// have been set when we saw a fork op for this thread. That is, the threadinit
+					// op id has not been set, same with firstOpID
+					assert(existingEntry.threadinitOpID == -1);
+					assert(existingEntry.firstOpID == -1);
 #endif
+					existingEntry.threadinitOpID = opCount;
+					existingEntry.firstOpID = opCount;
+					detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+					detector.threadIDMap[threadID] = existingEntry;
+				}
 
-						// Obtain details of current thread
+				stackForThreadOrder.push(stackElement);
+			} else if (token.opType == THREADEXIT_OP) {
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
 
-						if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-							// If there is no entry for this thread in the threadIDMap, then we did not see
-							// a fork op for this thread.
+				// Get the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)) {
+					cout << "WARNING: No previous op found for threadexit " << opCount
+						 << " on stackForThreadOrder\n";
+					cout << "WARNING: This is fine if this is the first op in the thread\n";
 
-							UAFDetector::threadDetails threaddetails;
-							threaddetails.firstOpID = opCount;
-							threaddetails.threadinitOpID = opCount;
-							detector.threadIDMap[threadID] = threaddetails;
-						} else {
-							UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
 #ifdef SANITYCHECK
-							// Sanity check: if there already exists an entry for thread, then this must
-							// have been set when we saw a fork op for this thread. That is, the threadinit
-							// op id has not been set, same with firstOpID
-							assert(existingEntry.threadinitOpID == -1);
-							assert(existingEntry.firstOpID == -1);
+					// Sanity check: task order stack needs to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
 #endif
-							existingEntry.threadinitOpID = opCount;
-							existingEntry.firstOpID = opCount;
-							detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-							detector.threadIDMap[threadID] = existingEntry;
-						}
-
-						stackForThreadOrder.push(stackElement);
-					} else if (match.compare("threadexit") == 0) {
-						nodeCount++;
-						opdetails.nodeID = nodeCount;
-						stackElement.nodeID = nodeCount;
 
-						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-							UAFDetector::setOfOps set;
-							set.opSet.insert(opCount);
-							detector.nodeIDMap[nodeCount] = set;
-						} else {
-							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.nodeIDMap[nodeCount].printDetails();
+					// Update firstop, firstblock, lastblock and threadexitopID for the current thread
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.threadexitOpID = opCount;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						// If there is an entry for this thread in threadIDMap, we had seen the fork op
+						// of this thread and the forkOpID is set.
+						// But in this case, threadexit cannot be the first op in the thread. We must have
+						// seen a threadinit.
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+#ifdef SANITYCHECK
+						assert(existingEntry.threadexitOpID == -1);
+						assert(existingEntry.firstOpID == -1);
+
+						if (existingEntry.forkOpID == -1) {
+							cout << "ERROR: We did not see a fork op for thread " << threadID
+								 << " but there already exists an entry for this thread in threadIDMap\n";
+							cout << "ERROR: Existing entry details:\n";
+							existingEntry.printThreadDetails();
+							cout << "\n";
 							return -1;
 						}
+#endif
+						existingEntry.threadexitOpID = opCount;
+						existingEntry.firstOpID = opCount;
+						existingEntry.lastOpInThreadID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-						// Get the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)) {
-							cout << "WARNING: No previous op found for threadexit " << opCount
-								 << " on stackForThreadOrder\n";
-							cout << "WARNING: This is fine if this is the first op in the thread\n";
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
 
+					// Set current op as next-op for the stack top
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "ERROR: While examining op " << opCount << "\n";
+						cout << "ERROR: Trying to set op " << opCount << " as next-op of op "
+							 << previousOpInThread.opID << "\n";
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-							// Sanity check: task order stack needs to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
+						// Sanity check: prev op has same threadID in stack and opIDMap
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
 
-							// Update firstop, firstblock, lastblock and threadexitopID for the current thread
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.threadexitOpID = opCount;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								// If there is an entry for this thread in threadIDMap, we had seen the fork op
-								// of this thread and the forkOpID is set.
-								// But in this case, threadexit cannot be the first op in the thread. We must have
-								// seen a threadinit.
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
-#ifdef SANITYCHECK
-								assert(existingEntry.threadexitOpID == -1);
-								assert(existingEntry.firstOpID == -1);
-
-								if (existingEntry.forkOpID == -1) {
-									cout << "ERROR: We did not see a fork op for thread " << threadID
-										 << " but there already exists an entry for this thread in threadIDMap\n";
-									cout << "ERROR: Existing entry details:\n";
-									existingEntry.printThreadDetails();
-									cout << "\n";
-									return -1;
-								}
-#endif
-								existingEntry.threadexitOpID = opCount;
-								existingEntry.firstOpID = opCount;
-								existingEntry.lastOpInThreadID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
 
-						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// Update threadexit-opID and lastblock-ID for the current thread
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						cout << "ERROR: Cannot find entry for thread " << threadID << " in threadIDMap\n";
+						cout << "ERROR: This is an error since threadexit is not the first op "
+						     << "in this thread according to the ThreadOrder stack, this means "
+						     << "we should find an entry for this thread in threadIDMap\n";
+						return -1;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+						existingEntry.threadexitOpID = opCount;
+						existingEntry.lastOpInThreadID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-							// Set current op as next-op for the stack top
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "ERROR: While examining op " << opCount << "\n";
-								cout << "ERROR: Trying to set op " << opCount << " as next-op of op "
-									 << previousOpInThread.opID << "\n";
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+					// Clear all the ops for this thread from the stack.
+					stackForThreadOrder.stackClear(threadID);
+				}
+			} else if (token.opType == ENTERLOOP_OP) {
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
+
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)){
+					cout << "WARNING: No previous op found for enterloop " << opCount
+						 << " on stackForThreadOrder\n";
+					cout << "WARNING: This is fine if this is the first op in the thread\n";
 
 #ifdef SANITYCHECK
-								// Sanity check: prev op has same threadID in stack and opIDMap
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
+					// Sanity check: task order stack needs to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
 #endif
 
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
-
-							// Update threadexit-opID and lastblock-ID for the current thread
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								cout << "ERROR: Cannot find entry for thread " << threadID << " in threadIDMap\n";
-								cout << "ERROR: This is an error since threadexit is not the first op "
-								     << "in this thread according to the ThreadOrder stack, this means "
-								     << "we should find an entry for this thread in threadIDMap\n";
-								return -1;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
-								existingEntry.threadexitOpID = opCount;
-								existingEntry.lastOpInThreadID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
-
-							// Clear all the ops for this thread from the stack.
-							stackForThreadOrder.stackClear(threadID);
-						}
-					} else if (match.compare("enterloop") == 0) {
-						nodeCount++;
-						opdetails.nodeID = nodeCount;
-						stackElement.nodeID = nodeCount;
+					// This means this is the first op in the thread
 
-						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-							UAFDetector::setOfOps set;
-							set.opSet.insert(opCount);
-							detector.nodeIDMap[nodeCount] = set;
-						} else {
-							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.nodeIDMap[nodeCount].printDetails();
+					// Update firstop and enterloopID for current thread
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						threaddetails.enterloopID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						// If there is an entry for this thread in threadIDMap, we had seen the fork op
+						// of this thread and the forkOpID is set.
+						// But in this case, enterloop cannot be the first op in the thread. We must have
+						// seen a threadinit.
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+#ifdef SANITYCHECK
+						assert(existingEntry.firstOpID == -1);
+
+						if (existingEntry.forkOpID == -1) {
+							cout << "ERROR: We did not see a fork op for thread " << threadID
+								 << " but there already exists an entry for this thread in threadIDMap\n";
+							cout << "ERROR: Existing entry details:\n";
+							existingEntry.printThreadDetails();
+							cout << "\n";
 							return -1;
 						}
+#endif
+
+						existingEntry.firstOpID = opCount;
+						existingEntry.enterloopID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
+
 
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)){
-							cout << "WARNING: No previous op found for enterloop " << opCount
-								 << " on stackForThreadOrder\n";
-							cout << "WARNING: This is fine if this is the first op in the thread\n";
+					stackForThreadOrder.push(stackElement);
+					stackForGlobalLoop.push(stackElement);
 
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+
+					// Set current op as next-op for the stack top
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "ERROR: While examining op " << opCount << "\n";
+						cout << "ERROR: Trying to set op " << opCount << " as next-op of op "
+							 << previousOpInThread.opID << "\n";
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-							// Sanity check: task order stack needs to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
+						// Sanity check: prev-op has same threadID as current op in stack and opIDMap
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
 
-							// This means this is the first op in the thread
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
+
+					// Set enterloopID for the current thread
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						cout << "ERROR: Cannot find entry for thread " << threadID << " in threadIDMap\n";
+						return -1;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+						existingEntry.enterloopID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
+
+					stackForThreadOrder.push(stackElement);
+					stackForGlobalLoop.push(stackElement);
+				}
+			} else if (token.opType == EXITLOOP_OP) {
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
+
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)){
+					cout << "WARNING: No previous op found for exitloop " << opCount
+						 << " on stack\n";
+					cout << "WARNING: This is fine if this is the first op in the thread\n";
 
-							// Update firstop and enterloopID for current thread
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								threaddetails.enterloopID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								// If there is an entry for this thread in threadIDMap, we had seen the fork op
-								// of this thread and the forkOpID is set.
-								// But in this case, enterloop cannot be the first op in the thread. We must have
-								// seen a threadinit.
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
 #ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
-
-								if (existingEntry.forkOpID == -1) {
-									cout << "ERROR: We did not see a fork op for thread " << threadID
-										 << " but there already exists an entry for this thread in threadIDMap\n";
-									cout << "ERROR: Existing entry details:\n";
-									existingEntry.printThreadDetails();
-									cout << "\n";
-									return -1;
-								}
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
 #endif
 
-								existingEntry.firstOpID = opCount;
-								existingEntry.enterloopID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
-
+					// This means this is the first op in the thread
+					// Update firstop for current thread
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						threaddetails.exitloopID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+#ifdef SANITYCHECK
+						assert(existingEntry.firstOpID == -1);
+
+						if (existingEntry.forkOpID == -1) {
+							cout << "ERROR: We did not see a fork op for thread " << threadID
+								 << " but there already exists an entry for this thread in threadIDMap\n";
+							cout << "ERROR: Existing entry details:\n";
+							existingEntry.printThreadDetails();
+							cout << "\n";
+							return -1;
+						}
+#endif
+						existingEntry.exitloopID = opCount;
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-							stackForThreadOrder.push(stackElement);
-							stackForGlobalLoop.push(stackElement);
 
-						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					stackForThreadOrder.push(stackElement);
 
-							// Set current op as next-op for the stack top
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "ERROR: While examining op " << opCount << "\n";
-								cout << "ERROR: Trying to set op " << opCount << " as next-op of op "
-									 << previousOpInThread.opID << "\n";
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
 
+					// Set current op as next-op for stack top
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-								// Sanity check: prev-op has same threadID as current op in stack and opIDMap
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
+						// Sanity check: prev-op has same thread as current op in stack and opIDMap
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
 
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
 
-							// Set enterloopID for the current thread
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								cout << "ERROR: Cannot find entry for thread " << threadID << " in threadIDMap\n";
-								return -1;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
-								existingEntry.enterloopID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
+					// Set exitloopID for the current thread
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						cout << "ERROR: Cannot find entry for thread " << threadID << " in threadIDMap\n";
+						return -1;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+						existingEntry.exitloopID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-							stackForThreadOrder.push(stackElement);
-							stackForGlobalLoop.push(stackElement);
-						}
-					} else if (match.compare("exitloop") == 0) {
-						nodeCount++;
-						opdetails.nodeID = nodeCount;
-						stackElement.nodeID = nodeCount;
+					stackForThreadOrder.push(stackElement);
+					stackForGlobalLoop.stackClear(threadID);
+					stackForGlobalLoop.push(stackElement); // pushing exitloop
+				}
+			} else if (token.opType == ENQ_OP) {
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
 
-						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-							UAFDetector::setOfOps set;
-							set.opSet.insert(opCount);
-							detector.nodeIDMap[nodeCount] = set;
-						} else {
-							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.nodeIDMap[nodeCount].printDetails();
-							return -1;
-						}
+				// Obtain 2nd, 3rd and 4th argument (i.e task enqueued, target threadID & priority) of enq op
+				TaskIDType taskEnqueued;
+				IDType targetThread;
+				IDType priority;
+				taskEnqueued = internTask(detector, token.args[1]);
+				targetThread = token.args[2].toInt();
+				priority = token.args[3].toInt();
+
+				if (detector.taskIDMap.find(taskEnqueued) == detector.taskIDMap.end()) {
+					UAFDetector::taskDetails taskdetails;
+					taskdetails.enqOpID = opCount;
+					taskdetails.priority = priority;
+					detector.taskIDMap[taskEnqueued] = taskdetails;
+				} else {
+					cout << "ERROR: Found duplicate entry for task " << detector.taskNames.name(taskEnqueued) << " in taskIDMap\n";
+					cout << "While examining op " << opCount;
+					cout << "\nDuplicate entry:\n";
+					detector.taskIDMap[taskEnqueued].printTaskDetails(detector.taskNames);
+					cout << endl;
+					return -1;
+				}
 
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)){
-							cout << "WARNING: No previous op found for exitloop " << opCount
-								 << " on stack\n";
-							cout << "WARNING: This is fine if this is the first op in the thread\n";
+				UAFDetector::enqOpDetails enqdetails;
+				enqdetails.targetThread = targetThread;
+				enqdetails.taskEnqueued = taskEnqueued;
+				enqdetails.priority = priority;
+
+				// Map enq op to its arguments;
+				if (detector.enqToTaskEnqueued.find(opCount) == detector.enqToTaskEnqueued.end()) {
+					detector.enqToTaskEnqueued[opCount] = enqdetails;
+				} else {
+					cout << "ERROR: Found duplicate entry for enq op " << opCount << " in enqToTaskEnqueued\n";
+					cout << "Duplicate entry:\n";
+					detector.enqToTaskEnqueued[opCount].printEnqDetails(detector.taskNames);
+					cout << endl;
+					return -1;
+				}
+
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)){
+					cout << "WARNING: No previous op found for enq " << opCount
+						 << " on stack\n";
+					cout << "WARNING: This is fine if this is the first op in the thread\n";
 
 #ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
 #endif
 
-							// This means this is the first op in the thread
-							// Update firstop for current thread
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								threaddetails.exitloopID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+					// This means this is the first op in the thread
+					// Update firstop for current thread
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
 #ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
-
-								if (existingEntry.forkOpID == -1) {
-									cout << "ERROR: We did not see a fork op for thread " << threadID
-										 << " but there already exists an entry for this thread in threadIDMap\n";
-									cout << "ERROR: Existing entry details:\n";
-									existingEntry.printThreadDetails();
-									cout << "\n";
-									return -1;
-								}
+						assert(existingEntry.firstOpID == -1);
 #endif
-								existingEntry.exitloopID = opCount;
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
-
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-							stackForThreadOrder.push(stackElement);
+					stackForThreadOrder.push(stackElement);
+
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of an enq operation, the previous op in the thread need not be in the same task as enq.
+					// The use case for this is when the task is a nested task and the enq op happens within the nesting
+					// loop, but outside any of the child tasks.
+					MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
+
+					// If the previous op in task stack is the same as the previous op in thread stack, then we are not
+					// in the middle of a nesting loop.
+					bool firstOpInsideNestingLoop;
+					bool firstOpInsideGlobalLoop = false;
+					if (previousOpInThread.opID == -1) {
+						cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
+						return -1;
+					}
+					if (!stackForTaskOrder.isEmpty(threadID)) {
+						if (previousOpInTask.opID != previousOpInThread.opID)
+							firstOpInsideNestingLoop = true;
+						else {
+							// If the previous op in task is a pause, then we are in a new block
+#ifdef PERMIT
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PERMIT_OP)
+#else
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PAUSE_OP)
+#endif
+								firstOpInsideNestingLoop = true;
+							else
+								firstOpInsideNestingLoop = false;
+						}
+					} else {
+						// Task order stack is empty, this means we are not inside a nesting loop
+						firstOpInsideNestingLoop = false;
+
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							// We are inside the global loop.
+							MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
+							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP
+									|| topOfGlobalLoopStack.opType == EXITLOOP_OP) {
+								if (previousOpInThread.opType == EXITLOOP_OP)
+									firstOpInsideGlobalLoop = false;
+								else
+									firstOpInsideGlobalLoop = true;
+							}
+						} else if (!stackForNestingOrder.isEmpty(threadID)) {
+							cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread "
+								 << threadID << "\n";
+							cout << "ERROR: Top element in NestingOrder stack: "
+								 << stackForNestingOrder.peek(threadID).opID
+								 << "\n";
+							return -1;
+						}
+					}
 
+					// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
 						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-
-							// Set current op as next-op for stack top
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+							opdetails.taskID = previousOpInThread.taskID;
+						}
+					} else {
+						// If this is the first op inside the nesting loop, then we are in a new block
+						opdetails.taskID = previousOpInTask.taskID;
+					}
 
+					// Set current op as next-op for stack top
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-								// Sanity check: prev-op has same thread as current op in stack and opIDMap
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
+						// Sanity check: prev-op has same thread as current op in stack and opIDMap
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
 
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
 
-							// Set exitloopID for the current thread
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								cout << "ERROR: Cannot find entry for thread " << threadID << " in threadIDMap\n";
-								return -1;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
-								existingEntry.exitloopID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
-
-							stackForThreadOrder.push(stackElement);
-							stackForGlobalLoop.stackClear(threadID);
-							stackForGlobalLoop.push(stackElement); // pushing exitloop
+						// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
+						if (!firstOpInsideNestingLoop && !firstOpInsideGlobalLoop) {
+							if (previousOpInThread.taskID != NOTASK)
+								detector.opIDMap.nextOpInTask[previousOpInThread.opID] = opCount;
 						}
-					} else if (match.compare("enq") == 0) {
-						nodeCount++;
-						opdetails.nodeID = nodeCount;
-						stackElement.nodeID = nodeCount;
 
-						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-							UAFDetector::setOfOps set;
-							set.opSet.insert(opCount);
-							detector.nodeIDMap[nodeCount] = set;
-						} else {
-							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.nodeIDMap[nodeCount].printDetails();
+					}
+
+					if (firstOpInsideNestingLoop) {
+						if (!detector.opIDMap.exists(previousOpInTask.opID)) {
+							cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
 							return -1;
+						} else {
+#ifdef SANITYCHECK
+							// Sanity check: prev-op has same thread as current op in stack and opIDMap
+							assert(previousOpInTask.threadID == threadID);
+							assert(detector.opIDMap.threadID[previousOpInTask.opID] == threadID);
+#endif
+							opdetails.taskID = previousOpInTask.taskID;
+							opdetails.prevOpInThread = previousOpInThread.opID;
+							detector.opIDMap.nextOpInTask[previousOpInTask.opID] = opCount;
 						}
+					}
 
-						// Obtain 2nd, 3rd and 4th argument (i.e task enqueued, target threadID & priority) of enq op
-						string taskEnqueued;
-						IDType targetThread;
-						IDType priority;
-						unsigned j;
-						for (j=threadPos+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								taskEnqueued = m1;
-								break;
-							}
-						}
-						for (j=j+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								targetThread = atoi(m1.c_str());
-								break;
-							}
-						}
-						for (j=j+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								priority = atoi(m1.c_str());
-								break;
-							}
-						}
+					// Add enq to the enqSet for current block
+					if (!firstOpInsideNestingLoop && !firstOpInsideGlobalLoop) {
 
-						if (detector.taskIDMap.find(taskEnqueued) == detector.taskIDMap.end()) {
-							UAFDetector::taskDetails taskdetails;
-							taskdetails.enqOpID = opCount;
-							taskdetails.priority = priority;
-							detector.taskIDMap[taskEnqueued] = taskdetails;
-						} else {
-							cout << "ERROR: Found duplicate entry for task " << taskEnqueued << " in taskIDMap\n";
-							cout << "While examining op " << opCount;
-							cout << "\nDuplicate entry:\n";
-							detector.taskIDMap[taskEnqueued].printTaskDetails();
-							cout << endl;
-							return -1;
-						}
+					} else if (!firstOpInsideNestingLoop && firstOpInsideGlobalLoop) {
+
+					} else {
 
-						UAFDetector::enqOpDetails enqdetails;
-						enqdetails.targetThread = targetThread;
-						enqdetails.taskEnqueued = taskEnqueued;
-						enqdetails.priority = priority;
+					}
 
-						// Map enq op to its arguments;
-						if (detector.enqToTaskEnqueued.find(opCount) == detector.enqToTaskEnqueued.end()) {
-							detector.enqToTaskEnqueued[opCount] = enqdetails;
-						} else {
-							cout << "ERROR: Found duplicate entry for enq op " << opCount << " in enqToTaskEnqueued\n";
-							cout << "Duplicate entry:\n";
-							detector.enqToTaskEnqueued[opCount].printEnqDetails();
-							cout << endl;
-							return -1;
+					if (!firstOpInsideNestingLoop && !firstOpInsideGlobalLoop) {
+						stackElement.taskID = previousOpInThread.taskID;
+					} else if (!firstOpInsideNestingLoop && firstOpInsideGlobalLoop) {
+					} else {
+						stackElement.taskID = previousOpInTask.taskID;
+					}
+					stackForThreadOrder.push(stackElement);
+					if (!stackForTaskOrder.isEmpty(threadID))
+						stackForTaskOrder.push(stackElement);
+					else {
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							stackForGlobalLoop.push(stackElement);
 						}
+					}
+				}
+			} else if (token.opType == DEQ_OP) {
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
 
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)){
-							cout << "WARNING: No previous op found for enq " << opCount
-								 << " on stack\n";
-							cout << "WARNING: This is fine if this is the first op in the thread\n";
+				// Obtain 2nd argument (i.e., task dequeued) of deq
+				TaskIDType taskDequeued;
+				taskDequeued = internTask(detector, token.args[1]);
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)){
+					cout << "WARNING: No previous op found for deq " << opCount
+						 << " on stack\n";
 
 #ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
 #endif
 
-							// This means this is the first op in the thread
-							// Update firstop for current thread
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
-#ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
-#endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
+					// This means this is the first op in the thread
+					opdetails.taskID = taskDequeued;
 
-							stackForThreadOrder.push(stackElement);
+					if (!detector.opIDMap.exists(opCount)) {
+						detector.opIDMap.insert(opCount, opdetails);
+					} else {
+						cout << "ERROR: Found duplicate entry for op " << opCount << " in opIDMap\n";
+						cout << "ERROR: Duplicate entry:\n";
+						detector.opIDMap.printOpDetails(opCount, detector.taskNames);
+						return -1;
+					}
 
-						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of an enq operation, the previous op in the thread need not be in the same task as enq.
-							// The use case for this is when the task is a nested task and the enq op happens within the nesting
-							// loop, but outside any of the child tasks.
-							MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
-
-							// If the previous op in task stack is the same as the previous op in thread stack, then we are not
-							// in the middle of a nesting loop.
-							bool firstOpInsideNestingLoop;
-							bool firstOpInsideGlobalLoop = false;
-							if (previousOpInThread.opID == -1) {
-								cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
-								return -1;
-							}
-							if (!stackForTaskOrder.isEmpty(threadID)) {
-								if (previousOpInTask.opID != previousOpInThread.opID)
-									firstOpInsideNestingLoop = true;
-								else {
-									// If the previous op in task is a pause, then we are in a new block
-#ifdef PERMIT
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("permit") == 0)
-#else
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("pause") == 0)
+					// If there exists an entry for this tak in taskIDMap, 
+					// then we saw an enq of this task
+					if (detector.taskIDMap.find(taskDequeued) == detector.taskIDMap.end()) {
+						UAFDetector::taskDetails taskdetails;
+						taskdetails.deqOpID = opCount;
+						taskdetails.firstOpInTaskID = opCount;
+						detector.taskIDMap[taskDequeued] = taskdetails;
+					} else {
+						// We saw an enq of this task before
+						UAFDetector::taskDetails& existingEntry = detector.taskIDMap[taskDequeued];
+#ifdef SANITYCHECK
+						assert(existingEntry.enqOpID != -1);
 #endif
-										firstOpInsideNestingLoop = true;
-									else
-										firstOpInsideNestingLoop = false;
-								}
-							} else {
-								// Task order stack is empty, this means we are not inside a nesting loop
-								firstOpInsideNestingLoop = false;
-
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									// We are inside the global loop.
-									MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
-									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0
-											|| topOfGlobalLoopStack.opType.compare("exitloop") == 0) {
-										if (previousOpInThread.opType.compare("exitloop") == 0)
-											firstOpInsideGlobalLoop = false;
-										else
-											firstOpInsideGlobalLoop = true;
-									}
-								} else if (!stackForNestingOrder.isEmpty(threadID)) {
-									cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread "
-										 << threadID << "\n";
-									cout << "ERROR: Top element in NestingOrder stack: "
-										 << stackForNestingOrder.peek(threadID).opID
-										 << "\n";
-									return -1;
-								}
-							}
-
-							// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									opdetails.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								// If this is the first op inside the nesting loop, then we are in a new block
-								opdetails.taskID = previousOpInTask.taskID;
-							}
-
-							// Set current op as next-op for stack top
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+						existingEntry.deqOpID = opCount;
+						existingEntry.firstOpInTaskID = opCount;
+					}
 
+					// Update firstop, firstblock and exitloopblock for current thread
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
 #ifdef SANITYCHECK
-								// Sanity check: prev-op has same thread as current op in stack and opIDMap
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
+						assert(existingEntry.firstOpID == -1);
 #endif
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-
-								// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
-								if (!firstOpInsideNestingLoop && !firstOpInsideGlobalLoop) {
-									if (previousOpInThread.taskID.compare("") != 0)
-										existingEntry.nextOpInTask = opCount;
-								}
+					stackElement.taskID = taskDequeued;
+					stackForThreadOrder.push(stackElement);
+					stackForTaskOrder.push(stackElement);
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
 
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+					// deq is the beginning of a block
+					opdetails.taskID = taskDequeued;
 
-							if (firstOpInsideNestingLoop) {
-								if (detector.opIDMap.find(previousOpInTask.opID) == detector.opIDMap.end()) {
-									cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
-									return -1;
-								} else {
-									UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInTask.opID];
+					// Set current op as next-op for stack top
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-									// Sanity check: prev-op has same thread as current op in stack and opIDMap
-									assert(previousOpInTask.threadID == threadID);
-									assert(existingEntry.threadID == threadID);
+						// Sanity check: prev-op has same thread as current op in stack and opIDMap
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
+						assert(previousOpInThread.taskID != taskDequeued);
+						assert(detector.opIDMap.taskID[previousOpInThread.opID] != taskDequeued);
 #endif
-									opdetails.taskID = previousOpInTask.taskID;
-									opdetails.prevOpInThread = previousOpInThread.opID;
-									existingEntry.nextOpInTask = opCount;
-									detector.opIDMap.erase(detector.opIDMap.find(previousOpInTask.opID));
-									detector.opIDMap[previousOpInTask.opID] = existingEntry;
-								}
-							}
 
-							// Add enq to the enqSet for current block
-							if (!firstOpInsideNestingLoop && !firstOpInsideGlobalLoop) {
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
 
-							} else if (!firstOpInsideNestingLoop && firstOpInsideGlobalLoop) {
+					// Map deqopID, parentTask, etc of current task
+					if (detector.taskIDMap.find(taskDequeued) == detector.taskIDMap.end()) {
+						// There is no entry for this task in taskIDMap, this means we did not see an enq of this op.
+						// This happens when the enq is from a thread we ignored (or something like that!)
 
-							} else {
+						UAFDetector::taskDetails taskdetails;
+						taskdetails.deqOpID = opCount;
+						taskdetails.firstOpInTaskID = opCount;
 
-							}
+						// Find if there was a pause of some task when this task is dequeued.
+						if (!stackForNestingOrder.isEmpty(threadID)) {
+							MultiStack::stackElementType topOfNestingStack = stackForNestingOrder.peek(threadID);
 
-							if (!firstOpInsideNestingLoop && !firstOpInsideGlobalLoop) {
-								stackElement.taskID = previousOpInThread.taskID;
-							} else if (!firstOpInsideNestingLoop && firstOpInsideGlobalLoop) {
-							} else {
-								stackElement.taskID = previousOpInTask.taskID;
-							}
-							stackForThreadOrder.push(stackElement);
-							if (!stackForTaskOrder.isEmpty(threadID))
-								stackForTaskOrder.push(stackElement);
-							else {
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									stackForGlobalLoop.push(stackElement);
+#ifdef PERMIT
+							if (topOfNestingStack.opType == PERMIT_OP) {
+#else
+							if (topOfNestingStack.opType == PAUSE_OP) {
+#endif
+								if (detector.taskIDMap.find(topOfNestingStack.taskID) == detector.taskIDMap.end()) {
+									cout << "ERROR: Cannot find entry for task " << detector.taskNames.name(topOfNestingStack.taskID) << " in taskIDMap\n";
+									cout << "ERROR: While examining op " << opCount << "\n";
+									return -1;
 								}
+								taskdetails.parentTask = topOfNestingStack.taskID;
 							}
 						}
-					} else if (match.compare("deq") == 0) {
-						nodeCount++;
-						opdetails.nodeID = nodeCount;
-						stackElement.nodeID = nodeCount;
 
-						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-							UAFDetector::setOfOps set;
-							set.opSet.insert(opCount);
-							detector.nodeIDMap[nodeCount] = set;
-						} else {
-							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.nodeIDMap[nodeCount].printDetails();
-							return -1;
-						}
+						detector.taskIDMap[taskDequeued] = taskdetails;
+					} else {
+						UAFDetector::taskDetails& existingEntry = detector.taskIDMap[taskDequeued];
+						existingEntry.deqOpID = opCount;
+						existingEntry.firstOpInTaskID = opCount;
 
-						// Obtain 2nd argument (i.e., task dequeued) of deq
-						string taskDequeued;
-						for (unsigned j=threadPos+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								taskDequeued = m1;
-								break;
+						// Find if there was a pause of some task when this task is dequeued.
+						if (!stackForNestingOrder.isEmpty(threadID)) {
+							MultiStack::stackElementType topOfNestingStack = stackForNestingOrder.peek(threadID);
+#ifdef PERMIT
+							if (topOfNestingStack.opType == PERMIT_OP) {
+#else
+							if (topOfNestingStack.opType == PAUSE_OP) {
+#endif
+							    if (detector.taskIDMap.find(topOfNestingStack.taskID) == detector.taskIDMap.end()) {
+								cout << "ERROR: Cannot find entry for task " << detector.taskNames.name(topOfNestingStack.taskID) << " in taskIDMap\n";
+								cout << "While examining op " << opCount << "\n";
+								return -1;
+							    }
+							    existingEntry.parentTask = topOfNestingStack.taskID;
 							}
 						}
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)){
-							cout << "WARNING: No previous op found for deq " << opCount
-								 << " on stack\n";
+					}
 
-#ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
+					stackElement.taskID = taskDequeued;
+					stackForThreadOrder.push(stackElement);
+					stackForTaskOrder.push(stackElement);
+					stackForNestingOrder.push(stackElement);
+
+					if (!stackForGlobalLoop.isEmpty(threadID)) {
+						while (stackForGlobalLoop.peek(threadID).opType != ENTERLOOP_OP &&
+								stackForGlobalLoop.peek(threadID).opType != EXITLOOP_OP)
+							stackForGlobalLoop.pop(threadID);
+					}
+				}
+#ifdef PERMIT
+			} else if (token.opType == PERMIT_OP) {
+#else
+			} else if (token.opType == PAUSE_OP) {
 #endif
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
 
-							// This means this is the first op in the thread
-							opdetails.taskID = taskDequeued;
+				// Obtain 2nd & 3rd argument (i.e., current task & shared variable) of pause
+				TaskIDType task;
+				string sharedVariable;
+				task = internTask(detector, token.args[1]);
+				sharedVariable = token.args[2].str();
+
+				if (detector.pauseResumeResetOps.find(opCount) == detector.pauseResumeResetOps.end()) {
+					detector.pauseResumeResetOps[opCount] = sharedVariable;
+				} else {
+					cout << "ERROR: Found duplicate entry for op " << opCount << " in pauseResumeResetOps\n";
+					cout << "Duplicate entry: " << detector.pauseResumeResetOps[opCount];
+					cout << endl;
+					return -1;
+				}
 
-							if (detector.opIDMap.find(opCount) == detector.opIDMap.end()) {
-								detector.opIDMap[opCount] = opdetails;
-							} else {
-								cout << "ERROR: Found duplicate entry for op " << opCount << " in opIDMap\n";
-								cout << "ERROR: Duplicate entry:\n";
-								detector.opIDMap[opCount].printOpDetails();
-								return -1;
-							}
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)) {
+					cout << "WARNING: No previous op found for pause " << opCount
+						 << " on stack\n";
 
-							// If there exists an entry for this tak in taskIDMap, 
-							// then we saw an enq of this task
-							if (detector.taskIDMap.find(taskDequeued) == detector.taskIDMap.end()) {
-								UAFDetector::taskDetails taskdetails;
-								taskdetails.deqOpID = opCount;
-								taskdetails.firstOpInTaskID = opCount;
-								detector.taskIDMap[taskDequeued] = taskdetails;
-							} else {
-								// We saw an enq of this task before
-								UAFDetector::taskDetails existingEntry = detector.taskIDMap[taskDequeued];
 #ifdef SANITYCHECK
-								assert(existingEntry.enqOpID != -1);
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
 #endif
-								existingEntry.deqOpID = opCount;
-								existingEntry.firstOpInTaskID = opCount;
-								detector.taskIDMap.erase(detector.taskIDMap.find(taskDequeued));
-								detector.taskIDMap[taskDequeued] = existingEntry;
-							}
 
-							// Update firstop, firstblock and exitloopblock for current thread
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+					// This means this is the first op in the thread
+					opdetails.taskID = task;
+
+					// Update firstop for current thread
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
 #ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
+						assert(existingEntry.firstOpID == -1);
+						if (existingEntry.forkOpID == -1) {
+						    cout << "ERROR: We did not see a fork op, but there already exists an entry for thread "
+							 << threadID << "\n";
+						    cout << "ERROR: Existing entry:\n";
+						    existingEntry.printThreadDetails();
+						}
 #endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
-
-							stackElement.taskID = taskDequeued;
-							stackForThreadOrder.push(stackElement);
-							stackForTaskOrder.push(stackElement);
-						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-							// deq is the beginning of a block
-							opdetails.taskID = taskDequeued;
+					if (detector.taskIDMap.find(task) == detector.taskIDMap.end()) {
+						UAFDetector::taskDetails taskdetails;
+						taskdetails.firstPauseOpID = opCount;
+						taskdetails.atomic = false;
+						taskdetails.firstOpInTaskID = opCount;
+						UAFDetector::pauseResumeResetTuple pauseResumeResetDetails;
+						pauseResumeResetDetails.pauseOp = opCount;
+						taskdetails.pauseResumeResetSequence.push_back(pauseResumeResetDetails);
+						detector.taskIDMap[task] = taskdetails;
+					} else {
+						UAFDetector::taskDetails& existingEntry = detector.taskIDMap[task];
+						existingEntry.atomic = false;
+						existingEntry.firstPauseOpID = opCount;
+						existingEntry.firstOpInTaskID = opCount;
+						UAFDetector::pauseResumeResetTuple pauseResumeResetDetails;
+						pauseResumeResetDetails.pauseOp	= opCount;
+						existingEntry.pauseResumeResetSequence.push_back(pauseResumeResetDetails);
+					}
 
-							// Set current op as next-op for stack top
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+					if (detector.nestingLoopMap.find(sharedVariable) == detector.nestingLoopMap.end()) {
+						UAFDetector::nestingLoopDetails loopdetails;
+						UAFDetector::pauseResumeResetTuple prr;
+						prr.pauseOp = opCount;
+						loopdetails.pauseResumeResetSet.push_back(prr);
+						detector.nestingLoopMap[sharedVariable] = loopdetails;
+					} else {
+#if 0
+						cout << "ERROR: Found duplicate entry for shared variable " << sharedVariable << " in nestingLoopMap\n";
+						cout << "While examining op " << opCount;
+						cout << "\nDuplicate entry:\n";
+						detector.nestingLoopMap[sharedVariable].printNestingLoopDetails();
+						cout << endl;
+						return -1;
+#endif
+						UAFDetector::nestingLoopDetails existingEntry = detector.nestingLoopMap[sharedVariable];
+						for (vector<UAFDetector::pauseResumeResetTuple>::iterator it =
+						    existingEntry.pauseResumeResetSet.begin();
+						    it != existingEntry.pauseResumeResetSet.end(); it++) {
+							if (it->pauseOp == opCount) {
+								cout << "ERROR: Found duplicate enry for pause op " << opCount
+									 << " in the set of shared variable " << sharedVariable << " in nestingLoopMap\n";
+								cout << "ERROR: While examining op " << opCount << "\n";
+								cout << "ERROR: Duplicate entry:\n";
+								detector.nestingLoopMap[sharedVariable].printNestingLoopDetails();
+								cout << "\n";
 								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
-
+							}
+						}
+						UAFDetector::pauseResumeResetTuple prr;
+						prr.pauseOp = opCount;
+						existingEntry.pauseResumeResetSet.push_back(prr);
+						detector.nestingLoopMap.erase(detector.nestingLoopMap.find(sharedVariable));
+						detector.nestingLoopMap[sharedVariable] = existingEntry;
+					}
+					stackElement.taskID = task;
+					stackForThreadOrder.push(stackElement);
+					stackForTaskOrder.push(stackElement);
+
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of pause, the previous op in thread is in the same task as pause.
+					// So no need to look separately in the task stack.
+
+					opdetails.taskID = task;
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "While examining op " << opCount;
+						cout << endl;
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-								// Sanity check: prev-op has same thread as current op in stack and opIDMap
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
-								assert(previousOpInThread.taskID.compare(taskDequeued) != 0);
-								assert(existingEntry.taskID.compare(taskDequeued) != 0);
+						// Sanity check: prev op has same threadID and taskID as current op
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
+						assert(previousOpInThread.taskID == task);
+						assert(detector.opIDMap.taskID[previousOpInThread.opID] == task);
 #endif
 
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
+						detector.opIDMap.nextOpInTask[previousOpInThread.opID] = opCount;
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
+
+					if (detector.taskIDMap.find(task) == detector.taskIDMap.end()) {
+						cout << "ERROR: Cannot find entry for task " << detector.taskNames.name(task) << " in taskIDMap\n";
+						cout << "While examining op " << opCount;
+						cout << endl;
+						return -1;
+					} else {
+						UAFDetector::taskDetails& existingEntry = detector.taskIDMap[task];
+						if (!stackForNestingOrder.isEmpty(threadID)) {
+							MultiStack::stackElementType topOfNestingStack = stackForNestingOrder.peek(threadID);
+							if (topOfNestingStack.opType == DEQ_OP) {
+								existingEntry.firstPauseOpID = opCount;
+								existingEntry.atomic = false;
 							}
+						} 
+#if 0
+						else {
+							cout << "ERROR: stackForNesting Order is empty\n";
+							cout << "Expected to find the deq/previous-resume of task " << detector.taskNames.name(task) << endl;
+							cout << "While examining pause op " << opCount << endl;
+							return -1;
+						}
+#endif
 
-							// Map deqopID, parentTask, etc of current task
-							if (detector.taskIDMap.find(taskDequeued) == detector.taskIDMap.end()) {
-								// There is no entry for this task in taskIDMap, this means we did not see an enq of this op.
-								// This happens when the enq is from a thread we ignored (or something like that!)
+						UAFDetector::pauseResumeResetTuple prr;
+						prr.pauseOp = opCount;
+						existingEntry.pauseResumeResetSequence.push_back(prr);
+					}
 
-								UAFDetector::taskDetails taskdetails;
-								taskdetails.deqOpID = opCount;
-								taskdetails.firstOpInTaskID = opCount;
+					if (detector.nestingLoopMap.find(sharedVariable) == detector.nestingLoopMap.end()) {
+						UAFDetector::nestingLoopDetails loopdetails;
+						UAFDetector::pauseResumeResetTuple prr;
+						prr.pauseOp = opCount;
+						loopdetails.pauseResumeResetSet.push_back(prr);
+						detector.nestingLoopMap[sharedVariable] = loopdetails;
+					} else {
+						UAFDetector::nestingLoopDetails existingEntry = detector.nestingLoopMap[sharedVariable];
+						for (vector<UAFDetector::pauseResumeResetTuple>::iterator it =
+						    existingEntry.pauseResumeResetSet.begin();
+						    it != existingEntry.pauseResumeResetSet.end(); it++) {
+						    if (it->pauseOp == opCount) {
+							cout << "ERROR: Found existing entry for pause op " << opCount 
+							     << " in nestingLoopMap\n";
+							return -1;
+						    }
+						}
+						UAFDetector::pauseResumeResetTuple prr;
+						prr.pauseOp = opCount;
+						existingEntry.pauseResumeResetSet.push_back(prr);
+						detector.nestingLoopMap.erase(detector.nestingLoopMap.find(sharedVariable));
+						detector.nestingLoopMap[sharedVariable] = existingEntry;
+					}
 
-								// Find if there was a pause of some task when this task is dequeued.
-								if (!stackForNestingOrder.isEmpty(threadID)) {
-									MultiStack::stackElementType topOfNestingStack = stackForNestingOrder.peek(threadID);
+					stackElement.taskID = task;
+					stackForThreadOrder.push(stackElement);
+					stackForTaskOrder.push(stackElement);
+					stackForNestingOrder.push(stackElement);
 
-#ifdef PERMIT
-									if (topOfNestingStack.opType.compare("permit") == 0) {
-#else
-									if (topOfNestingStack.opType.compare("pause") == 0) {
-#endif
-										if (detector.taskIDMap.find(topOfNestingStack.taskID) == detector.taskIDMap.end()) {
-											cout << "ERROR: Cannot find entry for task " << topOfNestingStack.taskID << " in taskIDMap\n";
-											cout << "ERROR: While examining op " << opCount << "\n";
-											return -1;
-										}
-										taskdetails.parentTask = topOfNestingStack.taskID;
-									}
-								}
+					if (!stackForGlobalLoop.isEmpty(threadID)) {
+//						while (stackForGlobalLoop.peek(threadID).opType != ENTERLOOP_OP)
+						while (stackForGlobalLoop.peek(threadID).opType != ENTERLOOP_OP &&
+								stackForGlobalLoop.peek(threadID).opType != EXITLOOP_OP)
+							stackForGlobalLoop.pop(threadID);
+					}
+				}
+			} else if (token.opType == RESET_OP) {
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
 
-								detector.taskIDMap[taskDequeued] = taskdetails;
-							} else {
-								UAFDetector::taskDetails existingEntry = detector.taskIDMap[taskDequeued];
-								existingEntry.deqOpID = opCount;
-								existingEntry.firstOpInTaskID = opCount;
+				// Obtain 2nd & 3rd argument (i.e., current task & shared variable) of reset
+				string sharedVariable;
+				sharedVariable = token.args[1].str();
+
+				if (detector.pauseResumeResetOps.find(opCount) == detector.pauseResumeResetOps.end()) {
+					detector.pauseResumeResetOps[opCount] = sharedVariable;
+				} else {
+					cout << "ERROR: Found duplicate entry for op " << opCount << " in pauseResumeResetOps\n";
+					cout << "Duplicate entry: " << detector.pauseResumeResetOps[opCount];
+					cout << endl;
+					return -1;
+				}
 
-								// Find if there was a pause of some task when this task is dequeued.
-								if (!stackForNestingOrder.isEmpty(threadID)) {
-									MultiStack::stackElementType topOfNestingStack = stackForNestingOrder.peek(threadID);
-#ifdef PERMIT
-									if (topOfNestingStack.opType.compare("permit") == 0) {
-#else
-									if (topOfNestingStack.opType.compare("pause") == 0) {
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)){
+					cout << "WARNING: No previous op found for reset " << opCount
+						 << " on stack\n";
+
+#ifdef SANITYCHECK
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
 #endif
-									    if (detector.taskIDMap.find(topOfNestingStack.taskID) == detector.taskIDMap.end()) {
-										cout << "ERROR: Cannot find entry for task " << topOfNestingStack.taskID << " in taskIDMap\n";
-										cout << "While examining op " << opCount << "\n";
-										return -1;
-									    }
-									    existingEntry.parentTask = topOfNestingStack.taskID;
-									}
-								}
 
-								detector.taskIDMap.erase(detector.taskIDMap.find(taskDequeued));
-								detector.taskIDMap[taskDequeued] = existingEntry;
-							}
+					// This means this is the first op in the thread
 
-							stackElement.taskID = taskDequeued;
-							stackForThreadOrder.push(stackElement);
-							stackForTaskOrder.push(stackElement);
-							stackForNestingOrder.push(stackElement);
+					// Update firstop, firstblock and exitloopblock for current thread
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+#ifdef SANITYCHECK
+						assert(existingEntry.firstOpID == -1);
+#endif
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-							if (!stackForGlobalLoop.isEmpty(threadID)) {
-								while (stackForGlobalLoop.peek(threadID).opType.compare("enterloop") != 0 &&
-										stackForGlobalLoop.peek(threadID).opType.compare("exitloop") != 0)
-									stackForGlobalLoop.pop(threadID);
-							}
+					if (detector.nestingLoopMap.find(sharedVariable) == detector.nestingLoopMap.end()) {
+						UAFDetector::nestingLoopDetails loopdetails;
+						UAFDetector::pauseResumeResetTuple prr;
+						prr.resetOp = opCount;
+						loopdetails.pauseResumeResetSet.push_back(prr);
+						detector.nestingLoopMap[sharedVariable] = loopdetails;
+					} else {
+						UAFDetector::nestingLoopDetails existingEntry = detector.nestingLoopMap[sharedVariable];
+						for (vector<UAFDetector::pauseResumeResetTuple>::iterator it =	
+						    existingEntry.pauseResumeResetSet.begin(); it !=
+						    existingEntry.pauseResumeResetSet.end();
+it++) {
+						    if (it->resetOp == opCount) {
+							cout << "ERROR: Found duplicate entry for reset op " << opCount
+							     << " in nestingLoopMap\n";
+							return -1;
+						    }
 						}
+						UAFDetector::pauseResumeResetTuple prr;
+						prr.resetOp = opCount;
+						existingEntry.pauseResumeResetSet.push_back(prr);
+						detector.nestingLoopMap.erase(detector.nestingLoopMap.find(sharedVariable));
+						detector.nestingLoopMap[sharedVariable] = existingEntry;
+					}
+					stackForThreadOrder.push(stackElement);
+//					stackForTaskOrder.push(stackElement);
+					stackForGlobalLoop.push(stackElement);
+
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of reset, the previous op in thread is not the previous op in the task.
+					// So, get top of task stack to obtain prev op in task.
+					MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
+					// If the previous op in task stack is the same as the previous op in thread stack, then we are not
+					// in the middle of a nesting loop.
+					bool firstOpInsideNestingLoop;
+					bool firstOpInsideGlobalLoop = false;
+					if (previousOpInThread.opID == -1) {
+						cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
+						return -1;
+					}
+					if (!stackForTaskOrder.isEmpty(threadID)) {
+						if (previousOpInTask.opID != previousOpInThread.opID)
+							firstOpInsideNestingLoop = true;
+						else {
+							// If the previous op in task is a pause, then we are in a new block
 #ifdef PERMIT
-					} else if (match.compare("permit") == 0) {
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PERMIT_OP)
 #else
-					} else if (match.compare("pause") == 0) {
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PAUSE_OP)
 #endif
-						nodeCount++;
-						opdetails.nodeID = nodeCount;
-						stackElement.nodeID = nodeCount;
-
-						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-							UAFDetector::setOfOps set;
-							set.opSet.insert(opCount);
-							detector.nodeIDMap[nodeCount] = set;
-						} else {
-							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.nodeIDMap[nodeCount].printDetails();
-							return -1;
-						}
-
-						// Obtain 2nd & 3rd argument (i.e., current task & shared variable) of pause
-						string task, sharedVariable;
-						unsigned j;
-						for (j=threadPos+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								task = m1;
-								break;
-							}
+								firstOpInsideNestingLoop = true;
+							else
+								firstOpInsideNestingLoop = false;
 						}
-						for (j=j+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								sharedVariable = m1;
-								break;
-							}
+					} else {
+						// Task order stack is empty, this means we are not inside a nesting loop
+						firstOpInsideNestingLoop = false;
+
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							// We are inside the global loop.
+							MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
+//							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP)
+							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP
+									|| topOfGlobalLoopStack.opType == EXITLOOP_OP) {
+								if (previousOpInThread.opType == EXITLOOP_OP)
+									firstOpInsideGlobalLoop = false;
+								else
+									firstOpInsideGlobalLoop = true;
+							}
+						} else if (!stackForNestingOrder.isEmpty(threadID)) {
+							cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
+							cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
+								 << "\n";
+							return -1;
 						}
+					}
 
-						if (detector.pauseResumeResetOps.find(opCount) == detector.pauseResumeResetOps.end()) {
-							detector.pauseResumeResetOps[opCount] = sharedVariable;
+					// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
 						} else {
-							cout << "ERROR: Found duplicate entry for op " << opCount << " in pauseResumeResetOps\n";
-							cout << "Duplicate entry: " << detector.pauseResumeResetOps[opCount];
-							cout << endl;
-							return -1;
+							opdetails.taskID = previousOpInThread.taskID;
 						}
+					} else {
+						// If this is the first op inside the nesting loop, then we are in a new block
+						opdetails.taskID = previousOpInTask.taskID;
+					}
 
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)) {
-							cout << "WARNING: No previous op found for pause " << opCount
-								 << " on stack\n";
-
+					// Set current op as next-op for stack top
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
+						// Sanity check: prev-op has same thread as current op in stack and opIDMap
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
 
-							// This means this is the first op in the thread
-							opdetails.taskID = task;
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
 
-							// Update firstop for current thread
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+						// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
+						if (!firstOpInsideNestingLoop) {
+							if (previousOpInThread.taskID != NOTASK)
+								detector.opIDMap.nextOpInTask[previousOpInThread.opID] = opCount;
+						}
+
+					}
+
+					if (firstOpInsideNestingLoop) {
+						if (!detector.opIDMap.exists(previousOpInTask.opID)) {
+							cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
+							return -1;
+						} else {
 #ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
-								if (existingEntry.forkOpID == -1) {
-								    cout << "ERROR: We did not see a fork op, but there already exists an entry for thread "
-									 << threadID << "\n";
-								    cout << "ERROR: Existing entry:\n";
-								    existingEntry.printThreadDetails();
-								}
+							// Sanity check: prev-op has same thread as current op in stack and opIDMap
+							assert(previousOpInTask.threadID == threadID);
+							assert(detector.opIDMap.threadID[previousOpInTask.opID] == threadID);
 #endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
+							opdetails.taskID = previousOpInTask.taskID;
+							detector.opIDMap.nextOpInTask[previousOpInTask.opID] = opCount;
+						}
+					}
 
-							if (detector.taskIDMap.find(task) == detector.taskIDMap.end()) {
-								UAFDetector::taskDetails taskdetails;
-								taskdetails.firstPauseOpID = opCount;
-								taskdetails.atomic = false;
-								taskdetails.firstOpInTaskID = opCount;
-								UAFDetector::pauseResumeResetTuple pauseResumeResetDetails;
-								pauseResumeResetDetails.pauseOp = opCount;
-								taskdetails.pauseResumeResetSequence.push_back(pauseResumeResetDetails);
-								detector.taskIDMap[task] = taskdetails;
-							} else {
-								UAFDetector::taskDetails existingEntry = detector.taskIDMap[task];
-								existingEntry.atomic = false;
-								existingEntry.firstPauseOpID = opCount;
-								existingEntry.firstOpInTaskID = opCount;
-								UAFDetector::pauseResumeResetTuple pauseResumeResetDetails;
-								pauseResumeResetDetails.pauseOp	= opCount;
-								existingEntry.pauseResumeResetSequence.push_back(pauseResumeResetDetails);
-								detector.taskIDMap.erase(detector.taskIDMap.find(task));
-								detector.taskIDMap[task] = existingEntry;
-							}
+					if (firstOpInsideNestingLoop || firstOpInsideGlobalLoop) {
 
-							if (detector.nestingLoopMap.find(sharedVariable) == detector.nestingLoopMap.end()) {
-								UAFDetector::nestingLoopDetails loopdetails;
-								UAFDetector::pauseResumeResetTuple prr;
-								prr.pauseOp = opCount;
-								loopdetails.pauseResumeResetSet.push_back(prr);
-								detector.nestingLoopMap[sharedVariable] = loopdetails;
-							} else {
-#if 0
-								cout << "ERROR: Found duplicate entry for shared variable " << sharedVariable << " in nestingLoopMap\n";
-								cout << "While examining op " << opCount;
-								cout << "\nDuplicate entry:\n";
-								detector.nestingLoopMap[sharedVariable].printNestingLoopDetails();
-								cout << endl;
-								return -1;
-#endif
-								UAFDetector::nestingLoopDetails existingEntry = detector.nestingLoopMap[sharedVariable];
-								for (vector<UAFDetector::pauseResumeResetTuple>::iterator it =
-								    existingEntry.pauseResumeResetSet.begin();
-								    it != existingEntry.pauseResumeResetSet.end(); it++) {
-									if (it->pauseOp == opCount) {
-										cout << "ERROR: Found duplicate enry for pause op " << opCount
-											 << " in the set of shared variable " << sharedVariable << " in nestingLoopMap\n";
-										cout << "ERROR: While examining op " << opCount << "\n";
-										cout << "ERROR: Duplicate entry:\n";
-										detector.nestingLoopMap[sharedVariable].printNestingLoopDetails();
-										cout << "\n";
-										return -1;
-									}
-								}
-								UAFDetector::pauseResumeResetTuple prr;
-								prr.pauseOp = opCount;
-								existingEntry.pauseResumeResetSet.push_back(prr);
-								detector.nestingLoopMap.erase(detector.nestingLoopMap.find(sharedVariable));
-								detector.nestingLoopMap[sharedVariable] = existingEntry;
-							}
-							stackElement.taskID = task;
-							stackForThreadOrder.push(stackElement);
-							stackForTaskOrder.push(stackElement);
+					}
 
-						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of pause, the previous op in thread is in the same task as pause.
-							// So no need to look separately in the task stack.
-
-							opdetails.taskID = task;
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "While examining op " << opCount;
-								cout << endl;
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+					if (firstOpInsideNestingLoop) {
 
-#ifdef SANITYCHECK
-								// Sanity check: prev op has same threadID and taskID as current op
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
-								assert(previousOpInThread.taskID.compare(task) == 0);
-								assert(existingEntry.taskID.compare(task) == 0);
-#endif
+					} else if (firstOpInsideGlobalLoop) {
 
-								existingEntry.nextOpInTask = opCount;
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+					}
 
-							if (detector.taskIDMap.find(task) == detector.taskIDMap.end()) {
-								cout << "ERROR: Cannot find entry for task " << task << " in taskIDMap\n";
-								cout << "While examining op " << opCount;
-								cout << endl;
-								return -1;
-							} else {
-								UAFDetector::taskDetails existingEntry = detector.taskIDMap[task];
-								if (!stackForNestingOrder.isEmpty(threadID)) {
-									MultiStack::stackElementType topOfNestingStack = stackForNestingOrder.peek(threadID);
-									if (topOfNestingStack.opType.compare("deq") == 0) {
-										existingEntry.firstPauseOpID = opCount;
-										existingEntry.atomic = false;
-									}
-								} 
-#if 0
-								else {
-									cout << "ERROR: stackForNesting Order is empty\n";
-									cout << "Expected to find the deq/previous-resume of task " << task << endl;
-									cout << "While examining pause op " << opCount << endl;
-									return -1;
+					if (detector.nestingLoopMap.find(sharedVariable) == detector.nestingLoopMap.end()) {
+						UAFDetector::nestingLoopDetails loopdetails;
+						UAFDetector::pauseResumeResetTuple prr;
+						prr.resetOp = opCount;
+						loopdetails.pauseResumeResetSet.push_back(prr);
+						detector.nestingLoopMap[sharedVariable] = loopdetails;
+					} else {
+						UAFDetector::nestingLoopDetails existingEntry = detector.nestingLoopMap[sharedVariable];
+						vector<UAFDetector::pauseResumeResetTuple>::reverse_iterator it;
+						for (it = existingEntry.pauseResumeResetSet.rbegin(); it !=
+						    existingEntry.pauseResumeResetSet.rend();
+it++) {
+						    if (it->resetOp == opCount) {
+							cout << "ERROR: Found duplicate entry for reset op " << opCount
+							     << " in nestingLoopMap\n";
+							return -1;
+						    }
+						    if (it->resetOp == -1 && it->pauseOp != -1 && it->resumeOp == -1)
+						    	break;
+						}
+						if (it != existingEntry.pauseResumeResetSet.rend()) {
+							it->resetOp = opCount;
+
+							// Add this reset op to taskIDMap of the appropriate task.
+							IDType pauseOp = it->pauseOp;
+							TaskIDType pauseTask = detector.opIDMap.taskID[pauseOp];
+							if (pauseTask != NOTASK) {
+								UAFDetector::taskDetails& taskExistingEntry = detector.taskIDMap[pauseTask];
+								vector<UAFDetector::pauseResumeResetTuple>::iterator it;
+								for (it = taskExistingEntry.pauseResumeResetSequence.begin();
+										it != taskExistingEntry.pauseResumeResetSequence.end();
+										it++) {
+									if (it->pauseOp == pauseOp && it->resetOp == -1)
+										break;
 								}
+								if (it != taskExistingEntry.pauseResumeResetSequence.end()) {
+									it->resetOp = opCount;
+								} else {
+									UAFDetector::pauseResumeResetTuple prr;
+									prr.resetOp = opCount;
+									existingEntry.pauseResumeResetSet.push_back(prr);
+								}
+							}
+						} else {
+							UAFDetector::pauseResumeResetTuple prr;
+							prr.resetOp = opCount;
+							existingEntry.pauseResumeResetSet.push_back(prr);
+						}
+						detector.nestingLoopMap.erase(detector.nestingLoopMap.find(sharedVariable));
+						detector.nestingLoopMap[sharedVariable] = existingEntry;
+					}
+
+					if (!firstOpInsideNestingLoop && !firstOpInsideGlobalLoop) {
+						stackElement.taskID = previousOpInThread.taskID;
+					} else if (!firstOpInsideNestingLoop && firstOpInsideGlobalLoop) {
+					} else {
+						stackElement.taskID = previousOpInTask.taskID;
+					}
+					stackForThreadOrder.push(stackElement);
+					if (!stackForTaskOrder.isEmpty(threadID))
+						stackForTaskOrder.push(stackElement);
+					else {
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							stackForGlobalLoop.push(stackElement);
+						}
+					}
+				}
+#ifdef PERMIT
+			} else if (token.opType == REVOKE_OP) {
+#else
+			} else if (token.opType == RESUME_OP) {
 #endif
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
 
-								UAFDetector::pauseResumeResetTuple prr;
-								prr.pauseOp = opCount;
-								existingEntry.pauseResumeResetSequence.push_back(prr);
+				// Obtain 2nd & 3rd argument (i.e., current task & shared variable) of resume
+				TaskIDType task;
+				string sharedVariable;
+				task = internTask(detector, token.args[1]);
+				sharedVariable = token.args[2].str();
+
+				if (detector.pauseResumeResetOps.find(opCount) == detector.pauseResumeResetOps.end()) {
+					detector.pauseResumeResetOps[opCount] = sharedVariable;
+				} else {
+					cout << "ERROR: Found duplicate entry for op " << opCount << " in pauseResumeResetOps\n";
+					cout << "Duplicate entry: " << detector.pauseResumeResetOps[opCount];
+						cout << endl;
+					return -1;
+				}
 
-								detector.taskIDMap.erase(detector.taskIDMap.find(task));
-								detector.taskIDMap[task] = existingEntry;
-							}
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)){
+					cout << "WARNING: No previous op found for resume " << opCount
+						 << " on stack\n";
 
-							if (detector.nestingLoopMap.find(sharedVariable) == detector.nestingLoopMap.end()) {
-								UAFDetector::nestingLoopDetails loopdetails;
-								UAFDetector::pauseResumeResetTuple prr;
-								prr.pauseOp = opCount;
-								loopdetails.pauseResumeResetSet.push_back(prr);
-								detector.nestingLoopMap[sharedVariable] = loopdetails;
-							} else {
-								UAFDetector::nestingLoopDetails existingEntry = detector.nestingLoopMap[sharedVariable];
-								for (vector<UAFDetector::pauseResumeResetTuple>::iterator it =
-								    existingEntry.pauseResumeResetSet.begin();
-								    it != existingEntry.pauseResumeResetSet.end(); it++) {
-								    if (it->pauseOp == opCount) {
-									cout << "ERROR: Found existing entry for pause op " << opCount 
-									     << " in nestingLoopMap\n";
-									return -1;
-								    }
-								}
-								UAFDetector::pauseResumeResetTuple prr;
-								prr.pauseOp = opCount;
-								existingEntry.pauseResumeResetSet.push_back(prr);
-								detector.nestingLoopMap.erase(detector.nestingLoopMap.find(sharedVariable));
-								detector.nestingLoopMap[sharedVariable] = existingEntry;
-							}
+#ifdef SANITYCHECK
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
+					assert(stackForNestingOrder.isEmpty(threadID));
+#endif
 
-							stackElement.taskID = task;
-							stackForThreadOrder.push(stackElement);
-							stackForTaskOrder.push(stackElement);
-							stackForNestingOrder.push(stackElement);
+					// This means this is the first op in the thread
+					opdetails.taskID = task;
 
-							if (!stackForGlobalLoop.isEmpty(threadID)) {
-//								while (stackForGlobalLoop.peek(threadID).opType.compare("enterloop") != 0)
-								while (stackForGlobalLoop.peek(threadID).opType.compare("enterloop") != 0 &&
-										stackForGlobalLoop.peek(threadID).opType.compare("exitloop") != 0)
-									stackForGlobalLoop.pop(threadID);
-							}
-						}
-					} else if (match.compare("reset") == 0) {
-						nodeCount++;
-						opdetails.nodeID = nodeCount;
-						stackElement.nodeID = nodeCount;
+					if (detector.taskIDMap.find(task) == detector.taskIDMap.end()) {
+						UAFDetector::taskDetails taskdetails;
+						taskdetails.atomic = false;
+						taskdetails.firstOpInTaskID = opCount;
 
-						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-							UAFDetector::setOfOps set;
-							set.opSet.insert(opCount);
-							detector.nodeIDMap[nodeCount] = set;
-						} else {
-							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.nodeIDMap[nodeCount].printDetails();
-							return -1;
-						}
+						UAFDetector::pauseResumeResetTuple prr;
+						prr.resumeOp = opCount;
+						taskdetails.pauseResumeResetSequence.push_back(prr);
 
-						// Obtain 2nd & 3rd argument (i.e., current task & shared variable) of reset
-						string sharedVariable;
-						unsigned j;
-						for (j=threadPos+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								sharedVariable = m1;
-								break;
-							}
-						}
+						detector.taskIDMap[task] = taskdetails;
+					} else {
+						// Resume is the first op in the thread and the task.
+						// This means the entry in taskIDMap contains only the information about the 
+						// enq op of this task
+						UAFDetector::taskDetails& existingEntry = detector.taskIDMap[task];
+						existingEntry.atomic = false;
+						existingEntry.firstOpInTaskID = opCount;
+						UAFDetector::pauseResumeResetTuple prr;
+						prr.resumeOp = opCount;
+						existingEntry.pauseResumeResetSequence.push_back(prr);
+					}
 
-						if (detector.pauseResumeResetOps.find(opCount) == detector.pauseResumeResetOps.end()) {
-							detector.pauseResumeResetOps[opCount] = sharedVariable;
-						} else {
-							cout << "ERROR: Found duplicate entry for op " << opCount << " in pauseResumeResetOps\n";
-							cout << "Duplicate entry: " << detector.pauseResumeResetOps[opCount];
-							cout << endl;
-							return -1;
+					if (detector.nestingLoopMap.find(sharedVariable) == detector.nestingLoopMap.end()) {
+						UAFDetector::nestingLoopDetails loopdetails;
+						UAFDetector::pauseResumeResetTuple prr;
+						prr.resumeOp = opCount;
+						loopdetails.pauseResumeResetSet.push_back(prr);
+						detector.nestingLoopMap[sharedVariable] = loopdetails;
+					} else {
+						UAFDetector::nestingLoopDetails existingEntry = detector.nestingLoopMap[sharedVariable];
+						for (vector<UAFDetector::pauseResumeResetTuple>::iterator it =	
+						    existingEntry.pauseResumeResetSet.begin(); it !=
+						    existingEntry.pauseResumeResetSet.end(); it++) {
+						    if (it->resumeOp == opCount) {
+						    	cout << "ERROR: Found duplicate entry for resume op " << opCount
+						    		 << " in nestingLoopMap\n";
+						    	cout << "ERROR: Duplicate entry:\n";
+						    	it->printPauseResumeResetTupleDetails();
+						    	return -1;
+						    }
 						}
+						UAFDetector::pauseResumeResetTuple prr;
+						prr.resumeOp = opCount;
+						existingEntry.pauseResumeResetSet.push_back(prr);
+						detector.nestingLoopMap.erase(detector.nestingLoopMap.find(sharedVariable));
+						detector.nestingLoopMap[sharedVariable] = existingEntry;
+					}
 
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)){
-							cout << "WARNING: No previous op found for reset " << opCount
-								 << " on stack\n";
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+#ifdef SANITYCHECK
+						assert(existingEntry.firstOpID == -1);
+#endif
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
+					stackElement.taskID = task;
+					stackForThreadOrder.push(stackElement);
+					stackForTaskOrder.push(stackElement);
+					stackForNestingOrder.push(stackElement);
+
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of resume, the previous op in thread is not the previous op in the task.
+					// So, get top of task stack to obtain prev op in task.
+					MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
+
+					// resume is the beginning of a block
+					opdetails.taskID = task;
+
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "While examining op " << opCount;
+						cout << endl;
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
+						// Sanity check: prev op has same threadID and taskID as current op
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
 
-							// This means this is the first op in the thread
+					}
 
-							// Update firstop, firstblock and exitloopblock for current thread
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+					if (!detector.opIDMap.exists(previousOpInTask.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
+						cout << "While examining op " << opCount << endl;
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
+						// Sanity check: prev op in task has same threadID and taskID as resume
+						assert(previousOpInTask.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInTask.opID] == threadID);
+						assert(previousOpInTask.taskID == task);
+						assert(detector.opIDMap.taskID[previousOpInTask.opID] == task);
 #endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
 
-							if (detector.nestingLoopMap.find(sharedVariable) == detector.nestingLoopMap.end()) {
-								UAFDetector::nestingLoopDetails loopdetails;
-								UAFDetector::pauseResumeResetTuple prr;
-								prr.resetOp = opCount;
-								loopdetails.pauseResumeResetSet.push_back(prr);
-								detector.nestingLoopMap[sharedVariable] = loopdetails;
-							} else {
-								UAFDetector::nestingLoopDetails existingEntry = detector.nestingLoopMap[sharedVariable];
-								for (vector<UAFDetector::pauseResumeResetTuple>::iterator it =	
-								    existingEntry.pauseResumeResetSet.begin(); it !=
-								    existingEntry.pauseResumeResetSet.end();
-it++) {
-								    if (it->resetOp == opCount) {
-									cout << "ERROR: Found duplicate entry for reset op " << opCount
-									     << " in nestingLoopMap\n";
-									return -1;
-								    }
+						detector.opIDMap.nextOpInTask[previousOpInTask.opID] = opCount;
+					}
+
+					if (detector.taskIDMap.find(task) == detector.taskIDMap.end()) {
+						cout << "WARNING: Cannot find entry for task " << detector.taskNames.name(task) << " in taskIDMap\n";
+						cout << "WARNING: While examining op " << opCount;
+						UAFDetector::taskDetails taskdetails;
+						taskdetails.atomic = false;
+						taskdetails.firstOpInTaskID = opCount;
+
+						// We cannot obtain parent task if resume is the first op we have seen in its own task.
+						// Also there cannot be a pause op of this task either.
+						vector<UAFDetector::pauseResumeResetTuple>::reverse_iterator it;
+						for (it = detector.nestingLoopMap[sharedVariable].pauseResumeResetSet.rbegin();
+								it != detector.nestingLoopMap[sharedVariable].pauseResumeResetSet.rend();
+								it++) {
+								if (it->resetOp != -1 && it->resumeOp == -1 && it->pauseOp == -1) {
+									DIAG(DIAG_PARSE, DIAG_DETAILS, "DEBUG: Matching reset op " << it->resetOp
+										 << " with resume op " << opCount << "\n");
+									UAFDetector::pauseResumeResetTuple prr;
+									prr.resetOp = it->resetOp;
+									prr.resumeOp = opCount;
+									taskdetails.pauseResumeResetSequence.push_back(prr);
+									break;
 								}
-								UAFDetector::pauseResumeResetTuple prr;
-								prr.resetOp = opCount;
-								existingEntry.pauseResumeResetSet.push_back(prr);
-								detector.nestingLoopMap.erase(detector.nestingLoopMap.find(sharedVariable));
-								detector.nestingLoopMap[sharedVariable] = existingEntry;
+						}
+						detector.taskIDMap[task] = taskdetails;
+					} else {
+						UAFDetector::taskDetails& existingEntry = detector.taskIDMap[task];
+						if (existingEntry.pauseResumeResetSequence.size() == 0) {
+							// There was no pause op of this task. But we must have seen an enq op.
+							for (vector<UAFDetector::pauseResumeResetTuple>::reverse_iterator it =
+									detector.nestingLoopMap[sharedVariable].pauseResumeResetSet.rbegin();
+									it != detector.nestingLoopMap[sharedVariable].pauseResumeResetSet.rend();
+									it++) {
+									if (it->resetOp != -1 && it->resumeOp == -1 && it->pauseOp == -1) {
+										DIAG(DIAG_PARSE, DIAG_DETAILS, "DEBUG: Matching reset op " << it->resetOp
+											 << " with resume op " << opCount << "\n");
+										UAFDetector::pauseResumeResetTuple prr;
+										prr.resetOp = it->resetOp;
+										prr.resumeOp = opCount;
+										existingEntry.pauseResumeResetSequence.push_back(prr);
+										break;
+									}
 							}
-							stackForThreadOrder.push(stackElement);
-//							stackForTaskOrder.push(stackElement);
-							stackForGlobalLoop.push(stackElement);
-
 						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of reset, the previous op in thread is not the previous op in the task.
-							// So, get top of task stack to obtain prev op in task.
-							MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
-							// If the previous op in task stack is the same as the previous op in thread stack, then we are not
-							// in the middle of a nesting loop.
-							bool firstOpInsideNestingLoop;
-							bool firstOpInsideGlobalLoop = false;
-							if (previousOpInThread.opID == -1) {
-								cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
-								return -1;
-							}
-							if (!stackForTaskOrder.isEmpty(threadID)) {
-								if (previousOpInTask.opID != previousOpInThread.opID)
-									firstOpInsideNestingLoop = true;
-								else {
-									// If the previous op in task is a pause, then we are in a new block
-#ifdef PERMIT
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("permit") == 0)
-#else
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("pause") == 0)
-#endif
-										firstOpInsideNestingLoop = true;
-									else
-										firstOpInsideNestingLoop = false;
-								}
-							} else {
-								// Task order stack is empty, this means we are not inside a nesting loop
-								firstOpInsideNestingLoop = false;
-
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									// We are inside the global loop.
-									MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
-//									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0)
-									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0
-											|| topOfGlobalLoopStack.opType.compare("exitloop") == 0) {
-										if (previousOpInThread.opType.compare("exitloop") == 0)
-											firstOpInsideGlobalLoop = false;
-										else
-											firstOpInsideGlobalLoop = true;
+							for (vector<UAFDetector::pauseResumeResetTuple>::reverse_iterator prIt =
+									existingEntry.pauseResumeResetSequence.rbegin();
+									prIt != existingEntry.pauseResumeResetSequence.rend(); prIt++) {
+								if (prIt->resumeOp == -1) {
+									IDType pauseOp = prIt->pauseOp;
+									if (pauseOp != -1 &&
+											detector.pauseResumeResetOps.find(pauseOp) == detector.pauseResumeResetOps.end()) {
+										cout << "ERROR: Cannot find shared variable of pause op " << pauseOp << " in pauseResumeResetOps\n";
+										cout << "While examining op " << opCount << endl;
+										return -1;
+									} else if (pauseOp != -1) {
+										std::string pauseVariable = detector.pauseResumeResetOps[pauseOp];
+										if (pauseVariable.compare(sharedVariable) == 0) {
+											prIt->resumeOp = opCount;
+											break;
+										}
 									}
-								} else if (!stackForNestingOrder.isEmpty(threadID)) {
-									cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
-									cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
-										 << "\n";
-									return -1;
 								}
 							}
+						}
+					}
 
-							// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									opdetails.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								// If this is the first op inside the nesting loop, then we are in a new block
-								opdetails.taskID = previousOpInTask.taskID;
+					if (detector.nestingLoopMap.find(sharedVariable) == detector.nestingLoopMap.end()) {
+						UAFDetector::nestingLoopDetails loopdetails;
+						UAFDetector::pauseResumeResetTuple prr;
+						prr.resumeOp = opCount;
+						loopdetails.pauseResumeResetSet.push_back(prr);
+						detector.nestingLoopMap[sharedVariable] = loopdetails;
+					} else {
+						UAFDetector::nestingLoopDetails existingEntry = detector.nestingLoopMap[sharedVariable];
+						if (existingEntry.pauseResumeResetSet.size() == 0) {
+							UAFDetector::pauseResumeResetTuple prr;
+							prr.resumeOp = opCount;
+							existingEntry.pauseResumeResetSet.push_back(prr);
+						} else {
+							vector<UAFDetector::pauseResumeResetTuple>::reverse_iterator prIt;
+							for (prIt = existingEntry.pauseResumeResetSet.rbegin();
+									prIt != existingEntry.pauseResumeResetSet.rend(); prIt++) {
+								if (prIt->resumeOp == -1 && (prIt->pauseOp != -1 || prIt->resetOp != -1))
+									break;
 							}
+							if (prIt != existingEntry.pauseResumeResetSet.rend()) {
+								prIt->resumeOp = opCount;
+							}
+						}
+						detector.nestingLoopMap.erase(detector.nestingLoopMap.find(sharedVariable));
+						detector.nestingLoopMap[sharedVariable] = existingEntry;
+					}
 
-							// Set current op as next-op for stack top
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
 
-#ifdef SANITYCHECK
-								// Sanity check: prev-op has same thread as current op in stack and opIDMap
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
-#endif
+					stackElement.taskID = task;
+					stackForThreadOrder.push(stackElement);
+					stackForTaskOrder.push(stackElement);
+					stackForNestingOrder.push(stackElement);
 
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
+					if (!stackForGlobalLoop.isEmpty(threadID)) {
+//						while (stackForGlobalLoop.peek(threadID).opType != ENTERLOOP_OP)
+						while (stackForGlobalLoop.peek(threadID).opType != ENTERLOOP_OP &&
+								stackForGlobalLoop.peek(threadID).opType != EXITLOOP_OP)
+							stackForGlobalLoop.pop(threadID);
+					}
+				}
+			} else if (token.opType == END_OP) {
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
 
-								// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
-								if (!firstOpInsideNestingLoop) {
-									if (previousOpInThread.taskID.compare("") != 0)
-										existingEntry.nextOpInTask = opCount;
-								}
+				// Obtain 2nd argument (i.e., current task) of end
+				TaskIDType task;
+				task = internTask(detector, token.args[1]);
 
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)){
+					cout << "WARNING: No previous op found for end " << opCount
+						 << " on stackForThreadOrder\n";
 
-							if (firstOpInsideNestingLoop) {
-								if (detector.opIDMap.find(previousOpInTask.opID) == detector.opIDMap.end()) {
-									cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
-									return -1;
-								} else {
-									UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInTask.opID];
 #ifdef SANITYCHECK
-									// Sanity check: prev-op has same thread as current op in stack and opIDMap
-									assert(previousOpInTask.threadID == threadID);
-									assert(existingEntry.threadID == threadID);
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
+					assert(stackForNestingOrder.isEmpty(threadID));
 #endif
-									opdetails.taskID = previousOpInTask.taskID;
-									existingEntry.nextOpInTask = opCount;
-									detector.opIDMap.erase(detector.opIDMap.find(previousOpInTask.opID));
-									detector.opIDMap[previousOpInTask.opID] = existingEntry;
-								}
-							}
 
-							if (firstOpInsideNestingLoop || firstOpInsideGlobalLoop) {
+					// This means this is the first op in the thread
+					opdetails.taskID = task;
 
-							}
+					if (detector.taskIDMap.find(task) == detector.taskIDMap.end()) {
+						UAFDetector::taskDetails taskdetails;
+						taskdetails.endOpID = opCount;
+						taskdetails.firstOpInTaskID = opCount;
+						taskdetails.lastOpInTaskID = opCount;
+						detector.taskIDMap[task] = taskdetails;
+					} else {
+						UAFDetector::taskDetails& existingEntry = detector.taskIDMap[task];
+#ifdef SANITYCHECK
+						// If there already exists an entry for this task in taskIDMap, we had seen
+						// an enq op.
+						assert(existingEntry.endOpID == -1);
+						assert(existingEntry.enqOpID != -1);
+#endif
+						existingEntry.endOpID = opCount;
+						existingEntry.firstOpInTaskID = opCount;
+						existingEntry.lastOpInTaskID = opCount;
+					}
 
-							if (firstOpInsideNestingLoop) {
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+#ifdef SANITYCHECK
+						assert(existingEntry.firstOpID == -1);
+#endif
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-							} else if (firstOpInsideGlobalLoop) {
 
-							}
+					stackElement.taskID = task;
+					stackForThreadOrder.push(stackElement);
 
-							if (detector.nestingLoopMap.find(sharedVariable) == detector.nestingLoopMap.end()) {
-								UAFDetector::nestingLoopDetails loopdetails;
-								UAFDetector::pauseResumeResetTuple prr;
-								prr.resetOp = opCount;
-								loopdetails.pauseResumeResetSet.push_back(prr);
-								detector.nestingLoopMap[sharedVariable] = loopdetails;
-							} else {
-								UAFDetector::nestingLoopDetails existingEntry = detector.nestingLoopMap[sharedVariable];
-								vector<UAFDetector::pauseResumeResetTuple>::reverse_iterator it;
-								for (it = existingEntry.pauseResumeResetSet.rbegin(); it !=
-								    existingEntry.pauseResumeResetSet.rend();
-it++) {
-								    if (it->resetOp == opCount) {
-									cout << "ERROR: Found duplicate entry for reset op " << opCount
-									     << " in nestingLoopMap\n";
-									return -1;
-								    }
-								    if (it->resetOp == -1 && it->pauseOp != -1 && it->resumeOp == -1)
-								    	break;
-								}
-								if (it != existingEntry.pauseResumeResetSet.rend()) {
-									it->resetOp = opCount;
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of end, the previous op in thread is the previous op in task.
+					// So no need to look separately in task stack.
 
-									// Add this reset op to taskIDMap of the appropriate task.
-									IDType pauseOp = it->pauseOp;
-									std::string pauseTask = detector.opIDMap[pauseOp].taskID;
-									if (pauseTask.compare("") != 0) {
-										UAFDetector::taskDetails taskExistingEntry = detector.taskIDMap[pauseTask];
-										vector<UAFDetector::pauseResumeResetTuple>::iterator it;
-										for (it = taskExistingEntry.pauseResumeResetSequence.begin();
-												it != taskExistingEntry.pauseResumeResetSequence.end();
-												it++) {
-											if (it->pauseOp == pauseOp && it->resetOp == -1)
-												break;
-										}
-										if (it != taskExistingEntry.pauseResumeResetSequence.end()) {
-											it->resetOp = opCount;
-										} else {
-											UAFDetector::pauseResumeResetTuple prr;
-											prr.resetOp = opCount;
-											existingEntry.pauseResumeResetSet.push_back(prr);
-										}
-										detector.taskIDMap.erase(detector.taskIDMap.find(pauseTask));
-										detector.taskIDMap[pauseTask] = taskExistingEntry;
-									}
-								} else {
-									UAFDetector::pauseResumeResetTuple prr;
-									prr.resetOp = opCount;
-									existingEntry.pauseResumeResetSet.push_back(prr);
-								}
-								detector.nestingLoopMap.erase(detector.nestingLoopMap.find(sharedVariable));
-								detector.nestingLoopMap[sharedVariable] = existingEntry;
-							}
+					opdetails.taskID = task;
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "While examining op " << opCount;
+						cout << endl;
+						return -1;
+					} else {
+#ifdef SANITYCHECK
+						// Sanity check: prev op has same threadID and taskID as current op
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
+						assert(previousOpInThread.taskID == task);
+						assert(detector.opIDMap.taskID[previousOpInThread.opID] == task);
+#endif
 
-							if (!firstOpInsideNestingLoop && !firstOpInsideGlobalLoop) {
-								stackElement.taskID = previousOpInThread.taskID;
-							} else if (!firstOpInsideNestingLoop && firstOpInsideGlobalLoop) {
-							} else {
-								stackElement.taskID = previousOpInTask.taskID;
-							}
-							stackForThreadOrder.push(stackElement);
-							if (!stackForTaskOrder.isEmpty(threadID))
-								stackForTaskOrder.push(stackElement);
-							else {
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									stackForGlobalLoop.push(stackElement);
-								}
-							}
-						}
+						detector.opIDMap.nextOpInTask[previousOpInThread.opID] = opCount;
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
+
+					if (detector.taskIDMap.find(task) == detector.taskIDMap.end()) {
+						cout << "ERROR: Cannot find entry for task " << detector.taskNames.name(task) << " in taskIDMap\n";
+						cout << "While examining op " << opCount << endl;
+						return -1;
+					} else {
+						UAFDetector::taskDetails& existingEntry = detector.taskIDMap[task];
+						existingEntry.endOpID = opCount;
+						existingEntry.lastOpInTaskID = opCount;
+						if (!stackForNestingOrder.isEmpty(threadID)) {
+							MultiStack::stackElementType topOfNestingStack = stackForNestingOrder.peek(threadID);
 #ifdef PERMIT
-					} else if (match.compare("revoke") == 0) {
+							if (topOfNestingStack.opType == REVOKE_OP) {
 #else
-					} else if (match.compare("resume") == 0) {
+							if (topOfNestingStack.opType == RESUME_OP) {
 #endif
-						nodeCount++;
-						opdetails.nodeID = nodeCount;
-						stackElement.nodeID = nodeCount;
-
-						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-							UAFDetector::setOfOps set;
-							set.opSet.insert(opCount);
-							detector.nodeIDMap[nodeCount] = set;
-						} else {
-							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.nodeIDMap[nodeCount].printDetails();
-							return -1;
-						}
-
-						// Obtain 2nd & 3rd argument (i.e., current task & shared variable) of resume
-						string task, sharedVariable;
-						unsigned j;
-						for (j=threadPos+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								task = m1;
-								break;
-							}
-						}
-						for (j=j+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								sharedVariable = m1;
-								break;
+#ifdef SANITYCHECK
+								assert(topOfNestingStack.taskID == task);
+								assert(topOfNestingStack.threadID == threadID);
+#endif
+								existingEntry.lastResumeOpID = topOfNestingStack.opID;
 							}
 						}
+					}
 
-						if (detector.pauseResumeResetOps.find(opCount) == detector.pauseResumeResetOps.end()) {
-							detector.pauseResumeResetOps[opCount] = sharedVariable;
-						} else {
-							cout << "ERROR: Found duplicate entry for op " << opCount << " in pauseResumeResetOps\n";
-							cout << "Duplicate entry: " << detector.pauseResumeResetOps[opCount];
-								cout << endl;
-							return -1;
-						}
 
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)){
-							cout << "WARNING: No previous op found for resume " << opCount
-								 << " on stack\n";
+					stackElement.taskID = task;
+					stackForThreadOrder.push(stackElement);
+					stackForTaskOrder.stackClear(threadID, task);
+					stackForNestingOrder.stackClear(threadID, task);
 
-#ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
-							assert(stackForNestingOrder.isEmpty(threadID));
-#endif
-
-							// This means this is the first op in the thread
-							opdetails.taskID = task;
+					if (!stackForGlobalLoop.isEmpty(threadID)) {
+//						while (stackForGlobalLoop.peek(threadID).opType != ENTERLOOP_OP)
+						while (stackForGlobalLoop.peek(threadID).opType != ENTERLOOP_OP &&
+								stackForGlobalLoop.peek(threadID).opType != EXITLOOP_OP)
+							stackForGlobalLoop.pop(threadID);
+					}
+				}
+			} else if (token.opType == FORK_OP) {
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
 
-							if (detector.taskIDMap.find(task) == detector.taskIDMap.end()) {
-								UAFDetector::taskDetails taskdetails;
-								taskdetails.atomic = false;
-								taskdetails.firstOpInTaskID = opCount;
+				// Obtain 2nd argument (i.e., target thread) of fork
+				IDType targetThread;
+				targetThread = token.args[1].toInt();
 
-								UAFDetector::pauseResumeResetTuple prr;
-								prr.resumeOp = opCount;
-								taskdetails.pauseResumeResetSequence.push_back(prr);
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)){
+					cout << "WARNING: No previous op found for fork " << opCount
+						 << " on stackForThreadOrder\n";
 
-								detector.taskIDMap[task] = taskdetails;
-							} else {
-								// Resume is the first op in the thread and the task.
-								// This means the entry in taskIDMap contains only the information about the 
-								// enq op of this task
-								UAFDetector::taskDetails existingEntry = detector.taskIDMap[task];
-								existingEntry.atomic = false;
-								existingEntry.firstOpInTaskID = opCount;
-								UAFDetector::pauseResumeResetTuple prr;
-								prr.resumeOp = opCount;
-								existingEntry.pauseResumeResetSequence.push_back(prr);
-								detector.taskIDMap.erase(detector.taskIDMap.find(task));
-								detector.taskIDMap[task] = existingEntry;
-							}
+#ifdef SANITYCHECK
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
+					assert(stackForNestingOrder.isEmpty(threadID));
+#endif
 
-							if (detector.nestingLoopMap.find(sharedVariable) == detector.nestingLoopMap.end()) {
-								UAFDetector::nestingLoopDetails loopdetails;
-								UAFDetector::pauseResumeResetTuple prr;
-								prr.resumeOp = opCount;
-								loopdetails.pauseResumeResetSet.push_back(prr);
-								detector.nestingLoopMap[sharedVariable] = loopdetails;
-							} else {
-								UAFDetector::nestingLoopDetails existingEntry = detector.nestingLoopMap[sharedVariable];
-								for (vector<UAFDetector::pauseResumeResetTuple>::iterator it =	
-								    existingEntry.pauseResumeResetSet.begin(); it !=
-								    existingEntry.pauseResumeResetSet.end(); it++) {
-								    if (it->resumeOp == opCount) {
-								    	cout << "ERROR: Found duplicate entry for resume op " << opCount
-								    		 << " in nestingLoopMap\n";
-								    	cout << "ERROR: Duplicate entry:\n";
-								    	it->printPauseResumeResetTupleDetails();
-								    	return -1;
-								    }
-								}
-								UAFDetector::pauseResumeResetTuple prr;
-								prr.resumeOp = opCount;
-								existingEntry.pauseResumeResetSet.push_back(prr);
-								detector.nestingLoopMap.erase(detector.nestingLoopMap.find(sharedVariable));
-								detector.nestingLoopMap[sharedVariable] = existingEntry;
-							}
+					// This means this is the first op in the thread
 
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
 #ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
+						assert(existingEntry.firstOpID == -1);
 #endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-							stackElement.taskID = task;
-							stackForThreadOrder.push(stackElement);
-							stackForTaskOrder.push(stackElement);
-							stackForNestingOrder.push(stackElement);
+					if (detector.threadIDMap.find(targetThread) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.forkOpID = opCount;
+						detector.threadIDMap[targetThread] = threaddetails;
+					} else {
+						cout << "ERROR: Found duplicate entry for thread " << targetThread << " in threadIDMap\n";
+						cout << "While examining op " << opCount << endl;
+						cout << "Duplicate entry:\n";
+						detector.threadIDMap[targetThread].printThreadDetails();
+						cout << endl;
+						return -1;
+					}
 
-						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of resume, the previous op in thread is not the previous op in the task.
-							// So, get top of task stack to obtain prev op in task.
-							MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
-
-							// resume is the beginning of a block
-							opdetails.taskID = task;
-
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "While examining op " << opCount;
-								cout << endl;
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
 
-#ifdef SANITYCHECK
-								// Sanity check: prev op has same threadID and taskID as current op
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
+					stackForThreadOrder.push(stackElement);
+					stackForTaskOrder.push(stackElement);
+					stackForGlobalLoop.push(stackElement);
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of fork, the previous op in thread is not necessarily the previous op in task.
+					MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
+
+					// If the previous op in task stack is the same as the previous op in thread stack, then we are not
+					// in the middle of a nesting loop.
+					bool firstOpInsideNestingLoop;
+					bool firstOpInsideGlobalLoop = false;
+					if (previousOpInThread.opID == -1) {
+						cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
+						return -1;
+					}
+					if (!stackForTaskOrder.isEmpty(threadID)) {
+						if (previousOpInTask.opID != previousOpInThread.opID)
+							firstOpInsideNestingLoop = true;
+						else {
+							// If the previous op in task is a pause, then we are in a new block
+#ifdef PERMIT
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PERMIT_OP)
+#else
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PAUSE_OP)
 #endif
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-
-							}
+								firstOpInsideNestingLoop = true;
+							else
+								firstOpInsideNestingLoop = false;
+						}
+					} else {
+						// Task order stack is empty, this means we are not inside a nesting loop
+						firstOpInsideNestingLoop = false;
+
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							// We are inside the global loop.
+							MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
+//							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP)
+							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP
+									|| topOfGlobalLoopStack.opType == EXITLOOP_OP) {
+								if (previousOpInThread.opType == EXITLOOP_OP)
+									firstOpInsideGlobalLoop = false;
+								else
+									firstOpInsideGlobalLoop = true;
+							}
+						} else if (!stackForNestingOrder.isEmpty(threadID)) {
+							cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
+							cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
+								 << "\n";
+							return -1;
+						}
+					}
 
-							if (detector.opIDMap.find(previousOpInTask.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
-								cout << "While examining op " << opCount << endl;
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInTask.opID];
+					// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
+						} else {
+							opdetails.taskID = previousOpInThread.taskID;
+						}
+					} else {
+						// If this is the first op inside the nesting loop, then we are in a new block
+						opdetails.taskID = previousOpInTask.taskID;
+					}
 
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "While examining op " << opCount;
+						cout << endl;
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-								// Sanity check: prev op in task has same threadID and taskID as resume
-								assert(previousOpInTask.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
-								assert(previousOpInTask.taskID.compare(task) == 0);
-								assert(existingEntry.taskID.compare(task) == 0);
+						// Sanity check: prev op has same threadID and taskID as current op
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
 
-								existingEntry.nextOpInTask = opCount;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInTask.opID));
-								detector.opIDMap[previousOpInTask.opID] = existingEntry;
-							}
-
-							if (detector.taskIDMap.find(task) == detector.taskIDMap.end()) {
-								cout << "WARNING: Cannot find entry for task " << task << " in taskIDMap\n";
-								cout << "WARNING: While examining op " << opCount;
-								UAFDetector::taskDetails taskdetails;
-								taskdetails.atomic = false;
-								taskdetails.firstOpInTaskID = opCount;
-
-								// We cannot obtain parent task if resume is the first op we have seen in its own task.
-								// Also there cannot be a pause op of this task either.
-								vector<UAFDetector::pauseResumeResetTuple>::reverse_iterator it;
-								for (it = detector.nestingLoopMap[sharedVariable].pauseResumeResetSet.rbegin();
-										it != detector.nestingLoopMap[sharedVariable].pauseResumeResetSet.rend();
-										it++) {
-										if (it->resetOp != -1 && it->resumeOp == -1 && it->pauseOp == -1) {
-											cout << "DEBUG: Matching reset op " << it->resetOp << " with resume op "
-												 << opCount << "\n";
-											UAFDetector::pauseResumeResetTuple prr;
-											prr.resetOp = it->resetOp;
-											prr.resumeOp = opCount;
-											taskdetails.pauseResumeResetSequence.push_back(prr);
-											break;
-										}
-								}
-								detector.taskIDMap[task] = taskdetails;
-							} else {
-								UAFDetector::taskDetails existingEntry = detector.taskIDMap[task];
-								if (existingEntry.pauseResumeResetSequence.size() == 0) {
-									// There was no pause op of this task. But we must have seen an enq op.
-									for (vector<UAFDetector::pauseResumeResetTuple>::reverse_iterator it =
-											detector.nestingLoopMap[sharedVariable].pauseResumeResetSet.rbegin();
-											it != detector.nestingLoopMap[sharedVariable].pauseResumeResetSet.rend();
-											it++) {
-											if (it->resetOp != -1 && it->resumeOp == -1 && it->pauseOp == -1) {
-												cout << "DEBUG: Matching reset op " << it->resetOp << " with resume op "
-													 << opCount << "\n";
-												UAFDetector::pauseResumeResetTuple prr;
-												prr.resetOp = it->resetOp;
-												prr.resumeOp = opCount;
-												existingEntry.pauseResumeResetSequence.push_back(prr);
-												break;
-											}
-									}
-								} else {
-									for (vector<UAFDetector::pauseResumeResetTuple>::reverse_iterator prIt =
-											existingEntry.pauseResumeResetSequence.rbegin();
-											prIt != existingEntry.pauseResumeResetSequence.rend(); prIt++) {
-										if (prIt->resumeOp == -1) {
-											IDType pauseOp = prIt->pauseOp;
-											if (pauseOp != -1 &&
-													detector.pauseResumeResetOps.find(pauseOp) == detector.pauseResumeResetOps.end()) {
-												cout << "ERROR: Cannot find shared variable of pause op " << pauseOp << " in pauseResumeResetOps\n";
-												cout << "While examining op " << opCount << endl;
-												return -1;
-											} else if (pauseOp != -1) {
-												std::string pauseVariable = detector.pauseResumeResetOps[pauseOp];
-												if (pauseVariable.compare(sharedVariable) == 0) {
-													prIt->resumeOp = opCount;
-													break;
-												}
-											}
-										}
-									}
-								}
+						if (!firstOpInsideNestingLoop) {
+							if (previousOpInThread.taskID != NOTASK)
+								detector.opIDMap.nextOpInTask[previousOpInThread.opID] = opCount;
+						}
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
 
-								detector.taskIDMap.erase(detector.taskIDMap.find(task));
-								detector.taskIDMap[task] = existingEntry;
-							}
+					if (firstOpInsideNestingLoop) {
+						if (!detector.opIDMap.exists(previousOpInTask.opID)) {
+							cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
+							cout << "ERROR: While examining op " << opCount << "\n";
+							return -1;
+						} else {
+#ifdef SANITYCHECK
+							// Sanity check: prev-op has same thread as current op in stack and opIDMap
+							assert(previousOpInTask.threadID == threadID);
+							assert(detector.opIDMap.threadID[previousOpInTask.opID] == threadID);
+#endif
+							opdetails.taskID = previousOpInTask.taskID;
+							detector.opIDMap.nextOpInTask[previousOpInTask.opID] = opCount;
+						}
 
-							if (detector.nestingLoopMap.find(sharedVariable) == detector.nestingLoopMap.end()) {
-								UAFDetector::nestingLoopDetails loopdetails;
-								UAFDetector::pauseResumeResetTuple prr;
-								prr.resumeOp = opCount;
-								loopdetails.pauseResumeResetSet.push_back(prr);
-								detector.nestingLoopMap[sharedVariable] = loopdetails;
-							} else {
-								UAFDetector::nestingLoopDetails existingEntry = detector.nestingLoopMap[sharedVariable];
-								if (existingEntry.pauseResumeResetSet.size() == 0) {
-									UAFDetector::pauseResumeResetTuple prr;
-									prr.resumeOp = opCount;
-									existingEntry.pauseResumeResetSet.push_back(prr);
-								} else {
-									vector<UAFDetector::pauseResumeResetTuple>::reverse_iterator prIt;
-									for (prIt = existingEntry.pauseResumeResetSet.rbegin();
-											prIt != existingEntry.pauseResumeResetSet.rend(); prIt++) {
-										if (prIt->resumeOp == -1 && (prIt->pauseOp != -1 || prIt->resetOp != -1))
-											break;
-									}
-									if (prIt != existingEntry.pauseResumeResetSet.rend()) {
-										prIt->resumeOp = opCount;
-									}
-								}
-								detector.nestingLoopMap.erase(detector.nestingLoopMap.find(sharedVariable));
-								detector.nestingLoopMap[sharedVariable] = existingEntry;
-							}
 
+					}
 
-							stackElement.taskID = task;
-							stackForThreadOrder.push(stackElement);
-							stackForTaskOrder.push(stackElement);
-							stackForNestingOrder.push(stackElement);
 
-							if (!stackForGlobalLoop.isEmpty(threadID)) {
-//								while (stackForGlobalLoop.peek(threadID).opType.compare("enterloop") != 0)
-								while (stackForGlobalLoop.peek(threadID).opType.compare("enterloop") != 0 &&
-										stackForGlobalLoop.peek(threadID).opType.compare("exitloop") != 0)
-									stackForGlobalLoop.pop(threadID);
-							}
-						}
-					} else if (match.compare("end") == 0) {
-						nodeCount++;
-						opdetails.nodeID = nodeCount;
-						stackElement.nodeID = nodeCount;
+					if (detector.threadIDMap.find(targetThread) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.forkOpID = opCount;
+						detector.threadIDMap[targetThread] = threaddetails;
+					} else {
+						cout << "ERROR: Found duplicate entry for thread " << targetThread << " in threadIDMap\n";
+						cout << "While examining op " << opCount << endl;
+						cout << "Duplicate entry:\n";
+						detector.threadIDMap[targetThread].printThreadDetails();
+						cout << endl;
+						return -1;
+					}
 
-						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-							UAFDetector::setOfOps set;
-							set.opSet.insert(opCount);
-							detector.nodeIDMap[nodeCount] = set;
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
 						} else {
-							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.nodeIDMap[nodeCount].printDetails();
-							return -1;
+							stackElement.taskID = previousOpInThread.taskID;
 						}
-
-						// Obtain 2nd argument (i.e., current task) of end
-						string task;
-						for (unsigned j=threadPos+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								task = m1;
-								break;
-							}
+					} else {
+						stackElement.taskID = previousOpInTask.taskID;
+					}
+					stackForThreadOrder.push(stackElement);
+					if (!stackForTaskOrder.isEmpty(threadID))
+						stackForTaskOrder.push(stackElement);
+					else {
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							stackForGlobalLoop.push(stackElement);
 						}
+					}
+				}
+			} else if (token.opType == JOIN_OP) {
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
 
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)){
-							cout << "WARNING: No previous op found for end " << opCount
-								 << " on stackForThreadOrder\n";
+				// Obtain 2nd argument (i.e., target thread) of join
+				IDType targetThread;
+				targetThread = token.args[1].toInt();
+
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)){
+					cout << "WARNING: No previous op found for join " << opCount
+						 << " on stackForThreadOrder\n";
 
 #ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
-							assert(stackForNestingOrder.isEmpty(threadID));
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
+					assert(stackForNestingOrder.isEmpty(threadID));
 #endif
 
-							// This means this is the first op in the thread
-							opdetails.taskID = task;
+					// This means this is the first op in the thread
 
-							if (detector.taskIDMap.find(task) == detector.taskIDMap.end()) {
-								UAFDetector::taskDetails taskdetails;
-								taskdetails.endOpID = opCount;
-								taskdetails.firstOpInTaskID = opCount;
-								taskdetails.lastOpInTaskID = opCount;
-								detector.taskIDMap[task] = taskdetails;
-							} else {
-								UAFDetector::taskDetails existingEntry = detector.taskIDMap[task];
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
 #ifdef SANITYCHECK
-								// If there already exists an entry for this task in taskIDMap, we had seen
-								// an enq op.
-								assert(existingEntry.endOpID == -1);
-								assert(existingEntry.enqOpID != -1);
+						assert(existingEntry.firstOpID == -1);
 #endif
-								existingEntry.endOpID = opCount;
-								existingEntry.firstOpInTaskID = opCount;
-								existingEntry.lastOpInTaskID = opCount;
-								detector.taskIDMap.erase(detector.taskIDMap.find(task));
-								detector.taskIDMap[task] = existingEntry;
-							}
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+					if (detector.threadIDMap.find(targetThread) == detector.threadIDMap.end()) {
+						cout << "ERROR: Cannot find entry for thread " << targetThread << " in threadIDMap\n";
+						cout << "While examining op " << opCount << endl;
+						return -1;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[targetThread];
 #ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
+						// Sanity check: the join op id should not be set till now
+						assert(existingEntry.joinOpID == -1);
 #endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
-
+						existingEntry.joinOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(targetThread));
+						detector.threadIDMap[targetThread] = existingEntry;
+					}
 
-							stackElement.taskID = task;
-							stackForThreadOrder.push(stackElement);
+					stackForThreadOrder.push(stackElement);
+					stackForTaskOrder.push(stackElement);
+					stackForGlobalLoop.push(stackElement);
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of join, the previous op in thread is not necessarily the previous op in task.
+					MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
+
+					// If the previous op in task stack is the same as the previous op in thread stack, then we are not
+					// in the middle of a nesting loop.
+					bool firstOpInsideNestingLoop;
+					bool firstOpInsideGlobalLoop = false;
+					if (previousOpInThread.opID == -1) {
+						cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
+						return -1;
+					}
+					if (!stackForTaskOrder.isEmpty(threadID)) {
+						if (previousOpInTask.opID != previousOpInThread.opID)
+							firstOpInsideNestingLoop = true;
+						else {
+							// If the previous op in task is a pause, then we are in a new block
+#ifdef PERMIT
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PERMIT_OP)
+#else
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PAUSE_OP)
+#endif
+								firstOpInsideNestingLoop = true;
+							else
+								firstOpInsideNestingLoop = false;
+						}
+					} else {
+						// Task order stack is empty, this means we are not inside a nesting loop
+						firstOpInsideNestingLoop = false;
+
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							// We are inside the global loop.
+							MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
+//							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP)
+							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP
+									|| topOfGlobalLoopStack.opType == EXITLOOP_OP) {
+								if (previousOpInThread.opType == EXITLOOP_OP)
+									firstOpInsideGlobalLoop = false;
+								else
+									firstOpInsideGlobalLoop = true;
+							}
+						} else if (!stackForNestingOrder.isEmpty(threadID)) {
+							cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
+							cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
+								 << "\n";
+							return -1;
+						}
+					}
 
+					// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
 						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of end, the previous op in thread is the previous op in task.
-							// So no need to look separately in task stack.
-
-							opdetails.taskID = task;
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "While examining op " << opCount;
-								cout << endl;
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+							opdetails.taskID = previousOpInThread.taskID;
+						}
+					} else {
+						// If this is the first op inside the nesting loop, then we are in a new block
+						opdetails.taskID = previousOpInTask.taskID;
+					}
 
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "While examining op " << opCount;
+						cout << endl;
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-								// Sanity check: prev op has same threadID and taskID as current op
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
-								assert(previousOpInThread.taskID.compare(task) == 0);
-								assert(existingEntry.taskID.compare(task) == 0);
+						// Sanity check: prev op has same threadID and taskID as current op
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
 
-								existingEntry.nextOpInTask = opCount;
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+						if (!firstOpInsideNestingLoop) {
+							if (previousOpInThread.taskID != NOTASK)
+								detector.opIDMap.nextOpInTask[previousOpInThread.opID] = opCount;
+						}
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
 
-							if (detector.taskIDMap.find(task) == detector.taskIDMap.end()) {
-								cout << "ERROR: Cannot find entry for task " << task << " in taskIDMap\n";
-								cout << "While examining op " << opCount << endl;
-								return -1;
-							} else {
-								UAFDetector::taskDetails existingEntry = detector.taskIDMap[task];
-								existingEntry.endOpID = opCount;
-								existingEntry.lastOpInTaskID = opCount;
-								if (!stackForNestingOrder.isEmpty(threadID)) {
-									MultiStack::stackElementType topOfNestingStack = stackForNestingOrder.peek(threadID);
-#ifdef PERMIT
-									if (topOfNestingStack.opType.compare("revoke") == 0) {
-#else
-									if (topOfNestingStack.opType.compare("resume") == 0) {
-#endif
+					if (firstOpInsideNestingLoop) {
+						if (!detector.opIDMap.exists(previousOpInTask.opID)) {
+							cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
+							cout << "ERROR: While examining op " << opCount << "\n";
+							return -1;
+						} else {
 #ifdef SANITYCHECK
-										assert(topOfNestingStack.taskID.compare(task) == 0);
-										assert(topOfNestingStack.threadID == threadID);
+							// Sanity check: prev-op has same thread as current op in stack and opIDMap
+							assert(previousOpInTask.threadID == threadID);
+							assert(detector.opIDMap.threadID[previousOpInTask.opID] == threadID);
 #endif
-										existingEntry.lastResumeOpID = topOfNestingStack.opID;
-									}
-								}
-								detector.taskIDMap.erase(detector.taskIDMap.find(task));
-								detector.taskIDMap[task] = existingEntry;
-							}
-
-
-							stackElement.taskID = task;
-							stackForThreadOrder.push(stackElement);
-							stackForTaskOrder.stackClear(threadID, task);
-							stackForNestingOrder.stackClear(threadID, task);
-
-							if (!stackForGlobalLoop.isEmpty(threadID)) {
-//								while (stackForGlobalLoop.peek(threadID).opType.compare("enterloop") != 0)
-								while (stackForGlobalLoop.peek(threadID).opType.compare("enterloop") != 0 &&
-										stackForGlobalLoop.peek(threadID).opType.compare("exitloop") != 0)
-									stackForGlobalLoop.pop(threadID);
-							}
+							opdetails.taskID = previousOpInTask.taskID;
+							detector.opIDMap.nextOpInTask[previousOpInTask.opID] = opCount;
 						}
-					} else if (match.compare("fork") == 0) {
-						nodeCount++;
-						opdetails.nodeID = nodeCount;
-						stackElement.nodeID = nodeCount;
+					}
 
-						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-							UAFDetector::setOfOps set;
-							set.opSet.insert(opCount);
-							detector.nodeIDMap[nodeCount] = set;
+					if (detector.threadIDMap.find(targetThread) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.joinOpID = opCount;
+						detector.threadIDMap[targetThread] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[targetThread];
+#ifdef SANITYCHECK
+						// Sanity check: the join op id should not be set till now
+						assert(existingEntry.joinOpID == -1);
+#endif
+						existingEntry.joinOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(targetThread));
+						detector.threadIDMap[targetThread] = existingEntry;
+					}
+
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
 						} else {
-							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.nodeIDMap[nodeCount].printDetails();
-							return -1;
+							stackElement.taskID = previousOpInThread.taskID;
 						}
-
-						// Obtain 2nd argument (i.e., target thread) of fork
-						IDType targetThread;
-						for (unsigned j=threadPos+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								targetThread = atoi(m1.c_str());
-								break;
-							}
+					} else {
+						stackElement.taskID = previousOpInTask.taskID;
+					}
+					stackForThreadOrder.push(stackElement);
+					if (!stackForTaskOrder.isEmpty(threadID))
+						stackForTaskOrder.push(stackElement);
+					else {
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							stackForGlobalLoop.push(stackElement);
 						}
+					}
+				}
+			} else if (token.opType == ALLOC_OP) {
+				// Obtain 2nd & 3rd argument (i.e., starting address & num of bytes) of alloc
+				AddressType baseAddress;
+				IDType size;
+				baseAddress = token.args[1].value;
+				size = token.args[2].toInt();
+
+				UAFDetector::memoryOpDetails memdetails;
+				memdetails.startingAddress = baseAddress;
+				memdetails.range = size;
+				if (detector.allocSet.find(opCount) == detector.allocSet.end()) {
+					detector.allocSet[opCount] = memdetails;
+					addressIndex.addAlloc(opCount, baseAddress, size);
+				} else {
+					cout << "ERROR: Found duplicate entry for op " << opCount << " in opIDMap\n";
+						cout << endl;
+					return -1;
+				}
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)){
+					nodeCount++;
+					opdetails.nodeID = nodeCount;
+					stackElement.nodeID = nodeCount;
+
+					if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+						UAFDetector::setOfOps set;
+						set.opSet.insert(opCount);
+						detector.nodeIDMap[nodeCount] = set;
+					} else {
+						cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+						cout << "ERROR: Existing entry:\n";
+						detector.nodeIDMap[nodeCount].printDetails();
+						return -1;
+					}
 
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)){
-							cout << "WARNING: No previous op found for fork " << opCount
-								 << " on stackForThreadOrder\n";
+					cout << "WARNING: No previous op found for alloc " << opCount
+						 << " on stackForThreadOrder\n";
 
 #ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
-							assert(stackForNestingOrder.isEmpty(threadID));
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
+					assert(stackForNestingOrder.isEmpty(threadID));
 #endif
 
-							// This means this is the first op in the thread
+					// This means this is the first op in the thread
 
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
 #ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
+						assert(existingEntry.firstOpID == -1);
 #endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
-
-							if (detector.threadIDMap.find(targetThread) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.forkOpID = opCount;
-								detector.threadIDMap[targetThread] = threaddetails;
-							} else {
-								cout << "ERROR: Found duplicate entry for thread " << targetThread << " in threadIDMap\n";
-								cout << "While examining op " << opCount << endl;
-								cout << "Duplicate entry:\n";
-								detector.threadIDMap[targetThread].printThreadDetails();
-								cout << endl;
-								return -1;
-							}
-
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-							stackForThreadOrder.push(stackElement);
-							stackForTaskOrder.push(stackElement);
-							stackForGlobalLoop.push(stackElement);
-						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of fork, the previous op in thread is not necessarily the previous op in task.
-							MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
-
-							// If the previous op in task stack is the same as the previous op in thread stack, then we are not
-							// in the middle of a nesting loop.
-							bool firstOpInsideNestingLoop;
-							bool firstOpInsideGlobalLoop = false;
-							if (previousOpInThread.opID == -1) {
-								cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
-								return -1;
-							}
-							if (!stackForTaskOrder.isEmpty(threadID)) {
-								if (previousOpInTask.opID != previousOpInThread.opID)
-									firstOpInsideNestingLoop = true;
-								else {
-									// If the previous op in task is a pause, then we are in a new block
+					stackForThreadOrder.push(stackElement);
+					stackForTaskOrder.push(stackElement);
+					stackForGlobalLoop.push(stackElement);
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of alloc, the previous op in thread is not necessarily the previous op in task.
+					MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
+
+					// If the previous op in task stack is the same as the previous op in thread stack, then we are not
+					// in the middle of a nesting loop.
+					bool firstOpInsideNestingLoop;
+					bool firstOpInsideGlobalLoop = false;
+					if (previousOpInThread.opID == -1) {
+						cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
+						return -1;
+					}
+					if (!stackForTaskOrder.isEmpty(threadID)) {
+						if (previousOpInTask.opID != previousOpInThread.opID)
+							firstOpInsideNestingLoop = true;
+						else {
+							// If the previous op in task is a pause, then we are in a new block
 #ifdef PERMIT
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("permit") == 0)
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PERMIT_OP)
 #else
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("pause") == 0)
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PAUSE_OP)
 #endif
-										firstOpInsideNestingLoop = true;
-									else
-										firstOpInsideNestingLoop = false;
-								}
-							} else {
-								// Task order stack is empty, this means we are not inside a nesting loop
+								firstOpInsideNestingLoop = true;
+							else
 								firstOpInsideNestingLoop = false;
+						}
+					} else {
+						// Task order stack is empty, this means we are not inside a nesting loop
+						firstOpInsideNestingLoop = false;
+
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							// We are inside the global loop.
+							MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
+//							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP)
+							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP
+									|| topOfGlobalLoopStack.opType == EXITLOOP_OP) {
+								if (previousOpInThread.opType == EXITLOOP_OP)
+									firstOpInsideGlobalLoop = false;
+								else
+									firstOpInsideGlobalLoop = true;
+							}
+						} else if (!stackForNestingOrder.isEmpty(threadID)) {
+							cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
+							cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
+								 << "\n";
+							return -1;
+						}
+					}
 
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									// We are inside the global loop.
-									MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
-//									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0)
-									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0
-											|| topOfGlobalLoopStack.opType.compare("exitloop") == 0) {
-										if (previousOpInThread.opType.compare("exitloop") == 0)
-											firstOpInsideGlobalLoop = false;
-										else
-											firstOpInsideGlobalLoop = true;
-									}
-								} else if (!stackForNestingOrder.isEmpty(threadID)) {
-									cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
-									cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
-										 << "\n";
-									return -1;
-								}
-							}
+					// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
 
-							// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									opdetails.taskID = previousOpInThread.taskID;
-								}
+							nodeCount++;
+							opdetails.nodeID = nodeCount;
+							stackElement.nodeID = nodeCount;
+
+							if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+								UAFDetector::setOfOps set;
+								set.opSet.insert(opCount);
+								detector.nodeIDMap[nodeCount] = set;
 							} else {
-								// If this is the first op inside the nesting loop, then we are in a new block
-								opdetails.taskID = previousOpInTask.taskID;
+								cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+								cout << "ERROR: Existing entry:\n";
+								detector.nodeIDMap[nodeCount].printDetails();
+								return -1;
 							}
 
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "While examining op " << opCount;
-								cout << endl;
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+						} else {
+							opdetails.taskID = previousOpInThread.taskID;
 
-#ifdef SANITYCHECK
-								// Sanity check: prev op has same threadID and taskID as current op
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
-#endif
+							if (previousOpInThread.opType == ALLOC_OP ||
+									previousOpInThread.opType == FREE_OP ||
+									previousOpInThread.opType == READ_OP ||
+									previousOpInThread.opType == WRITE_OP) {
+								opdetails.nodeID = previousOpInThread.nodeID;
 
-								if (!firstOpInsideNestingLoop) {
-									if (previousOpInThread.taskID.compare("") != 0)
-										existingEntry.nextOpInTask = opCount;
-								}
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+								stackElement.nodeID = previousOpInThread.nodeID;
 
-							if (firstOpInsideNestingLoop) {
-								if (detector.opIDMap.find(previousOpInTask.opID) == detector.opIDMap.end()) {
-									cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
-									cout << "ERROR: While examining op " << opCount << "\n";
+								if (detector.nodeIDMap.find(previousOpInThread.nodeID) == detector.nodeIDMap.end()) {
+									cout << "ERROR: Cannot find entry for node " << previousOpInThread.nodeID << " in nodeIDMap\n";
 									return -1;
 								} else {
-									UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInTask.opID];
-#ifdef SANITYCHECK
-									// Sanity check: prev-op has same thread as current op in stack and opIDMap
-									assert(previousOpInTask.threadID == threadID);
-									assert(existingEntry.threadID == threadID);
-#endif
-									opdetails.taskID = previousOpInTask.taskID;
-									existingEntry.nextOpInTask = opCount;
-									detector.opIDMap.erase(detector.opIDMap.find(previousOpInTask.opID));
-									detector.opIDMap[previousOpInTask.opID] = existingEntry;
+									detector.nodeIDMap[previousOpInThread.nodeID].opSet.insert(opCount);
 								}
-
-
-							}
-
-
-							if (detector.threadIDMap.find(targetThread) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.forkOpID = opCount;
-								detector.threadIDMap[targetThread] = threaddetails;
 							} else {
-								cout << "ERROR: Found duplicate entry for thread " << targetThread << " in threadIDMap\n";
-								cout << "While examining op " << opCount << endl;
-								cout << "Duplicate entry:\n";
-								detector.threadIDMap[targetThread].printThreadDetails();
-								cout << endl;
-								return -1;
-							}
+								nodeCount++;
+								opdetails.nodeID = nodeCount;
+								stackElement.nodeID = nodeCount;
 
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
+								if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+									UAFDetector::setOfOps set;
+									set.opSet.insert(opCount);
+									detector.nodeIDMap[nodeCount] = set;
 								} else {
-									stackElement.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								stackElement.taskID = previousOpInTask.taskID;
-							}
-							stackForThreadOrder.push(stackElement);
-							if (!stackForTaskOrder.isEmpty(threadID))
-								stackForTaskOrder.push(stackElement);
-							else {
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									stackForGlobalLoop.push(stackElement);
+									cout << "ERROR: Found duplicate entry for node " << nodeCount << " in nodeIDMap\n";
+									return -1;
 								}
 							}
 						}
-					} else if (match.compare("join") == 0) {
+					} else {
+						// If this is the first op inside the nesting loop, then we are in a new block
+						opdetails.taskID = previousOpInTask.taskID;
+
 						nodeCount++;
 						opdetails.nodeID = nodeCount;
 						stackElement.nodeID = nodeCount;
@@ -2091,232 +2550,207 @@ it++) {
 							return -1;
 						}
 
-						// Obtain 2nd argument (i.e., target thread) of join
-						IDType targetThread;
-						for (unsigned j=threadPos+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								targetThread = atoi(m1.c_str());
-								break;
-							}
-						}
-
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)){
-							cout << "WARNING: No previous op found for join " << opCount
-								 << " on stackForThreadOrder\n";
+					}
 
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "While examining op " << opCount;
+						cout << endl;
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
-							assert(stackForNestingOrder.isEmpty(threadID));
+						// Sanity check: prev op has same threadID and taskID as current op
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
 
-							// This means this is the first op in the thread
+						if (!firstOpInsideNestingLoop) {
+							if (previousOpInThread.taskID != NOTASK)
+								detector.opIDMap.nextOpInTask[previousOpInThread.opID] = opCount;
+						}
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
 
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+					if (firstOpInsideNestingLoop) {
+						if (!detector.opIDMap.exists(previousOpInTask.opID)) {
+							cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
+							cout << "ERROR: While examining op " << opCount << "\n";
+							return -1;
+						} else {
 #ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
+							// Sanity check: prev-op has same thread as current op in stack and opIDMap
+							assert(previousOpInTask.threadID == threadID);
+							assert(detector.opIDMap.threadID[previousOpInTask.opID] == threadID);
 #endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
+							opdetails.taskID = previousOpInTask.taskID;
+							detector.opIDMap.nextOpInTask[previousOpInTask.opID] = opCount;
+						}
+					}
 
-							if (detector.threadIDMap.find(targetThread) == detector.threadIDMap.end()) {
-								cout << "ERROR: Cannot find entry for thread " << targetThread << " in threadIDMap\n";
-								cout << "While examining op " << opCount << endl;
-								return -1;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[targetThread];
-#ifdef SANITYCHECK
-								// Sanity check: the join op id should not be set till now
-								assert(existingEntry.joinOpID == -1);
-#endif
-								existingEntry.joinOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(targetThread));
-								detector.threadIDMap[targetThread] = existingEntry;
-							}
 
-							stackForThreadOrder.push(stackElement);
-							stackForTaskOrder.push(stackElement);
-							stackForGlobalLoop.push(stackElement);
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
 						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of join, the previous op in thread is not necessarily the previous op in task.
-							MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
-
-							// If the previous op in task stack is the same as the previous op in thread stack, then we are not
-							// in the middle of a nesting loop.
-							bool firstOpInsideNestingLoop;
-							bool firstOpInsideGlobalLoop = false;
-							if (previousOpInThread.opID == -1) {
-								cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
-								return -1;
-							}
-							if (!stackForTaskOrder.isEmpty(threadID)) {
-								if (previousOpInTask.opID != previousOpInThread.opID)
-									firstOpInsideNestingLoop = true;
-								else {
-									// If the previous op in task is a pause, then we are in a new block
-#ifdef PERMIT
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("permit") == 0)
-#else
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("pause") == 0)
-#endif
-										firstOpInsideNestingLoop = true;
-									else
-										firstOpInsideNestingLoop = false;
-								}
-							} else {
-								// Task order stack is empty, this means we are not inside a nesting loop
-								firstOpInsideNestingLoop = false;
+							stackElement.taskID = previousOpInThread.taskID;
+						}
+					} else {
+						stackElement.taskID = previousOpInTask.taskID;
+					}
+					stackForThreadOrder.push(stackElement);
+					if (!stackForTaskOrder.isEmpty(threadID))
+						stackForTaskOrder.push(stackElement);
+					else {
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							stackForGlobalLoop.push(stackElement);
+						}
+					}
+				}
 
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									// We are inside the global loop.
-									MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
-//									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0)
-									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0
-											|| topOfGlobalLoopStack.opType.compare("exitloop") == 0) {
-										if (previousOpInThread.opType.compare("exitloop") == 0)
-											firstOpInsideGlobalLoop = false;
-										else
-											firstOpInsideGlobalLoop = true;
-									}
-								} else if (!stackForNestingOrder.isEmpty(threadID)) {
-									cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
-									cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
-										 << "\n";
-									return -1;
-								}
-							}
+			} else if (token.opType == FREE_OP) {
+				// Obtain 2nd & 3rd argument (i.e., starting address & num of bytes) of free
+				AddressType baseAddress;
+				IDType size;
+				baseAddress = token.args[1].value;
+				size = token.args[2].toInt();
 
-							// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									opdetails.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								// If this is the first op inside the nesting loop, then we are in a new block
-								opdetails.taskID = previousOpInTask.taskID;
-							}
+				// Allocs so far whose block contains the freed block
+				vector<IDType> allocsOfFree;
+				addressIndex.findAllocsContaining(baseAddress, size, allocsOfFree);
+				for (vector<IDType>::iterator it = allocsOfFree.begin(); it != allocsOfFree.end(); it++) {
+					detector.allocIDMap[*it].freeOps.insert(opCount);
 
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "While examining op " << opCount;
-								cout << endl;
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+					detector.freeIDMap[opCount].allocOpID = *it;
+				}
 
-#ifdef SANITYCHECK
-								// Sanity check: prev op has same threadID and taskID as current op
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
-#endif
+				// Reads so far of an address in the freed block
+				vector<IDType> readsOfFree;
+				addressIndex.findReads(baseAddress, size, readsOfFree);
+				for (vector<IDType>::iterator it = readsOfFree.begin(); it != readsOfFree.end(); it++) {
+					IDType readNode = detector.opIDMap.nodeID[*it];
+					detector.freeIDMap[opCount].readOps.insert(*it);
+					detector.freeIDMap[opCount].nodes.insert(readNode);
+				}
 
-								if (!firstOpInsideNestingLoop) {
-									if (previousOpInThread.taskID.compare("") != 0)
-										existingEntry.nextOpInTask = opCount;
-								}
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+				// Writes so far of an address in the freed block
+				vector<IDType> writesOfFree;
+				addressIndex.findWrites(baseAddress, size, writesOfFree);
+				for (vector<IDType>::iterator it = writesOfFree.begin(); it != writesOfFree.end(); it++) {
+					IDType writeNode = detector.opIDMap.nodeID[*it];
+					detector.freeIDMap[opCount].writeOps.insert(*it);
+					detector.freeIDMap[opCount].nodes.insert(writeNode);
+				}
+
+				UAFDetector::memoryOpDetails memdetails;
+				memdetails.startingAddress = baseAddress;
+				memdetails.range = size;
+				if (detector.freeSet.find(opCount) == detector.freeSet.end()) {
+					detector.freeSet[opCount] = memdetails;
+					addressIndex.addFree(opCount, baseAddress, size);
+				} else {
+					cout << "ERROR: Found duplicate entry for op " << opCount << " in opIDMap\n";
+					return -1;
+				}
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)){
+
+					nodeCount++;
+					opdetails.nodeID = nodeCount;
+					stackElement.nodeID = nodeCount;
+
+					if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+						UAFDetector::setOfOps set;
+						set.opSet.insert(opCount);
+						detector.nodeIDMap[nodeCount] = set;
+					} else {
+						cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+						cout << "ERROR: Existing entry:\n";
+						detector.nodeIDMap[nodeCount].printDetails();
+						return -1;
+					}
+
+					cout << "WARNING: No previous op found for free " << opCount
+						 << " on stackForThreadOrder\n";
 
-							if (firstOpInsideNestingLoop) {
-								if (detector.opIDMap.find(previousOpInTask.opID) == detector.opIDMap.end()) {
-									cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
-									cout << "ERROR: While examining op " << opCount << "\n";
-									return -1;
-								} else {
-									UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInTask.opID];
 #ifdef SANITYCHECK
-									// Sanity check: prev-op has same thread as current op in stack and opIDMap
-									assert(previousOpInTask.threadID == threadID);
-									assert(existingEntry.threadID == threadID);
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
+					assert(stackForNestingOrder.isEmpty(threadID));
 #endif
-									opdetails.taskID = previousOpInTask.taskID;
-									existingEntry.nextOpInTask = opCount;
-									detector.opIDMap.erase(detector.opIDMap.find(previousOpInTask.opID));
-									detector.opIDMap[previousOpInTask.opID] = existingEntry;
-								}
-							}
 
-							if (detector.threadIDMap.find(targetThread) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.joinOpID = opCount;
-								detector.threadIDMap[targetThread] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[targetThread];
+					// This means this is the first op in the thread
+
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
 #ifdef SANITYCHECK
-								// Sanity check: the join op id should not be set till now
-								assert(existingEntry.joinOpID == -1);
+						assert(existingEntry.firstOpID == -1);
 #endif
-								existingEntry.joinOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(targetThread));
-								detector.threadIDMap[targetThread] = existingEntry;
-							}
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									stackElement.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								stackElement.taskID = previousOpInTask.taskID;
-							}
-							stackForThreadOrder.push(stackElement);
-							if (!stackForTaskOrder.isEmpty(threadID))
-								stackForTaskOrder.push(stackElement);
-							else {
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									stackForGlobalLoop.push(stackElement);
-								}
-							}
-						}
-					} else if (match.compare("alloc") == 0) {
-						// Obtain 2nd & 3rd argument (i.e., starting address & num of bytes) of alloc
-						string baseAddress;
-						IDType size;
-						unsigned j;
-						for (j=threadPos+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								baseAddress = m1;
-								break;
-							}
-						}
-						for (j=j+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								size = atoi(m1.c_str());
-								break;
-							}
+					stackForThreadOrder.push(stackElement);
+					stackForTaskOrder.push(stackElement);
+					stackForGlobalLoop.push(stackElement);
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of free, the previous op in thread is not necessarily the previous op in task.
+					MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
+
+					// If the previous op in task stack is the same as the previous op in thread stack, then we are not
+					// in the middle of a nesting loop.
+					bool firstOpInsideNestingLoop;
+					bool firstOpInsideGlobalLoop = false;
+					if (previousOpInThread.opID == -1) {
+						cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
+						return -1;
+					}
+					if (!stackForTaskOrder.isEmpty(threadID)) {
+						if (previousOpInTask.opID != previousOpInThread.opID)
+							firstOpInsideNestingLoop = true;
+						else {
+							// If the previous op in task is a pause, then we are in a new block
+#ifdef PERMIT
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PERMIT_OP)
+#else
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PAUSE_OP)
+#endif
+								firstOpInsideNestingLoop = true;
+							else
+								firstOpInsideNestingLoop = false;
 						}
-
-						UAFDetector::memoryOpDetails memdetails;
-						memdetails.startingAddress = baseAddress;
-						memdetails.range = size;
-						if (detector.allocSet.find(opCount) == detector.allocSet.end()) {
-							detector.allocSet[opCount] = memdetails;
-						} else {
-							cout << "ERROR: Found duplicate entry for op " << opCount << " in opIDMap\n";
-								cout << endl;
+					} else {
+						// Task order stack is empty, this means we are not inside a nesting loop
+						firstOpInsideNestingLoop = false;
+
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							// We are inside the global loop.
+							MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
+//							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP)
+							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP
+									|| topOfGlobalLoopStack.opType == EXITLOOP_OP) {
+								if (previousOpInThread.opType == EXITLOOP_OP)
+									firstOpInsideGlobalLoop = false;
+								else
+									firstOpInsideGlobalLoop = true;
+							}
+						} else if (!stackForNestingOrder.isEmpty(threadID)) {
+							cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
+							cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
+								 << "\n";
 							return -1;
 						}
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)){
+					}
+
+					// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
+
 							nodeCount++;
 							opdetails.nodeID = nodeCount;
 							stackElement.nodeID = nodeCount;
@@ -2331,143 +2765,23 @@ it++) {
 								detector.nodeIDMap[nodeCount].printDetails();
 								return -1;
 							}
-
-							cout << "WARNING: No previous op found for alloc " << opCount
-								 << " on stackForThreadOrder\n";
-
-#ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
-							assert(stackForNestingOrder.isEmpty(threadID));
-#endif
-
-							// This means this is the first op in the thread
-
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
-#ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
-#endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
-
-							stackForThreadOrder.push(stackElement);
-							stackForTaskOrder.push(stackElement);
-							stackForGlobalLoop.push(stackElement);
 						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of alloc, the previous op in thread is not necessarily the previous op in task.
-							MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
-
-							// If the previous op in task stack is the same as the previous op in thread stack, then we are not
-							// in the middle of a nesting loop.
-							bool firstOpInsideNestingLoop;
-							bool firstOpInsideGlobalLoop = false;
-							if (previousOpInThread.opID == -1) {
-								cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
-								return -1;
-							}
-							if (!stackForTaskOrder.isEmpty(threadID)) {
-								if (previousOpInTask.opID != previousOpInThread.opID)
-									firstOpInsideNestingLoop = true;
-								else {
-									// If the previous op in task is a pause, then we are in a new block
-#ifdef PERMIT
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("permit") == 0)
-#else
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("pause") == 0)
-#endif
-										firstOpInsideNestingLoop = true;
-									else
-										firstOpInsideNestingLoop = false;
-								}
-							} else {
-								// Task order stack is empty, this means we are not inside a nesting loop
-								firstOpInsideNestingLoop = false;
-
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									// We are inside the global loop.
-									MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
-//									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0)
-									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0
-											|| topOfGlobalLoopStack.opType.compare("exitloop") == 0) {
-										if (previousOpInThread.opType.compare("exitloop") == 0)
-											firstOpInsideGlobalLoop = false;
-										else
-											firstOpInsideGlobalLoop = true;
-									}
-								} else if (!stackForNestingOrder.isEmpty(threadID)) {
-									cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
-									cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
-										 << "\n";
-									return -1;
-								}
-							}
+							opdetails.taskID = previousOpInThread.taskID;
+							if (previousOpInThread.opType == ALLOC_OP ||
+									previousOpInThread.opType == FREE_OP ||
+									previousOpInThread.opType == READ_OP ||
+									previousOpInThread.opType == WRITE_OP) {
+								opdetails.nodeID = previousOpInThread.nodeID;
 
-							// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-
-									nodeCount++;
-									opdetails.nodeID = nodeCount;
-									stackElement.nodeID = nodeCount;
-
-									if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-										UAFDetector::setOfOps set;
-										set.opSet.insert(opCount);
-										detector.nodeIDMap[nodeCount] = set;
-									} else {
-										cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-										cout << "ERROR: Existing entry:\n";
-										detector.nodeIDMap[nodeCount].printDetails();
-										return -1;
-									}
+								stackElement.nodeID = previousOpInThread.nodeID;
 
+								if (detector.nodeIDMap.find(previousOpInThread.nodeID) == detector.nodeIDMap.end()) {
+									cout << "ERROR: Cannot find entry for node " << previousOpInThread.nodeID << " in nodeIDMap\n";
+									return -1;
 								} else {
-									opdetails.taskID = previousOpInThread.taskID;
-
-									if (previousOpInThread.opType.compare("alloc") == 0 ||
-											previousOpInThread.opType.compare("free") == 0 ||
-											previousOpInThread.opType.compare("read") == 0 ||
-											previousOpInThread.opType.compare("write") == 0) {
-										opdetails.nodeID = previousOpInThread.nodeID;
-
-										stackElement.nodeID = previousOpInThread.nodeID;
-
-										if (detector.nodeIDMap.find(previousOpInThread.nodeID) == detector.nodeIDMap.end()) {
-											cout << "ERROR: Cannot find entry for node " << previousOpInThread.nodeID << " in nodeIDMap\n";
-											return -1;
-										} else {
-											UAFDetector::setOfOps existingEntry = detector.nodeIDMap[previousOpInThread.nodeID];
-											existingEntry.opSet.insert(opCount);
-											detector.nodeIDMap.erase(detector.nodeIDMap.find(previousOpInThread.nodeID));
-											detector.nodeIDMap[previousOpInThread.nodeID] = existingEntry;
-										}
-									} else {
-										nodeCount++;
-										opdetails.nodeID = nodeCount;
-										stackElement.nodeID = nodeCount;
-
-										if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-											UAFDetector::setOfOps set;
-											set.opSet.insert(opCount);
-											detector.nodeIDMap[nodeCount] = set;
-										} else {
-											cout << "ERROR: Found duplicate entry for node " << nodeCount << " in nodeIDMap\n";
-											return -1;
-										}
-									}
+									detector.nodeIDMap[previousOpInThread.nodeID].opSet.insert(opCount);
 								}
 							} else {
-								// If this is the first op inside the nesting loop, then we are in a new block
-								opdetails.taskID = previousOpInTask.taskID;
-
 								nodeCount++;
 								opdetails.nodeID = nodeCount;
 								stackElement.nodeID = nodeCount;
@@ -2477,193 +2791,219 @@ it++) {
 									set.opSet.insert(opCount);
 									detector.nodeIDMap[nodeCount] = set;
 								} else {
-									cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-									cout << "ERROR: Existing entry:\n";
-									detector.nodeIDMap[nodeCount].printDetails();
+									cout << "ERROR: Found duplicate entry for node " << nodeCount << " in nodeIDMap\n";
 									return -1;
 								}
-
 							}
+						}
+					} else {
+						// If this is the first op inside the nesting loop, then we are in a new block
+						opdetails.taskID = previousOpInTask.taskID;
 
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "While examining op " << opCount;
-								cout << endl;
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+						nodeCount++;
+						opdetails.nodeID = nodeCount;
+						stackElement.nodeID = nodeCount;
+
+						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+							UAFDetector::setOfOps set;
+							set.opSet.insert(opCount);
+							detector.nodeIDMap[nodeCount] = set;
+						} else {
+							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+							cout << "ERROR: Existing entry:\n";
+							detector.nodeIDMap[nodeCount].printDetails();
+							return -1;
+						}
+					}
 
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "While examining op " << opCount;
+						cout << endl;
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-								// Sanity check: prev op has same threadID and taskID as current op
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
+						// Sanity check: prev op has same threadID and taskID as current op
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
 
-								if (!firstOpInsideNestingLoop) {
-									if (previousOpInThread.taskID.compare("") != 0)
-										existingEntry.nextOpInTask = opCount;
-								}
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+						if (!firstOpInsideNestingLoop) {
+							if (previousOpInThread.taskID != NOTASK)
+								detector.opIDMap.nextOpInTask[previousOpInThread.opID] = opCount;
+						}
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
 
-							if (firstOpInsideNestingLoop) {
-								if (detector.opIDMap.find(previousOpInTask.opID) == detector.opIDMap.end()) {
-									cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
-									cout << "ERROR: While examining op " << opCount << "\n";
-									return -1;
-								} else {
-									UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInTask.opID];
+					if (firstOpInsideNestingLoop) {
+						if (!detector.opIDMap.exists(previousOpInTask.opID)) {
+							cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
+							cout << "ERROR: While examining op " << opCount << "\n";
+							return -1;
+						} else {
 #ifdef SANITYCHECK
-									// Sanity check: prev-op has same thread as current op in stack and opIDMap
-									assert(previousOpInTask.threadID == threadID);
-									assert(existingEntry.threadID == threadID);
+							// Sanity check: prev-op has same thread as current op in stack and opIDMap
+							assert(previousOpInTask.threadID == threadID);
+							assert(detector.opIDMap.threadID[previousOpInTask.opID] == threadID);
 #endif
-									opdetails.taskID = previousOpInTask.taskID;
-									existingEntry.nextOpInTask = opCount;
-									detector.opIDMap.erase(detector.opIDMap.find(previousOpInTask.opID));
-									detector.opIDMap[previousOpInTask.opID] = existingEntry;
-								}
-							}
-
-
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									stackElement.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								stackElement.taskID = previousOpInTask.taskID;
-							}
-							stackForThreadOrder.push(stackElement);
-							if (!stackForTaskOrder.isEmpty(threadID))
-								stackForTaskOrder.push(stackElement);
-							else {
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									stackForGlobalLoop.push(stackElement);
-								}
-							}
+							opdetails.taskID = previousOpInTask.taskID;
+							detector.opIDMap.nextOpInTask[previousOpInTask.opID] = opCount;
 						}
+					}
 
-					} else if (match.compare("free") == 0) {
-						// Obtain 2nd & 3rd argument (i.e., starting address & num of bytes) of free
-						string baseAddress;
-						IDType size;
-						unsigned j;
-						for (j=threadPos+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								baseAddress = m1;
-								break;
-							}
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
+						} else {
+							stackElement.taskID = previousOpInThread.taskID;
 						}
-						for (j=j+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								size = atoi(m1.c_str());
-								break;
-							}
+					} else {
+						stackElement.taskID = previousOpInTask.taskID;
+					}
+
+					stackForThreadOrder.push(stackElement);
+					if (!stackForTaskOrder.isEmpty(threadID))
+						stackForTaskOrder.push(stackElement);
+					else {
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							stackForGlobalLoop.push(stackElement);
 						}
+					}
+				}
 
-						std::stringstream str1;
-						str1 << baseAddress;
-						IDType baseAddressIntFree, endAddressIntFree;
-						str1 >> std::hex >> baseAddressIntFree;
-						endAddressIntFree = baseAddressIntFree + size - 1;
-
-						for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.allocSet.begin(); it != detector.allocSet.end(); it++) {
-							std::stringstream str2;
-							str2 << it->second.startingAddress;
-							IDType baseAddressIntAlloc, endAddressIntAlloc;
-							str2 >> std::hex >> baseAddressIntAlloc;
-							endAddressIntAlloc = baseAddressIntAlloc + it->second.range - 1;
-
-							if (baseAddressIntAlloc <= baseAddressIntFree && endAddressIntFree <= endAddressIntAlloc) {
-								if (detector.allocIDMap.find(it->first) == detector.allocIDMap.end()) {
-									UAFDetector::allocOpDetails allocdetails;
-									allocdetails.freeOps.insert(opCount);
-									detector.allocIDMap[it->first] = allocdetails;
-								} else {
-									UAFDetector::allocOpDetails existingEntry = detector.allocIDMap[it->first];
-									existingEntry.freeOps.insert(opCount);
-									detector.allocIDMap.erase(detector.allocIDMap.find(it->first));
-									detector.allocIDMap[it->first] = existingEntry;
-								}
+			} else if (token.opType == READ_OP) {
+				// Obtain 2nd argument (i.e., address) of read
+				AddressType address;
+				address = token.args[1].value;
 
-								if (detector.freeIDMap.find(opCount) == detector.freeIDMap.end()) {
-									UAFDetector::freeOpDetails freedetails;
-									freedetails.allocOpID = it->first;
-									detector.freeIDMap[opCount] = freedetails;
-								} else {
-									UAFDetector::freeOpDetails existingEntry = detector.freeIDMap[opCount];
-									existingEntry.allocOpID = it->first;
-									detector.freeIDMap.erase(detector.freeIDMap.find(opCount));
-									detector.freeIDMap[opCount] = existingEntry;
-								}
-							}
-						}
+				// Allocs and frees so far whose block contains the address
+				vector<IDType> allocsOfRead, freesOfRead;
+				addressIndex.findAllocs(address, allocsOfRead);
+				addressIndex.findFrees(address, freesOfRead);
 
-						for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.readSet.begin(); it != detector.readSet.end(); it++) {
-							std::stringstream str2;
-							str2 << it->second.startingAddress;
-							IDType addressIntRead;
-							str2 >> std::hex >> addressIntRead;
-
-							IDType readNode = detector.opIDMap[it->first].nodeID;
-							if (baseAddressIntFree <= addressIntRead && addressIntRead <= endAddressIntFree) {
-								if (detector.freeIDMap.find(opCount) == detector.freeIDMap.end()) {
-									UAFDetector::freeOpDetails freedetails;
-									freedetails.readOps.insert(it->first);
-									freedetails.nodes.insert(readNode);
-									detector.freeIDMap[opCount] = freedetails;
-								} else {
-									UAFDetector::freeOpDetails existingEntry = detector.freeIDMap[opCount];
-									existingEntry.readOps.insert(it->first);
-									existingEntry.nodes.insert(readNode);
-									detector.freeIDMap.erase(detector.freeIDMap.find(opCount));
-									detector.freeIDMap[opCount] = existingEntry;
-								}
-							}
-						}
+				for (vector<IDType>::iterator it = allocsOfRead.begin(); it != allocsOfRead.end(); it++) {
+					detector.allocIDMap[*it].readOps.insert(opCount);
+				}
 
-						for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.writeSet.begin(); it != detector.writeSet.end(); it++) {
-							std::stringstream str2;
-							str2 << it->second.startingAddress;
-							IDType addressIntWrite;
-							str2 >> std::hex >> addressIntWrite;
-
-							IDType writeNode = detector.opIDMap[it->first].nodeID;
-							if (baseAddressIntFree <= addressIntWrite && addressIntWrite <= endAddressIntFree) {
-								if (detector.freeIDMap.find(opCount) == detector.freeIDMap.end()) {
-									UAFDetector::freeOpDetails freedetails;
-									freedetails.writeOps.insert(it->first);
-									freedetails.nodes.insert(writeNode);
-									detector.freeIDMap[opCount] = freedetails;
-								} else {
-									UAFDetector::freeOpDetails existingEntry = detector.freeIDMap[opCount];
-									existingEntry.writeOps.insert(it->first);
-									existingEntry.nodes.insert(writeNode);
-									detector.freeIDMap.erase(detector.freeIDMap.find(opCount));
-									detector.freeIDMap[opCount] = existingEntry;
-								}
-							}
-						}
+				for (vector<IDType>::iterator it = freesOfRead.begin(); it != freesOfRead.end(); it++) {
+					detector.freeIDMap[*it].readOps.insert(opCount);
+				}
 
-						UAFDetector::memoryOpDetails memdetails;
-						memdetails.startingAddress = baseAddress;
-						memdetails.range = size;
-						if (detector.freeSet.find(opCount) == detector.freeSet.end()) {
-							detector.freeSet[opCount] = memdetails;
-						} else {
-							cout << "ERROR: Found duplicate entry for op " << opCount << " in opIDMap\n";
+				UAFDetector::memoryOpDetails memdetails;
+				memdetails.startingAddress = address;
+				if (detector.readSet.find(opCount) == detector.readSet.end()) {
+					detector.readSet[opCount] = memdetails;
+					addressIndex.addRead(opCount, address);
+				} else {
+					cout << "ERROR: Found duplicate entry for op " << opCount << " in opIDMap\n";
+					return -1;
+				}
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)){
+
+					nodeCount++;
+					opdetails.nodeID = nodeCount;
+					stackElement.nodeID = nodeCount;
+
+					for (vector<IDType>::iterator it = allocsOfRead.begin(); it != allocsOfRead.end(); it++) {
+						detector.allocIDMap[*it].nodes.insert(nodeCount);
+					}
+
+					for (vector<IDType>::iterator it = freesOfRead.begin(); it != freesOfRead.end(); it++) {
+						detector.freeIDMap[*it].nodes.insert(nodeCount);
+					}
+
+					if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+						UAFDetector::setOfOps set;
+						set.opSet.insert(opCount);
+						detector.nodeIDMap[nodeCount] = set;
+					} else {
+						cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+						cout << "ERROR: Existing entry:\n";
+						detector.nodeIDMap[nodeCount].printDetails();
+						return -1;
+					}
+
+					cout << "WARNING: No previous op found for read " << opCount
+						 << " on stackForThreadOrder\n";
+
+#ifdef SANITYCHECK
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
+#endif
+
+					// This means this is the first op in the thread
+
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+#ifdef SANITYCHECK
+						assert(existingEntry.firstOpID == -1);
+#endif
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
+
+
+					stackForThreadOrder.push(stackElement);
+					stackForGlobalLoop.push(stackElement);
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of read, the previous op in thread is not necessarily the previous op in task.
+					MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
+
+					// If the previous op in task stack is the same as the previous op in thread stack, then we are not
+					// in the middle of a nesting loop.
+					bool firstOpInsideNestingLoop;
+					bool firstOpInsideGlobalLoop = false;
+					if (previousOpInThread.opID == -1) {
+						cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
+						return -1;
+					}
+					if (!stackForTaskOrder.isEmpty(threadID)) {
+						if (previousOpInTask.opID != previousOpInThread.opID)
+							firstOpInsideNestingLoop = true;
+						else {
+							// If the previous op in task is a pause, then we are in a new block
+#ifdef PERMIT
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PERMIT_OP)
+#else
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PAUSE_OP)
+#endif
+								firstOpInsideNestingLoop = true;
+							else
+								firstOpInsideNestingLoop = false;
+						}
+					} else {
+						// Task order stack is empty, this means we are not inside a nesting loop
+						firstOpInsideNestingLoop = false;
+
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							// We are inside the global loop.
+							MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
+//							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP)
+							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP
+									|| topOfGlobalLoopStack.opType == EXITLOOP_OP) {
+								if (previousOpInThread.opType == EXITLOOP_OP)
+									firstOpInsideGlobalLoop = false;
+								else
+									firstOpInsideGlobalLoop = true;
+							}
+						} else if (!stackForNestingOrder.isEmpty(threadID)) {
+							cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
+							cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
+								 << "\n";
 							return -1;
 						}
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)){
+					}
+
+					// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
 
 							nodeCount++;
 							opdetails.nodeID = nodeCount;
@@ -2679,141 +3019,23 @@ it++) {
 								detector.nodeIDMap[nodeCount].printDetails();
 								return -1;
 							}
-
-							cout << "WARNING: No previous op found for free " << opCount
-								 << " on stackForThreadOrder\n";
-
-#ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
-							assert(stackForNestingOrder.isEmpty(threadID));
-#endif
-
-							// This means this is the first op in the thread
-
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
-#ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
-#endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
-
-							stackForThreadOrder.push(stackElement);
-							stackForTaskOrder.push(stackElement);
-							stackForGlobalLoop.push(stackElement);
 						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of free, the previous op in thread is not necessarily the previous op in task.
-							MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
-
-							// If the previous op in task stack is the same as the previous op in thread stack, then we are not
-							// in the middle of a nesting loop.
-							bool firstOpInsideNestingLoop;
-							bool firstOpInsideGlobalLoop = false;
-							if (previousOpInThread.opID == -1) {
-								cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
-								return -1;
-							}
-							if (!stackForTaskOrder.isEmpty(threadID)) {
-								if (previousOpInTask.opID != previousOpInThread.opID)
-									firstOpInsideNestingLoop = true;
-								else {
-									// If the previous op in task is a pause, then we are in a new block
-#ifdef PERMIT
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("permit") == 0)
-#else
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("pause") == 0)
-#endif
-										firstOpInsideNestingLoop = true;
-									else
-										firstOpInsideNestingLoop = false;
-								}
-							} else {
-								// Task order stack is empty, this means we are not inside a nesting loop
-								firstOpInsideNestingLoop = false;
+							opdetails.taskID = previousOpInThread.taskID;
+							if (previousOpInThread.opType == ALLOC_OP ||
+									previousOpInThread.opType == FREE_OP ||
+									previousOpInThread.opType == READ_OP ||
+									previousOpInThread.opType == WRITE_OP) {
+								opdetails.nodeID = previousOpInThread.nodeID;
 
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									// We are inside the global loop.
-									MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
-//									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0)
-									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0
-											|| topOfGlobalLoopStack.opType.compare("exitloop") == 0) {
-										if (previousOpInThread.opType.compare("exitloop") == 0)
-											firstOpInsideGlobalLoop = false;
-										else
-											firstOpInsideGlobalLoop = true;
-									}
-								} else if (!stackForNestingOrder.isEmpty(threadID)) {
-									cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
-									cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
-										 << "\n";
-									return -1;
-								}
-							}
+								stackElement.nodeID = previousOpInThread.nodeID;
 
-							// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-
-									nodeCount++;
-									opdetails.nodeID = nodeCount;
-									stackElement.nodeID = nodeCount;
-
-									if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-										UAFDetector::setOfOps set;
-										set.opSet.insert(opCount);
-										detector.nodeIDMap[nodeCount] = set;
-									} else {
-										cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-										cout << "ERROR: Existing entry:\n";
-										detector.nodeIDMap[nodeCount].printDetails();
-										return -1;
-									}
+								if (detector.nodeIDMap.find(previousOpInThread.nodeID) == detector.nodeIDMap.end()) {
+									cout << "ERROR: Cannot find entry for node " << previousOpInThread.nodeID << " in nodeIDMap\n";
+									return -1;
 								} else {
-									opdetails.taskID = previousOpInThread.taskID;
-									if (previousOpInThread.opType.compare("alloc") == 0 ||
-											previousOpInThread.opType.compare("free") == 0 ||
-											previousOpInThread.opType.compare("read") == 0 ||
-											previousOpInThread.opType.compare("write") == 0) {
-										opdetails.nodeID = previousOpInThread.nodeID;
-
-										stackElement.nodeID = previousOpInThread.nodeID;
-
-										if (detector.nodeIDMap.find(previousOpInThread.nodeID) == detector.nodeIDMap.end()) {
-											cout << "ERROR: Cannot find entry for node " << previousOpInThread.nodeID << " in nodeIDMap\n";
-											return -1;
-										} else {
-											UAFDetector::setOfOps existingEntry = detector.nodeIDMap[previousOpInThread.nodeID];
-											existingEntry.opSet.insert(opCount);
-											detector.nodeIDMap.erase(detector.nodeIDMap.find(previousOpInThread.nodeID));
-											detector.nodeIDMap[previousOpInThread.nodeID] = existingEntry;
-										}
-									} else {
-										nodeCount++;
-										opdetails.nodeID = nodeCount;
-										stackElement.nodeID = nodeCount;
-
-										if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-											UAFDetector::setOfOps set;
-											set.opSet.insert(opCount);
-											detector.nodeIDMap[nodeCount] = set;
-										} else {
-											cout << "ERROR: Found duplicate entry for node " << nodeCount << " in nodeIDMap\n";
-											return -1;
-										}
-									}
+									detector.nodeIDMap[previousOpInThread.nodeID].opSet.insert(opCount);
 								}
 							} else {
-								// If this is the first op inside the nesting loop, then we are in a new block
-								opdetails.taskID = previousOpInTask.taskID;
-
 								nodeCount++;
 								opdetails.nodeID = nodeCount;
 								stackElement.nodeID = nodeCount;
@@ -2823,575 +3045,238 @@ it++) {
 									set.opSet.insert(opCount);
 									detector.nodeIDMap[nodeCount] = set;
 								} else {
-									cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-									cout << "ERROR: Existing entry:\n";
-									detector.nodeIDMap[nodeCount].printDetails();
+									cout << "ERROR: Found duplicate entry for node " << nodeCount << " in nodeIDMap\n";
 									return -1;
 								}
 							}
+						}
+					} else {
+						// If this is the first op inside the nesting loop, then we are in a new block
+						opdetails.taskID = previousOpInTask.taskID;
 
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "While examining op " << opCount;
-								cout << endl;
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+						nodeCount++;
+						opdetails.nodeID = nodeCount;
+						stackElement.nodeID = nodeCount;
+
+						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+							UAFDetector::setOfOps set;
+							set.opSet.insert(opCount);
+							detector.nodeIDMap[nodeCount] = set;
+						} else {
+							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+							cout << "ERROR: Existing entry:\n";
+							detector.nodeIDMap[nodeCount].printDetails();
+							return -1;
+						}
+					}
 
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "While examining op " << opCount;
+						cout << endl;
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-								// Sanity check: prev op has same threadID and taskID as current op
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
+						// Sanity check: prev op has same threadID and taskID as current op
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
 
-								if (!firstOpInsideNestingLoop) {
-									if (previousOpInThread.taskID.compare("") != 0)
-										existingEntry.nextOpInTask = opCount;
-								}
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+						if (!firstOpInsideNestingLoop) {
+							if (previousOpInThread.taskID != NOTASK && previousOpInThread.opType != END_OP)
+								detector.opIDMap.nextOpInTask[previousOpInThread.opID] = opCount;
+						}
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
 
-							if (firstOpInsideNestingLoop) {
-								if (detector.opIDMap.find(previousOpInTask.opID) == detector.opIDMap.end()) {
-									cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
-									cout << "ERROR: While examining op " << opCount << "\n";
-									return -1;
-								} else {
-									UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInTask.opID];
+					if (firstOpInsideNestingLoop) {
+						if (!detector.opIDMap.exists(previousOpInTask.opID)) {
+							cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
+							cout << "ERROR: While examining op " << opCount << "\n";
+							return -1;
+						} else {
 #ifdef SANITYCHECK
-									// Sanity check: prev-op has same thread as current op in stack and opIDMap
-									assert(previousOpInTask.threadID == threadID);
-									assert(existingEntry.threadID == threadID);
+							// Sanity check: prev-op has same thread as current op in stack and opIDMap
+							assert(previousOpInTask.threadID == threadID);
+							assert(detector.opIDMap.threadID[previousOpInTask.opID] == threadID);
 #endif
-									opdetails.taskID = previousOpInTask.taskID;
-									existingEntry.nextOpInTask = opCount;
-									detector.opIDMap.erase(detector.opIDMap.find(previousOpInTask.opID));
-									detector.opIDMap[previousOpInTask.opID] = existingEntry;
-								}
-							}
-
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									stackElement.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								stackElement.taskID = previousOpInTask.taskID;
-							}
-
-							stackForThreadOrder.push(stackElement);
-							if (!stackForTaskOrder.isEmpty(threadID))
-								stackForTaskOrder.push(stackElement);
-							else {
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									stackForGlobalLoop.push(stackElement);
-								}
-							}
+							opdetails.taskID = previousOpInTask.taskID;
+							detector.opIDMap.nextOpInTask[previousOpInTask.opID] = opCount;
 						}
+					}
 
-					} else if (match.compare("read") == 0) {
-						// Obtain 2nd argument (i.e., address) of read
-						string address;
-						for (unsigned j=threadPos+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								address = m1;
-								break;
-							}
-						}
 
-						std::stringstream str1;
-						str1 << address;
-						IDType addressIntRead;
-						str1 >> std::hex >> addressIntRead;
-
-						for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.allocSet.begin(); it != detector.allocSet.end(); it++) {
-							std::stringstream str2;
-							str2 << it->second.startingAddress;
-							IDType baseAddressIntAlloc, endAddressIntAlloc;
-							str2 >> std::hex >> baseAddressIntAlloc;
-							endAddressIntAlloc = baseAddressIntAlloc + it->second.range - 1;
-
-							if (baseAddressIntAlloc <= addressIntRead && addressIntRead <= endAddressIntAlloc) {
-								if (detector.allocIDMap.find(it->first) == detector.allocIDMap.end()) {
-									UAFDetector::allocOpDetails allocdetails;
-									allocdetails.readOps.insert(opCount);
-									detector.allocIDMap[it->first] = allocdetails;
-								} else {
-									UAFDetector::allocOpDetails existingEntry = detector.allocIDMap[it->first];
-									existingEntry.readOps.insert(opCount);
-									detector.allocIDMap.erase(detector.allocIDMap.find(it->first));
-									detector.allocIDMap[it->first] = existingEntry;
-								}
-							}
-						}
 
-						for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.freeSet.begin(); it != detector.freeSet.end(); it++) {
-							std::stringstream str2;
-							str2 << it->second.startingAddress;
-							IDType baseAddressIntFree, endAddressIntFree;
-							str2 >> std::hex >> baseAddressIntFree;
-							endAddressIntFree = baseAddressIntFree + it->second.range - 1;
-
-							if (baseAddressIntFree <= addressIntRead && addressIntRead <= endAddressIntFree) {
-								if (detector.freeIDMap.find(it->first) == detector.freeIDMap.end()) {
-									UAFDetector::freeOpDetails freedetails;
-									freedetails.readOps.insert(opCount);
-									detector.freeIDMap[it->first] = freedetails;
-								} else {
-									UAFDetector::freeOpDetails existingEntry = detector.freeIDMap[it->first];
-									existingEntry.readOps.insert(opCount);
-									detector.freeIDMap.erase(detector.freeIDMap.find(it->first));
-									detector.freeIDMap[it->first] = existingEntry;
-								}
-							}
-						}
 
-						UAFDetector::memoryOpDetails memdetails;
-						memdetails.startingAddress = address;
-						if (detector.readSet.find(opCount) == detector.readSet.end()) {
-							detector.readSet[opCount] = memdetails;
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
 						} else {
-							cout << "ERROR: Found duplicate entry for op " << opCount << " in opIDMap\n";
-							return -1;
+							stackElement.taskID = previousOpInThread.taskID;
 						}
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)){
-
-							nodeCount++;
-							opdetails.nodeID = nodeCount;
-							stackElement.nodeID = nodeCount;
-
-							for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.allocSet.begin(); it != detector.allocSet.end(); it++) {
-								std::stringstream str2;
-								str2 << it->second.startingAddress;
-								IDType baseAddressIntAlloc, endAddressIntAlloc;
-								str2 >> std::hex >> baseAddressIntAlloc;
-								endAddressIntAlloc = baseAddressIntAlloc + it->second.range - 1;
-
-								if (baseAddressIntAlloc <= addressIntRead && addressIntRead <= endAddressIntAlloc) {
-									if (detector.allocIDMap.find(it->first) == detector.allocIDMap.end()) {
-										UAFDetector::allocOpDetails allocdetails;
-										allocdetails.nodes.insert(nodeCount);
-										detector.allocIDMap[it->first] = allocdetails;
-									} else {
-										UAFDetector::allocOpDetails existingEntry = detector.allocIDMap[it->first];
-										existingEntry.nodes.insert(nodeCount);
-										detector.allocIDMap.erase(detector.allocIDMap.find(it->first));
-										detector.allocIDMap[it->first] = existingEntry;
-									}
-								}
-							}
-
-							for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.freeSet.begin(); it != detector.freeSet.end(); it++) {
-								std::stringstream str2;
-								str2 << it->second.startingAddress;
-								IDType baseAddressIntFree, endAddressIntFree;
-								str2 >> std::hex >> baseAddressIntFree;
-								endAddressIntFree = baseAddressIntFree + it->second.range - 1;
-
-								if (baseAddressIntFree <= addressIntRead && addressIntRead <= endAddressIntFree) {
-									if (detector.freeIDMap.find(it->first) == detector.freeIDMap.end()) {
-										UAFDetector::freeOpDetails freedetails;
-										freedetails.nodes.insert(nodeCount);
-										detector.freeIDMap[it->first] = freedetails;
-									} else {
-										UAFDetector::freeOpDetails existingEntry = detector.freeIDMap[it->first];
-										existingEntry.nodes.insert(nodeCount);
-										detector.freeIDMap.erase(detector.freeIDMap.find(it->first));
-										detector.freeIDMap[it->first] = existingEntry;
-									}
-								}
-							}
-
-							if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-								UAFDetector::setOfOps set;
-								set.opSet.insert(opCount);
-								detector.nodeIDMap[nodeCount] = set;
-							} else {
-								cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-								cout << "ERROR: Existing entry:\n";
-								detector.nodeIDMap[nodeCount].printDetails();
-								return -1;
-							}
-
-							cout << "WARNING: No previous op found for read " << opCount
-								 << " on stackForThreadOrder\n";
-
-#ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
-#endif
-
-							// This means this is the first op in the thread
-
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
-#ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
-#endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
-
+					} else {
+						stackElement.taskID = previousOpInTask.taskID;
+					}
 
-							stackForThreadOrder.push(stackElement);
+					stackForThreadOrder.push(stackElement);
+					if (!stackForTaskOrder.isEmpty(threadID))
+						stackForTaskOrder.push(stackElement);
+					else {
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
 							stackForGlobalLoop.push(stackElement);
-						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of read, the previous op in thread is not necessarily the previous op in task.
-							MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
-
-							// If the previous op in task stack is the same as the previous op in thread stack, then we are not
-							// in the middle of a nesting loop.
-							bool firstOpInsideNestingLoop;
-							bool firstOpInsideGlobalLoop = false;
-							if (previousOpInThread.opID == -1) {
-								cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
-								return -1;
-							}
-							if (!stackForTaskOrder.isEmpty(threadID)) {
-								if (previousOpInTask.opID != previousOpInThread.opID)
-									firstOpInsideNestingLoop = true;
-								else {
-									// If the previous op in task is a pause, then we are in a new block
-#ifdef PERMIT
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("permit") == 0)
-#else
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("pause") == 0)
-#endif
-										firstOpInsideNestingLoop = true;
-									else
-										firstOpInsideNestingLoop = false;
-								}
-							} else {
-								// Task order stack is empty, this means we are not inside a nesting loop
-								firstOpInsideNestingLoop = false;
-
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									// We are inside the global loop.
-									MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
-//									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0)
-									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0
-											|| topOfGlobalLoopStack.opType.compare("exitloop") == 0) {
-										if (previousOpInThread.opType.compare("exitloop") == 0)
-											firstOpInsideGlobalLoop = false;
-										else
-											firstOpInsideGlobalLoop = true;
-									}
-								} else if (!stackForNestingOrder.isEmpty(threadID)) {
-									cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
-									cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
-										 << "\n";
-									return -1;
-								}
-							}
+						}
+					}
 
-							// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-
-									nodeCount++;
-									opdetails.nodeID = nodeCount;
-									stackElement.nodeID = nodeCount;
-
-									if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-										UAFDetector::setOfOps set;
-										set.opSet.insert(opCount);
-										detector.nodeIDMap[nodeCount] = set;
-									} else {
-										cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-										cout << "ERROR: Existing entry:\n";
-										detector.nodeIDMap[nodeCount].printDetails();
-										return -1;
-									}
-								} else {
-									opdetails.taskID = previousOpInThread.taskID;
-									if (previousOpInThread.opType.compare("alloc") == 0 ||
-											previousOpInThread.opType.compare("free") == 0 ||
-											previousOpInThread.opType.compare("read") == 0 ||
-											previousOpInThread.opType.compare("write") == 0) {
-										opdetails.nodeID = previousOpInThread.nodeID;
-
-										stackElement.nodeID = previousOpInThread.nodeID;
-
-										if (detector.nodeIDMap.find(previousOpInThread.nodeID) == detector.nodeIDMap.end()) {
-											cout << "ERROR: Cannot find entry for node " << previousOpInThread.nodeID << " in nodeIDMap\n";
-											return -1;
-										} else {
-											UAFDetector::setOfOps existingEntry = detector.nodeIDMap[previousOpInThread.nodeID];
-											existingEntry.opSet.insert(opCount);
-											detector.nodeIDMap.erase(detector.nodeIDMap.find(previousOpInThread.nodeID));
-											detector.nodeIDMap[previousOpInThread.nodeID] = existingEntry;
-										}
-									} else {
-										nodeCount++;
-										opdetails.nodeID = nodeCount;
-										stackElement.nodeID = nodeCount;
-
-										if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-											UAFDetector::setOfOps set;
-											set.opSet.insert(opCount);
-											detector.nodeIDMap[nodeCount] = set;
-										} else {
-											cout << "ERROR: Found duplicate entry for node " << nodeCount << " in nodeIDMap\n";
-											return -1;
-										}
-									}
-								}
-							} else {
-								// If this is the first op inside the nesting loop, then we are in a new block
-								opdetails.taskID = previousOpInTask.taskID;
+					for (vector<IDType>::iterator it = allocsOfRead.begin(); it != allocsOfRead.end(); it++) {
+						detector.allocIDMap[*it].nodes.insert(opdetails.nodeID);
+					}
 
-								nodeCount++;
-								opdetails.nodeID = nodeCount;
-								stackElement.nodeID = nodeCount;
+					for (vector<IDType>::iterator it = freesOfRead.begin(); it != freesOfRead.end(); it++) {
+						detector.freeIDMap[*it].nodes.insert(opdetails.nodeID);
+					}
+				}
 
-								if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-									UAFDetector::setOfOps set;
-									set.opSet.insert(opCount);
-									detector.nodeIDMap[nodeCount] = set;
-								} else {
-									cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-									cout << "ERROR: Existing entry:\n";
-									detector.nodeIDMap[nodeCount].printDetails();
-									return -1;
-								}
-							}
+			} else if (token.opType == WRITE_OP) {
+				// Obtain 2nd argument (i.e., address) of write
+				AddressType address;
+				address = token.args[1].value;
 
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "While examining op " << opCount;
-								cout << endl;
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+				// Allocs and frees so far whose block contains the address
+				vector<IDType> allocsOfWrite, freesOfWrite;
+				addressIndex.findAllocs(address, allocsOfWrite);
+				addressIndex.findFrees(address, freesOfWrite);
 
-#ifdef SANITYCHECK
-								// Sanity check: prev op has same threadID and taskID as current op
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
-#endif
+				for (vector<IDType>::iterator it = allocsOfWrite.begin(); it != allocsOfWrite.end(); it++) {
+					detector.allocIDMap[*it].writeOps.insert(opCount);
+				}
 
-								if (!firstOpInsideNestingLoop) {
-									if (previousOpInThread.taskID.compare("") != 0 && previousOpInThread.opType.compare("end") != 0)
-										existingEntry.nextOpInTask = opCount;
-								}
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+				for (vector<IDType>::iterator it = freesOfWrite.begin(); it != freesOfWrite.end(); it++) {
+					detector.freeIDMap[*it].writeOps.insert(opCount);
+				}
 
-							if (firstOpInsideNestingLoop) {
-								if (detector.opIDMap.find(previousOpInTask.opID) == detector.opIDMap.end()) {
-									cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
-									cout << "ERROR: While examining op " << opCount << "\n";
-									return -1;
-								} else {
-									UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInTask.opID];
-#ifdef SANITYCHECK
-									// Sanity check: prev-op has same thread as current op in stack and opIDMap
-									assert(previousOpInTask.threadID == threadID);
-									assert(existingEntry.threadID == threadID);
-#endif
-									opdetails.taskID = previousOpInTask.taskID;
-									existingEntry.nextOpInTask = opCount;
-									detector.opIDMap.erase(detector.opIDMap.find(previousOpInTask.opID));
-									detector.opIDMap[previousOpInTask.opID] = existingEntry;
-								}
-							}
+				UAFDetector::memoryOpDetails memdetails;
+				memdetails.startingAddress = address;
+				if (detector.writeSet.find(opCount) == detector.writeSet.end()) {
+					detector.writeSet[opCount] = memdetails;
+					addressIndex.addWrite(opCount, address);
+				} else {
+					cout << "ERROR: Found duplicate entry for op " << opCount << " in opIDMap\n";
+					return -1;
+				}
 
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)){
 
+					nodeCount++;
+					opdetails.nodeID = nodeCount;
+					stackElement.nodeID = nodeCount;
 
+					for (vector<IDType>::iterator it = allocsOfWrite.begin(); it != allocsOfWrite.end(); it++) {
+						detector.allocIDMap[*it].nodes.insert(nodeCount);
+					}
 
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									stackElement.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								stackElement.taskID = previousOpInTask.taskID;
-							}
+					for (vector<IDType>::iterator it = freesOfWrite.begin(); it != freesOfWrite.end(); it++) {
+						detector.freeIDMap[*it].nodes.insert(nodeCount);
+					}
 
-							stackForThreadOrder.push(stackElement);
-							if (!stackForTaskOrder.isEmpty(threadID))
-								stackForTaskOrder.push(stackElement);
-							else {
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									stackForGlobalLoop.push(stackElement);
-								}
-							}
+					if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+						UAFDetector::setOfOps set;
+						set.opSet.insert(opCount);
+						detector.nodeIDMap[nodeCount] = set;
+					} else {
+						cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+						cout << "ERROR: Existing entry:\n";
+						detector.nodeIDMap[nodeCount].printDetails();
+						return -1;
+					}
 
-							for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.allocSet.begin(); it != detector.allocSet.end(); it++) {
-								std::stringstream str2;
-								str2 << it->second.startingAddress;
-								IDType baseAddressIntAlloc, endAddressIntAlloc;
-								str2 >> std::hex >> baseAddressIntAlloc;
-								endAddressIntAlloc = baseAddressIntAlloc + it->second.range - 1;
-
-								if (baseAddressIntAlloc <= addressIntRead && addressIntRead <= endAddressIntAlloc) {
-									if (detector.allocIDMap.find(it->first) == detector.allocIDMap.end()) {
-										UAFDetector::allocOpDetails allocdetails;
-										allocdetails.nodes.insert(opdetails.nodeID);
-										detector.allocIDMap[it->first] = allocdetails;
-									} else {
-										UAFDetector::allocOpDetails existingEntry = detector.allocIDMap[it->first];
-										existingEntry.nodes.insert(opdetails.nodeID);
-										detector.allocIDMap.erase(detector.allocIDMap.find(it->first));
-										detector.allocIDMap[it->first] = existingEntry;
-									}
-								}
-							}
+					cout << "WARNING: No previous op found for write " << opCount
+						 << " on stackForThreadOrder\n";
 
-							for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.freeSet.begin(); it != detector.freeSet.end(); it++) {
-								std::stringstream str2;
-								str2 << it->second.startingAddress;
-								IDType baseAddressIntFree, endAddressIntFree;
-								str2 >> std::hex >> baseAddressIntFree;
-								endAddressIntFree = baseAddressIntFree + it->second.range - 1;
-
-								if (baseAddressIntFree <= addressIntRead && addressIntRead <= endAddressIntFree) {
-									if (detector.freeIDMap.find(it->first) == detector.freeIDMap.end()) {
-										UAFDetector::freeOpDetails freedetails;
-										freedetails.nodes.insert(opdetails.nodeID);
-										detector.freeIDMap[it->first] = freedetails;
-									} else {
-										UAFDetector::freeOpDetails existingEntry = detector.freeIDMap[it->first];
-										existingEntry.nodes.insert(opdetails.nodeID);
-										detector.freeIDMap.erase(detector.freeIDMap.find(it->first));
-										detector.freeIDMap[it->first] = existingEntry;
-									}
-								}
-							}
-						}
+#ifdef SANITYCHECK
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
+//					assert(stackForBlockOrder.isEmpty(threadID));
+//					assert(stackForNestingOrder.isEmpty(threadID));
+#endif
 
-					} else if (match.compare("write") == 0) {
-						// Obtain 2nd argument (i.e., address) of write
-						string address;
-						for (unsigned j=threadPos+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							// find the next non-empty matches[i] after threadID of operation.
-							if (!m1.empty() && m1.compare(" ") != 0) {
-								address = m1;
-								break;
-							}
-						}
+					// This means this is the first op in the thread
 
-						std::stringstream str1;
-						str1 << address;
-						IDType addressIntWrite;
-						str1 >> std::hex >> addressIntWrite;
-
-						for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.allocSet.begin(); it != detector.allocSet.end(); it++) {
-							std::stringstream str2;
-							str2 << it->second.startingAddress;
-							IDType baseAddressIntAlloc, endAddressIntAlloc;
-							str2 >> std::hex >> baseAddressIntAlloc;
-							endAddressIntAlloc = baseAddressIntAlloc + it->second.range - 1;
-
-							if (baseAddressIntAlloc <= addressIntWrite && addressIntWrite <= endAddressIntAlloc) {
-								if (detector.allocIDMap.find(it->first) == detector.allocIDMap.end()) {
-									UAFDetector::allocOpDetails allocdetails;
-									allocdetails.writeOps.insert(opCount);
-									detector.allocIDMap[it->first] = allocdetails;
-								} else {
-									UAFDetector::allocOpDetails existingEntry = detector.allocIDMap[it->first];
-									existingEntry.writeOps.insert(opCount);
-									detector.allocIDMap.erase(detector.allocIDMap.find(it->first));
-									detector.allocIDMap[it->first] = existingEntry;
-								}
-							}
-						}
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+#ifdef SANITYCHECK
+						assert(existingEntry.firstOpID == -1);
+#endif
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-						for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.freeSet.begin(); it != detector.freeSet.end(); it++) {
-							std::stringstream str2;
-							str2 << it->second.startingAddress;
-							IDType baseAddressIntFree, endAddressIntFree;
-							str2 >> std::hex >> baseAddressIntFree;
-							endAddressIntFree = baseAddressIntFree + it->second.range - 1;
-
-							if (baseAddressIntFree <= addressIntWrite && addressIntWrite <= endAddressIntFree) {
-								if (detector.freeIDMap.find(it->first) == detector.freeIDMap.end()) {
-									UAFDetector::freeOpDetails freedetails;
-									freedetails.writeOps.insert(opCount);
-									detector.freeIDMap[it->first] = freedetails;
-								} else {
-									UAFDetector::freeOpDetails existingEntry = detector.freeIDMap[it->first];
-									existingEntry.writeOps.insert(opCount);
-									detector.freeIDMap.erase(detector.freeIDMap.find(it->first));
-									detector.freeIDMap[it->first] = existingEntry;
-								}
-							}
+					stackForThreadOrder.push(stackElement);
+//					stackForTaskOrder.push(stackElement);
+					stackForGlobalLoop.push(stackElement);
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of write, the previous op in thread is not necessarily the previous op in task.
+					MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
+
+					// If the previous op in task stack is the same as the previous op in thread stack, then we are not
+					// in the middle of a nesting loop.
+					bool firstOpInsideNestingLoop;
+					bool firstOpInsideGlobalLoop = false;
+					if (previousOpInThread.opID == -1) {
+						cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
+						return -1;
+					}
+					if (!stackForTaskOrder.isEmpty(threadID)) {
+						if (previousOpInTask.opID != previousOpInThread.opID)
+							firstOpInsideNestingLoop = true;
+						else {
+							// If the previous op in task is a pause, then we are in a new block
+#ifdef PERMIT
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PERMIT_OP)
+#else
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PAUSE_OP)
+#endif
+								firstOpInsideNestingLoop = true;
+							else
+								firstOpInsideNestingLoop = false;
 						}
-
-						UAFDetector::memoryOpDetails memdetails;
-						memdetails.startingAddress = address;
-						if (detector.writeSet.find(opCount) == detector.writeSet.end()) {
-							detector.writeSet[opCount] = memdetails;
-						} else {
-							cout << "ERROR: Found duplicate entry for op " << opCount << " in opIDMap\n";
+					} else {
+						// Task order stack is empty, this means we are not inside a nesting loop
+						firstOpInsideNestingLoop = false;
+
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							// We are inside the global loop.
+							MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
+//							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP)
+							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP
+									|| topOfGlobalLoopStack.opType == EXITLOOP_OP) {
+								if (previousOpInThread.opType == EXITLOOP_OP)
+									firstOpInsideGlobalLoop = false;
+								else
+									firstOpInsideGlobalLoop = true;
+							}
+						} else if (!stackForNestingOrder.isEmpty(threadID)) {
+							cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
+							cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
+								 << "\n";
 							return -1;
 						}
+					}
 
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)){
+					// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
 
 							nodeCount++;
 							opdetails.nodeID = nodeCount;
 							stackElement.nodeID = nodeCount;
 
-							for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.allocSet.begin(); it != detector.allocSet.end(); it++) {
-								std::stringstream str2;
-								str2 << it->second.startingAddress;
-								IDType baseAddressIntAlloc, endAddressIntAlloc;
-								str2 >> std::hex >> baseAddressIntAlloc;
-								endAddressIntAlloc = baseAddressIntAlloc + it->second.range - 1;
-
-								if (baseAddressIntAlloc <= addressIntWrite && addressIntWrite <= endAddressIntAlloc) {
-									if (detector.allocIDMap.find(it->first) == detector.allocIDMap.end()) {
-										UAFDetector::allocOpDetails allocdetails;
-										allocdetails.nodes.insert(nodeCount);
-										detector.allocIDMap[it->first] = allocdetails;
-									} else {
-										UAFDetector::allocOpDetails existingEntry = detector.allocIDMap[it->first];
-										existingEntry.nodes.insert(nodeCount);
-										detector.allocIDMap.erase(detector.allocIDMap.find(it->first));
-										detector.allocIDMap[it->first] = existingEntry;
-									}
-								}
-							}
-
-							for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.freeSet.begin(); it != detector.freeSet.end(); it++) {
-								std::stringstream str2;
-								str2 << it->second.startingAddress;
-								IDType baseAddressIntFree, endAddressIntFree;
-								str2 >> std::hex >> baseAddressIntFree;
-								endAddressIntFree = baseAddressIntFree + it->second.range - 1;
-
-								if (baseAddressIntFree <= addressIntWrite && addressIntWrite <= endAddressIntFree) {
-									if (detector.freeIDMap.find(it->first) == detector.freeIDMap.end()) {
-										UAFDetector::freeOpDetails freedetails;
-										freedetails.nodes.insert(nodeCount);
-										detector.freeIDMap[it->first] = freedetails;
-									} else {
-										UAFDetector::freeOpDetails existingEntry = detector.freeIDMap[it->first];
-										existingEntry.nodes.insert(nodeCount);
-										detector.freeIDMap.erase(detector.freeIDMap.find(it->first));
-										detector.freeIDMap[it->first] = existingEntry;
-									}
-								}
-							}
-
 							if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
 								UAFDetector::setOfOps set;
 								set.opSet.insert(opCount);
@@ -3402,142 +3287,23 @@ it++) {
 								detector.nodeIDMap[nodeCount].printDetails();
 								return -1;
 							}
-
-							cout << "WARNING: No previous op found for write " << opCount
-								 << " on stackForThreadOrder\n";
-
-#ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
-//							assert(stackForBlockOrder.isEmpty(threadID));
-//							assert(stackForNestingOrder.isEmpty(threadID));
-#endif
-
-							// This means this is the first op in the thread
-
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
-#ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
-#endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
-
-							stackForThreadOrder.push(stackElement);
-//							stackForTaskOrder.push(stackElement);
-							stackForGlobalLoop.push(stackElement);
 						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of write, the previous op in thread is not necessarily the previous op in task.
-							MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
-
-							// If the previous op in task stack is the same as the previous op in thread stack, then we are not
-							// in the middle of a nesting loop.
-							bool firstOpInsideNestingLoop;
-							bool firstOpInsideGlobalLoop = false;
-							if (previousOpInThread.opID == -1) {
-								cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
-								return -1;
-							}
-							if (!stackForTaskOrder.isEmpty(threadID)) {
-								if (previousOpInTask.opID != previousOpInThread.opID)
-									firstOpInsideNestingLoop = true;
-								else {
-									// If the previous op in task is a pause, then we are in a new block
-#ifdef PERMIT
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("permit") == 0)
-#else
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("pause") == 0)
-#endif
-										firstOpInsideNestingLoop = true;
-									else
-										firstOpInsideNestingLoop = false;
-								}
-							} else {
-								// Task order stack is empty, this means we are not inside a nesting loop
-								firstOpInsideNestingLoop = false;
+							opdetails.taskID = previousOpInThread.taskID;
+							if (previousOpInThread.opType == ALLOC_OP ||
+									previousOpInThread.opType == FREE_OP ||
+									previousOpInThread.opType == READ_OP ||
+									previousOpInThread.opType == WRITE_OP) {
+								opdetails.nodeID = previousOpInThread.nodeID;
 
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									// We are inside the global loop.
-									MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
-//									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0)
-									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0
-											|| topOfGlobalLoopStack.opType.compare("exitloop") == 0) {
-										if (previousOpInThread.opType.compare("exitloop") == 0)
-											firstOpInsideGlobalLoop = false;
-										else
-											firstOpInsideGlobalLoop = true;
-									}
-								} else if (!stackForNestingOrder.isEmpty(threadID)) {
-									cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
-									cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
-										 << "\n";
-									return -1;
-								}
-							}
+								stackElement.nodeID = previousOpInThread.nodeID;
 
-							// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-
-									nodeCount++;
-									opdetails.nodeID = nodeCount;
-									stackElement.nodeID = nodeCount;
-
-									if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-										UAFDetector::setOfOps set;
-										set.opSet.insert(opCount);
-										detector.nodeIDMap[nodeCount] = set;
-									} else {
-										cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-										cout << "ERROR: Existing entry:\n";
-										detector.nodeIDMap[nodeCount].printDetails();
-										return -1;
-									}
+								if (detector.nodeIDMap.find(previousOpInThread.nodeID) == detector.nodeIDMap.end()) {
+									cout << "ERROR: Cannot find entry for node " << previousOpInThread.nodeID << " in nodeIDMap\n";
+									return -1;
 								} else {
-									opdetails.taskID = previousOpInThread.taskID;
-									if (previousOpInThread.opType.compare("alloc") == 0 ||
-											previousOpInThread.opType.compare("free") == 0 ||
-											previousOpInThread.opType.compare("read") == 0 ||
-											previousOpInThread.opType.compare("write") == 0) {
-										opdetails.nodeID = previousOpInThread.nodeID;
-
-										stackElement.nodeID = previousOpInThread.nodeID;
-
-										if (detector.nodeIDMap.find(previousOpInThread.nodeID) == detector.nodeIDMap.end()) {
-											cout << "ERROR: Cannot find entry for node " << previousOpInThread.nodeID << " in nodeIDMap\n";
-											return -1;
-										} else {
-											UAFDetector::setOfOps existingEntry = detector.nodeIDMap[previousOpInThread.nodeID];
-											existingEntry.opSet.insert(opCount);
-											detector.nodeIDMap.erase(detector.nodeIDMap.find(previousOpInThread.nodeID));
-											detector.nodeIDMap[previousOpInThread.nodeID] = existingEntry;
-										}
-									} else {
-										nodeCount++;
-										opdetails.nodeID = nodeCount;
-										stackElement.nodeID = nodeCount;
-
-										if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-											UAFDetector::setOfOps set;
-											set.opSet.insert(opCount);
-											detector.nodeIDMap[nodeCount] = set;
-										} else {
-											cout << "ERROR: Found duplicate entry for node " << nodeCount << " in nodeIDMap\n";
-											return -1;
-										}
-									}
+									detector.nodeIDMap[previousOpInThread.nodeID].opSet.insert(opCount);
 								}
 							} else {
-								// If this is the first op inside the nesting loop, then we are in a new block
-								opdetails.taskID = previousOpInTask.taskID;
-
 								nodeCount++;
 								opdetails.nodeID = nodeCount;
 								stackElement.nodeID = nodeCount;
@@ -3547,120 +3313,14 @@ it++) {
 									set.opSet.insert(opCount);
 									detector.nodeIDMap[nodeCount] = set;
 								} else {
-									cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-									cout << "ERROR: Existing entry:\n";
-									detector.nodeIDMap[nodeCount].printDetails();
-									return -1;
-								}
-							}
-
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "While examining op " << opCount;
-								cout << endl;
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
-
-#ifdef SANITYCHECK
-								// Sanity check: prev op has same threadID and taskID as current op
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
-#endif
-
-								if (!firstOpInsideNestingLoop) {
-									if (previousOpInThread.taskID.compare("") != 0)
-										existingEntry.nextOpInTask = opCount;
-								}
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
-
-							if (firstOpInsideNestingLoop) {
-								if (detector.opIDMap.find(previousOpInTask.opID) == detector.opIDMap.end()) {
-									cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
-									cout << "ERROR: While examining op " << opCount << "\n";
+									cout << "ERROR: Found duplicate entry for node " << nodeCount << " in nodeIDMap\n";
 									return -1;
-								} else {
-									UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInTask.opID];
-#ifdef SANITYCHECK
-									// Sanity check: prev-op has same thread as current op in stack and opIDMap
-									assert(previousOpInTask.threadID == threadID);
-									assert(existingEntry.threadID == threadID);
-#endif
-									opdetails.taskID = previousOpInTask.taskID;
-									existingEntry.nextOpInTask = opCount;
-									detector.opIDMap.erase(detector.opIDMap.find(previousOpInTask.opID));
-									detector.opIDMap[previousOpInTask.opID] = existingEntry;
-								}
-							}
-
-
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									stackElement.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								stackElement.taskID = previousOpInTask.taskID;
-							}
-
-							stackForThreadOrder.push(stackElement);
-							if (!stackForTaskOrder.isEmpty(threadID))
-								stackForTaskOrder.push(stackElement);
-							else {
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									stackForGlobalLoop.push(stackElement);
-								}
-							}
-							for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.allocSet.begin(); it != detector.allocSet.end(); it++) {
-								std::stringstream str2;
-								str2 << it->second.startingAddress;
-								IDType baseAddressIntAlloc, endAddressIntAlloc;
-								str2 >> std::hex >> baseAddressIntAlloc;
-								endAddressIntAlloc = baseAddressIntAlloc + it->second.range - 1;
-
-								if (baseAddressIntAlloc <= addressIntWrite && addressIntWrite <= endAddressIntAlloc) {
-									if (detector.allocIDMap.find(it->first) == detector.allocIDMap.end()) {
-										UAFDetector::allocOpDetails allocdetails;
-										allocdetails.nodes.insert(opdetails.nodeID);
-										detector.allocIDMap[it->first] = allocdetails;
-									} else {
-										UAFDetector::allocOpDetails existingEntry = detector.allocIDMap[it->first];
-										existingEntry.nodes.insert(opdetails.nodeID);
-										detector.allocIDMap.erase(detector.allocIDMap.find(it->first));
-										detector.allocIDMap[it->first] = existingEntry;
-									}
-								}
-							}
-
-							for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.freeSet.begin(); it != detector.freeSet.end(); it++) {
-								std::stringstream str2;
-								str2 << it->second.startingAddress;
-								IDType baseAddressIntFree, endAddressIntFree;
-								str2 >> std::hex >> baseAddressIntFree;
-								endAddressIntFree = baseAddressIntFree + it->second.range - 1;
-
-								if (baseAddressIntFree <= addressIntWrite && addressIntWrite <= endAddressIntFree) {
-									if (detector.freeIDMap.find(it->first) == detector.freeIDMap.end()) {
-										UAFDetector::freeOpDetails freedetails;
-										freedetails.nodes.insert(opdetails.nodeID);
-										detector.freeIDMap[it->first] = freedetails;
-									} else {
-										UAFDetector::freeOpDetails existingEntry = detector.freeIDMap[it->first];
-										existingEntry.nodes.insert(opdetails.nodeID);
-										detector.freeIDMap.erase(detector.freeIDMap.find(it->first));
-										detector.freeIDMap[it->first] = existingEntry;
-									}
 								}
 							}
 						}
-
-					}
-#ifdef LOCKS
-					else if (match.compare("wait") == 0) {
+					} else {
+						// If this is the first op inside the nesting loop, then we are in a new block
+						opdetails.taskID = previousOpInTask.taskID;
 
 						nodeCount++;
 						opdetails.nodeID = nodeCount;
@@ -3676,733 +3336,759 @@ it++) {
 							detector.nodeIDMap[nodeCount].printDetails();
 							return -1;
 						}
+					}
 
-						// Obtain two arguments of wait
-						IDType threadID;
-						std::string lockID;
-						unsigned j = typePos + 1;
-						for (; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							if (!m1.empty() && m1.compare(" ") != 0){
-								threadID = atoi(m1.c_str());
-								break;
-							}
-						}
-						for (j=j+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							if (!m1.empty() && m1.compare(" ") != 0){
-								lockID = m1;
-								break;
-							}
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "While examining op " << opCount;
+						cout << endl;
+						return -1;
+					} else {
+#ifdef SANITYCHECK
+						// Sanity check: prev op has same threadID and taskID as current op
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
+#endif
+
+						if (!firstOpInsideNestingLoop) {
+							if (previousOpInThread.taskID != NOTASK)
+								detector.opIDMap.nextOpInTask[previousOpInThread.opID] = opCount;
 						}
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
 
-						if (detector.waitSet.find(opCount) == detector.waitSet.end()) {
-							UAFDetector::lockOpDetails waitopdetails;
-							waitopdetails.threadID = threadID;
-							waitopdetails.lockID = lockID;
-							detector.waitSet[opCount] = waitopdetails;
-						} else {
-							cout << "ERROR: Found duplicate entry for op " << opCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.waitSet[opCount].printDetails();
+					if (firstOpInsideNestingLoop) {
+						if (!detector.opIDMap.exists(previousOpInTask.opID)) {
+							cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
+							cout << "ERROR: While examining op " << opCount << "\n";
 							return -1;
+						} else {
+#ifdef SANITYCHECK
+							// Sanity check: prev-op has same thread as current op in stack and opIDMap
+							assert(previousOpInTask.threadID == threadID);
+							assert(detector.opIDMap.threadID[previousOpInTask.opID] == threadID);
+#endif
+							opdetails.taskID = previousOpInTask.taskID;
+							detector.opIDMap.nextOpInTask[previousOpInTask.opID] = opCount;
 						}
+					}
 
-						bool notifyFlag = false, notifyAllFlag = false;
-						IDType notifyOp, notifyAllOp;
-						if (detector.lockToNotify.find(lockID) != detector.lockToNotify.end()) {
-							UAFDetector::setOfOps notifySet = detector.lockToNotify[lockID];
 
-							if (!notifySet.opSet.empty()) {
-								notifyOp = *(notifySet.opSet.rbegin());
-								if (detector.waitToNotify.find(opCount) == detector.waitToNotify.end()) {
-									detector.waitToNotify[opCount] = notifyOp;
-									notifyFlag = true;
-								} else {
-									if (detector.waitToNotify[opCount] < notifyOp) {
-										detector.waitToNotify.erase(detector.waitToNotify.find(opCount));
-										detector.waitToNotify[opCount] = notifyOp;
-										notifyFlag = true;
-									}
-								}
-							}
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
+						} else {
+							stackElement.taskID = previousOpInThread.taskID;
+						}
+					} else {
+						stackElement.taskID = previousOpInTask.taskID;
+					}
+
+					stackForThreadOrder.push(stackElement);
+					if (!stackForTaskOrder.isEmpty(threadID))
+						stackForTaskOrder.push(stackElement);
+					else {
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							stackForGlobalLoop.push(stackElement);
 						}
+					}
+					for (vector<IDType>::iterator it = allocsOfWrite.begin(); it != allocsOfWrite.end(); it++) {
+						detector.allocIDMap[*it].nodes.insert(opdetails.nodeID);
+					}
 
-						if (detector.lockToNotifyAll.find(lockID) != detector.lockToNotifyAll.end()) {
-							UAFDetector::setOfOps notifyAllSet = detector.lockToNotifyAll[lockID];
+					for (vector<IDType>::iterator it = freesOfWrite.begin(); it != freesOfWrite.end(); it++) {
+						detector.freeIDMap[*it].nodes.insert(opdetails.nodeID);
+					}
+				}
 
-							if (!notifyAllSet.opSet.empty()) {
-								notifyAllOp = *(notifyAllSet.opSet.rbegin());
-								if (detector.waitToNotify.find(opCount) == detector.waitToNotify.end()) {
-									detector.waitToNotify[opCount] = notifyAllOp;
-									notifyAllFlag = true;
-								} else {
-									if (detector.waitToNotify[opCount] < notifyAllOp) {
-										detector.waitToNotify.erase(detector.waitToNotify.find(opCount));
-										detector.waitToNotify[opCount] = notifyAllOp;
-										notifyAllFlag = true;
-									}
-								}
+			}
+#ifdef LOCKS
+			else if (token.opType == WAIT_OP) {
+
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
+
+				// Obtain two arguments of wait
+				IDType threadID;
+				std::string lockID;
+				threadID = token.args[0].toInt();
+				lockID = token.args[1].str();
+
+				if (detector.waitSet.find(opCount) == detector.waitSet.end()) {
+					UAFDetector::lockOpDetails waitopdetails;
+					waitopdetails.threadID = threadID;
+					waitopdetails.lockID = lockID;
+					detector.waitSet[opCount] = waitopdetails;
+				} else {
+					cout << "ERROR: Found duplicate entry for op " << opCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.waitSet[opCount].printDetails();
+					return -1;
+				}
+
+				bool notifyFlag = false, notifyAllFlag = false;
+				IDType notifyOp, notifyAllOp;
+				if (detector.lockToNotify.find(lockID) != detector.lockToNotify.end()) {
+					UAFDetector::setOfOps notifySet = detector.lockToNotify[lockID];
+
+					if (!notifySet.opSet.empty()) {
+						notifyOp = *(notifySet.opSet.rbegin());
+						if (detector.waitToNotify.find(opCount) == detector.waitToNotify.end()) {
+							detector.waitToNotify[opCount] = notifyOp;
+							notifyFlag = true;
+						} else {
+							if (detector.waitToNotify[opCount] < notifyOp) {
+								detector.waitToNotify.erase(detector.waitToNotify.find(opCount));
+								detector.waitToNotify[opCount] = notifyOp;
+								notifyFlag = true;
 							}
 						}
+					}
+				}
 
-						if (notifyFlag && !notifyAllFlag) {
-							if (detector.notifyToWait.find(notifyOp) == detector.notifyToWait.end()) {
-								detector.notifyToWait[notifyOp] = opCount;
-							} else {
-								cout << "WARNING: Wait op already set for notify op " << notifyOp << "\n";
-								cout << "WARNING: Existing entry: " << detector.notifyToWait[notifyOp] << "\n";
-								cout << "WARNING: Skipping this op\n";
-								continue;
-//								return -1;
-							}
-						} else if (!notifyFlag && notifyAllFlag) {
-							if (detector.notifyAllToWaitSet.find(notifyAllOp) == detector.notifyAllToWaitSet.end()) {
-								UAFDetector::setOfOps waitset;
-								waitset.opSet.insert(opCount);
-								detector.notifyAllToWaitSet[notifyAllOp] = waitset;
-							} else {
-								UAFDetector::setOfOps existingEntry = detector.notifyAllToWaitSet[notifyAllOp];
-								existingEntry.opSet.insert(opCount);
-								detector.notifyAllToWaitSet.erase(detector.notifyAllToWaitSet.find(notifyAllOp));
-								detector.notifyAllToWaitSet[notifyAllOp] = existingEntry;
+				if (detector.lockToNotifyAll.find(lockID) != detector.lockToNotifyAll.end()) {
+					UAFDetector::setOfOps notifyAllSet = detector.lockToNotifyAll[lockID];
+
+					if (!notifyAllSet.opSet.empty()) {
+						notifyAllOp = *(notifyAllSet.opSet.rbegin());
+						if (detector.waitToNotify.find(opCount) == detector.waitToNotify.end()) {
+							detector.waitToNotify[opCount] = notifyAllOp;
+							notifyAllFlag = true;
+						} else {
+							if (detector.waitToNotify[opCount] < notifyAllOp) {
+								detector.waitToNotify.erase(detector.waitToNotify.find(opCount));
+								detector.waitToNotify[opCount] = notifyAllOp;
+								notifyAllFlag = true;
 							}
 						}
+					}
+				}
+
+				if (notifyFlag && !notifyAllFlag) {
+					if (detector.notifyToWait.find(notifyOp) == detector.notifyToWait.end()) {
+						detector.notifyToWait[notifyOp] = opCount;
+					} else {
+						cout << "WARNING: Wait op already set for notify op " << notifyOp << "\n";
+						cout << "WARNING: Existing entry: " << detector.notifyToWait[notifyOp] << "\n";
+						cout << "WARNING: Skipping this op\n";
+						continue;
+//						return -1;
+					}
+				} else if (!notifyFlag && notifyAllFlag) {
+					if (detector.notifyAllToWaitSet.find(notifyAllOp) == detector.notifyAllToWaitSet.end()) {
+						UAFDetector::setOfOps waitset;
+						waitset.opSet.insert(opCount);
+						detector.notifyAllToWaitSet[notifyAllOp] = waitset;
+					} else {
+						UAFDetector::setOfOps existingEntry = detector.notifyAllToWaitSet[notifyAllOp];
+						existingEntry.opSet.insert(opCount);
+						detector.notifyAllToWaitSet.erase(detector.notifyAllToWaitSet.find(notifyAllOp));
+						detector.notifyAllToWaitSet[notifyAllOp] = existingEntry;
+					}
+				}
 
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)) {
-							cout << "WARNING: No previous op found for wait " << opCount
-								 << " on stackForThreadOrder\n";
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)) {
+					cout << "WARNING: No previous op found for wait " << opCount
+						 << " on stackForThreadOrder\n";
 
 #ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
 #endif
 
-							// This means this is the first op in the thread
+					// This means this is the first op in the thread
 
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
 #ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
+						assert(existingEntry.firstOpID == -1);
 #endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-							stackForThreadOrder.push(stackElement);
-							stackForGlobalLoop.push(stackElement);
-						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of wait, the previous op in thread is not necessarily the previous op in task.
-							MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
-
-							// If the previous op in task stack is the same as the previous op in thread stack, then we are not
-							// in the middle of a nesting loop.
-							bool firstOpInsideNestingLoop;
-							bool firstOpInsideGlobalLoop = false;
-							if (previousOpInThread.opID == -1) {
-								cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
-								return -1;
-							}
-							if (!stackForTaskOrder.isEmpty(threadID)) {
-								if (previousOpInTask.opID != previousOpInThread.opID)
-									firstOpInsideNestingLoop = true;
-								else {
-									// If the previous op in task is a pause, then we are in a new block
+					stackForThreadOrder.push(stackElement);
+					stackForGlobalLoop.push(stackElement);
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of wait, the previous op in thread is not necessarily the previous op in task.
+					MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
+
+					// If the previous op in task stack is the same as the previous op in thread stack, then we are not
+					// in the middle of a nesting loop.
+					bool firstOpInsideNestingLoop;
+					bool firstOpInsideGlobalLoop = false;
+					if (previousOpInThread.opID == -1) {
+						cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
+						return -1;
+					}
+					if (!stackForTaskOrder.isEmpty(threadID)) {
+						if (previousOpInTask.opID != previousOpInThread.opID)
+							firstOpInsideNestingLoop = true;
+						else {
+							// If the previous op in task is a pause, then we are in a new block
 #ifdef PERMIT
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("permit") == 0)
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PERMIT_OP)
 #else
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("pause") == 0)
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PAUSE_OP)
 #endif
-										firstOpInsideNestingLoop = true;
-									else
-										firstOpInsideNestingLoop = false;
-								}
-							} else {
-								// Task order stack is empty, this means we are not inside a nesting loop
+								firstOpInsideNestingLoop = true;
+							else
 								firstOpInsideNestingLoop = false;
+						}
+					} else {
+						// Task order stack is empty, this means we are not inside a nesting loop
+						firstOpInsideNestingLoop = false;
+
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							// We are inside the global loop.
+							MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
+//							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP)
+							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP
+									|| topOfGlobalLoopStack.opType == EXITLOOP_OP) {
+								if (previousOpInThread.opType == EXITLOOP_OP)
+									firstOpInsideGlobalLoop = false;
+								else
+									firstOpInsideGlobalLoop = true;
+							}
+						} else if (!stackForNestingOrder.isEmpty(threadID)) {
+							cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
+							cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
+								 << "\n";
+							return -1;
+						}
+					}
 
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									// We are inside the global loop.
-									MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
-//									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0)
-									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0
-											|| topOfGlobalLoopStack.opType.compare("exitloop") == 0) {
-										if (previousOpInThread.opType.compare("exitloop") == 0)
-											firstOpInsideGlobalLoop = false;
-										else
-											firstOpInsideGlobalLoop = true;
-									}
-								} else if (!stackForNestingOrder.isEmpty(threadID)) {
-									cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
-									cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
-										 << "\n";
-									return -1;
-								}
-							}
-
-							// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									opdetails.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								// If this is the first op inside the nesting loop, then we are in a new block
-								opdetails.taskID = previousOpInTask.taskID;
-							}
-
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "While examining op " << opCount;
-								cout << endl;
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+					// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
+						} else {
+							opdetails.taskID = previousOpInThread.taskID;
+						}
+					} else {
+						// If this is the first op inside the nesting loop, then we are in a new block
+						opdetails.taskID = previousOpInTask.taskID;
+					}
 
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "While examining op " << opCount;
+						cout << endl;
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-								// Sanity check: prev op has same threadID and taskID as current op
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
+						// Sanity check: prev op has same threadID and taskID as current op
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
 
-								if (!firstOpInsideNestingLoop) {
-									if (previousOpInThread.taskID.compare("") != 0)
-										existingEntry.nextOpInTask = opCount;
-								}
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+						if (!firstOpInsideNestingLoop) {
+							if (previousOpInThread.taskID != NOTASK)
+								detector.opIDMap.nextOpInTask[previousOpInThread.opID] = opCount;
+						}
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
 
-							if (firstOpInsideNestingLoop) {
-								if (detector.opIDMap.find(previousOpInTask.opID) == detector.opIDMap.end()) {
-									cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
-									cout << "ERROR: While examining op " << opCount << "\n";
-									return -1;
-								} else {
-									UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInTask.opID];
+					if (firstOpInsideNestingLoop) {
+						if (!detector.opIDMap.exists(previousOpInTask.opID)) {
+							cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
+							cout << "ERROR: While examining op " << opCount << "\n";
+							return -1;
+						} else {
 #ifdef SANITYCHECK
-									// Sanity check: prev-op has same thread as current op in stack and opIDMap
-									assert(previousOpInTask.threadID == threadID);
-									assert(existingEntry.threadID == threadID);
+							// Sanity check: prev-op has same thread as current op in stack and opIDMap
+							assert(previousOpInTask.threadID == threadID);
+							assert(detector.opIDMap.threadID[previousOpInTask.opID] == threadID);
 #endif
-									opdetails.taskID = previousOpInTask.taskID;
-									existingEntry.nextOpInTask = opCount;
-									detector.opIDMap.erase(detector.opIDMap.find(previousOpInTask.opID));
-									detector.opIDMap[previousOpInTask.opID] = existingEntry;
-								}
-							}
-
-
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									stackElement.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								stackElement.taskID = previousOpInTask.taskID;
-							}
-
-							stackForThreadOrder.push(stackElement);
-							if (!stackForTaskOrder.isEmpty(threadID))
-								stackForTaskOrder.push(stackElement);
-							else {
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									stackForGlobalLoop.push(stackElement);
-								}
-							}
+							opdetails.taskID = previousOpInTask.taskID;
+							detector.opIDMap.nextOpInTask[previousOpInTask.opID] = opCount;
 						}
-					} else if (match.compare("notify") == 0) {
+					}
 
-						nodeCount++;
-						opdetails.nodeID = nodeCount;
-						stackElement.nodeID = nodeCount;
 
-						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-							UAFDetector::setOfOps set;
-							set.opSet.insert(opCount);
-							detector.nodeIDMap[nodeCount] = set;
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
 						} else {
-							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.nodeIDMap[nodeCount].printDetails();
-							return -1;
+							stackElement.taskID = previousOpInThread.taskID;
 						}
+					} else {
+						stackElement.taskID = previousOpInTask.taskID;
+					}
 
-						// Obtain two arguments of notify
-						IDType threadID;
-						std::string lockID;
-						unsigned j = typePos + 1;
-						for (; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							if (!m1.empty() && m1.compare(" ") != 0){
-								threadID = atoi(m1.c_str());
-								break;
-							}
-						}
-						for (j=j+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							if (!m1.empty() && m1.compare(" ") != 0){
-								lockID = m1;
-								break;
-							}
+					stackForThreadOrder.push(stackElement);
+					if (!stackForTaskOrder.isEmpty(threadID))
+						stackForTaskOrder.push(stackElement);
+					else {
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							stackForGlobalLoop.push(stackElement);
 						}
+					}
+				}
+			} else if (token.opType == NOTIFY_OP) {
+
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
 
-						if (detector.notifySet.find(opCount) == detector.notifySet.end()) {
-							UAFDetector::lockOpDetails notifyopdetails;
-							notifyopdetails.threadID = threadID;
-							notifyopdetails.lockID = lockID;
-							detector.notifySet[opCount] = notifyopdetails;
-						} else {
-							cout << "ERROR: Found duplicate entry for op " << opCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.notifySet[opCount].printDetails();
-							return -1;
-						}
+				// Obtain two arguments of notify
+				IDType threadID;
+				std::string lockID;
+				threadID = token.args[0].toInt();
+				lockID = token.args[1].str();
+
+				if (detector.notifySet.find(opCount) == detector.notifySet.end()) {
+					UAFDetector::lockOpDetails notifyopdetails;
+					notifyopdetails.threadID = threadID;
+					notifyopdetails.lockID = lockID;
+					detector.notifySet[opCount] = notifyopdetails;
+				} else {
+					cout << "ERROR: Found duplicate entry for op " << opCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.notifySet[opCount].printDetails();
+					return -1;
+				}
 
-						if (detector.lockToNotify.find(lockID) != detector.lockToNotify.end()) {
-							UAFDetector::setOfOps notifyOps = detector.lockToNotify[lockID];
-							notifyOps.opSet.insert(opCount);
-							detector.lockToNotify.erase(detector.lockToNotify.find(lockID));
-							detector.lockToNotify[lockID] = notifyOps;
-						} else {
-							UAFDetector::setOfOps notifyOps;
-							notifyOps.opSet.insert(opCount);
-							detector.lockToNotify[lockID] = notifyOps;
-						}
+				if (detector.lockToNotify.find(lockID) != detector.lockToNotify.end()) {
+					UAFDetector::setOfOps notifyOps = detector.lockToNotify[lockID];
+					notifyOps.opSet.insert(opCount);
+					detector.lockToNotify.erase(detector.lockToNotify.find(lockID));
+					detector.lockToNotify[lockID] = notifyOps;
+				} else {
+					UAFDetector::setOfOps notifyOps;
+					notifyOps.opSet.insert(opCount);
+					detector.lockToNotify[lockID] = notifyOps;
+				}
 
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)) {
-							cout << "WARNING: No previous op found for wait " << opCount
-								 << " on stackForThreadOrder\n";
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)) {
+					cout << "WARNING: No previous op found for wait " << opCount
+						 << " on stackForThreadOrder\n";
 
 #ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
 #endif
 
-							// This means this is the first op in the thread
+					// This means this is the first op in the thread
 
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
 #ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
+						assert(existingEntry.firstOpID == -1);
 #endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
 
-							stackForThreadOrder.push(stackElement);
-							stackForGlobalLoop.push(stackElement);
-						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of wait, the previous op in thread is not necessarily the previous op in task.
-							MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
-
-							// If the previous op in task stack is the same as the previous op in thread stack, then we are not
-							// in the middle of a nesting loop.
-							bool firstOpInsideNestingLoop;
-							bool firstOpInsideGlobalLoop = false;
-							if (previousOpInThread.opID == -1) {
-								cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
-								return -1;
-							}
-							if (!stackForTaskOrder.isEmpty(threadID)) {
-								if (previousOpInTask.opID != previousOpInThread.opID)
-									firstOpInsideNestingLoop = true;
-								else {
-									// If the previous op in task is a pause, then we are in a new block
+					stackForThreadOrder.push(stackElement);
+					stackForGlobalLoop.push(stackElement);
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of wait, the previous op in thread is not necessarily the previous op in task.
+					MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
+
+					// If the previous op in task stack is the same as the previous op in thread stack, then we are not
+					// in the middle of a nesting loop.
+					bool firstOpInsideNestingLoop;
+					bool firstOpInsideGlobalLoop = false;
+					if (previousOpInThread.opID == -1) {
+						cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
+						return -1;
+					}
+					if (!stackForTaskOrder.isEmpty(threadID)) {
+						if (previousOpInTask.opID != previousOpInThread.opID)
+							firstOpInsideNestingLoop = true;
+						else {
+							// If the previous op in task is a pause, then we are in a new block
 #ifdef PERMIT
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("permit") == 0)
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PERMIT_OP)
 #else
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("pause") == 0)
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PAUSE_OP)
 #endif
-										firstOpInsideNestingLoop = true;
-									else
-										firstOpInsideNestingLoop = false;
-								}
-							} else {
-								// Task order stack is empty, this means we are not inside a nesting loop
+								firstOpInsideNestingLoop = true;
+							else
 								firstOpInsideNestingLoop = false;
+						}
+					} else {
+						// Task order stack is empty, this means we are not inside a nesting loop
+						firstOpInsideNestingLoop = false;
+
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							// We are inside the global loop.
+							MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
+//							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP)
+							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP
+									|| topOfGlobalLoopStack.opType == EXITLOOP_OP) {
+								if (previousOpInThread.opType == EXITLOOP_OP)
+									firstOpInsideGlobalLoop = false;
+								else
+									firstOpInsideGlobalLoop = true;
+							}
+						} else if (!stackForNestingOrder.isEmpty(threadID)) {
+							cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
+							cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
+								 << "\n";
+							return -1;
+						}
+					}
 
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									// We are inside the global loop.
-									MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
-//									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0)
-									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0
-											|| topOfGlobalLoopStack.opType.compare("exitloop") == 0) {
-										if (previousOpInThread.opType.compare("exitloop") == 0)
-											firstOpInsideGlobalLoop = false;
-										else
-											firstOpInsideGlobalLoop = true;
-									}
-								} else if (!stackForNestingOrder.isEmpty(threadID)) {
-									cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
-									cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
-										 << "\n";
-									return -1;
-								}
-							}
-
-							// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									opdetails.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								// If this is the first op inside the nesting loop, then we are in a new block
-								opdetails.taskID = previousOpInTask.taskID;
-							}
-
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "While examining op " << opCount;
-								cout << endl;
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+					// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
+						} else {
+							opdetails.taskID = previousOpInThread.taskID;
+						}
+					} else {
+						// If this is the first op inside the nesting loop, then we are in a new block
+						opdetails.taskID = previousOpInTask.taskID;
+					}
 
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "While examining op " << opCount;
+						cout << endl;
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-								// Sanity check: prev op has same threadID and taskID as current op
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
+						// Sanity check: prev op has same threadID and taskID as current op
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
 
-								if (!firstOpInsideNestingLoop) {
-									if (previousOpInThread.taskID.compare("") != 0)
-										existingEntry.nextOpInTask = opCount;
-								}
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+						if (!firstOpInsideNestingLoop) {
+							if (previousOpInThread.taskID != NOTASK)
+								detector.opIDMap.nextOpInTask[previousOpInThread.opID] = opCount;
+						}
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
 
-							if (firstOpInsideNestingLoop) {
-								if (detector.opIDMap.find(previousOpInTask.opID) == detector.opIDMap.end()) {
-									cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
-									cout << "ERROR: While examining op " << opCount << "\n";
-									return -1;
-								} else {
-									UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInTask.opID];
+					if (firstOpInsideNestingLoop) {
+						if (!detector.opIDMap.exists(previousOpInTask.opID)) {
+							cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
+							cout << "ERROR: While examining op " << opCount << "\n";
+							return -1;
+						} else {
 #ifdef SANITYCHECK
-									// Sanity check: prev-op has same thread as current op in stack and opIDMap
-									assert(previousOpInTask.threadID == threadID);
-									assert(existingEntry.threadID == threadID);
+							// Sanity check: prev-op has same thread as current op in stack and opIDMap
+							assert(previousOpInTask.threadID == threadID);
+							assert(detector.opIDMap.threadID[previousOpInTask.opID] == threadID);
 #endif
-									opdetails.taskID = previousOpInTask.taskID;
-									existingEntry.nextOpInTask = opCount;
-									detector.opIDMap.erase(detector.opIDMap.find(previousOpInTask.opID));
-									detector.opIDMap[previousOpInTask.opID] = existingEntry;
-								}
-							}
-
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									stackElement.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								stackElement.taskID = previousOpInTask.taskID;
-							}
-
-							stackForThreadOrder.push(stackElement);
-							if (!stackForTaskOrder.isEmpty(threadID))
-								stackForTaskOrder.push(stackElement);
-							else {
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									stackForGlobalLoop.push(stackElement);
-								}
-							}
+							opdetails.taskID = previousOpInTask.taskID;
+							detector.opIDMap.nextOpInTask[previousOpInTask.opID] = opCount;
 						}
-					} else if (match.compare("notifyall") == 0) {
-
-						nodeCount++;
-						opdetails.nodeID = nodeCount;
-						stackElement.nodeID = nodeCount;
+					}
 
-						if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
-							UAFDetector::setOfOps set;
-							set.opSet.insert(opCount);
-							detector.nodeIDMap[nodeCount] = set;
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
 						} else {
-							cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.nodeIDMap[nodeCount].printDetails();
-							return -1;
+							stackElement.taskID = previousOpInThread.taskID;
 						}
+					} else {
+						stackElement.taskID = previousOpInTask.taskID;
+					}
 
-						// Obtain two arguments of notifyall
-						IDType threadID;
-						std::string lockID;
-						unsigned j = typePos + 1;
-						for (; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							if (!m1.empty() && m1.compare(" ") != 0){
-								threadID = atoi(m1.c_str());
-								break;
-							}
-						}
-						for (j=j+1; j < matches.size(); j++) {
-							string m1(matches[j].first, matches[j].second);
-							if (!m1.empty() && m1.compare(" ") != 0){
-								lockID = m1;
-								break;
-							}
+					stackForThreadOrder.push(stackElement);
+					if (!stackForTaskOrder.isEmpty(threadID))
+						stackForTaskOrder.push(stackElement);
+					else {
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							stackForGlobalLoop.push(stackElement);
 						}
+					}
+				}
+			} else if (token.opType == NOTIFYALL_OP) {
+
+				nodeCount++;
+				opdetails.nodeID = nodeCount;
+				stackElement.nodeID = nodeCount;
+
+				if (detector.nodeIDMap.find(nodeCount) == detector.nodeIDMap.end()) {
+					UAFDetector::setOfOps set;
+					set.opSet.insert(opCount);
+					detector.nodeIDMap[nodeCount] = set;
+				} else {
+					cout << "ERROR: Found duplicate entry for node " << nodeCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.nodeIDMap[nodeCount].printDetails();
+					return -1;
+				}
 
-						if (detector.notifyAllSet.find(opCount) == detector.notifyAllSet.end()) {
-							UAFDetector::lockOpDetails notifyallopdetails;
-							notifyallopdetails.threadID = threadID;
-							notifyallopdetails.lockID = lockID;
-							detector.notifySet[opCount] = notifyallopdetails;
-						} else {
-							cout << "ERROR: Found duplicate entry for op " << opCount << "\n";
-							cout << "ERROR: Existing entry:\n";
-							detector.notifyAllSet[opCount].printDetails();
-							return -1;
-						}
+				// Obtain two arguments of notifyall
+				IDType threadID;
+				std::string lockID;
+				threadID = token.args[0].toInt();
+				lockID = token.args[1].str();
+
+				if (detector.notifyAllSet.find(opCount) == detector.notifyAllSet.end()) {
+					UAFDetector::lockOpDetails notifyallopdetails;
+					notifyallopdetails.threadID = threadID;
+					notifyallopdetails.lockID = lockID;
+					detector.notifySet[opCount] = notifyallopdetails;
+				} else {
+					cout << "ERROR: Found duplicate entry for op " << opCount << "\n";
+					cout << "ERROR: Existing entry:\n";
+					detector.notifyAllSet[opCount].printDetails();
+					return -1;
+				}
 
-						if (detector.lockToNotifyAll.find(lockID) != detector.lockToNotifyAll.end()) {
-							UAFDetector::setOfOps notifyAllOps = detector.lockToNotifyAll[lockID];
-							notifyAllOps.opSet.insert(opCount);
-							detector.lockToNotifyAll.erase(detector.lockToNotifyAll.find(lockID));
-							detector.lockToNotifyAll[lockID] = notifyAllOps;
-						} else {
-							UAFDetector::setOfOps notifyAllOps;
-							notifyAllOps.opSet.insert(opCount);
-							detector.lockToNotifyAll[lockID] = notifyAllOps;
-						}
+				if (detector.lockToNotifyAll.find(lockID) != detector.lockToNotifyAll.end()) {
+					UAFDetector::setOfOps notifyAllOps = detector.lockToNotifyAll[lockID];
+					notifyAllOps.opSet.insert(opCount);
+					detector.lockToNotifyAll.erase(detector.lockToNotifyAll.find(lockID));
+					detector.lockToNotifyAll[lockID] = notifyAllOps;
+				} else {
+					UAFDetector::setOfOps notifyAllOps;
+					notifyAllOps.opSet.insert(opCount);
+					detector.lockToNotifyAll[lockID] = notifyAllOps;
+				}
 
-						// Obtain the stack top to obtain the previous op in thread.
-						if (stackForThreadOrder.isEmpty(threadID)) {
-							cout << "WARNING: No previous op found for wait " << opCount
-								 << " on stackForThreadOrder\n";
+				// Obtain the stack top to obtain the previous op in thread.
+				if (stackForThreadOrder.isEmpty(threadID)) {
+					cout << "WARNING: No previous op found for wait " << opCount
+						 << " on stackForThreadOrder\n";
 
 #ifdef SANITYCHECK
-							// Sanity check: all stacks need to be empty if this is the first op
-							assert(stackForTaskOrder.isEmpty(threadID));
+					// Sanity check: all stacks need to be empty if this is the first op
+					assert(stackForTaskOrder.isEmpty(threadID));
 #endif
 
-							// This means this is the first op in the thread
+					// This means this is the first op in the thread
 
-							if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
-								UAFDetector::threadDetails threaddetails;
-								threaddetails.firstOpID = opCount;
-								detector.threadIDMap[threadID] = threaddetails;
-							} else {
-								UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
+					if (detector.threadIDMap.find(threadID) == detector.threadIDMap.end()) {
+						UAFDetector::threadDetails threaddetails;
+						threaddetails.firstOpID = opCount;
+						detector.threadIDMap[threadID] = threaddetails;
+					} else {
+						UAFDetector::threadDetails existingEntry = detector.threadIDMap[threadID];
 #ifdef SANITYCHECK
-								assert(existingEntry.firstOpID == -1);
+						assert(existingEntry.firstOpID == -1);
 #endif
-								existingEntry.firstOpID = opCount;
-								detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
-								detector.threadIDMap[threadID] = existingEntry;
-							}
+						existingEntry.firstOpID = opCount;
+						detector.threadIDMap.erase(detector.threadIDMap.find(threadID));
+						detector.threadIDMap[threadID] = existingEntry;
+					}
 
-							stackForThreadOrder.push(stackElement);
-							stackForGlobalLoop.push(stackElement);
-						} else {
-							MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
-							// In the case of wait, the previous op in thread is not necessarily the previous op in task.
-							MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
-
-							// If the previous op in task stack is the same as the previous op in thread stack, then we are not
-							// in the middle of a nesting loop.
-							bool firstOpInsideNestingLoop;
-							bool firstOpInsideGlobalLoop = false;
-							if (previousOpInThread.opID == -1) {
-								cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
-								return -1;
-							}
-							if (!stackForTaskOrder.isEmpty(threadID)) {
-								if (previousOpInTask.opID != previousOpInThread.opID)
-									firstOpInsideNestingLoop = true;
-								else {
-									// If the previous op in task is a pause, then we are in a new block
+					stackForThreadOrder.push(stackElement);
+					stackForGlobalLoop.push(stackElement);
+				} else {
+					MultiStack::stackElementType previousOpInThread = stackForThreadOrder.peek(threadID);
+					// In the case of wait, the previous op in thread is not necessarily the previous op in task.
+					MultiStack::stackElementType previousOpInTask = stackForTaskOrder.peek(threadID);
+
+					// If the previous op in task stack is the same as the previous op in thread stack, then we are not
+					// in the middle of a nesting loop.
+					bool firstOpInsideNestingLoop;
+					bool firstOpInsideGlobalLoop = false;
+					if (previousOpInThread.opID == -1) {
+						cout << "ERROR: ThreadOrder stack is not empty, but a peek operation returns invalid element\n";
+						return -1;
+					}
+					if (!stackForTaskOrder.isEmpty(threadID)) {
+						if (previousOpInTask.opID != previousOpInThread.opID)
+							firstOpInsideNestingLoop = true;
+						else {
+							// If the previous op in task is a pause, then we are in a new block
 #ifdef PERMIT
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("permit") == 0)
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PERMIT_OP)
 #else
-									if (detector.opIDMap[previousOpInTask.opID].opType.compare("pause") == 0)
+							if (detector.opIDMap.opType[previousOpInTask.opID] == PAUSE_OP)
 #endif
-										firstOpInsideNestingLoop = true;
-									else
-										firstOpInsideNestingLoop = false;
-								}
-							} else {
-								// Task order stack is empty, this means we are not inside a nesting loop
+								firstOpInsideNestingLoop = true;
+							else
 								firstOpInsideNestingLoop = false;
+						}
+					} else {
+						// Task order stack is empty, this means we are not inside a nesting loop
+						firstOpInsideNestingLoop = false;
+
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							// We are inside the global loop.
+							MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
+//							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP)
+							if (topOfGlobalLoopStack.opType == ENTERLOOP_OP
+									|| topOfGlobalLoopStack.opType == EXITLOOP_OP) {
+								if (previousOpInThread.opType == EXITLOOP_OP)
+									firstOpInsideGlobalLoop = false;
+								else
+									firstOpInsideGlobalLoop = true;
+							}
+						} else if (!stackForNestingOrder.isEmpty(threadID)) {
+							cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
+							cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
+								 << "\n";
+							return -1;
+						}
+					}
 
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									// We are inside the global loop.
-									MultiStack::stackElementType topOfGlobalLoopStack = stackForGlobalLoop.peek(threadID);
-//									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0)
-									if (topOfGlobalLoopStack.opType.compare("enterloop") == 0
-											|| topOfGlobalLoopStack.opType.compare("exitloop") == 0) {
-										if (previousOpInThread.opType.compare("exitloop") == 0)
-											firstOpInsideGlobalLoop = false;
-										else
-											firstOpInsideGlobalLoop = true;
-									}
-								} else if (!stackForNestingOrder.isEmpty(threadID)) {
-									cout << "ERROR: TaskOrder stack is empty but NestingOrder stack is not: for thread " << threadID << "\n";
-									cout << "ERROR: Top element in NestingOrder stack: " << stackForNestingOrder.peek(threadID).opID
-										 << "\n";
-									return -1;
-								}
-							}
-
-							// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									opdetails.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								// If this is the first op inside the nesting loop, then we are in a new block
-								opdetails.taskID = previousOpInTask.taskID;
-							}
-
-							if (detector.opIDMap.find(previousOpInThread.opID) == detector.opIDMap.end()) {
-								cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
-								cout << "While examining op " << opCount;
-								cout << endl;
-								return -1;
-							} else {
-								UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInThread.opID];
+					// previous-op-in-thread need not be the previous-op-in-task or the previous-op-in-block
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
+						} else {
+							opdetails.taskID = previousOpInThread.taskID;
+						}
+					} else {
+						// If this is the first op inside the nesting loop, then we are in a new block
+						opdetails.taskID = previousOpInTask.taskID;
+					}
 
+					if (!detector.opIDMap.exists(previousOpInThread.opID)) {
+						cout << "ERROR: Cannot find entry for op " << previousOpInThread.opID << " in opIDMap\n";
+						cout << "While examining op " << opCount;
+						cout << endl;
+						return -1;
+					} else {
 #ifdef SANITYCHECK
-								// Sanity check: prev op has same threadID and taskID as current op
-								assert(previousOpInThread.threadID == threadID);
-								assert(existingEntry.threadID == threadID);
+						// Sanity check: prev op has same threadID and taskID as current op
+						assert(previousOpInThread.threadID == threadID);
+						assert(detector.opIDMap.threadID[previousOpInThread.opID] == threadID);
 #endif
 
-								if (!firstOpInsideNestingLoop) {
-									if (previousOpInThread.taskID.compare("") != 0)
-										existingEntry.nextOpInTask = opCount;
-								}
-								existingEntry.nextOpInThread = opCount;
-								opdetails.prevOpInThread = previousOpInThread.opID;
-								detector.opIDMap.erase(detector.opIDMap.find(previousOpInThread.opID));
-								detector.opIDMap[previousOpInThread.opID] = existingEntry;
-							}
+						if (!firstOpInsideNestingLoop) {
+							if (previousOpInThread.taskID != NOTASK)
+								detector.opIDMap.nextOpInTask[previousOpInThread.opID] = opCount;
+						}
+						detector.opIDMap.nextOpInThread[previousOpInThread.opID] = opCount;
+						opdetails.prevOpInThread = previousOpInThread.opID;
+					}
 
-							if (firstOpInsideNestingLoop) {
-								if (detector.opIDMap.find(previousOpInTask.opID) == detector.opIDMap.end()) {
-									cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
-									cout << "ERROR: While examining op " << opCount << "\n";
-									return -1;
-								} else {
-									UAFDetector::opDetails existingEntry = detector.opIDMap[previousOpInTask.opID];
+					if (firstOpInsideNestingLoop) {
+						if (!detector.opIDMap.exists(previousOpInTask.opID)) {
+							cout << "ERROR: Cannot find entry for op " << previousOpInTask.opID << " in opIDMap\n";
+							cout << "ERROR: While examining op " << opCount << "\n";
+							return -1;
+						} else {
 #ifdef SANITYCHECK
-									// Sanity check: prev-op has same thread as current op in stack and opIDMap
-									assert(previousOpInTask.threadID == threadID);
-									assert(existingEntry.threadID == threadID);
+							// Sanity check: prev-op has same thread as current op in stack and opIDMap
+							assert(previousOpInTask.threadID == threadID);
+							assert(detector.opIDMap.threadID[previousOpInTask.opID] == threadID);
 #endif
-									opdetails.taskID = previousOpInTask.taskID;
-									existingEntry.nextOpInTask = opCount;
-									detector.opIDMap.erase(detector.opIDMap.find(previousOpInTask.opID));
-									detector.opIDMap[previousOpInTask.opID] = existingEntry;
-								}
-							}
-
+							opdetails.taskID = previousOpInTask.taskID;
+							detector.opIDMap.nextOpInTask[previousOpInTask.opID] = opCount;
+						}
+					}
 
 
 
-							if (!firstOpInsideNestingLoop) {
-								if (firstOpInsideGlobalLoop) {
-								} else {
-									stackElement.taskID = previousOpInThread.taskID;
-								}
-							} else {
-								stackElement.taskID = previousOpInTask.taskID;
-							}
 
-							stackForThreadOrder.push(stackElement);
-							if (!stackForTaskOrder.isEmpty(threadID))
-								stackForTaskOrder.push(stackElement);
-							else {
-								if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
-									stackForGlobalLoop.push(stackElement);
-								}
-							}
+					if (!firstOpInsideNestingLoop) {
+						if (firstOpInsideGlobalLoop) {
+						} else {
+							stackElement.taskID = previousOpInThread.taskID;
 						}
+					} else {
+						stackElement.taskID = previousOpInTask.taskID;
 					}
-#endif
 
-					if (detector.opIDMap.find(opCount) == detector.opIDMap.end()) {
-						detector.opIDMap[opCount] = opdetails;
-					} else {
-						cout << "ERROR: Found duplicate entry for " << opCount << " in opIDMap\n";
-						cout << "While examining " << OpString << "\n";
-						cout << "Duplicate entry:\n";
-						detector.opIDMap[opCount].printOpDetails();
-						cout << endl;
-						return -1;
+					stackForThreadOrder.push(stackElement);
+					if (!stackForTaskOrder.isEmpty(threadID))
+						stackForTaskOrder.push(stackElement);
+					else {
+						if (stackForNestingOrder.isEmpty(threadID) && !stackForGlobalLoop.isEmpty(threadID)) {
+							stackForGlobalLoop.push(stackElement);
+						}
 					}
-					break;
 				}
 			}
+#endif
+
+			if (!detector.opIDMap.exists(opCount)) {
+				detector.opIDMap.insert(opCount, opdetails);
+			} else {
+				cout << "ERROR: Found duplicate entry for " << opCount << " in opIDMap\n";
+				cout << "While examining " << currentOp(token) << "\n";
+				cout << "Duplicate entry:\n";
+				detector.opIDMap.printOpDetails(opCount, detector.taskNames);
+				cout << endl;
+				return -1;
+			}
 		}
 	}
+	if (readFailed()) {
+		cout << "ERROR: Cannot read the trace to the end\n";
+		return -1;
+	}
+
+	// All task names have been seen. Make room for every task in taskIDMap,
+	// so that entries added by the detector do not move the existing ones.
+	detector.taskIDMap.reserve(detector.taskNames.size());
 
 	for (map<IDType, UAFDetector::threadDetails>::iterator it = detector.threadIDMap.begin(); it != detector.threadIDMap.end(); it++) {
 		if (!stackForThreadOrder.isEmpty(it->first)) {
 			MultiStack::stackElementType lastOp = stackForThreadOrder.peek(it->first);
 			it->second.lastOpInThreadID = lastOp.opID;
 
-			if (lastOp.taskID.compare("") == 0) continue;
+			if (lastOp.taskID == NOTASK) continue;
 
 			if (detector.taskIDMap.find(lastOp.taskID) == detector.taskIDMap.end()) {
-				cout << "ERROR: Cannot find entry for task " << lastOp.taskID << " in taskIDMap\n";
+				cout << "ERROR: Cannot find entry for task " << detector.taskNames.name(lastOp.taskID) << " in taskIDMap\n";
 				return -1;
 			} else {
-				UAFDetector::taskDetails existingEntry = detector.taskIDMap[lastOp.taskID];
+				UAFDetector::taskDetails& existingEntry = detector.taskIDMap[lastOp.taskID];
 				if (!stackForTaskOrder.isEmpty(it->first)) {
 					MultiStack::stackElementType lastConcurrencyOpInTask = stackForTaskOrder.peek(it->first);
 #ifdef PERMIT
-					if (lastConcurrencyOpInTask.opType.compare("revoke") == 0) {
+					if (lastConcurrencyOpInTask.opType == REVOKE_OP) {
 #else
-					if (lastConcurrencyOpInTask.opType.compare("resume") == 0) {
+					if (lastConcurrencyOpInTask.opType == RESUME_OP) {
 #endif
 						if (existingEntry.lastResumeOpID == -1)
 							existingEntry.lastResumeOpID = lastConcurrencyOpInTask.opID;
 					}
 				}
-				detector.taskIDMap.erase(detector.taskIDMap.find(lastOp.taskID));
-				detector.taskIDMap[lastOp.taskID] = existingEntry;
 			}
 		}
 	}
 
-	for (std::map<std::string, UAFDetector::taskDetails>::iterator taskIt = detector.taskIDMap.begin();
+	for (UAFDetector::taskMap::iterator taskIt = detector.taskIDMap.begin();
 			taskIt != detector.taskIDMap.end(); taskIt++) {
 		if (taskIt->second.endOpID != -1) continue;
 		if (taskIt->second.lastResumeOpID != -1) continue;
 
 		if (taskIt->second.deqOpID == -1) continue;
-		IDType threadID = detector.opIDMap[taskIt->second.deqOpID].threadID;
+		IDType threadID = detector.opIDMap.threadID[taskIt->second.deqOpID];
 		MultiStack::stackElementType lastOpInTask = stackForNestingOrder.pop(threadID, taskIt->first);
 		if (!stackForNestingOrder.isBottom(lastOpInTask)) {
 #ifdef PERMIT
-			if (lastOpInTask.opType.compare("revoke") == 0)
+			if (lastOpInTask.opType == REVOKE_OP)
 #else
-			if (lastOpInTask.opType.compare("resume") == 0)
+			if (lastOpInTask.opType == RESUME_OP)
 #endif
 				taskIt->second.lastResumeOpID = lastOpInTask.opID;
 		}
@@ -4413,15 +4099,51 @@ it++) {
 
 	cout << "Finished parsing the file\n";
 
-#ifdef TRACEDEBUG
-	cout << "No of ops: " << opCount << "\n";
-	cout << "No of tasks: " << detector.taskIDMap.size() << "\n";
+	if (Diagnostics::enabled(DIAG_PARSE, DIAG_SUMMARY))
+		printStatistics(detector);
+
+#ifndef RUNOVERNODELIMIT
+	if (detector.nodeIDMap.size() > NODELIMIT)
+		return -2;
+#endif
+
+	Logger opTaskLogger;
+	opTaskLogger.init(outputPrefix + ".tasks");
+	for (IDType op = 1; op <= detector.opIDMap.maxOpID(); op++) {
+		if (!detector.opIDMap.exists(op))
+			continue;
+		opTaskLogger.streamObject << op << ":" << detector.taskNames.name(detector.opIDMap.taskID[op]) << "\n";
+		opTaskLogger.writeLog();
+	}
+
+	if (Diagnostics::enabled(DIAG_PARSE, DIAG_DETAILS))
+		printDetails(detector);
+
+	// Initialize HB Graph
+	if (detector.initGraph(nodeCount) < 0)
+		return -1;
+
+	return 0;
+}
+
+/*
+ * Prints the number of ops, tasks, threads, nesting loops, etc in the trace
+ */
+void TraceParser::printStatistics(UAFDetector& detector) {
+	std::ostream& out = Diagnostics::stream();
+
+	out << "No of ops: " << opCount << "\n";
+	if (filters != 0)
+		out << "No of lines dropped/rewritten by filters: " << droppedLines << "/" << rewrittenLines << "\n";
+	if (slicer.enabled())
+		out << "No of memory ops dropped by slicing: " << slicer.droppedOps << "\n";
+	out << "No of tasks: " << detector.taskIDMap.size() << "\n";
 
 	long long numOfAtomicTasks = 0;
 	long long numOfTasksWithNonNullParent = 0;
 	long long numOfTasksWithCascadingLoop = 0;
-	int maxRecursiveDepth = 0; std::string taskWithMaxRecursiveDepth = "";
-	int maxCascadingDepth = 0; std::string taskWithMaxCascadingDepth = "";
+	int maxRecursiveDepth = 0; TaskIDType taskWithMaxRecursiveDepth = NOTASK;
+	int maxCascadingDepth = 0; TaskIDType taskWithMaxCascadingDepth = NOTASK;
 	IDType numOfNestingLoops = 0;
 
 	std::set<IDType> setOfThreadsWithQueues;
@@ -4429,15 +4151,15 @@ it++) {
 	map<IDType, int> threadToMaxRecursiveDepth;
 	map<IDType, int> threadToMaxCascadingDepth;
 
-	for (map<string, UAFDetector::taskDetails>::iterator it = detector.taskIDMap.begin(); it != detector.taskIDMap.end(); it++) {
+	for (UAFDetector::taskMap::iterator it = detector.taskIDMap.begin(); it != detector.taskIDMap.end(); it++) {
 #ifdef SANITYCHECK
 		if (it->second.atomic == true && (it->second.firstPauseOpID != -1 || it->second.lastResumeOpID != -1
 				|| it->second.pauseResumeResetSequence.size() != 0 )) {
-			cout << "ERROR: Atomic flag of task " << it->first << " is true but...\n";
-			it->second.printTaskDetails();
+			cout << "ERROR: Atomic flag of task " << detector.taskNames.name(it->first) << " is true but...\n";
+			it->second.printTaskDetails(detector.taskNames);
 		}
 #endif
-		if (it->second.parentTask.compare("") != 0)
+		if (it->second.parentTask != NOTASK)
 			numOfTasksWithNonNullParent++;
 		if (it->second.atomic == true)
 			numOfAtomicTasks++;
@@ -4445,7 +4167,7 @@ it++) {
 
 			numOfNestingLoops += it->second.pauseResumeResetSequence.size();
 
-			IDType currThreadID = detector.opIDMap[it->second.firstPauseOpID].threadID;
+			IDType currThreadID = detector.opIDMap.threadID[it->second.firstPauseOpID];
 			setOfThreadsWithNestingLoops.insert(currThreadID);
 
 			int currCascadingDepth = it->second.pauseResumeResetSequence.size();
@@ -4467,9 +4189,9 @@ it++) {
 			}
 
 			int recursiveDepth = 0;
-			std::string currTask = it->first;
-			std::string prevTask = "";
-			while (currTask.compare("") != 0) {
+			TaskIDType currTask = it->first;
+			TaskIDType prevTask = NOTASK;
+			while (currTask != NOTASK) {
 				recursiveDepth++;
 				prevTask = currTask;
 				currTask = detector.taskIDMap[currTask].parentTask;
@@ -4491,177 +4213,169 @@ it++) {
 			}
 		}
 	}
-	cout << "No of atomic tasks: " << numOfAtomicTasks << "\n";
-	cout << "No of non-atomic tasks: " << detector.taskIDMap.size() - numOfAtomicTasks << "\n";
-	cout << "No of tasks with non-null parent: " << numOfTasksWithNonNullParent << "\n";
-	cout << "No of shared variables guarding nesting loops: " << detector.nestingLoopMap.size() << "\n";
-	cout << "No of nesting loops: " << numOfNestingLoops << "\n";
+	out << "No of atomic tasks: " << numOfAtomicTasks << "\n";
+	out << "No of non-atomic tasks: " << detector.taskIDMap.size() - numOfAtomicTasks << "\n";
+	out << "No of tasks with non-null parent: " << numOfTasksWithNonNullParent << "\n";
+	out << "No of shared variables guarding nesting loops: " << detector.nestingLoopMap.size() << "\n";
+	out << "No of nesting loops: " << numOfNestingLoops << "\n";
 	if (maxRecursiveDepth != 0)
-		cout << "Max recursive depth: " << maxRecursiveDepth << " (task "
-			 << taskWithMaxRecursiveDepth << ")\n";
+		out << "Max recursive depth: " << maxRecursiveDepth << " (task "
+			 << detector.taskNames.name(taskWithMaxRecursiveDepth) << ")\n";
 	if (maxCascadingDepth != 0)
-		cout << "Max cascading depth: " << maxCascadingDepth << " (task "
-			 << taskWithMaxCascadingDepth << ")\n";
-	cout << "No of tasks with cascading depth > 1: " << numOfTasksWithCascadingLoop << "\n";
-	cout << "No of threads: " << detector.threadIDMap.size() << "\n";
-	cout << "No of threads with queues: " << setOfThreadsWithQueues.size() << "\n";
-	cout << "No of threads with nesting loops: " << setOfThreadsWithNestingLoops.size() << "\n";
-	cout << "No of alloc ops: " << detector.allocSet.size() << "\n";
-	cout << "No of free ops: " << detector.freeSet.size() << "\n";
-	cout << "No of read ops: " << detector.readSet.size() << "\n";
-	cout << "No of write ops: " << detector.writeSet.size() << "\n";
-	cout << "No of read + write ops: " << detector.readSet.size() + detector.writeSet.size() << "\n";
-	cout << "No of nodes: " << detector.nodeIDMap.size() << "\n";
-	cout << "Node Limit: " << NODELIMIT << "\n";
-
-	cout << "threadToMaxRecursiveDepth:\n";
+		out << "Max cascading depth: " << maxCascadingDepth << " (task "
+			 << detector.taskNames.name(taskWithMaxCascadingDepth) << ")\n";
+	out << "No of tasks with cascading depth > 1: " << numOfTasksWithCascadingLoop << "\n";
+	out << "No of threads: " << detector.threadIDMap.size() << "\n";
+	out << "No of threads with queues: " << setOfThreadsWithQueues.size() << "\n";
+	out << "No of threads with nesting loops: " << setOfThreadsWithNestingLoops.size() << "\n";
+	out << "No of alloc ops: " << detector.allocSet.size() << "\n";
+	out << "No of free ops: " << detector.freeSet.size() << "\n";
+	out << "No of read ops: " << detector.readSet.size() << "\n";
+	out << "No of write ops: " << detector.writeSet.size() << "\n";
+	out << "No of read + write ops: " << detector.readSet.size() + detector.writeSet.size() << "\n";
+	out << "No of nodes: " << detector.nodeIDMap.size() << "\n";
+	out << "Node Limit: " << NODELIMIT << "\n";
+
+	out << "threadToMaxRecursiveDepth:\n";
 	for (map<IDType, IDType>::iterator it = threadToMaxRecursiveDepth.begin(); it != threadToMaxRecursiveDepth.end(); it++) {
-		cout << "Thread " << it->first << ": " << it->second << "\n";
+		out << "Thread " << it->first << ": " << it->second << "\n";
 	}
 
-	cout << "threadToMaxCascadingDepth:\n";
+	out << "threadToMaxCascadingDepth:\n";
 	for (map<IDType, IDType>::iterator it = threadToMaxCascadingDepth.begin(); it != threadToMaxCascadingDepth.end(); it++) {
-		cout << "Thread " << it->first << ": " << it->second << "\n";
+		out << "Thread " << it->first << ": " << it->second << "\n";
 	}
+}
 
-#ifndef RUNOVERNODELIMIT
-	if (detector.nodeIDMap.size() > NODELIMIT)
-		return -2;
-#endif
-
-	Logger opTaskLogger;
-	opTaskLogger.init(traceName + ".tasks");
-
-	cout << "\nOps: \n";
-	for (map<IDType, UAFDetector::opDetails>::iterator it = detector.opIDMap.begin(); it != detector.opIDMap.end(); it++) {
-		cout << "\nOp: " << it->first << " - details: ";
-		it->second.printOpDetails();
-		cout << endl;
-
-		opTaskLogger.streamObject << it->first << ":" << it->second.taskID << "\n";
-		opTaskLogger.writeLog();
+/*
+ * Prints all ops, tasks, threads, nesting loops and memory ops of the trace
+ */
+void TraceParser::printDetails(UAFDetector& detector) {
+	std::ostream& out = Diagnostics::stream();
+
+	out << "\nOps: \n";
+	for (IDType op = 1; op <= detector.opIDMap.maxOpID(); op++) {
+		if (!detector.opIDMap.exists(op))
+			continue;
+		out << "\nOp: " << op << " - details: ";
+		detector.opIDMap.printOpDetails(op, detector.taskNames, out);
+		out << "\n";
 	}
 
-	cout << "\nTasks:\n";
-	for (map<string, UAFDetector::taskDetails>::iterator it = detector.taskIDMap.begin(); it != detector.taskIDMap.end(); it++) {
-		cout << "Task ID: " << it->first << " - details: ";
-		it->second.printTaskDetails();
-		cout << endl;
+	out << "\nTasks:\n";
+	for (UAFDetector::taskMap::iterator it = detector.taskIDMap.begin(); it != detector.taskIDMap.end(); it++) {
+		out << "Task ID: " << detector.taskNames.name(it->first) << " - details: ";
+		it->second.printTaskDetails(detector.taskNames, out);
+		out << "\n";
 	}
-	cout << "\nThreads:\n";
+	out << "\nThreads:\n";
 	for (map<IDType, UAFDetector::threadDetails>::iterator it = detector.threadIDMap.begin(); it != detector.threadIDMap.end(); it++) {
-		cout << "Thread ID: " << it->first << " - details:";
-		it->second.printThreadDetails();
-		cout << endl;
+		out << "Thread ID: " << it->first << " - details:";
+		it->second.printThreadDetails(out);
+		out << "\n";
 	}
-	cout << "\nNesting Loops:\n";
+	out << "\nNesting Loops:\n";
 	for (map<string, UAFDetector::nestingLoopDetails>::iterator it = detector.nestingLoopMap.begin(); it != detector.nestingLoopMap.end(); it++) {
-		cout << "Shared variable: " << it->first << " - details: ";
-		it->second.printNestingLoopDetails();
-		cout << endl;
+		out << "Shared variable: " << it->first << " - details: ";
+		it->second.printNestingLoopDetails(out);
+		out << "\n";
 	}
-	cout << "\nPause/Reset/Resume Ops:\n";
+	out << "\nPause/Reset/Resume Ops:\n";
 	for (map<IDType, string>::iterator it = detector.pauseResumeResetOps.begin(); it != detector.pauseResumeResetOps.end(); it++) {
-		cout << "Op: " << it->first << " shared variable: " << it->second << endl;
+		out << "Op: " << it->first << " shared variable: " << it->second << "\n";
 	}
-	cout << "\nSet - enq\n";
+	out << "\nSet - enq\n";
 	for (map<IDType, UAFDetector::enqOpDetails>::iterator it = detector.enqToTaskEnqueued.begin(); it != detector.enqToTaskEnqueued.end(); it++) {
-		cout << "Op: " << it->first << " - details: ";
-		it->second.printEnqDetails();
-		cout << endl;
+		out << "Op: " << it->first << " - details: ";
+		it->second.printEnqDetails(detector.taskNames, out);
+		out << "\n";
 	}
-	cout << "\nSet - alloc\n";
+	out << "\nSet - alloc\n";
 	for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.allocSet.begin(); it != detector.allocSet.end(); it++) {
-		cout << "Op: " << it->first << " - details :";
-		it->second.printMemOpDetails();
-		cout << endl;
+		out << "Op: " << it->first << " - details :";
+		it->second.printMemOpDetails(out);
+		out << "\n";
 	}
-	cout << "\nSet - free\n";
+	out << "\nSet - free\n";
 	for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.freeSet.begin(); it != detector.freeSet.end(); it++) {
-		cout << "Op: " << it->first << " - details :";
-		it->second.printMemOpDetails();
-		cout << endl;
+		out << "Op: " << it->first << " - details :";
+		it->second.printMemOpDetails(out);
+		out << "\n";
 	}
-	cout << "\nSet - read\n";
-	for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.readSet.begin(); it != detector.readSet.end(); it++) {
-		cout << "Op: " << it->first << " - details :";
-		it->second.printMemOpDetails();
-		cout << endl;
+	out << "\nSet - read\n";
+	for (IDMap<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.readSet.begin(); it != detector.readSet.end(); it++) {
+		out << "Op: " << it->first << " - details :";
+		it->second.printMemOpDetails(out);
+		out << "\n";
 	}
-	cout << "\nSet - write\n";
-	for (map<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.writeSet.begin(); it != detector.writeSet.end(); it++) {
-		cout << "Op: " << it->first << " - details :";
-		it->second.printMemOpDetails();
-		cout << endl;
+	out << "\nSet - write\n";
+	for (IDMap<IDType, UAFDetector::memoryOpDetails>::iterator it = detector.writeSet.begin(); it != detector.writeSet.end(); it++) {
+		out << "Op: " << it->first << " - details :";
+		it->second.printMemOpDetails(out);
+		out << "\n";
 	}
-	cout << "\nMap - alloc\n";
+	out << "\nMap - alloc\n";
 	for (map<IDType, UAFDetector::allocOpDetails>::iterator it = detector.allocIDMap.begin(); it != detector.allocIDMap.end(); it++) {
-		cout << "Op: " << it->first << endl;
-		it->second.printDetails();
-		cout << endl;
+		out << "Op: " << it->first << "\n";
+		it->second.printDetails(out);
+		out << "\n";
 	}
-	cout << "\nMap - free\n";
+	out << "\nMap - free\n";
 	for (map<IDType, UAFDetector::freeOpDetails>::iterator it = detector.freeIDMap.begin(); it != detector.freeIDMap.end(); it++) {
-		cout << "Op: " << it->first << endl;
-		it->second.printDetails();
-		cout << endl;
+		out << "Op: " << it->first << "\n";
+		it->second.printDetails(out);
+		out << "\n";
 	}
-	cout << "\nMap - nodes\n";
-	for (map<IDType, UAFDetector::setOfOps>::iterator it = detector.nodeIDMap.begin(); it != detector.nodeIDMap.end(); it++) {
-		cout << "Node: " << it->first << "\n";
-		it->second.printDetails();
-		cout << "\n";
+	out << "\nMap - nodes\n";
+	for (IDMap<IDType, UAFDetector::setOfOps>::iterator it = detector.nodeIDMap.begin(); it != detector.nodeIDMap.end(); it++) {
+		out << "Node: " << it->first << "\n";
+		it->second.printDetails(out);
+		out << "\n";
 	}
 #ifdef LOCKS
-	cout << "\nMap - wait\n";
+	out << "\nMap - wait\n";
 	for (map<IDType, UAFDetector::lockOpDetails>::iterator it = detector.waitSet.begin(); it != detector.waitSet.end(); it++) {
-		cout << "Wait: " << it->first << "\n";
-		it->second.printDetails();
-		cout << "\n";
+		out << "Wait: " << it->first << "\n";
+		it->second.printDetails(out);
+		out << "\n";
 	}
-	cout << "\nMap - notify\n";
+	out << "\nMap - notify\n";
 	for (map<IDType, UAFDetector::lockOpDetails>::iterator it = detector.notifySet.begin(); it != detector.notifySet.end(); it++) {
-		cout << "Notify: " << it->first << "\n";
-		it->second.printDetails();
-		cout << "\n";
+		out << "Notify: " << it->first << "\n";
+		it->second.printDetails(out);
+		out << "\n";
 	}
-	cout << "\nMap - notifyAll\n";
+	out << "\nMap - notifyAll\n";
 	for (map<IDType, UAFDetector::lockOpDetails>::iterator it = detector.notifyAllSet.begin(); it != detector.notifyAllSet.end(); it++) {
-		cout << "NotifyAll: " << it->first << "\n";
-		it->second.printDetails();
-		cout << "\n";
+		out << "NotifyAll: " << it->first << "\n";
+		it->second.printDetails(out);
+		out << "\n";
 	}
-	cout << "\nMap - lockToNotify\n";
+	out << "\nMap - lockToNotify\n";
 	for (map<std::string, UAFDetector::setOfOps>::iterator it = detector.lockToNotify.begin(); it != detector.lockToNotify.end(); it++) {
-		cout << "Lock ID: " << it->first << "\n";
-		it->second.printDetails();
-		cout << "\n";
+		out << "Lock ID: " << it->first << "\n";
+		it->second.printDetails(out);
+		out << "\n";
 	}
-	cout << "\nMap - lockToNotifyAll\n";
+	out << "\nMap - lockToNotifyAll\n";
 	for (map<std::string, UAFDetector::setOfOps>::iterator it = detector.lockToNotifyAll.begin(); it != detector.lockToNotifyAll.end(); it++) {
-		cout << "Lock ID: " << it->first << "\n";
-		it->second.printDetails();
-		cout << "\n";
+		out << "Lock ID: " << it->first << "\n";
+		it->second.printDetails(out);
+		out << "\n";
 	}
-	cout << "\nMap - notifyToWait\n";
+	out << "\nMap - notifyToWait\n";
 	for (map<IDType, IDType>::iterator it = detector.notifyToWait.begin(); it != detector.notifyToWait.end(); it++) {
-		cout << "Notify " << it->first << " --> Wait " << it->second << "\n";
+		out << "Notify " << it->first << " --> Wait " << it->second << "\n";
 	}
-	cout << "\nMap - notifyAllToWaitSet\n";
+	out << "\nMap - notifyAllToWaitSet\n";
 	for (map<IDType, UAFDetector::setOfOps>::iterator it = detector.notifyAllToWaitSet.begin(); it != detector.notifyAllToWaitSet.end(); it++) {
-		cout << "NotifyAll " << it->first << "-->\n";
-		it->second.printDetails();
-		cout << "\n";
+		out << "NotifyAll " << it->first << "-->\n";
+		it->second.printDetails(out);
+		out << "\n";
 	}
-	cout << "\nMap - waitToNotify\n";
+	out << "\nMap - waitToNotify\n";
 	for (map<IDType, IDType>::iterator it = detector.waitToNotify.begin(); it != detector.waitToNotify.end(); it++) {
-		cout << "Wait " << it->first << " --> Notify " << it->second << "\n";
+		out << "Wait " << it->first << " --> Notify " << it->second << "\n";
 	}
 #endif
-#endif
-
-	// Initialize HB Graph
-	detector.initGraph(nodeCount);
-
-	return 0;
 }
@@ -6,8 +6,15 @@
  */
 
 #include <fstream>
+#include <boost/regex.hpp>
 #include <racedetector/UAFDetector.h>
 #include <logging/Logger.h>
+#include <parser/TraceTokenizer.h>
+#include <parser/TraceReader.h>
+#include <parser/ChunkedTokenizer.h>
+#include <parser/BinaryTrace.h>
+#include <parser/AddressIndex.h>
+#include <parser/TraceSlicer.h>
 
 #include <config.h>
 
@@ -23,14 +30,70 @@ public:
 	TraceParser(string traceFileName);
 	virtual ~TraceParser();
 
-	std::string traceName;
+	std::string traceName;	// "-" for standard input
+
+	// prefix of the names of output files (<prefix>.tasks), traceName by default
+	std::string outputPrefix;
+
+	// match each line against finalRegEx instead of using TraceTokenizer
+	// (slower, kept to cross-check the tokenizer)
+	bool useRegEx;
+
+	// map the trace file instead of reading it through an ifstream
+	bool useMmap;
+
+	// no of threads tokenizing a text trace (the trace is mapped if > 1)
+	unsigned numOfThreads;
+
+	// normalizations of raw trace lines, FILTER_* flags (see TraceFilter)
+	unsigned filters;
+
+	// memory ops not on the objects selected by slicer are skipped (keeping
+	// their op IDs), all other ops are kept
+	TraceSlicer slicer;
 
 	// checks whether each line from the trace file is a valid operation
 	int parse(UAFDetector &detector);
 
+	// writes the trace in the binary (.srb) format
+	long long convertToBinary(std::string outFileName);
+
+	// checks the structure of the trace (see TraceValidator) without
+	// building the maps of UAFDetector. Returns the number of violations,
+	// -1 if the trace cannot be read.
+	long long validate();
+
 
 private:
-	ifstream traceFile;
+	TraceReader* reader;			// text traces
+	BinaryTraceReader* binaryReader;	// binary traces
+	ChunkedTokenizer* chunkedTokenizer;	// text traces tokenized on numOfThreads threads
+
+	// current line of a text trace
+	const char* lineBegin;
+	const char* lineEnd;
+
+	long long lineNumber;		// line (record of a binary trace) of the current op
+	std::string filteredLine;	// current line, if it was rewritten by filters
+	long long droppedLines;
+	long long rewrittenLines;
+
+	boost::regex reg;
+	boost::cmatch matches;
+
+	int openTrace();
+	bool getOp(TraceTokenizer::tokenType& token, bool& validOp);
+	bool readOp(TraceTokenizer::tokenType& token, bool& validOp);
+	// true if getOp() stopped on a read error rather than at end of trace
+	bool readFailed() const;
+	bool tokenizeLine(TraceTokenizer::tokenType& token);
+	std::string currentOp(const TraceTokenizer::tokenType& token);
+	TaskIDType internTask(UAFDetector& detector, const TraceTokenizer::fieldType& field);
+	bool matchRegEx(const char* lineBegin, const char* lineEnd, TraceTokenizer::tokenType& token);
+
+	// debug output of the parsed trace (see Diagnostics)
+	void printStatistics(UAFDetector& detector);
+	void printDetails(UAFDetector& detector);
 
 	std::string opRegEx;	 // regex for all valid operations
 	std::string posIntRegEx;
@@ -40,6 +103,9 @@ private:
 	std::string suffixRegEx; // regex for suffix (if any) of each line in the trace file
 	std::string finalRegEx;  // regex for a valid line in the trace file
 
+	// allocs, frees, reads and writes seen so far, by address
+	AddressIndex addressIndex;
+
 	long long opCount;		// no of operations in the trace
 	long long nodeCount;	// no of nodes in the trace/graph
 };
@@ -0,0 +1,260 @@
+/*
+ * TraceReader.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include "TraceReader.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <debugconfig.h>
+
+using namespace std;
+
+// Drop consumed parts of a mapped trace in chunks of this many bytes
+#define RELEASECHUNK (64 << 20)
+
+// Initial size of the buffer of BufferedTraceReader (grown for longer lines)
+#define LINEBUFFERSIZE (1 << 20)
+
+TraceReader::TraceReader() {
+	readError = false;
+}
+
+TraceReader::~TraceReader() {
+}
+
+StreamTraceReader::StreamTraceReader() {
+}
+
+StreamTraceReader::~StreamTraceReader() {
+	traceFile.close();
+}
+
+bool StreamTraceReader::open(string traceFileName) {
+	traceFile.open(traceFileName.c_str(), ios_base::in);
+	return traceFile.is_open();
+}
+
+bool StreamTraceReader::getLine(const char*& begin, const char*& end) {
+	if (!getline(traceFile, line)) {
+		if (traceFile.bad()) {
+			cout << "ERROR: Cannot read trace\n";
+			readError = true;
+		}
+		return false;
+	}
+	begin = line.data();
+	end = begin + line.size();
+	return true;
+}
+
+MappedTraceReader::MappedTraceReader() {
+	fd = -1;
+	data = NULL;
+	size = 0;
+	offset = 0;
+	released = 0;
+}
+
+MappedTraceReader::~MappedTraceReader() {
+	if (data != NULL)
+		munmap(data, size);
+	if (fd != -1)
+		close(fd);
+}
+
+bool MappedTraceReader::open(string traceFileName) {
+	fd = ::open(traceFileName.c_str(), O_RDONLY);
+	if (fd == -1)
+		return false;
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode)) {
+		cout << "ERROR: Cannot map " << traceFileName << ", not a regular file\n";
+		return false;
+	}
+
+	size = fileStat.st_size;
+	// Nothing to map for an empty trace
+	if (size == 0)
+		return true;
+
+	void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (mapping == MAP_FAILED) {
+		cout << "ERROR: Cannot map " << traceFileName << ": " << strerror(errno) << "\n";
+		size = 0;
+		return false;
+	}
+	data = (char*) mapping;
+	madvise(data, size, MADV_SEQUENTIAL);
+#ifdef POSIX_FADV_SEQUENTIAL
+	posix_fadvise(fd, 0, size, POSIX_FADV_SEQUENTIAL);
+#endif
+	return true;
+}
+
+/*
+ * Drops the pages before data[upto]. The mapping is private and read-only,
+ * so a (never expected) access to a dropped page just reads the file again.
+ */
+void MappedTraceReader::release(size_t upto) {
+	size_t pageSize = sysconf(_SC_PAGESIZE);
+	upto = (upto / pageSize) * pageSize;
+	if (upto <= released)
+		return;
+
+	madvise(data + released, upto - released, MADV_DONTNEED);
+#ifdef POSIX_FADV_DONTNEED
+	posix_fadvise(fd, released, upto - released, POSIX_FADV_DONTNEED);
+#endif
+	released = upto;
+}
+
+void MappedTraceReader::releaseBefore(const char* position) {
+	if ((size_t) (position - data) - released >= RELEASECHUNK)
+		release(position - data);
+}
+
+bool MappedTraceReader::getBlock(size_t blockSize, const char*& begin, const char*& end) {
+	if (offset >= size)
+		return false;
+
+	begin = data + offset;
+	if (size - offset <= blockSize) {
+		end = data + size;
+	} else {
+		// extend the block to the end of its last line
+		size_t last = offset + blockSize - 1;
+		const char* newline = (const char*) memchr(data + last, '\n', size - last);
+		end = (newline == NULL) ? data + size : newline + 1;
+	}
+	offset = end - data;
+	return true;
+}
+
+bool MappedTraceReader::getLine(const char*& begin, const char*& end) {
+	if (offset >= size)
+		return false;
+
+	if (offset - released >= RELEASECHUNK)
+		release(offset);
+
+	begin = data + offset;
+	const char* newline = (const char*) memchr(begin, '\n', size - offset);
+	if (newline == NULL) {
+		end = data + size;
+		offset = size;
+	} else {
+		end = newline;
+		offset = newline - data + 1;
+	}
+	return true;
+}
+
+BufferedTraceReader::BufferedTraceReader() {
+	bufferSize = LINEBUFFERSIZE;
+	buffer = new char[bufferSize];
+	position = 0;
+	available = 0;
+	endOfTrace = false;
+}
+
+BufferedTraceReader::~BufferedTraceReader() {
+	delete[] buffer;
+}
+
+bool BufferedTraceReader::fill() {
+	if (endOfTrace)
+		return false;
+
+	if (position == 0 && available == bufferSize) {
+		// a single line fills the buffer
+		char* newBuffer = new char[2 * bufferSize];
+		memcpy(newBuffer, buffer, available);
+		delete[] buffer;
+		buffer = newBuffer;
+		bufferSize *= 2;
+	} else {
+		memmove(buffer, buffer + position, available - position);
+		available -= position;
+		position = 0;
+	}
+
+	long ret = readBlock(buffer + available, bufferSize - available);
+	if (ret < 0)
+		readError = true;
+	if (ret <= 0) {
+		endOfTrace = true;
+		return false;
+	}
+	available += ret;
+	return true;
+}
+
+bool BufferedTraceReader::getLine(const char*& begin, const char*& end) {
+	// bytes of the current line already searched for a newline
+	size_t searched = 0;
+	while (true) {
+		const char* from = buffer + position + searched;
+		const char* newline = (const char*) memchr(from, '\n', available - position - searched);
+		if (newline != NULL) {
+			begin = buffer + position;
+			end = newline;
+			position = newline - buffer + 1;
+			return true;
+		}
+
+		searched = available - position;
+		if (!fill())
+			break;
+	}
+
+	// last line without a trailing newline (not a line if the read failed)
+	if (position == available || readError)
+		return false;
+	begin = buffer + position;
+	end = buffer + available;
+	position = available;
+	return true;
+}
+
+PipeTraceReader::PipeTraceReader() {
+	fd = -1;
+}
+
+PipeTraceReader::~PipeTraceReader() {
+	if (fd > STDIN_FILENO)
+		close(fd);
+}
+
+bool PipeTraceReader::isPipe(string traceFileName) {
+	if (traceFileName == "-")
+		return true;
+	struct stat fileStat;
+	return stat(traceFileName.c_str(), &fileStat) == 0 && !S_ISREG(fileStat.st_mode);
+}
+
+bool PipeTraceReader::open(string traceFileName) {
+	if (traceFileName == "-")
+		fd = STDIN_FILENO;
+	else
+		fd = ::open(traceFileName.c_str(), O_RDONLY);
+	return fd != -1;
+}
+
+long PipeTraceReader::readBlock(char* buffer, size_t size) {
+	ssize_t ret;
+	do {
+		ret = read(fd, buffer, size);
+	} while (ret == -1 && errno == EINTR);
+	if (ret == -1)
+		cout << "ERROR: Cannot read trace: " << strerror(errno) << "\n";
+	return ret;
+}
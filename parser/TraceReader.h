@@ -0,0 +1,139 @@
+/*
+ * TraceReader.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <fstream>
+#include <string>
+#include <cstddef>
+
+#include <config.h>
+
+#ifndef TRACEREADER_H_
+#define TRACEREADER_H_
+
+/*
+ * TraceReader hands out the lines of a trace one at a time.
+ * A line is returned as [begin, end) without the trailing newline and is
+ * only valid until the next call to getLine().
+ */
+class TraceReader {
+public:
+	TraceReader();
+	virtual ~TraceReader();
+
+	// returns false if the trace cannot be read
+	virtual bool open(std::string traceFileName) = 0;
+
+	// returns false at end of trace, or if the trace cannot be read on
+	// (then failed() is true)
+	virtual bool getLine(const char*& begin, const char*& end) = 0;
+
+	// True if the trace could not be read to the end
+	bool failed() const {
+		return readError;
+	}
+
+protected:
+	bool readError;
+};
+
+/*
+ * Reads the trace through an ifstream, one getline at a time.
+ */
+class StreamTraceReader : public TraceReader {
+public:
+	StreamTraceReader();
+	virtual ~StreamTraceReader();
+
+	bool open(std::string traceFileName);
+	bool getLine(const char*& begin, const char*& end);
+
+private:
+	std::ifstream traceFile;
+	std::string line;
+};
+
+/*
+ * Maps the whole trace file and walks it in place. The mapping is advised
+ * as sequential, and the part of the file already consumed is dropped from
+ * memory (and from the page cache) every RELEASECHUNK bytes.
+ */
+class MappedTraceReader : public TraceReader {
+public:
+	MappedTraceReader();
+	virtual ~MappedTraceReader();
+
+	bool open(std::string traceFileName);
+	bool getLine(const char*& begin, const char*& end);
+
+	// Returns the next blockSize bytes of the trace (more or less, ending at
+	// the end of a line). The lines of the block stay valid until the pages
+	// holding them are dropped with release().
+	bool getBlock(size_t blockSize, const char*& begin, const char*& end);
+
+	// Drops the pages before position once RELEASECHUNK bytes can be dropped
+	void releaseBefore(const char* position);
+
+private:
+	int fd;
+	char* data;
+	size_t size;
+	size_t offset;		// start of the next line
+	size_t released;	// data[0, released) has been dropped
+
+	void release(size_t upto);
+};
+
+/*
+ * Splits the output of readBlock() into lines, without reading the whole
+ * trace into memory. Subclasses fill the buffer from a source that cannot be
+ * mapped, e.g. a decompressor.
+ */
+class BufferedTraceReader : public TraceReader {
+public:
+	BufferedTraceReader();
+	virtual ~BufferedTraceReader();
+
+	bool getLine(const char*& begin, const char*& end);
+
+protected:
+	// Reads up to size bytes into buffer. Returns the number of bytes read,
+	// 0 at end of trace and -1 on error (also if the trace is cut short).
+	virtual long readBlock(char* buffer, size_t size) = 0;
+
+private:
+	char* buffer;
+	size_t bufferSize;
+	size_t position;	// start of the next line in buffer
+	size_t available;	// bytes in buffer
+	bool endOfTrace;
+
+	// reads more of the trace, keeping buffer[position, available)
+	bool fill();
+};
+
+/*
+ * Reads a text trace from standard input ("-") or from a file that cannot be
+ * mapped or read twice, e.g. a named pipe. Only the buffer of
+ * BufferedTraceReader is kept in memory.
+ */
+class PipeTraceReader : public BufferedTraceReader {
+public:
+	PipeTraceReader();
+	virtual ~PipeTraceReader();
+
+	// returns true if traceFileName is "-" or not a regular file
+	static bool isPipe(std::string traceFileName);
+
+	bool open(std::string traceFileName);
+
+protected:
+	long readBlock(char* buffer, size_t size);
+
+private:
+	int fd;
+};
+
+#endif /* TRACEREADER_H_ */
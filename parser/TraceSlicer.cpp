@@ -0,0 +1,112 @@
+/*
+ * TraceSlicer.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include "TraceSlicer.h"
+#include <iostream>
+#include <cstdlib>
+#include <cerrno>
+
+#include <debugconfig.h>
+
+using namespace std;
+
+// Parses text as a number (hex with 0x, else decimal). Returns false if it is not one.
+static bool toNumber(const string& text, unsigned long long& value) {
+	if (text.empty() || text[0] == '-')
+		return false;
+	char* end;
+	errno = 0;
+	value = strtoull(text.c_str(), &end, 0);
+	return errno == 0 && *end == '\0';
+}
+
+TraceSlicer::TraceSlicer() {
+	droppedOps = 0;
+}
+
+TraceSlicer::~TraceSlicer() {
+}
+
+bool TraceSlicer::addAllocs(string list) {
+	size_t begin = 0;
+	while (begin <= list.size()) {
+		size_t end = list.find(',', begin);
+		if (end == string::npos)
+			end = list.size();
+		unsigned long long op;
+		if (!toNumber(list.substr(begin, end - begin), op) || op == 0) {
+			cout << "ERROR: Invalid alloc op ID " << list.substr(begin, end - begin) << "\n";
+			return false;
+		}
+		allocOps.insert((IDType) op);
+		begin = end + 1;
+	}
+	return true;
+}
+
+bool TraceSlicer::addRange(string range) {
+	size_t comma = range.find(',');
+	unsigned long long begin, end;
+	if (comma == string::npos || !toNumber(range.substr(0, comma), begin)
+			|| !toNumber(range.substr(comma + 1), end) || begin >= end) {
+		cout << "ERROR: Invalid address range " << range << " (start,end)\n";
+		return false;
+	}
+	addBlock(begin, end);
+	return true;
+}
+
+bool TraceSlicer::overlaps(AddressType begin, AddressType end) const {
+	// the last block starting before end is the only one that can overlap
+	map<AddressType, AddressType>::const_iterator it = ranges.lower_bound(end);
+	if (it == ranges.begin())
+		return false;
+	it--;
+	return it->second > begin;
+}
+
+void TraceSlicer::addBlock(AddressType begin, AddressType end) {
+	// merge with the blocks it overlaps or touches, so blocks stay disjoint
+	map<AddressType, AddressType>::iterator it = ranges.upper_bound(end);
+	while (it != ranges.begin()) {
+		it--;
+		if (it->second < begin)
+			break;
+		if (it->first < begin)
+			begin = it->first;
+		if (it->second > end)
+			end = it->second;
+		ranges.erase(it++);
+	}
+	ranges[begin] = end;
+}
+
+bool TraceSlicer::keepOp(IDType opID, const TraceTokenizer::tokenType& token) {
+	bool keep = true;
+	switch (token.opType) {
+	case ALLOC_OP:
+	case FREE_OP: {
+		AddressType base = token.args[1].value;
+		AddressType size = token.args[2].value;
+		if (token.opType == ALLOC_OP && allocOps.find(opID) != allocOps.end()) {
+			addBlock(base, base + (size > 0 ? size : 1));
+			break;
+		}
+		keep = overlaps(base, base + (size > 0 ? size : 1));
+		break;
+	}
+	case READ_OP:
+	case WRITE_OP:
+		keep = overlaps(token.args[1].value, token.args[1].value + 1);
+		break;
+	default:
+		break;
+	}
+
+	if (!keep)
+		droppedOps++;
+	return keep;
+}
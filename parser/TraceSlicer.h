@@ -0,0 +1,61 @@
+/*
+ * TraceSlicer.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <string>
+#include <set>
+#include <map>
+#include <parser/TraceTokenizer.h>
+
+#include <config.h>
+
+#ifndef TRACESLICER_H_
+#define TRACESLICER_H_
+
+/*
+ * TraceSlicer keeps only the memory ops that touch the objects of interest,
+ * so that the HB graph of a large trace can be built for a few objects.
+ * The objects are given as alloc op IDs (the block of each alloc, from the
+ * alloc on) and/or as an address range. All other ops (enq/deq/end,
+ * pause/resume/reset, fork/join, enterloop/exitloop, ...) are always kept,
+ * since the HB rules are built from them.
+ *
+ * Dropped ops keep their op IDs, so the ops in the output of a sliced run
+ * have the same IDs as in a run over the whole trace.
+ */
+class TraceSlicer {
+public:
+	TraceSlicer();
+	virtual ~TraceSlicer();
+
+	// Adds the alloc ops in a comma separated list of op IDs.
+	// Returns false if the list is not valid.
+	bool addAllocs(std::string list);
+
+	// Adds the addresses in "start,end" (end excluded, hex or decimal).
+	// Returns false if the range is not valid.
+	bool addRange(std::string range);
+
+	bool enabled() const {
+		return !allocOps.empty() || !ranges.empty();
+	}
+
+	// Returns true if op opID is kept
+	bool keepOp(IDType opID, const TraceTokenizer::tokenType& token);
+
+	long long droppedOps;
+
+private:
+	std::set<IDType> allocOps;
+	// blocks of interest (start -> end, end excluded), from the alloc op
+	// IDs (added when the alloc is seen) and from the address ranges
+	std::map<AddressType, AddressType> ranges;
+
+	// true if [begin, end) overlaps a block of interest
+	bool overlaps(AddressType begin, AddressType end) const;
+	void addBlock(AddressType begin, AddressType end);
+};
+
+#endif /* TRACESLICER_H_ */
@@ -0,0 +1,254 @@
+/*
+ * TraceTokenizer.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include "TraceTokenizer.h"
+#include <cstring>
+#include <strings.h>
+#include <cstdio>
+
+#include <debugconfig.h>
+
+using namespace std;
+
+typedef TraceTokenizer::argKind argKind;
+static const argKind POSINT_ARG = TraceTokenizer::POSINT_ARG;
+static const argKind INT_ARG = TraceTokenizer::INT_ARG;
+static const argKind HEX_ARG = TraceTokenizer::HEX_ARG;
+
+// Arguments of each operation, in the same order as in TraceParser's opRegEx
+struct opGrammar {
+	OpType opType;
+	unsigned numOfArgs;
+	argKind kinds[MAXARGS];
+	bool nestedPair;	// last two arguments are enclosed in parentheses, e.g. inc(0, (0x1, 2))
+};
+
+static const opGrammar grammar[] = {
+	{THREADINIT_OP,	1, {POSINT_ARG}, false},
+	{THREADEXIT_OP,	1, {POSINT_ARG}, false},
+	{FORK_OP,		2, {POSINT_ARG, POSINT_ARG}, false},
+	{JOIN_OP,		2, {POSINT_ARG, POSINT_ARG}, false},
+	{ENTERLOOP_OP,	1, {POSINT_ARG}, false},
+	{EXITLOOP_OP,	1, {POSINT_ARG}, false},
+	{ENQ_OP,		4, {POSINT_ARG, POSINT_ARG, POSINT_ARG, INT_ARG}, false},
+	{DEQ_OP,		2, {POSINT_ARG, POSINT_ARG}, false},
+	{END_OP,		2, {POSINT_ARG, POSINT_ARG}, false},
+#ifdef PERMIT
+	{PERMIT_OP,		3, {POSINT_ARG, POSINT_ARG, HEX_ARG}, false},
+	{REVOKE_OP,		3, {POSINT_ARG, POSINT_ARG, HEX_ARG}, false},
+#else
+	{PAUSE_OP,		3, {POSINT_ARG, POSINT_ARG, HEX_ARG}, false},
+	{RESUME_OP,		3, {POSINT_ARG, POSINT_ARG, HEX_ARG}, false},
+#endif
+	{RESET_OP,		2, {POSINT_ARG, HEX_ARG}, false},
+	{ALLOC_OP,		3, {POSINT_ARG, HEX_ARG, POSINT_ARG}, false},
+	{FREE_OP,		3, {POSINT_ARG, HEX_ARG, POSINT_ARG}, false},
+	{INC_OP,		3, {POSINT_ARG, HEX_ARG, POSINT_ARG}, true},
+	{DEC_OP,		3, {POSINT_ARG, HEX_ARG, POSINT_ARG}, true},
+#ifdef LOCKS
+	{WAIT_OP,		2, {POSINT_ARG, HEX_ARG}, false},
+	{NOTIFY_OP,		2, {POSINT_ARG, HEX_ARG}, false},
+	{NOTIFYALL_OP,	2, {POSINT_ARG, HEX_ARG}, false},
+#endif
+	{READ_OP,		2, {POSINT_ARG, HEX_ARG}, false},
+	{WRITE_OP,		2, {POSINT_ARG, HEX_ARG}, false}
+};
+
+static const unsigned grammarSize = sizeof(grammar)/sizeof(grammar[0]);
+
+// \s of the regex
+static inline bool isSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+static inline bool isDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+static inline bool isHexDigit(char c) {
+	return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+static inline bool isLetter(char c) {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// " *" of the regex
+static inline void skipBlanks(const char*& p, const char* end) {
+	while (p != end && *p == ' ')
+		p++;
+}
+
+static inline bool expect(const char*& p, const char* end, char c) {
+	if (p == end || *p != c)
+		return false;
+	p++;
+	return true;
+}
+
+static bool scanArg(const char*& p, const char* end, argKind kind, TraceTokenizer::fieldType& field) {
+	field.begin = p;
+	if (kind == HEX_ARG) {
+		if (!expect(p, end, '0'))
+			return false;
+		if (p == end || (*p != 'x' && *p != 'X'))
+			return false;
+		p++;
+		if (p == end || !isHexDigit(*p))
+			return false;
+		while (p != end && isHexDigit(*p))
+			p++;
+	} else {
+		if (kind == INT_ARG && p != end && *p == '-')
+			p++;
+		if (p == end || !isDigit(*p))
+			return false;
+		while (p != end && isDigit(*p))
+			p++;
+	}
+	field.end = p;
+	TraceTokenizer::decode(field, kind);
+	return true;
+}
+
+void TraceTokenizer::decode(fieldType& field, argKind kind) {
+	const char* p = field.begin;
+	unsigned long long value = 0;
+
+	field.kind = kind;
+	if (kind == HEX_ARG) {
+		for (p += 2; p != field.end; p++) {
+			char c = *p;
+			unsigned digit;
+			if (isDigit(c))
+				digit = c - '0';
+			else if (c >= 'a' && c <= 'f')
+				digit = c - 'a' + 10;
+			else
+				digit = c - 'A' + 10;
+			value = (value << 4) | digit;
+		}
+		field.value = value;
+	} else {
+		bool negative = false;
+		if (p != field.end && *p == '-') {
+			negative = true;
+			p++;
+		}
+		for (; p != field.end; p++)
+			value = value * 10 + (*p - '0');
+		field.value = negative ? -value : value;
+	}
+}
+
+string TraceTokenizer::fieldType::str() const {
+	if (begin != NULL)
+		return string(begin, end);
+
+	char text[24];
+	if (kind == HEX_ARG)
+		snprintf(text, sizeof(text), "0x%llx", value);
+	else if (kind == INT_ARG)
+		snprintf(text, sizeof(text), "%lld", (long long) value);
+	else
+		snprintf(text, sizeof(text), "%llu", value);
+	return string(text);
+}
+
+// Returns the grammar entry of the op whose name (ignoring case) is [begin, end)
+static const opGrammar* findOp(const char* begin, const char* end) {
+	size_t length = end - begin;
+	for (unsigned i = 0; i < grammarSize; i++) {
+		const char* name = opTypeToString(grammar[i].opType);
+		if (strlen(name) == length && strncasecmp(name, begin, length) == 0)
+			return &grammar[i];
+	}
+	return NULL;
+}
+
+OpType TraceTokenizer::opTypeFromName(const char* begin, const char* end) {
+	const opGrammar* op = findOp(begin, end);
+	if (op == NULL)
+		return INVALID_OP;
+	return op->opType;
+}
+
+bool TraceTokenizer::getArgKinds(OpType type, unsigned& numOfArgs, argKind kinds[MAXARGS]) {
+	for (unsigned i = 0; i < grammarSize; i++) {
+		if (grammar[i].opType != type)
+			continue;
+		numOfArgs = grammar[i].numOfArgs;
+		for (unsigned j = 0; j < numOfArgs; j++)
+			kinds[j] = grammar[i].kinds[j];
+		return true;
+	}
+	return false;
+}
+
+string TraceTokenizer::toString(const tokenType& token) {
+	string text = opTypeToString(token.opType);
+	text += "(";
+	for (unsigned i = 0; i < token.numOfArgs; i++) {
+		if (i > 0)
+			text += ",";
+		if ((token.opType == INC_OP || token.opType == DEC_OP) && i == token.numOfArgs - 2)
+			text += "(";
+		text += token.args[i].str();
+	}
+	if (token.opType == INC_OP || token.opType == DEC_OP)
+		text += ")";
+	text += ")";
+	return text;
+}
+
+bool TraceTokenizer::tokenize(const char* begin, const char* end, tokenType& token) {
+	const char* p = begin;
+	while (p != end && isSpace(*p))
+		p++;
+
+	const char* nameBegin = p;
+	while (p != end && isLetter(*p))
+		p++;
+
+	const opGrammar* op = findOp(nameBegin, p);
+	if (op == NULL)
+		return false;
+
+	token.opType = op->opType;
+	token.numOfArgs = op->numOfArgs;
+
+	skipBlanks(p, end);
+	if (!expect(p, end, '('))
+		return false;
+
+	for (unsigned i = 0; i < op->numOfArgs; i++) {
+		skipBlanks(p, end);
+		if (i > 0) {
+			if (!expect(p, end, ','))
+				return false;
+			skipBlanks(p, end);
+		}
+		if (op->nestedPair && i == op->numOfArgs - 2) {
+			if (!expect(p, end, '('))
+				return false;
+			skipBlanks(p, end);
+		}
+		if (!scanArg(p, end, op->kinds[i], token.args[i]))
+			return false;
+	}
+	skipBlanks(p, end);
+	if (op->nestedPair) {
+		if (!expect(p, end, ')'))
+			return false;
+		skipBlanks(p, end);
+	}
+	if (!expect(p, end, ')'))
+		return false;
+
+	while (p != end && isSpace(*p))
+		p++;
+	return p == end;
+}
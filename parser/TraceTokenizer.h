@@ -0,0 +1,90 @@
+/*
+ * TraceTokenizer.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <string>
+#include <racedetector/UAFDetector.h>
+
+#include <config.h>
+
+#ifndef TRACETOKENIZER_H_
+#define TRACETOKENIZER_H_
+
+// Max number of arguments of any operation in the trace (enq has 4)
+#define MAXARGS 4
+
+/*
+ * TraceTokenizer recognizes a single line of the trace in one pass over the
+ * line, without building any strings. It accepts exactly the grammar of
+ * TraceParser's finalRegEx (including the PERMIT and LOCKS variants) and
+ * returns the kind of operation and its arguments as views into the line.
+ */
+class TraceTokenizer {
+public:
+	enum argKind {
+		POSINT_ARG,	// [0-9]+
+		INT_ARG,	// [-]?[0-9]+
+		HEX_ARG		// 0[xX][0-9a-fA-F]+
+	};
+
+	// An argument of an operation
+	class fieldType {
+	public:
+		// text of the argument in the line buffer, both NULL if the argument
+		// was read from a binary trace
+		const char* begin;
+		const char* end;
+
+		argKind kind;
+		unsigned long long value;	// int arguments are stored in two's complement
+
+		fieldType() {
+			begin = NULL;
+			end = NULL;
+			kind = POSINT_ARG;
+			value = 0;
+		}
+
+		// text of the argument (rebuilt from value for binary traces)
+		std::string str() const;
+
+		// value of a posInt/int argument
+		IDType toInt() const {
+			return (IDType) (long long) value;
+		}
+	};
+
+	class tokenType {
+	public:
+		OpType opType;
+		unsigned numOfArgs;
+		// args[0] is always the thread of the operation
+		fieldType args[MAXARGS];
+
+		tokenType() {
+			opType = INVALID_OP;
+			numOfArgs = 0;
+		}
+	};
+
+	// Returns true if [begin, end) is a valid line, and fills in token.
+	static bool tokenize(const char* begin, const char* end, tokenType& token);
+
+	// Returns the op whose name (ignoring case) is [begin, end), or INVALID_OP
+	// if the name is not part of the grammar.
+	static OpType opTypeFromName(const char* begin, const char* end);
+
+	// Returns the number and kinds of arguments of type, false if type is not
+	// part of the grammar.
+	static bool getArgKinds(OpType type, unsigned& numOfArgs, argKind kinds[MAXARGS]);
+
+	// Sets the kind and value of field from its text
+	static void decode(fieldType& field, argKind kind);
+
+	// Rebuilds the text of an operation, e.g. "alloc(1,0x10,8)"
+	static std::string toString(const tokenType& token);
+};
+
+#endif /* TRACETOKENIZER_H_ */
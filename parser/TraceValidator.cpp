@@ -0,0 +1,202 @@
+/*
+ * TraceValidator.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include "TraceValidator.h"
+#include <sstream>
+#include <algorithm>
+
+#include <debugconfig.h>
+
+using namespace std;
+
+TraceValidator::TraceValidator() {
+}
+
+TraceValidator::~TraceValidator() {
+}
+
+bool TraceValidator::checkOp(long long lineNumber, const TraceTokenizer::tokenType& token,
+		vector<string>& violations) {
+	violations.clear();
+
+	IDType thread = token.args[0].toInt();
+	threadState& state = threads[thread];
+
+	switch (token.opType) {
+	case THREADINIT_OP:
+		if (state.initialized)
+			violations.push_back("second threadinit of thread " + to_string(thread));
+		state.initialized = true;
+		break;
+	case THREADEXIT_OP:
+		checkThread(thread, state, violations);
+		for (unsigned i = 0; i < state.runningTasks.size(); i++)
+			violations.push_back("thread " + to_string(thread) + " exits while task "
+					+ to_string(state.runningTasks[i]) + " is running");
+		state.exited = true;
+		break;
+	case FORK_OP: {
+		checkThread(thread, state, violations);
+		IDType child = token.args[1].toInt();
+		threadState& childState = threads[child];
+		if (childState.forked || childState.initialized)
+			violations.push_back("thread " + to_string(child) + " is forked after it started");
+		childState.forked = true;
+		break;
+	}
+	case ENQ_OP: {
+		checkThread(thread, state, violations);
+		unsigned long long task = token.args[1].value;
+		if (tasks.find(task) != tasks.end())
+			violations.push_back("task " + to_string(task) + " is enqueued again");
+		else
+			tasks[task] = taskState();
+		break;
+	}
+	case DEQ_OP:
+		checkThread(thread, state, violations);
+		checkDeq(thread, token.args[1].value, lineNumber, violations);
+		break;
+	case END_OP:
+		checkThread(thread, state, violations);
+		checkEnd(thread, token.args[1].value, violations);
+		break;
+	case PAUSE_OP:
+	case PERMIT_OP:
+		checkThread(thread, state, violations);
+		checkPause(thread, token.args[1].value, token.args[2].value, violations);
+		break;
+	case RESUME_OP:
+	case REVOKE_OP:
+		checkThread(thread, state, violations);
+		checkResume(thread, token.args[1].value, token.args[2].value, violations);
+		break;
+	default:
+		checkThread(thread, state, violations);
+		break;
+	}
+
+	return violations.empty();
+}
+
+// A thread can be used between its threadinit and its threadexit. Reported
+// once per thread.
+void TraceValidator::checkThread(IDType thread, threadState& state, vector<string>& violations) {
+	if (state.reported)
+		return;
+	if (!state.initialized) {
+		violations.push_back("thread " + to_string(thread) + " is used before its threadinit");
+		state.reported = true;
+	} else if (state.exited) {
+		violations.push_back("thread " + to_string(thread) + " is used after its threadexit");
+		state.reported = true;
+	}
+}
+
+void TraceValidator::checkDeq(IDType thread, unsigned long long task, long long lineNumber,
+		vector<string>& violations) {
+	taskState& state = tasks[task];
+	if (state.status != TASK_ENQUEUED) {
+		ostringstream message;
+		message << "task " << task << " is dequeued again (first deq on line " << state.deqLine << ")";
+		violations.push_back(message.str());
+		if (state.status == TASK_RUNNING)
+			return;
+	}
+	state.status = TASK_RUNNING;
+	state.thread = thread;
+	state.deqLine = lineNumber;
+	threads[thread].runningTasks.push_back(task);
+}
+
+void TraceValidator::checkEnd(IDType thread, unsigned long long task, vector<string>& violations) {
+	unordered_map<unsigned long long, taskState>::iterator it = tasks.find(task);
+	if (it == tasks.end() || it->second.status == TASK_ENQUEUED) {
+		violations.push_back("task " + to_string(task) + " ends without a deq");
+		return;
+	}
+	if (it->second.status == TASK_ENDED) {
+		violations.push_back("task " + to_string(task) + " ends again");
+		return;
+	}
+	if (it->second.thread != thread) {
+		violations.push_back("task " + to_string(task) + " ends on thread " + to_string(thread)
+				+ " but was dequeued on thread " + to_string(it->second.thread));
+		return;
+	}
+
+	vector<unsigned long long>& running = threads[thread].runningTasks;
+	if (running.back() != task)
+		violations.push_back("task " + to_string(task) + " ends before task "
+				+ to_string(running.back()) + " dequeued after it on thread " + to_string(thread));
+	for (unsigned i = running.size(); i > 0; i--) {
+		if (running[i-1] == task) {
+			running.erase(running.begin() + (i-1));
+			break;
+		}
+	}
+
+	unordered_map<unsigned long long, unordered_map<unsigned long long, unsigned> >::iterator pauseIt
+		= openPauses.find(task);
+	if (pauseIt != openPauses.end()) {
+		violations.push_back("task " + to_string(task) + " ends with a pause that is not resumed");
+		openPauses.erase(pauseIt);
+	}
+	it->second.status = TASK_ENDED;
+}
+
+void TraceValidator::checkPause(IDType thread, unsigned long long task, unsigned long long variable,
+		vector<string>& violations) {
+	vector<unsigned long long>& running = threads[thread].runningTasks;
+	if (running.empty() || running.back() != task)
+		violations.push_back("pause of task " + to_string(task) + " which is not running on thread "
+				+ to_string(thread));
+
+	unsigned& count = openPauses[task][variable];
+	if (count > 0)
+		violations.push_back("task " + to_string(task) + " pauses again on " + addressToString(variable)
+				+ " without a resume");
+	count++;
+}
+
+void TraceValidator::checkResume(IDType thread, unsigned long long task, unsigned long long variable,
+		vector<string>& violations) {
+	vector<unsigned long long>& running = threads[thread].runningTasks;
+	if (running.empty() || running.back() != task)
+		violations.push_back("resume of task " + to_string(task) + " which is not running on thread "
+				+ to_string(thread));
+
+	unordered_map<unsigned long long, unordered_map<unsigned long long, unsigned> >::iterator it
+		= openPauses.find(task);
+	if (it == openPauses.end() || it->second.find(variable) == it->second.end()) {
+		violations.push_back("resume of task " + to_string(task) + " on " + addressToString(variable)
+				+ " without a pause");
+		return;
+	}
+	if (--it->second[variable] == 0) {
+		it->second.erase(variable);
+		if (it->second.empty())
+			openPauses.erase(it);
+	}
+}
+
+void TraceValidator::finish(vector<string>& violations) {
+	violations.clear();
+
+	// tasks still running, in the order of their deq
+	vector<pair<long long, unsigned long long> > running;
+	for (unordered_map<unsigned long long, taskState>::iterator it = tasks.begin(); it != tasks.end(); it++) {
+		if (it->second.status == TASK_RUNNING)
+			running.push_back(make_pair(it->second.deqLine, it->first));
+	}
+	sort(running.begin(), running.end());
+
+	for (unsigned i = 0; i < running.size(); i++) {
+		ostringstream message;
+		message << "task " << running[i].second << " dequeued on line " << running[i].first << " never ends";
+		violations.push_back(message.str());
+	}
+}
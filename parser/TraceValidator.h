@@ -0,0 +1,91 @@
+/*
+ * TraceValidator.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <parser/TraceTokenizer.h>
+
+#include <config.h>
+
+#ifndef TRACEVALIDATOR_H_
+#define TRACEVALIDATOR_H_
+
+/*
+ * TraceValidator checks the structure of a trace one op at a time, without
+ * building the HB graph or the maps of UAFDetector:
+ *   - every thread is initialized (threadinit) before its other ops and has
+ *     no ops after its threadexit,
+ *   - every task is dequeued once and ended once, on the thread that
+ *     dequeued it, after the tasks dequeued on that thread in between,
+ *   - every resume (revoke) matches an earlier pause (permit) of the same
+ *     task and shared variable, and a task is resumed on the thread running it.
+ * Only the state of threads and tasks is kept, so memory does not grow with
+ * the number of ops.
+ */
+class TraceValidator {
+public:
+	TraceValidator();
+	virtual ~TraceValidator();
+
+	// Checks the op on line lineNumber. Returns false and fills in
+	// violations if the op breaks the structure of the trace.
+	bool checkOp(long long lineNumber, const TraceTokenizer::tokenType& token,
+			std::vector<std::string>& violations);
+
+	// Fills in the violations left at the end of the trace (tasks that are
+	// dequeued but never end).
+	void finish(std::vector<std::string>& violations);
+
+private:
+	enum taskStatus {
+		TASK_ENQUEUED,
+		TASK_RUNNING,
+		TASK_ENDED
+	};
+
+	class taskState {
+	public:
+		taskStatus status;
+		IDType thread;			// thread that dequeued the task
+		long long deqLine;		// line of the deq
+
+		taskState() {
+			status = TASK_ENQUEUED;
+			thread = -1;
+			deqLine = 0;
+		}
+	};
+
+	class threadState {
+	public:
+		bool forked;
+		bool initialized;
+		bool exited;
+		bool reported;		// a use before threadinit/after threadexit was reported
+		std::vector<unsigned long long> runningTasks;	// innermost task last
+
+		threadState() {
+			forked = false;
+			initialized = false;
+			exited = false;
+			reported = false;
+		}
+	};
+
+	std::unordered_map<unsigned long long, taskState> tasks;
+	std::unordered_map<IDType, threadState> threads;
+	// pauses not resumed yet, by task and shared variable
+	std::unordered_map<unsigned long long, std::unordered_map<unsigned long long, unsigned> > openPauses;
+
+	void checkThread(IDType thread, threadState& state, std::vector<std::string>& violations);
+	void checkDeq(IDType thread, unsigned long long task, long long lineNumber, std::vector<std::string>& violations);
+	void checkEnd(IDType thread, unsigned long long task, std::vector<std::string>& violations);
+	void checkPause(IDType thread, unsigned long long task, unsigned long long variable, std::vector<std::string>& violations);
+	void checkResume(IDType thread, unsigned long long task, unsigned long long variable, std::vector<std::string>& violations);
+};
+
+#endif /* TRACEVALIDATOR_H_ */
@@ -0,0 +1,203 @@
+/*
+ * BitMatrix.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <racedetector/BitMatrix.h>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <cerrno>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BITMATRIX_AVX2
+#endif
+
+#include <debugconfig.h>
+
+using namespace std;
+
+// Rows start on a cache line
+static const size_t rowAlignment = 64;
+
+BitMatrix::BitMatrix() {
+	wordsPerPlane = 0;
+	wordsPerRow = 0;
+	words = NULL;
+	block = NULL;
+	blockSize = 0;
+	numOfRows = 0;
+	numOfPlanes = 0;
+	upperTriangular = false;
+}
+
+BitMatrix::~BitMatrix() {
+	release();
+}
+
+void BitMatrix::release() {
+	if (blockSize > 0)
+		munmap(block, blockSize);
+	else
+		free(block);
+	words = NULL;
+	block = NULL;
+	blockSize = 0;
+	numOfRows = 0;
+	upperTriangular = false;
+}
+
+bool BitMatrix::allocate(size_t rows, size_t numOfColumns, unsigned planes) {
+	release();
+
+	numOfRows = rows;
+	numOfPlanes = planes;
+	upperTriangular = false;
+	size_t numOfBlocks = (numOfColumns + bitsPerBlock - 1) / bitsPerBlock;
+	wordsPerPlane = numOfBlocks * wordsPerBlock;
+	wordsPerRow = wordsPerPlane * numOfPlanes;
+	size_t wordsPerLine = rowAlignment / sizeof(wordType);
+	wordsPerRow = (wordsPerRow + wordsPerLine - 1) / wordsPerLine * wordsPerLine;
+
+	return allocateBlock();
+}
+
+bool BitMatrix::allocateUpperTriangular(size_t size, unsigned planes) {
+	release();
+
+	numOfRows = size;
+	numOfPlanes = planes;
+	upperTriangular = true;
+	size_t numOfBlocks = (size + bitsPerBlock - 1) / bitsPerBlock;
+	wordsPerPlane = numOfBlocks * wordsPerBlock;
+	wordsPerRow = wordsPerPlane * numOfPlanes;
+
+	return allocateBlock();
+}
+
+bool BitMatrix::expandToSquare() {
+	if (!upperTriangular)
+		return true;
+
+	BitMatrix square;
+	square.setBackingDirectory(backingDirectory);
+	if (!square.allocate(numOfRows, numOfRows, numOfPlanes))
+		return false;
+	for (size_t row = 0; row < numOfRows; row++) {
+		for (unsigned plane = 0; plane < numOfPlanes; plane++)
+			memcpy(square.rowWords(row, plane) + firstWordOfRow(row), rowWords(row, plane),
+					wordsOfRow(row) * sizeof(wordType));
+	}
+
+	// take over the block of square, which frees this one
+	swap(words, square.words);
+	swap(block, square.block);
+	swap(blockSize, square.blockSize);
+	swap(wordsPerPlane, square.wordsPerPlane);
+	swap(wordsPerRow, square.wordsPerRow);
+	swap(upperTriangular, square.upperTriangular);
+	return true;
+}
+
+bool BitMatrix::allocateBlock() {
+	if (!backingDirectory.empty()) {
+		// a new file is read as zeros, and mappings start on a page. mkstemp
+		// only creates a file that does not exist yet.
+		string path = backingDirectory + "/sparseracer-hb-XXXXXX";
+		vector<char> pathName(path.begin(), path.end());
+		pathName.push_back('\0');
+		int fd = mkstemp(&pathName[0]);
+		if (fd < 0) {
+			cout << "ERROR: Cannot create a file in " << backingDirectory << ": " << strerror(errno) << "\n";
+			return false;
+		}
+		string backingFile(&pathName[0]);
+		size_t size = sizeInBytes() > 0 ? sizeInBytes() : rowAlignment;
+		void* mapping = MAP_FAILED;
+		if (ftruncate(fd, size) == 0)
+			mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_NORESERVE, fd, 0);
+		if (mapping == MAP_FAILED)
+			cout << "ERROR: Cannot map " << size << " bytes of " << backingFile << ": " << strerror(errno) << "\n";
+		close(fd);
+		unlink(backingFile.c_str());
+		if (mapping == MAP_FAILED)
+			return false;
+		block = mapping;
+		blockSize = size;
+		words = (wordType*) block;
+		return true;
+	}
+
+	// calloc leaves the pages of a large block untouched until they are used
+	block = calloc(sizeInBytes() + rowAlignment, 1);
+	if (block == NULL)
+		return false;
+	words = (wordType*) (((uintptr_t) block + rowAlignment - 1) / rowAlignment * rowAlignment);
+	return true;
+}
+
+void BitMatrix::willNeedRows(IDType firstRow, IDType lastRow) {
+	if (blockSize == 0 || firstRow > lastRow)
+		return;
+	uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+	uintptr_t begin = (uintptr_t) (words + rowStart(firstRow)) / pageSize * pageSize;
+	uintptr_t end = (uintptr_t) (words + rowStart((size_t) lastRow + 1));
+	madvise((void*) begin, end - begin, MADV_WILLNEED);
+}
+
+void BitMatrix::clearRow(IDType row, unsigned plane) {
+	memset(rowWords(row, plane), 0, wordsOfRow(row) * sizeof(wordType));
+}
+
+typedef void (*orWordsType)(BitMatrix::wordType*, const BitMatrix::wordType*, size_t);
+
+static void orWordsScalar(BitMatrix::wordType* destination, const BitMatrix::wordType* source, size_t numOfWords) {
+	for (size_t i = 0; i < numOfWords; i++)
+		destination[i] |= source[i];
+}
+
+#ifdef BITMATRIX_AVX2
+// Compiled for AVX2 whatever the flags of the build, only called if the
+// processor has it
+__attribute__((target("avx2")))
+static void orWordsAVX2(BitMatrix::wordType* destination, const BitMatrix::wordType* source, size_t numOfWords) {
+	for (size_t i = 0; i < numOfWords; i += BitMatrix::wordsPerBlock) {
+		__m256i d = _mm256_loadu_si256((const __m256i*) (destination + i));
+		__m256i s = _mm256_loadu_si256((const __m256i*) (source + i));
+		_mm256_storeu_si256((__m256i*) (destination + i), _mm256_or_si256(d, s));
+	}
+}
+#endif
+
+static bool hasAVX2() {
+#ifdef BITMATRIX_AVX2
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+static orWordsType selectOrWords() {
+#ifdef BITMATRIX_AVX2
+	if (hasAVX2())
+		return orWordsAVX2;
+#endif
+	return orWordsScalar;
+}
+
+void BitMatrix::orWords(wordType* destination, const wordType* source, size_t numOfWords) {
+	static const orWordsType kernel = selectOrWords();
+	kernel(destination, source, numOfWords);
+}
+
+const char* BitMatrix::orWordsKernel() {
+	return (hasAVX2() ? "avx2" : "scalar");
+}
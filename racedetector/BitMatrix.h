@@ -0,0 +1,157 @@
+/*
+ * BitMatrix.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <cstddef>
+#include <string>
+#include <stdint.h>
+
+#include <config.h>
+
+#ifndef BITMATRIX_H_
+#define BITMATRIX_H_
+
+/*
+ * Matrix of bits in one zeroed block, one bit per (row, column) pair in each
+ * of its planes (HBGraph keeps edges in plane 0 and edge types in plane 1).
+ * A row holds the words of plane 0, then the words of plane 1, ...
+ * Each plane of a row starts on a 32 byte boundary and rows start on a cache
+ * line, so whole rows can be combined a word (or a vector of words) at a time
+ * with orWords().
+ *
+ * An upper triangular matrix only keeps, in each row r, the blocks of
+ * wordsPerBlock words from the one holding column r+1 on (the bits before are
+ * 0), in about half the memory. Its rows are packed one after the other.
+ *
+ * With a backing directory (setBackingDirectory()), the block is a shared
+ * mapping of a new file in that directory rather than memory: the rows are
+ * written back to the file by the page cache, so a matrix larger than memory
+ * can be used as long as the rows in use at a time fit. The file is removed
+ * once it is mapped.
+ */
+class BitMatrix {
+public:
+	typedef uint64_t wordType;
+	static const unsigned bitsPerWord = 64;
+	// words of a plane of a row are a multiple of this (32 bytes)
+	static const unsigned wordsPerBlock = 4;
+	static const unsigned bitsPerBlock = wordsPerBlock * bitsPerWord;
+
+	BitMatrix();
+	virtual ~BitMatrix();
+
+	// Allocates (zeroed) numOfRows rows of numOfColumns columns in each of
+	// numOfPlanes planes. Returns false if there is not enough memory.
+	bool allocate(size_t numOfRows, size_t numOfColumns, unsigned numOfPlanes);
+	// Allocates an upper triangular matrix of size rows and columns
+	bool allocateUpperTriangular(size_t size, unsigned numOfPlanes);
+
+	// Keeps the matrices allocated from now on in new files in directory
+	// (in memory again if directory is empty)
+	void setBackingDirectory(const std::string& directory) {
+		backingDirectory = directory;
+	}
+
+	// Turns an upper triangular matrix into a full one with the same bits
+	// (nothing if it is not upper triangular). Returns false if there is not
+	// enough memory, leaving the matrix as it was.
+	bool expandToSquare();
+
+	// Frees the matrix
+	void release();
+
+	// Asks for the rows firstRow..lastRow of a file backed matrix to be read
+	// in ahead of their use (nothing for a matrix in memory)
+	void willNeedRows(IDType firstRow, IDType lastRow);
+
+	bool isAllocated() const {
+		return words != NULL;
+	}
+
+	bool get(IDType row, IDType column, unsigned plane) const {
+		if (column / bitsPerWord < firstWordOfRow(row))
+			return false;
+		return (words[wordIndex(row, column, plane)] >> (column % bitsPerWord)) & 1;
+	}
+
+	void set(IDType row, IDType column, unsigned plane) {
+		words[wordIndex(row, column, plane)] |= (wordType) 1 << (column % bitsPerWord);
+	}
+
+	void clear(IDType row, IDType column, unsigned plane) {
+		words[wordIndex(row, column, plane)] &= ~((wordType) 1 << (column % bitsPerWord));
+	}
+
+	void assign(IDType row, IDType column, unsigned plane, bool value) {
+		if (value)
+			set(row, column, plane);
+		else
+			clear(row, column, plane);
+	}
+
+	// Word of the first column kept in row: 0, unless upper triangular
+	size_t firstWordOfRow(IDType row) const {
+		return (upperTriangular ? (size_t) (row + 1) / bitsPerBlock * wordsPerBlock : 0);
+	}
+
+	// Words of a plane kept in row (a multiple of wordsPerBlock)
+	size_t wordsOfRow(IDType row) const {
+		return wordsPerPlane - firstWordOfRow(row);
+	}
+
+	// Word firstWordOfRow(row) of plane of row (wordsOfRow(row) words)
+	wordType* rowWords(IDType row, unsigned plane) {
+		return words + rowStart(row) + (size_t) plane * wordsOfRow(row);
+	}
+
+	// Clears plane of row
+	void clearRow(IDType row, unsigned plane);
+
+	// destination[i] |= source[i] for the numOfWords (a multiple of
+	// wordsPerBlock) words. Uses AVX2 if the processor has it.
+	static void orWords(wordType* destination, const wordType* source, size_t numOfWords);
+
+	// Instruction set used by orWords() ("avx2" or "scalar")
+	static const char* orWordsKernel();
+
+	size_t wordsPerPlane;
+	size_t wordsPerRow;
+
+	// Bytes allocated for the matrix
+	size_t sizeInBytes() const {
+		return rowStart(numOfRows) * sizeof(wordType);
+	}
+
+private:
+	wordType* words;		// aligned start of the matrix in block
+	void* block;			// allocated block
+	size_t blockSize;		// bytes of the mapping if backed by a file, else 0
+	std::string backingDirectory;
+	size_t numOfRows;
+	unsigned numOfPlanes;
+	bool upperTriangular;
+
+	// Index of the first word of row in words
+	size_t rowStart(size_t row) const {
+		if (!upperTriangular)
+			return row * wordsPerRow;
+		// blocks left out of the rows before row: sum of (r+1) / bitsPerBlock for r < row
+		size_t q = row / bitsPerBlock, m = row % bitsPerBlock;
+		size_t blocksLeftOut = bitsPerBlock * q * (q - 1) / 2 + q * (m + 1);
+		return numOfPlanes * (row * wordsPerPlane - blocksLeftOut * wordsPerBlock);
+	}
+
+	bool allocateBlock();
+
+	size_t wordIndex(IDType row, IDType column, unsigned plane) const {
+		return rowStart(row) + (size_t) plane * wordsOfRow(row) + column / bitsPerWord - firstWordOfRow(row);
+	}
+
+	// not copyable
+	BitMatrix(const BitMatrix&);
+	BitMatrix& operator=(const BitMatrix&);
+};
+
+#endif /* BITMATRIX_H_ */
@@ -0,0 +1,90 @@
+/*
+ * ChainIndex.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <racedetector/ChainIndex.h>
+
+#include <debugconfig.h>
+
+using namespace std;
+
+ChainIndex::ChainIndex() {
+	numOfThreads = 0;
+}
+
+ChainIndex::~ChainIndex() {
+}
+
+void ChainIndex::build(BitMatrix& matrix, unsigned edges, unsigned edgeTypes, IDType numOfNodes,
+		const vector<IDType>& threads, IDType countOfThreads) {
+	typedef BitMatrix::wordType wordType;
+
+	numOfThreads = countOfThreads;
+	threadOfNode = threads;
+	threadOfNode.resize(numOfNodes + 1, 0);
+
+	// chains of the threads
+	vector<vector<IDType> > chains(numOfThreads);
+	positionOfNode.assign(numOfNodes + 1, 0);
+	for (IDType node = 1; node <= numOfNodes; node++) {
+		positionOfNode[node] = chains[threadOfNode[node]].size();
+		chains[threadOfNode[node]].push_back(node);
+	}
+
+	suffixStart.assign((size_t) (numOfNodes + 1) * numOfThreads, 0);
+	exceptionsBegin.assign(numOfNodes + 2, 0);
+	typeExceptionsBegin.assign(numOfNodes + 2, 0);
+	exceptions.clear();
+	typeExceptions.clear();
+
+	for (IDType node = 0; node <= numOfNodes; node++) {
+		exceptionsBegin[node] = exceptions.size();
+		typeExceptionsBegin[node] = typeExceptions.size();
+		IDType* start = &suffixStart[(size_t) node * numOfThreads];
+		if (node == 0) {
+			for (IDType t = 0; t < numOfThreads; t++)
+				start[t] = chains[t].size();
+			continue;
+		}
+
+		// longest suffix of each chain the node has edges to
+		for (IDType t = 0; t < numOfThreads; t++) {
+			IDType position = chains[t].size();
+			while (position > 0 && matrix.get(node, chains[t][position-1], edges))
+				position--;
+			start[t] = position;
+		}
+
+		// words of the row from firstWord (the matrix can be upper triangular)
+		size_t firstWord = matrix.firstWordOfRow(node);
+		const wordType* row = matrix.rowWords(node, edges) - firstWord;
+		const wordType* types = matrix.rowWords(node, edgeTypes) - firstWord;
+		for (size_t w = firstWord; w < matrix.wordsPerPlane; w++) {
+			wordType bits = row[w];
+			while (bits != 0) {
+				unsigned bit = __builtin_ctzll(bits);
+				bits &= bits - 1;
+				IDType destination = w * BitMatrix::bitsPerWord + bit;
+				if (destination > numOfNodes)
+					break;
+
+				IDType thread = threadOfNode[destination];
+				if (positionOfNode[destination] < start[thread])
+					exceptions.push_back(destination);
+				bool st = (types[w] >> bit) & 1;
+				if (st != (thread == threadOfNode[node]))
+					typeExceptions.push_back(destination);
+			}
+		}
+	}
+	exceptionsBegin[numOfNodes + 1] = exceptions.size();
+	typeExceptionsBegin[numOfNodes + 1] = typeExceptions.size();
+}
+
+size_t ChainIndex::sizeInBytes() const {
+	return (threadOfNode.size() + positionOfNode.size() + suffixStart.size()
+			+ exceptions.size() + typeExceptions.size()) * sizeof(IDType)
+			+ (exceptionsBegin.size() + typeExceptionsBegin.size()) * sizeof(size_t);
+}
@@ -0,0 +1,78 @@
+/*
+ * ChainIndex.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+#include <racedetector/BitMatrix.h>
+
+#include <config.h>
+
+#ifndef CHAININDEX_H_
+#define CHAININDEX_H_
+
+/*
+ * Edges of a closed HB graph indexed by thread chains, in place of the dense
+ * matrix (O(nodes x threads) words plus the exceptions below, instead of
+ * O(nodes^2) bits).
+ *
+ * The nodes of each thread, in increasing node ID, form the chain of the
+ * thread. For each node and thread, suffixStart is the first position in the
+ * chain from which the node has an edge to every node of the chain, so most
+ * edges are answered by one comparison. The HB relation is only closed under
+ * TRANS-ST/MT on a thread (and not across threads without ADVANCEDRULES), so
+ * a node can also have edges to nodes before that position: these are kept,
+ * sorted, as exceptions. Likewise an edge is ST if its nodes are on the same
+ * thread, except for the (sorted) type exceptions.
+ */
+class ChainIndex {
+public:
+	ChainIndex();
+	virtual ~ChainIndex();
+
+	// Builds the index from plane edges (and plane edgeTypes for the ST
+	// edges) of matrix, for nodes 1 to numOfNodes. threadOfNode[n] is the
+	// thread of node n, from 0 to numOfThreads-1.
+	void build(BitMatrix& matrix, unsigned edges, unsigned edgeTypes, IDType numOfNodes,
+			const std::vector<IDType>& threadOfNode, IDType numOfThreads);
+
+	bool edgeExists(IDType source, IDType destination) const {
+		IDType thread = threadOfNode[destination];
+		if (positionOfNode[destination] >= suffixStart[(size_t) source * numOfThreads + thread])
+			return true;
+		return std::binary_search(exceptions.begin() + exceptionsBegin[source],
+				exceptions.begin() + exceptionsBegin[source+1], destination);
+	}
+
+	// Only for an existing edge
+	bool isSTEdge(IDType source, IDType destination) const {
+		bool sameThread = (threadOfNode[source] == threadOfNode[destination]);
+		bool exception = std::binary_search(typeExceptions.begin() + typeExceptionsBegin[source],
+				typeExceptions.begin() + typeExceptionsBegin[source+1], destination);
+		return sameThread != exception;
+	}
+
+	size_t numOfExceptions() const {
+		return exceptions.size() + typeExceptions.size();
+	}
+
+	size_t sizeInBytes() const;
+
+private:
+	IDType numOfThreads;
+	std::vector<IDType> threadOfNode;
+	std::vector<IDType> positionOfNode;		// position of the node in the chain of its thread
+	std::vector<IDType> suffixStart;		// [node * numOfThreads + thread]
+
+	// destinations of the exceptions of node n: [exceptionsBegin[n], exceptionsBegin[n+1])
+	std::vector<size_t> exceptionsBegin;
+	std::vector<IDType> exceptions;
+	std::vector<size_t> typeExceptionsBegin;
+	std::vector<IDType> typeExceptions;
+};
+
+#endif /* CHAININDEX_H_ */
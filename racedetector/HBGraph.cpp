@@ -11,47 +11,46 @@
 #include <cstdlib>
 #include <cstring>
 #include <cassert>
-typedef std::multiset<HBGraph::adjListNode>::iterator nodeIterator;
+#include <algorithm>
 
 HBGraph::HBGraph(){
 	totalOps = 0;
 	numOfOpEdges = 0;
-	opIDMap = map<IDType, UAFDetector::opDetails>();
-	nodeIDMap = map<IDType, UAFDetector::setOfOps>();
+	edgeSerial = 0;
+	chainIndex = NULL;
+	forwardEdgesOnly = false;
+	lazyThreadOfNode = NULL;
+	lazyThreadMasks = NULL;
 
-	opAdjList = std::map<IDType, adjListType*>();
-	opAdjMatrix = NULL;
-	opEdgeTypeMatrix = NULL;
+	opSuccessors.resize(1);
 }
 
-HBGraph::HBGraph(IDType countOfOps,
-		map<IDType, UAFDetector::opDetails> opMap,
-		map<IDType, UAFDetector::setOfOps> nodeMap) {
+HBGraph::HBGraph(IDType countOfOps, bool upperTriangular, const std::string& matrixDirectory) {
 	totalOps = countOfOps;
 	numOfOpEdges = 0;
+	edgeSerial = 0;
+	lastEdgeFrom.assign(totalOps+1, 0);
+	chainIndex = NULL;
+	forwardEdgesOnly = upperTriangular;
+	lazyThreadOfNode = NULL;
+	lazyThreadMasks = NULL;
 
-	opIDMap = opMap;
-	nodeIDMap = nodeMap;
-
-	opAdjMatrix = (bool**) malloc(sizeof(bool*) * (totalOps+1));
-	opEdgeTypeMatrix = (bool**) malloc(sizeof(bool*) * (totalOps+1));
-
-	if (opAdjMatrix == NULL) {
-		cout << "ERROR: Cannot allocate memory for opAdjMatrix\n";
-	}
-	if (opEdgeTypeMatrix == NULL) {
-		cout << "ERROR: Cannot allocate memory for opEdgeTypeMatrix\n";
+	opMatrix.setBackingDirectory(matrixDirectory);
+	bool allocated;
+	if (upperTriangular)
+		allocated = opMatrix.allocateUpperTriangular(totalOps+1, 2);
+	else
+		allocated = opMatrix.allocate(totalOps+1, totalOps+1, 2);
+	if (!allocated) {
+		cout << "ERROR: Cannot allocate memory for opMatrix\n";
+		return;
 	}
 
-	opAdjList = std::map<IDType, adjListType*>();
-
-	for (IDType i=1; i <= totalOps; i++) {
-		opAdjMatrix[i] = (bool*) calloc((totalOps+1) , sizeof(bool));
-		opEdgeTypeMatrix[i] = (bool*) calloc((totalOps+1), sizeof(bool));
-	}
+	opSuccessors.resize(totalOps+1);
 }
 
 HBGraph::~HBGraph() {
+	delete chainIndex;
 }
 
 int HBGraph::addOpEdge(IDType sourceNode, IDType destinationNode, bool edgeType) {
@@ -60,8 +59,23 @@ int HBGraph::addOpEdge(IDType sourceNode, IDType destinationNode, bool edgeType)
 	assert(1 <= sourceNode      && sourceNode <= totalOps);
 	assert(1 <= destinationNode && destinationNode <= totalOps);
 	assert(sourceNode != destinationNode);
+	assert(chainIndex == NULL);
+	assert(frozenBegin.empty());
 #endif
 
+	// Nodes are numbered in trace order and most HB edges go to later nodes,
+	// but ENQRESET-ST-2/3 can add an edge to an earlier one: the lower
+	// triangle is needed from then on
+	if (forwardEdgesOnly && sourceNode > destinationNode) {
+		if (!opMatrix.expandToSquare()) {
+			cout << "ERROR: Cannot allocate memory for opMatrix\n";
+			return -1;
+		}
+		forwardEdgesOnly = false;
+	}
+	if (lazyThreadOfNode != NULL && sourceNode > destinationNode)
+		stopClosingRowsOnDemand();
+
 	int retOpValue = opEdgeExists(sourceNode, destinationNode);
 	if (retOpValue == 0) {
 #ifdef SANITYCHECK
@@ -73,21 +87,17 @@ int HBGraph::addOpEdge(IDType sourceNode, IDType destinationNode, bool edgeType)
 
 #endif
 
-		opAdjMatrix[sourceNode][destinationNode] = true;
-		opEdgeTypeMatrix[sourceNode][destinationNode] = edgeType;
-
-		if (opAdjList.find(sourceNode) == opAdjList.end()) {
-			adjListNode* newNode = new adjListNode(destinationNode);
-			adjListType* newList = new adjListType;
-			newList->head = newNode;
-			opAdjList[sourceNode] = newList;
-		} else {
-			adjListNode* newNode = new adjListNode(destinationNode);
-			newNode->next = opAdjList[sourceNode]->head;
-			opAdjList[sourceNode]->head = newNode;
-		}
+		opMatrix.set(sourceNode, destinationNode, EDGES);
+		opMatrix.assign(sourceNode, destinationNode, EDGETYPES, edgeType);
+
+		opSuccessors[sourceNode].push_back(destinationNode);
 
 		numOfOpEdges++;
+		lastEdgeFrom[sourceNode] = ++edgeSerial;
+		// once committed, the rows of the earlier nodes of the thread have to
+		// be closed again
+		if (lazyThreadOfNode != NULL)
+			uncommittedEdges.push_back(std::make_pair(edgeSerial, sourceNode));
 
 		return 1;
 	} else if (retOpValue == 1)
@@ -98,35 +108,20 @@ int HBGraph::addOpEdge(IDType sourceNode, IDType destinationNode, bool edgeType)
 	return -1;
 }
 
-// currNode is the adjListNode containing destinationOp in the adjacency list of sourceOp
 int HBGraph::removeOpEdge(IDType sourceNode, IDType destinationNode) {
 #ifdef SANITYCHECK
 	assert(1 <= sourceNode && sourceNode <= totalOps);
 	assert(1 <= destinationNode && destinationNode <= totalOps);
+	assert(frozenBegin.empty());
 #endif
 
-	if (opAdjList.find(sourceNode) != opAdjList.end()) {
-		adjListNode* currNode = opAdjList[sourceNode]->head;
-		adjListNode* prevNode = NULL;
-		while (currNode != NULL) {
-			if (currNode->nodeID == destinationNode) {
-				if (!prevNode) {
-					opAdjList[sourceNode]->head = currNode->next;
-					delete currNode;
-					break;
-				} else {
-					prevNode->next = currNode->next;
-					delete currNode;
-					break;
-				}
-			}
-			prevNode = currNode;
-			currNode = currNode->next;
-		}
-	}
+	std::vector<IDType>& successors = opSuccessors[sourceNode];
+	std::vector<IDType>::iterator it = std::find(successors.begin(), successors.end(), destinationNode);
+	if (it != successors.end())
+		successors.erase(it);
 
-	opAdjMatrix[sourceNode][destinationNode] = false;
-	opEdgeTypeMatrix[sourceNode][destinationNode] = false;
+	opMatrix.clear(sourceNode, destinationNode, EDGES);
+	opMatrix.clear(sourceNode, destinationNode, EDGETYPES);
 	numOfOpEdges--;
 	return 0;
 }
@@ -139,15 +134,42 @@ int HBGraph::opEdgeExists(IDType sourceNode, IDType destinationNode) {
 		cout << "ERROR: sourceNode == destinationNode: " << sourceNode << "\n";
 	}
 	assert(sourceNode != destinationNode);
-	assert(opAdjMatrix[sourceNode][destinationNode] == true || opAdjMatrix[sourceNode][destinationNode] == false);
-	//assert(opAdjMatrix[sourceNode][destinationNode] == opEdgeExistsinList(sourceNode, destinationNode));
 #endif
 
-	if (opAdjMatrix[sourceNode][destinationNode])
+	if (chainIndex != NULL)
+		return (chainIndex->edgeExists(sourceNode, destinationNode) ? 1 : 0);
+
+	if (opMatrix.get(sourceNode, destinationNode, EDGES))
 		return 1;
-	else
+
+	// TRANS-ST/MT edges go to later nodes of the same thread, and a closed
+	// row has them all
+	if (lazyThreadOfNode == NULL || sourceNode > destinationNode
+			|| (*lazyThreadOfNode)[sourceNode] != (*lazyThreadOfNode)[destinationNode]
+			|| rowIsClosed(sourceNode))
+		return 0;
+
+	unsigned long long key = ((unsigned long long) sourceNode << 32) | (unsigned long long) destinationNode;
+	std::unordered_map<unsigned long long, unsigned long long>::iterator it = unreachableAt.find(key);
+	if (it != unreachableAt.end() && unchangedSince(sourceNode, it->second))
 		return 0;
 
+	int reached = reachesOnThread(sourceNode, destinationNode);
+	if (reached == -1) {
+		// too far to search for each query: close the row once instead
+		if (closeRow(sourceNode) < 0)
+			return -1;
+		return (opMatrix.get(sourceNode, destinationNode, EDGES) ? 1 : 0);
+	}
+	if (reached == 1) {
+		addDerivedEdge(sourceNode, destinationNode);
+		return 1;
+	}
+	// bound the cache (entries go stale as edges are added)
+	if (unreachableAt.size() >= (1 << 20))
+		unreachableAt.clear();
+	unreachableAt[key] = edgeSerial + 1;
+	return 0;
 }
 
 void HBGraph::printGraph() {
@@ -155,19 +177,232 @@ void HBGraph::printGraph() {
 	cout << "\nOp Edges:";
 	for (IDType i=1; i <= totalOps; i++) {
 		cout << endl << i << ": ";
-		if (opAdjList.find(i) == opAdjList.end())
-			cout << "";
-		else {
-			adjListNode* currNode = opAdjList[i]->head;
-			while (currNode != NULL) {
-				cout << currNode->nodeID << " ";
-				currNode = currNode->next;
-			}
-		}
+		for (IDType succ = numOfSuccessors(i); succ-- > 0; )
+			cout << successor(i, succ) << " ";
 	}
 	cout << "\n";
 }
 
+void HBGraph::freezeSuccessors() {
+	if (!frozenBegin.empty())
+		return;
+
+	frozenBegin.assign(totalOps+2, 0);
+	for (IDType node = 0; node <= totalOps; node++)
+		frozenBegin[node+1] = frozenBegin[node] + opSuccessors[node].size();
+
+	frozenSuccessors.resize(frozenBegin[totalOps+1]);
+	for (IDType node = 0; node <= totalOps; node++) {
+		std::copy(opSuccessors[node].begin(), opSuccessors[node].end(), frozenSuccessors.begin() + frozenBegin[node]);
+		std::vector<IDType>().swap(opSuccessors[node]);
+	}
+}
+
 bool HBGraph::isSTEdge(IDType sourceNode, IDType destinationNode) {
-	return opEdgeTypeMatrix[sourceNode][destinationNode];
+	if (chainIndex != NULL)
+		return chainIndex->isSTEdge(sourceNode, destinationNode);
+	return opMatrix.get(sourceNode, destinationNode, EDGETYPES);
+}
+
+void HBGraph::freezeToChains(const std::vector<IDType>& threadOfNode, IDType numOfThreads) {
+	// the index needs every row closed
+	if (lazyThreadOfNode != NULL) {
+		for (IDType node = totalOps; node >= 1; node--) {
+			if (!rowIsClosed(node))
+				closeRow(node);
+		}
+	}
+
+	chainIndex = new ChainIndex();
+	chainIndex->build(opMatrix, EDGES, EDGETYPES, totalOps, threadOfNode, numOfThreads);
+	opMatrix.release();
+}
+
+void HBGraph::closeRowsOnDemand(const std::vector<IDType>* threadOfNode, BitMatrix* threadMasks) {
+	lazyThreadOfNode = threadOfNode;
+	lazyThreadMasks = threadMasks;
+
+	IDType numOfThreadIndices = 0;
+	for (IDType node = 0; node <= totalOps; node++) {
+		if ((*threadOfNode)[node] + 1 > numOfThreadIndices)
+			numOfThreadIndices = (*threadOfNode)[node] + 1;
+	}
+	edgesOfThread.assign(numOfThreadIndices, threadEdges());
+	uncommittedEdges.clear();
+	rowClosedAt.assign(totalOps+1, 0);
+	unreachableAt.clear();
+	if (!lazyScratch.allocate(1, totalOps+1, 3)) {
+		cout << "ERROR: Cannot allocate memory for closing rows on demand\n";
+	}
+}
+
+void HBGraph::stopClosingRowsOnDemand() {
+	lazyThreadOfNode = NULL;
+	lazyThreadMasks = NULL;
+	std::vector<threadEdges>().swap(edgesOfThread);
+	std::vector<std::pair<unsigned long long, IDType> >().swap(uncommittedEdges);
+	std::vector<unsigned long long>().swap(rowClosedAt);
+	unreachableAt.clear();
+	lazyScratch.release();
+}
+
+void HBGraph::addDerivedEdge(IDType sourceNode, IDType destinationNode) {
+	opMatrix.set(sourceNode, destinationNode, EDGES);
+	opMatrix.set(sourceNode, destinationNode, EDGETYPES);
+	if (frozenBegin.empty())
+		opSuccessors[sourceNode].push_back(destinationNode);
+	numOfOpEdges++;
+	lastEdgeFrom[sourceNode] = ++edgeSerial;
+}
+
+// Nodes a search of reachesOnThread() visits before it gives up
+#define SEARCHLIMIT 64
+
+int HBGraph::reachesOnThread(IDType sourceNode, IDType destinationNode) {
+	typedef BitMatrix::wordType wordType;
+
+	IDType thread = (*lazyThreadOfNode)[sourceNode];
+	const wordType* mask = lazyThreadMasks->rowWords(thread, 0);
+	size_t lastWord = destinationNode / BitMatrix::bitsPerWord;
+	wordType destinationBit = (wordType) 1 << (destinationNode % BitMatrix::bitsPerWord);
+	// nodes after destinationNode cannot reach it
+	wordType lastWordMask = destinationBit | (destinationBit - 1);
+
+	// only the nodes from sourceNode to destinationNode are visited
+	wordType* visited = lazyScratch.rowWords(0, 0);
+	size_t firstWord = sourceNode / BitMatrix::bitsPerWord;
+	memset(visited + firstWord, 0, (lastWord + 1 - firstWord) * sizeof(wordType));
+
+	unsigned numOfVisits = 0;
+	lazyStack.clear();
+	lazyStack.push_back(std::make_pair(sourceNode, false));
+	while (!lazyStack.empty()) {
+		IDType node = lazyStack.back().first;
+		lazyStack.pop_back();
+
+		// a closed row has the nodes it reaches as ST edges
+		if (rowIsClosed(node)) {
+			if (opMatrix.get(node, destinationNode, EDGETYPES))
+				return 1;
+			continue;
+		}
+		if (++numOfVisits > SEARCHLIMIT)
+			return -1;
+
+		size_t firstWordOfRow = opMatrix.firstWordOfRow(node);
+		const wordType* types = opMatrix.rowWords(node, EDGETYPES) - firstWordOfRow;
+		for (size_t w = std::max(firstWordOfRow, (size_t) node / BitMatrix::bitsPerWord); w <= lastWord; w++) {
+			wordType successors = types[w] & mask[w] & ~visited[w];
+			if (w == lastWord) {
+				if (successors & destinationBit)
+					return 1;
+				successors &= lastWordMask;
+			}
+			visited[w] |= successors;
+			while (successors != 0) {
+				IDType successor = w * BitMatrix::bitsPerWord + __builtin_ctzll(successors);
+				successors &= successors - 1;
+				lazyStack.push_back(std::make_pair(successor, false));
+			}
+		}
+	}
+	return 0;
+}
+
+int HBGraph::closeRow(IDType node) {
+	typedef BitMatrix::wordType wordType;
+
+	size_t numOfWords = opMatrix.wordsPerPlane;
+
+	// Depth first, so that the rows of the ST successors on the thread are
+	// closed before they are ORed into the row of their predecessor. A node
+	// stays on the stack (plane 2 of lazyScratch) from when it is expanded
+	// until its row is closed, so reaching it again means a cycle.
+	lazyStack.clear();
+	lazyStack.push_back(std::make_pair(node, false));
+	while (!lazyStack.empty()) {
+		IDType nodeK = lazyStack.back().first;
+		bool expanded = lazyStack.back().second;
+		if (rowIsClosed(nodeK)) {
+			lazyStack.pop_back();
+			continue;
+		}
+
+		IDType thread = (*lazyThreadOfNode)[nodeK];
+		const wordType* mask = lazyThreadMasks->rowWords(thread, 0);
+		size_t firstWord = opMatrix.firstWordOfRow(nodeK);
+		const wordType* types = opMatrix.rowWords(nodeK, EDGETYPES) - firstWord;
+
+		if (!expanded) {
+			lazyStack.back().second = true;
+			lazyScratch.set(0, nodeK, 2);
+			for (size_t w = firstWord; w < numOfWords; w++) {
+				wordType successors = types[w] & mask[w];
+				while (successors != 0) {
+					IDType nodeJ = w * BitMatrix::bitsPerWord + __builtin_ctzll(successors);
+					successors &= successors - 1;
+					if (lazyScratch.get(0, nodeJ, 2)) {
+						cout << "ERROR: Cycle through edge from " << nodeK << " to " << nodeJ << "\n";
+						lazyScratch.clearRow(0, 2);
+						return -1;
+					}
+					if (!rowIsClosed(nodeJ))
+						lazyStack.push_back(std::make_pair(nodeJ, false));
+				}
+			}
+			continue;
+		}
+		lazyStack.pop_back();
+		lazyScratch.clear(0, nodeK, 2);
+
+		// every ST successor on the thread is closed now
+		wordType* reached = lazyScratch.rowWords(0, 1);
+		lazyScratch.clearRow(0, 1);
+		for (size_t w = firstWord; w < numOfWords; w++) {
+			wordType successors = types[w] & mask[w];
+			while (successors != 0) {
+				IDType nodeJ = w * BitMatrix::bitsPerWord + __builtin_ctzll(successors);
+				successors &= successors - 1;
+				size_t firstWordJ = opMatrix.firstWordOfRow(nodeJ);
+				BitMatrix::orWords(reached + firstWordJ, opMatrix.rowWords(nodeJ, EDGETYPES), numOfWords - firstWordJ);
+			}
+		}
+
+		const wordType* edges = opMatrix.rowWords(nodeK, EDGES) - firstWord;
+		for (size_t w = firstWord; w < numOfWords; w++) {
+			wordType newEdges = reached[w] & mask[w] & ~edges[w];
+			while (newEdges != 0) {
+				IDType nodeJ = w * BitMatrix::bitsPerWord + __builtin_ctzll(newEdges);
+				newEdges &= newEdges - 1;
+				addDerivedEdge(nodeK, nodeJ);
+			}
+		}
+		rowClosedAt[nodeK] = edgeSerial + 1;
+	}
+	return 0;
+}
+
+void HBGraph::commitEdges() {
+	for (size_t i = 0; i < uncommittedEdges.size(); i++) {
+		IDType sourceNode = uncommittedEdges[i].second;
+		threadEdges& edges = edgesOfThread[(*lazyThreadOfNode)[sourceNode]];
+		while (!edges.sources.empty() && edges.sources.back() <= sourceNode) {
+			edges.sources.pop_back();
+			edges.serials.pop_back();
+		}
+		edges.serials.push_back(uncommittedEdges[i].first);
+		edges.sources.push_back(sourceNode);
+	}
+	uncommittedEdges.clear();
+}
+
+bool HBGraph::unchangedSince(IDType node, unsigned long long since) const {
+	if (since == 0)
+		return false;
+	// the latest source of the edges of the thread from since on
+	const threadEdges& edges = edgesOfThread[(*lazyThreadOfNode)[node]];
+	std::vector<unsigned long long>::const_iterator it = std::lower_bound(edges.serials.begin(), edges.serials.end(), since);
+	if (it == edges.serials.end())
+		return true;
+	return edges.sources[it - edges.serials.begin()] < node;
 }
@@ -0,0 +1,141 @@
+/*
+ * IDMap.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <utility>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+#include <config.h>
+
+#ifndef IDMAP_H_
+#define IDMAP_H_
+
+/*
+ * Map from a dense, non-negative ID (op, node or task ID) to its details,
+ * stored in a vector indexed by ID. Works like the std::map it replaces:
+ * operator[] adds an entry, find() returns end() for an ID without one, and
+ * iterators (it->first is the ID, it->second its details) visit the IDs with
+ * an entry in increasing order.
+ *
+ * Iterators remember the index of their entry, so they stay valid when the
+ * map grows. References returned by operator[] do not.
+ */
+template<typename KeyType, typename ValueType>
+class IDMap {
+public:
+	typedef std::pair<KeyType, ValueType> entryType;
+
+	class iterator {
+	public:
+		iterator(IDMap* m, KeyType k) {
+			owner = m;
+			key = k;
+		}
+
+		entryType& operator*() const {
+			return owner->entries[key];
+		}
+
+		entryType* operator->() const {
+			return &(owner->entries[key]);
+		}
+
+		iterator& operator++() {
+			key = owner->next(key);
+			return *this;
+		}
+
+		iterator operator++(int) {
+			iterator temp = *this;
+			key = owner->next(key);
+			return temp;
+		}
+
+		bool operator==(const iterator& param) const {
+			return key == param.key;
+		}
+
+		bool operator!=(const iterator& param) const {
+			return key != param.key;
+		}
+
+	private:
+		IDMap* owner;
+		KeyType key;
+	};
+
+	IDMap() {
+		count = 0;
+	}
+
+	iterator begin() {
+		return iterator(this, next(-1));
+	}
+
+	iterator end() {
+		return iterator(this, entries.size());
+	}
+
+	iterator find(KeyType key) {
+		if (key >= 0 && key < (KeyType) entries.size() && present[key])
+			return iterator(this, key);
+		return end();
+	}
+
+	// Makes room for IDs 0 to numOfKeys-1 without adding entries, so that
+	// later insertions do not move the existing entries.
+	void reserve(KeyType numOfKeys) {
+		KeyType oldSize = entries.size();
+		if (numOfKeys <= oldSize)
+			return;
+		entries.resize(numOfKeys);
+		present.resize(numOfKeys, false);
+		for (KeyType k = oldSize; k < numOfKeys; k++)
+			entries[k].first = k;
+	}
+
+	ValueType& operator[](KeyType key) {
+#ifdef SANITYCHECK
+		assert(key >= 0);
+#endif
+		if (key >= (KeyType) entries.size())
+			reserve(key + 1);
+		if (!present[key]) {
+			present[key] = true;
+			count++;
+		}
+		return entries[key].second;
+	}
+
+	void erase(iterator it) {
+		if (it == end())
+			return;
+		KeyType key = it->first;
+		entries[key].second = ValueType();
+		present[key] = false;
+		count--;
+	}
+
+	size_t size() const {
+		return count;
+	}
+
+private:
+	std::vector<entryType> entries;
+	std::vector<bool> present;
+	size_t count;
+
+	KeyType next(KeyType key) const {
+		for (key++; key < (KeyType) entries.size(); key++) {
+			if (present[key])
+				break;
+		}
+		return key;
+	}
+};
+
+#endif /* IDMAP_H_ */
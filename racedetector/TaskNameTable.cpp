@@ -0,0 +1,32 @@
+/*
+ * TaskNameTable.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include "TaskNameTable.h"
+
+using namespace std;
+
+TaskNameTable::TaskNameTable() {
+	intern("");
+}
+
+TaskNameTable::~TaskNameTable() {
+}
+
+TaskIDType TaskNameTable::intern(const char* begin, const char* end) {
+	key.assign(begin, end);
+	return intern(key);
+}
+
+TaskIDType TaskNameTable::intern(const string& name) {
+	unordered_map<string, TaskIDType>::iterator it = ids.find(name);
+	if (it != ids.end())
+		return it->second;
+
+	TaskIDType task = names.size();
+	names.push_back(name);
+	ids[name] = task;
+	return task;
+}
@@ -0,0 +1,51 @@
+/*
+ * TaskNameTable.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include <config.h>
+
+#ifndef TASKNAMETABLE_H_
+#define TASKNAMETABLE_H_
+
+// Dense ID given to a task name by TaskNameTable
+typedef int TaskIDType;
+
+// ID of the empty task name, used for ops that are not inside any task
+#define NOTASK 0
+
+/*
+ * Interns the task names seen in the trace. Each distinct name gets the next
+ * free ID, so the IDs can be used to index vectors. Names are only needed
+ * again when reports are written.
+ */
+class TaskNameTable {
+public:
+	TaskNameTable();
+	virtual ~TaskNameTable();
+
+	// Returns the ID of the name [begin, end), adding it if it is new.
+	TaskIDType intern(const char* begin, const char* end);
+	TaskIDType intern(const std::string& name);
+
+	const std::string& name(TaskIDType task) const {
+		return names[task];
+	}
+
+	// Number of IDs handed out (including NOTASK)
+	TaskIDType size() const {
+		return names.size();
+	}
+
+private:
+	std::vector<std::string> names;
+	std::unordered_map<std::string, TaskIDType> ids;
+	std::string key;	// reused to look up names given as [begin, end)
+};
+
+#endif /* TASKNAMETABLE_H_ */
@@ -8,14 +8,16 @@
 #include "UAFDetector.h"
 #include <iostream>
 #include <cassert>
+#include <cstdio>
+#include <algorithm>
 #include <fstream>
 #include <boost/regex.hpp>
+#include <logging/Diagnostics.h>
 
 #include <debugconfig.h>
 
 using namespace std;
 
-typedef std::multiset<HBGraph::adjListNode>::iterator nodeIterator;
 
 UAFDetector::UAFDetector()
 	:
@@ -33,6 +35,11 @@ UAFDetector::UAFDetector()
 	  freeIDMap()
 {
 	graph = NULL;
+	closure = CLOSURE_ROWS;
+	representation = HB_MATRIX;
+	numOfClosureThreads = 1;
+	closureWorkers = NULL;
+	transClosedAt = 0;
 	raceCount = 0;
 	uafCount = 0;
 	uniqueRaceCount = 0;
@@ -40,23 +47,64 @@ UAFDetector::UAFDetector()
 }
 
 UAFDetector::~UAFDetector() {
+	delete closureWorkers;
 }
 
-void UAFDetector::initGraph(IDType countOfNodes) {
-	graph = new HBGraph(countOfNodes, opIDMap, nodeIDMap);
+const char* opTypeToString(OpType type) {
+	switch (type) {
+	case THREADINIT_OP:	return "threadinit";
+	case THREADEXIT_OP:	return "threadexit";
+	case FORK_OP:		return "fork";
+	case JOIN_OP:		return "join";
+	case ENTERLOOP_OP:	return "enterloop";
+	case EXITLOOP_OP:	return "exitloop";
+	case ENQ_OP:		return "enq";
+	case DEQ_OP:		return "deq";
+	case END_OP:		return "end";
+	case PAUSE_OP:		return "pause";
+	case RESUME_OP:		return "resume";
+	case PERMIT_OP:		return "permit";
+	case REVOKE_OP:		return "revoke";
+	case RESET_OP:		return "reset";
+	case ALLOC_OP:		return "alloc";
+	case FREE_OP:		return "free";
+	case INC_OP:		return "inc";
+	case DEC_OP:		return "dec";
+	case WAIT_OP:		return "wait";
+	case NOTIFY_OP:		return "notify";
+	case NOTIFYALL_OP:	return "notifyall";
+	case READ_OP:		return "read";
+	case WRITE_OP:		return "write";
+	default:			return "";
+	}
+}
+
+std::string addressToString(AddressType address) {
+	char text[24];
+	snprintf(text, sizeof(text), "0x%llx", (unsigned long long) address);
+	return std::string(text);
+}
+
+int UAFDetector::initGraph(IDType countOfNodes) {
+	graph = new HBGraph(countOfNodes, closure == CLOSURE_SWEEP, matrixDirectory);
 	assert(graph != NULL);
+	if (!graph->isAllocated())
+		return -1;
+	if (!matrixDirectory.empty())
+		DIAG(DIAG_PARSE, DIAG_SUMMARY, "Bit matrix: " << graph->opMatrix.sizeInBytes() << " bytes in a file in " << matrixDirectory << "\n");
+	return 0;
 }
 
 struct field {
-	std::string address;
+	AddressType address;
 	IDType minUseOp;
 	std::string minMsg;
 };
 
-bool isFieldPresent(std::vector<field> fieldsVector, std::string address) {
+bool isFieldPresent(std::vector<field> fieldsVector, AddressType address) {
 	for (std::vector<field>::iterator it = fieldsVector.begin();
 			it != fieldsVector.end(); it++) {
-		if (it->address.compare(address) == 0)
+		if (it->address == address)
 			return true;
 	}
 
@@ -77,7 +125,7 @@ void UAFDetector::outputAllConflictingOps(std::string outUAFFileName, std::strin
 	IDType totalObjsWithUAFCount = 0, totalObjsWithRacesCount = 0;
 	std::stringstream str;
 
-	for (std::map<IDType, allocOpDetails>::iterator allocIt = allocIDMap.begin();
+	for (map<IDType, allocOpDetails>::iterator allocIt = allocIDMap.begin();
 			allocIt != allocIDMap.end(); allocIt++) {
 		IDType allocID = allocIt->first;
 		IDType uafsCount = 0, racesCount = 0;
@@ -97,12 +145,12 @@ void UAFDetector::outputAllConflictingOps(std::string outUAFFileName, std::strin
 		for (std::set<IDType>::iterator freeIt = allocIt->second.freeOps.begin();
 				freeIt != allocIt->second.freeOps.end(); freeIt++) {
 			IDType freeID = *freeIt;
-			IDType threadFree = opIDMap[freeID].threadID;
+			IDType threadFree = opIDMap.threadID[freeID];
 			for (std::set<IDType>::iterator readIt = allocIt->second.readOps.begin();
 					readIt != allocIt->second.readOps.end(); readIt++) {
 				IDType readID = *readIt;
-				IDType threadRead = opIDMap[readID].threadID;
-				std::string address = readSet[readID].startingAddress;
+				IDType threadRead = opIDMap.threadID[readID];
+//				AddressType address = readSet[readID].startingAddress;
 
 				if (threadFree == threadRead) continue;
 
@@ -130,7 +178,7 @@ void UAFDetector::outputAllConflictingOps(std::string outUAFFileName, std::strin
 			for (std::set<IDType>::iterator writeIt = allocIt->second.writeOps.begin();
 					writeIt != allocIt->second.writeOps.end(); writeIt++) {
 				IDType writeID = *writeIt;
-				IDType threadWrite = opIDMap[writeID].threadID;
+				IDType threadWrite = opIDMap.threadID[writeID];
 
 				if (threadFree == threadWrite) continue;
 
@@ -164,16 +212,16 @@ void UAFDetector::outputAllConflictingOps(std::string outUAFFileName, std::strin
 		for (std::set<IDType>::iterator wIt = allocIt->second.writeOps.begin();
 				wIt != allocIt->second.writeOps.end(); wIt++) {
 			IDType writeOp = *wIt;
-			IDType threadWrite = opIDMap[writeOp].threadID;
-			std::string writeAddress = writeSet[writeOp].startingAddress;
+			IDType threadWrite = opIDMap.threadID[writeOp];
+			AddressType writeAddress = writeSet[writeOp].startingAddress;
 			for (std::set<IDType>::iterator rIt = allocIt->second.readOps.begin();
 					rIt != allocIt->second.readOps.end(); rIt++) {
 				IDType readOp = *rIt;
-				IDType threadRead = opIDMap[readOp].threadID;
-				std::string readAddress = readSet[readOp].startingAddress;
+				IDType threadRead = opIDMap.threadID[readOp];
+				AddressType readAddress = readSet[readOp].startingAddress;
 
 				if (threadWrite == threadRead) continue;
-				if (writeAddress.compare(readAddress) != 0) continue;
+				if (writeAddress != readAddress) continue;
 
 				if (firstWrite) {
 					outRace.writeLog(objmsg);
@@ -200,12 +248,12 @@ void UAFDetector::outputAllConflictingOps(std::string outUAFFileName, std::strin
 			for (std::set<IDType>::iterator w2It = allocIt->second.writeOps.begin();
 					w2It != allocIt->second.writeOps.end(); w2It++) {
 				IDType write2Op = *w2It;
-				IDType threadWrite2 = opIDMap[write2Op].threadID;
-				std::string write2Address = writeSet[write2Op].startingAddress;
+				IDType threadWrite2 = opIDMap.threadID[write2Op];
+				AddressType write2Address = writeSet[write2Op].startingAddress;
 
 				if (writeOp == write2Op) continue;
 				if (threadWrite == threadWrite2) continue;
-				if (writeAddress.compare(write2Address) != 0) continue;
+				if (writeAddress != write2Address) continue;
 
 				if (firstWrite) {
 					outRace.writeLog(objmsg);
@@ -248,9 +296,44 @@ void UAFDetector::outputAllConflictingOps(std::string outUAFFileName, std::strin
 	cout << "Total races: " << totalRacesCount << "\n";
 }
 
+bool UAFDetector::ruleUnits::mustEvaluate(size_t unit, const HBGraph* graph) {
+	if (unit >= units.size())
+		units.resize(unit + 1);
+	unitDetails& details = units[unit];
+
+	if (details.evaluatedAt != 0) {
+		bool readEdgesChanged = false;
+		for (size_t i = 0; i < details.readNodes.size(); i++) {
+			if (graph->edgesChangedSince(details.readNodes[i], details.evaluatedAt)) {
+				readEdgesChanged = true;
+				break;
+			}
+		}
+		if (!readEdgesChanged)
+			return false;
+	}
+
+	details.evaluatedAt = graph->edgeSerial + 1;
+	details.readNodes.clear();
+	current = &details;
+	return true;
+}
+
 int UAFDetector::addEdges() {
 	assert (graph->totalOps != 0);
 
+	if (closure == CLOSURE_LAZY) {
+#ifdef ADVANCEDRULES
+		cout << "ERROR: TRANS-ST/MT edges are only found on demand without ADVANCEDRULES\n";
+		return -1;
+#endif
+		if (threadIndexOfNode.empty())
+			initThreadMasks();
+		if (!threadMasks.isAllocated())
+			return -1;
+		graph->closeRowsOnDemand(&threadIndexOfNode, &threadMasks);
+	}
+
 	// LOOP-PO/FORK/JOIN
 	if (add_LoopPO_Fork_Join_Edges() < 0) {
 		cout << "ERROR: While adding LOOP-PO/Fork/Join edges\n";
@@ -286,9 +369,7 @@ int UAFDetector::addEdges() {
 #endif
 
 		// FIFO-ATOMIC/NO-PRE
-#ifdef GRAPHDEBUG
-		cout << "Adding Fifo-Atomic/No-Pre edges\n";
-#endif
+		DIAG(DIAG_CLOSURE, DIAG_DETAILS, "Adding Fifo-Atomic/No-Pre edges\n");
 		retValue = add_FifoAtomic_NoPre_Edges();
 		if (retValue == 1) edgeAdded = true;
 		else if (retValue == -1) {
@@ -306,9 +387,7 @@ int UAFDetector::addEdges() {
 #endif
 
 		// FIFO-NESTED-1/2/GEN Or ENQRESET-ST-1
-#ifdef GRAPHDEBUG
-		cout << "Adding Fifo-Nested-1/2/GEN or EnqResetST-1 edges\n";
-#endif
+		DIAG(DIAG_CLOSURE, DIAG_DETAILS, "Adding Fifo-Nested-1/2/GEN or EnqResetST-1 edges\n");
 
 		retValue = add_FifoNested_1_2_Gen_EnqResetST_1_Edges();
 		if (retValue == 1) edgeAdded = true;
@@ -326,9 +405,7 @@ int UAFDetector::addEdges() {
 #endif
 
 		// ENQRESET-ST-2/3
-#ifdef GRAPHDEBUG
-		cout << "Adding EnqReset-ST-2/3 edges\n";
-#endif
+		DIAG(DIAG_CLOSURE, DIAG_DETAILS, "Adding EnqReset-ST-2/3 edges\n");
 
 		retValue = add_EnqReset_ST_2_3_Edges();
 		if (retValue == 1) edgeAdded = true;
@@ -346,10 +423,22 @@ int UAFDetector::addEdges() {
 #endif
 
 		// TRANS-ST/MT
-#ifdef GRAPHDEBUG
-		cout << "Adding Trans-ST/MT edges\n";
-#endif
-		retValue = addTransSTOrMTEdges();
+		DIAG(DIAG_CLOSURE, DIAG_DETAILS, "Adding Trans-ST/MT edges\n");
+		if ((closure == CLOSURE_SWEEP && !graph->forwardEdgesOnly)
+				|| (closure == CLOSURE_LAZY && !graph->closesRowsOnDemand())) {
+			DIAG(DIAG_CLOSURE, DIAG_SUMMARY, "Edge to an earlier node: closing the graph by rows\n");
+			closure = CLOSURE_ROWS;
+		}
+		if (closure == CLOSURE_LAZY) {
+			graph->commitEdges();
+			retValue = 0;
+		}
+		else if (closure == CLOSURE_ROWS)
+			retValue = addTransSTOrMTEdgesByRows();
+		else if (closure == CLOSURE_SWEEP)
+			retValue = addTransSTOrMTEdgesBySweep();
+		else
+			retValue = addTransSTOrMTEdges();
 		if (retValue == 1) edgeAdded = true;
 		else if (retValue == -1) {
 			cout << "ERROR: While adding TRANS-ST/MT edges\n";
@@ -358,9 +447,7 @@ int UAFDetector::addEdges() {
 			cout << "ERROR: Unknown return value from addTransSTOrMTEdges()\n";
 			return -1;
 		}
-#ifdef GRAPHDEBUG
-		cout << "DEBUG: edgeAdded = " << edgeAdded << "\n";
-#endif
+		DIAG(DIAG_CLOSURE, DIAG_DETAILS, "DEBUG: edgeAdded = " << edgeAdded << "\n");
 
 		if (!edgeAdded) // If no edges were added in this iteration, stop.
 			break;
@@ -373,6 +460,24 @@ int UAFDetector::addEdges() {
 #endif
 
 	cout << "Total op edges = " << graph->numOfOpEdges << "\n";
+	graph->freezeSuccessors();
+	delete closureWorkers;
+	closureWorkers = NULL;
+
+	// No more edges are added: answer the queries of detection from the
+	// thread chains instead of the matrix
+	if (representation == HB_CHAINS) {
+		if (threadIndexOfNode.empty())
+			initThreadMasks();
+		if (threadIndexOfNode.empty())
+			return -1;
+		IDType numOfThreadIndices = *max_element(threadIndexOfNode.begin(), threadIndexOfNode.end()) + 1;
+		size_t matrixBytes = graph->opMatrix.sizeInBytes();
+		graph->freezeToChains(threadIndexOfNode, numOfThreadIndices);
+		DIAG(DIAG_CLOSURE, DIAG_SUMMARY, "Chain index: " << graph->chainIndex->sizeInBytes() << " bytes ("
+				<< graph->chainIndex->numOfExceptions() << " exceptions) in place of "
+				<< matrixBytes << " bytes of matrix\n");
+	}
 	return 0;
 }
 
@@ -389,8 +494,8 @@ int UAFDetector::add_LoopPO_Fork_Join_Edges() {
 		opJ = it->second.threadinitOpID;
 
 		if (opI > 0 && opJ > 0) {
-			IDType nodeI = opIDMap[opI].nodeID;
-			IDType nodeJ = opIDMap[opJ].nodeID;
+			IDType nodeI = opIDMap.nodeID[opI];
+			IDType nodeJ = opIDMap.nodeID[opJ];
 			if (nodeI <= 0) {
 				cout << "ERROR: Invalid node ID for op " << opI << "\n";
 				return -1;
@@ -401,10 +506,8 @@ int UAFDetector::add_LoopPO_Fork_Join_Edges() {
 				int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, false);
 				if (addEdgeRetValue == 1) {
 					flag = true;
-#ifdef GRAPHDEBUG
-					cout << "FORK edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-						 << "\n";
-#endif
+					DIAG(DIAG_RULES, DIAG_DETAILS, "FORK edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+						 << "\n");
 #ifdef GRAPHDEBUGFULL
 				} else if (addEdgeRetValue == 0) {
 					cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -432,8 +535,8 @@ int UAFDetector::add_LoopPO_Fork_Join_Edges() {
 		opJ = it->second.joinOpID;
 
 		if (opI > 0 && opJ > 0) {
-			IDType nodeI = opIDMap[opI].nodeID;
-			IDType nodeJ = opIDMap[opJ].nodeID;
+			IDType nodeI = opIDMap.nodeID[opI];
+			IDType nodeJ = opIDMap.nodeID[opJ];
 			if (nodeI <= 0) {
 				cout << "ERROR: Invalid node ID for op " << opI << "\n";
 				return -1;
@@ -444,10 +547,8 @@ int UAFDetector::add_LoopPO_Fork_Join_Edges() {
 				int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, false);
 				if (addEdgeRetValue == 1) {
 					flag = true;
-#ifdef GRAPHDEBUG
-					cout << "JOIN edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-						 << "\n";
-#endif
+					DIAG(DIAG_RULES, DIAG_DETAILS, "JOIN edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+						 << "\n");
 #ifdef GRAPHDEBUGFULL
 				} else if (addEdgeRetValue == 0) {
 					cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -460,15 +561,11 @@ int UAFDetector::add_LoopPO_Fork_Join_Edges() {
 		} else {
 #ifdef GRAPHDEBUGFULL
 			if (opI <= 0) {
-#ifdef GRAPHDEBUG
-				cout << "DEBUG: Cannot find threadexit op of thread " << it->first << endl;
-				cout << "DEBUG: Skipping JOIN-edge for thread " << it->first << endl;
-#endif
+				DIAG(DIAG_RULES, DIAG_DETAILS, "DEBUG: Cannot find threadexit op of thread " << it->first << "\n");
+				DIAG(DIAG_RULES, DIAG_DETAILS, "DEBUG: Skipping JOIN-edge for thread " << it->first << "\n");
 			} else if (opJ <= 0) {
-#ifdef GRAPHDEBUG
-				cout << "DEBUG: Cannot find join op of thread " << it->first << endl;
-				cout << "DEBUG: Skipping JOIN-edge for thread " << it->first << endl;
-#endif
+				DIAG(DIAG_RULES, DIAG_DETAILS, "DEBUG: Cannot find join op of thread " << it->first << "\n");
+				DIAG(DIAG_RULES, DIAG_DETAILS, "DEBUG: Skipping JOIN-edge for thread " << it->first << "\n");
 			}
 #endif
 		}
@@ -508,9 +605,9 @@ int UAFDetector::add_LoopPO_Fork_Join_Edges() {
 #endif
 
 		// R1: Add edge from ops before enterloop to all ops subsequent to them
-		for (IDType opI = firstOpInThread; (opI > 0 && opI <= loopExitOp); opI = opIDMap[opI].nextOpInThread) {
+		for (IDType opI = firstOpInThread; (opI > 0 && opI <= loopExitOp); opI = opIDMap.nextOpInThread[opI]) {
 
-			IDType nextOpAfterOpI = opIDMap[opI].nextOpInThread;
+			IDType nextOpAfterOpI = opIDMap.nextOpInThread[opI];
 
 #ifdef SANITYCHECK
 			if (nextOpAfterOpI <= 0) {
@@ -522,15 +619,15 @@ int UAFDetector::add_LoopPO_Fork_Join_Edges() {
 			}
 #endif
 
-			IDType nodeI = opIDMap[opI].nodeID;
+			IDType nodeI = opIDMap.nodeID[opI];
 			if (nodeI <= 0) {
 				cout << "ERROR: Invalid node ID for op " << opI << "\n";
 				return -1;
 			}
 			IDType prevNodeJ = -1;
-			for (IDType opJ = nextOpAfterOpI; (opJ > 0 && opJ <= lastOpInThread); opJ = opIDMap[opJ].nextOpInThread) {
+			for (IDType opJ = nextOpAfterOpI; (opJ > 0 && opJ <= lastOpInThread); opJ = opIDMap.nextOpInThread[opJ]) {
 
-				IDType nodeJ = opIDMap[opJ].nodeID;
+				IDType nodeJ = opIDMap.nodeID[opJ];
 				if (nodeJ <= 0) {
 					cout << "ERROR: Invalid node ID for op " << opJ << "\n";
 					return -1;
@@ -542,10 +639,8 @@ int UAFDetector::add_LoopPO_Fork_Join_Edges() {
 					int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, true);
 					if (addEdgeRetValue == 1) {
 						flag = true;
-#ifdef GRAPHDEBUG
-						cout << "R1: LOOP-PO edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "
-							 << graph->numOfOpEdges << "\n";
-#endif
+						DIAG(DIAG_RULES, DIAG_DETAILS, "R1: LOOP-PO edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "
+							 << graph->numOfOpEdges << "\n");
 #ifdef GRAPHDEBUGFULL
 					} else if (addEdgeRetValue == 0) {
 						cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -573,9 +668,9 @@ int UAFDetector::add_LoopPO_Fork_Join_Edges() {
 
 		// R2: Add edge from ops after enterloop to all ops after exitloop
 
-		for (IDType opJ = exitloop; (opJ > 0 && opJ <= lastOpInThread); opJ = opIDMap[opJ].nextOpInThread) {
+		for (IDType opJ = exitloop; (opJ > 0 && opJ <= lastOpInThread); opJ = opIDMap.nextOpInThread[opJ]) {
 
-			IDType prevOpBeforeOpJ = opIDMap[opJ].prevOpInThread;
+			IDType prevOpBeforeOpJ = opIDMap.prevOpInThread[opJ];
 
 #ifdef SANITYCHECK
 			if (prevOpBeforeOpJ <= 0) {
@@ -587,14 +682,14 @@ int UAFDetector::add_LoopPO_Fork_Join_Edges() {
 			}
 #endif
 
-			IDType nodeJ = opIDMap[opJ].nodeID;
+			IDType nodeJ = opIDMap.nodeID[opJ];
 			if (nodeJ <= 0) {
 				cout << "ERROR: Invalid node ID for op " << opJ << "\n";
 				return -1;
 			}
 			IDType prevNodeI = -1;
-			for (IDType opI = firstOpInThread; (opI > 0 && opI <= prevOpBeforeOpJ); opI = opIDMap[opI].nextOpInThread) {
-				IDType nodeI = opIDMap[opI].nodeID;
+			for (IDType opI = firstOpInThread; (opI > 0 && opI <= prevOpBeforeOpJ); opI = opIDMap.nextOpInThread[opI]) {
+				IDType nodeI = opIDMap.nodeID[opI];
 				if (nodeI <= 0) {
 					cout << "ERROR: Invalid node ID for op " << opI << "\n";
 					return -1;
@@ -606,10 +701,8 @@ int UAFDetector::add_LoopPO_Fork_Join_Edges() {
 					int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, true);
 					if (addEdgeRetValue == 1) {
 						flag = true;
-#ifdef GRAPHDEBUG
-						cout << "R2: LOOP-PO edge (" << nodeJ << ", " << nodeI << ") -- #op-edges "
-							 << graph->numOfOpEdges << "\n";
-#endif
+						DIAG(DIAG_RULES, DIAG_DETAILS, "R2: LOOP-PO edge (" << nodeJ << ", " << nodeI << ") -- #op-edges "
+							 << graph->numOfOpEdges << "\n");
 #ifdef GRAPHDEBUGFULL
 					} else if (addEdgeRetValue == 0) {
 						cout << "DEBUG: Edge (" << nodeJ << ", " << nodeI << ") already implied in the graph\n";
@@ -633,7 +726,7 @@ int UAFDetector::add_LoopPO_Fork_Join_Edges() {
 int UAFDetector::add_TaskPO_EnqueueSTOrMT_Edges() {
 	bool flag = false; // To keep track of whether edges were added.
 
-	for (map<std::string, UAFDetector::taskDetails>::iterator it = taskIDMap.begin(); it != taskIDMap.end(); it++) {
+	for (UAFDetector::taskMap::iterator it = taskIDMap.begin(); it != taskIDMap.end(); it++) {
 
 		// TASK-PO
 
@@ -642,24 +735,24 @@ int UAFDetector::add_TaskPO_EnqueueSTOrMT_Edges() {
 #ifdef SANITYCHECK
 		if (firstOpInTask <= 0) {
 #ifdef GRAPHDEBUGFULL
-			cout << "DEBUG: Cannot find first op of task " << it->first << endl;
+			cout << "DEBUG: Cannot find first op of task " << taskNames.name(it->first) << endl;
 			cout << "DEBUG: Skipping TASK-PO edges for this task\n";
 #endif
 			continue;
 		}
 #endif
 
-		for (IDType opI = firstOpInTask; (opI > 0); opI = opIDMap[opI].nextOpInTask) {
-			IDType nodeI = opIDMap[opI].nodeID;
+		for (IDType opI = firstOpInTask; (opI > 0); opI = opIDMap.nextOpInTask[opI]) {
+			IDType nodeI = opIDMap.nodeID[opI];
 			if (nodeI <= 0) {
 				cout << "ERROR: Invalid node ID for op " << opI << "\n";
 				return -1;
 			}
 
-			IDType nextOp = opIDMap[opI].nextOpInTask;
+			IDType nextOp = opIDMap.nextOpInTask[opI];
 			IDType prevNodeJ = -1;
-			for (IDType opJ = nextOp; opJ > 0; opJ = opIDMap[opJ].nextOpInTask) {
-				IDType nodeJ = opIDMap[opJ].nodeID;
+			for (IDType opJ = nextOp; opJ > 0; opJ = opIDMap.nextOpInTask[opJ]) {
+				IDType nodeJ = opIDMap.nodeID[opJ];
 				if (nodeJ <= 0) {
 					cout << "ERROR: Invalid node ID for op " << opJ << "\n";
 					return -1;
@@ -671,10 +764,8 @@ int UAFDetector::add_TaskPO_EnqueueSTOrMT_Edges() {
 					int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, true);
 					if (addEdgeRetValue == 1) {
 						flag = true;
-#ifdef GRAPHDEBUG
-						cout << "R3: TASK-PO edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-							 << "\n";
-#endif
+						DIAG(DIAG_RULES, DIAG_DETAILS, "R3: TASK-PO edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+							 << "\n");
 #ifdef GRAPHDEBUGFULL
 					} else if (addEdgeRetValue == 0) {
 						cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -694,8 +785,8 @@ int UAFDetector::add_TaskPO_EnqueueSTOrMT_Edges() {
 		IDType deqOp = it->second.deqOpID;
 
 		if (enqOp > 0 && deqOp > 0) {
-			IDType nodeEnq = opIDMap[enqOp].nodeID;
-			IDType nodeDeq = opIDMap[deqOp].nodeID;
+			IDType nodeEnq = opIDMap.nodeID[enqOp];
+			IDType nodeDeq = opIDMap.nodeID[deqOp];
 			if (nodeEnq <= 0) {
 				cout << "ERROR: Invalid node ID for op " << enqOp << "\n";
 				return -1;
@@ -703,8 +794,8 @@ int UAFDetector::add_TaskPO_EnqueueSTOrMT_Edges() {
 				cout << "ERROR: Invalid node ID for op " << deqOp << "\n";
 				return -1;
 			} else {
-				IDType threadEnq = opIDMap[enqOp].threadID;
-				IDType threadDeq = opIDMap[deqOp].threadID;
+				IDType threadEnq = opIDMap.threadID[enqOp];
+				IDType threadDeq = opIDMap.threadID[deqOp];
 				if (threadEnq < 0) {
 					cout << "ERROR: Invalid thread ID for op " << enqOp << "\n";
 					return -1;
@@ -726,10 +817,8 @@ int UAFDetector::add_TaskPO_EnqueueSTOrMT_Edges() {
 				int addEdgeRetValue = graph->addOpEdge(nodeEnq, nodeDeq, edgeType);
 				if (addEdgeRetValue == 1) {
 					flag = true;
-#ifdef GRAPHDEBUG
-					cout << "R4: ENQUEUE-ST/MT edge (" << nodeEnq << ", " << nodeDeq << ") -- #op-edges "   << graph->numOfOpEdges
-						 << "\n";
-#endif
+					DIAG(DIAG_RULES, DIAG_DETAILS, "R4: ENQUEUE-ST/MT edge (" << nodeEnq << ", " << nodeDeq << ") -- #op-edges "   << graph->numOfOpEdges
+						 << "\n");
 #ifdef GRAPHDEBUGFULL
 				} else if (addEdgeRetValue == 0) {
 					cout << "DEBUG: Edge (" << nodeEnq << ", " << nodeDeq << ") already implied in the graph\n";
@@ -742,13 +831,13 @@ int UAFDetector::add_TaskPO_EnqueueSTOrMT_Edges() {
 		} else {
 			if (enqOp <= 0) {
 #ifdef GRAPHDEBUGFULL
-				cout << "DEBUG: Cannot find enq op of task " << it->first << endl;
+				cout << "DEBUG: Cannot find enq op of task " << taskNames.name(it->first) << endl;
 				cout << "DEBUG: Skipping ENQUEUE-ST/MT edge for this task\n";
 #endif
 			}
 			if (deqOp <= 0) {
 #ifdef GRAPHDEBUGFULL
-				cout << "DEBUG: Cannot find deq op of task " << it->first << endl;
+				cout << "DEBUG: Cannot find deq op of task " << taskNames.name(it->first) << endl;
 				cout << "DEBUG: Skipping ENQUEUE-ST/MT edge for this task\n";
 #endif
 			}
@@ -767,13 +856,15 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 
 	bool flag = false; // To keep track of whether edges were added.
 
-
-	for (map<std::string, taskDetails>::iterator it = taskIDMap.begin(); it != taskIDMap.end(); it++) {
+	size_t unit = 0;
+	for (taskMap::iterator it = taskIDMap.begin(); it != taskIDMap.end(); it++, unit++) {
+		if (!fifoAtomicNoPreUnits.mustEvaluate(unit, graph))
+			continue;
 
 		// If the task is not atomic, the rule does not apply
 		if (it->second.atomic == false) {
 #ifdef GRAPHDEBUGFULL
-			cout << "DEBUG: Task " << it->first << " is not atomic\n";
+			cout << "DEBUG: Task " << taskNames.name(it->first) << " is not atomic\n";
 			cout << "DEBUG: Skipping FIFO-ATOMIC/NO-PRE edges for this task\n";
 #endif
 			continue;
@@ -788,7 +879,7 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 			// creates this situation.
 			// So we check if there is an end op for the task
 #ifdef GRAPHDEBUGFULL
-			cout << "DEBUG: Saw enq of task " << it->first << " at " << it->second.enqOpID << ", but no end op\n";
+			cout << "DEBUG: Saw enq of task " << taskNames.name(it->first) << " at " << it->second.enqOpID << ", but no end op\n";
 			cout << "DEBUG: Skipping FIFO-ATOMIC/NO-PRE edges for this task\n";
 #endif
 			continue;
@@ -798,11 +889,11 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 		IDType enqOp = it->second.enqOpID;
 		if (enqOp <= 0) {
 #ifdef GRAPHDEBUGFULL
-			cout << "DEBUG: Cannot find enq of task " << it->first << endl;
+			cout << "DEBUG: Cannot find enq of task " << taskNames.name(it->first) << endl;
 			cout << "DEBUG: Skipping FIFO-ATOMIC edge for this task\n";
 #endif
 		} else {
-			IDType nodeEnq = opIDMap[enqOp].nodeID;
+			IDType nodeEnq = opIDMap.nodeID[enqOp];
 			if (nodeEnq <= 0) {
 				cout << "ERROR: Invalid node ID for op " << enqOp << "\n";
 				return -1;
@@ -811,21 +902,21 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 			if (opI <= 0) {
 #ifdef GRAPHDEBUGFULL
 				cout << "DEBUG: Cannot find end of task " << opI << endl;
-				cout << "DEBUG: Skipping FIFO-ATOMIC edge for task " << it->first << "\n";
+				cout << "DEBUG: Skipping FIFO-ATOMIC edge for task " << taskNames.name(it->first) << "\n";
 #endif
 			} else {
-				IDType nodeI = opIDMap[opI].nodeID;
+				IDType nodeI = opIDMap.nodeID[opI];
 				if (nodeI <= 0) {
 					cout << "ERROR: Invalid node ID for op " << opI << "\n";
 					return -1;
 				}
+				fifoAtomicNoPreUnits.readsEdgesFrom(nodeEnq);
 				// If enq has no outgoing edges, then skip
-				if (graph->opAdjList.find(nodeEnq) == graph->opAdjList.end())
+				if (graph->numOfSuccessors(nodeEnq) == 0)
 					continue;
-				HBGraph::adjListNode* currNode = graph->opAdjList[nodeEnq]->head;
-				for (; currNode != NULL; currNode = currNode->next) {
-					// Check if the op in currNode is enq
-					IDType destNode = currNode->nodeID;
+				for (IDType succ = graph->numOfSuccessors(nodeEnq); succ-- > 0; ) {
+					// Check if the op in destNode is enq
+					IDType destNode = graph->successor(nodeEnq, succ);
 					if (nodeIDMap.find(destNode) == nodeIDMap.end()) {
 						cout << "ERROR: Cannot find entry for node " << destNode << " in nodeIDMap\n";
 						return -1;
@@ -836,17 +927,17 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 					IDType destOp = *(nodeIDMap[destNode].opSet.begin());
 
 					// Get opType of destOp
-					if (opIDMap.find(destOp) == opIDMap.end()) {
+					if (!opIDMap.exists(destOp)) {
 						cout << "ERROR: Cannot find entry for op " << destOp << " in opIDMap\n";
 						return -1;
 					}
-					std::string destOpType = opIDMap[destOp].opType;
-					if (destOpType.compare("enq") != 0) continue;
+					OpType destOpType = opIDMap.opType[destOp];
+					if (destOpType != ENQ_OP) continue;
 
 					IDType tempenqOp = destOp;
 
-					std::string taskName = enqToTaskEnqueued[tempenqOp].taskEnqueued;
-					if (taskName.compare("") == 0) {
+					TaskIDType taskName = enqToTaskEnqueued[tempenqOp].taskEnqueued;
+					if (taskName == NOTASK) {
 #ifdef GRAPHDEBUGFULL
 						cout << "DEBUG: Cannot find task enqueued in op " << tempenqOp << endl;
 #endif
@@ -862,7 +953,7 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 						return -1;
 					}
 					if (it->second.priority == INT_MAX) {
-						cout << "ERROR: Priority is not set for task " << it->first << "\n";
+						cout << "ERROR: Priority is not set for task " << taskNames.name(it->first) << "\n";
 						return -1;
 					}
 					if (enqToTaskEnqueued[tempenqOp].priority == INT_MAX) {
@@ -875,12 +966,12 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 					IDType opJ = taskIDMap[taskName].deqOpID;
 					if (opJ <= 0) {
 #ifdef GRAPHDEBUGFULL
-						cout << "DEBUG: Cannot find deq op of task " << taskName << endl;
+						cout << "DEBUG: Cannot find deq op of task " << taskNames.name(taskName) << endl;
 #endif
 						continue;
 					}
 
-					IDType nodeJ = opIDMap[opJ].nodeID;
+					IDType nodeJ = opIDMap.nodeID[opJ];
 					if (nodeJ <= 0) {
 						cout << "ERROR: Invalid node ID for op " << opJ << "\n";
 						return -1;
@@ -888,10 +979,8 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 						int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, true);
 						if (addEdgeRetValue == 1) {
 							flag = true;
-#ifdef GRAPHDEBUG
-							cout << "R5: FIFO-ATOMIC edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-								 << "\n";
-#endif
+							DIAG(DIAG_RULES, DIAG_DETAILS, "R5: FIFO-ATOMIC edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+								 << "\n");
 #ifdef GRAPHDEBUGFULL
 						} else if (addEdgeRetValue == 0) {
 							cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -913,23 +1002,23 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 #ifdef SANITYCHECK
 		if (i <= 0) {
 #ifdef GRAPHDEBUGFULL
-			cout << "DEBUG: Cannot find deq op of task " << it->first << endl;
+			cout << "DEBUG: Cannot find deq op of task " << taskNames.name(it->first) << endl;
 			cout << "DEBUG: If there is no deq op, find the first op of task\n";
 #endif
 			i = it->second.firstOpInTaskID;
 			if (i <= 0) {
-				cout << "ERROR: Cannot find first op of task " << it->first << "\n";
+				cout << "ERROR: Cannot find first op of task " << taskNames.name(it->first) << "\n";
 				return -1;
 			}
 		}
 		if (opI <= 0) {
 #ifdef GRAPHDEBUGFULL
-			cout << "DEBUG: Cannot find end op of task " << it->first << endl;
+			cout << "DEBUG: Cannot find end op of task " << taskNames.name(it->first) << endl;
 			cout << "DEBUG: Skipping NOPRE edges for this task\n";
 #endif
 		}
 #endif
-		IDType nodeI = opIDMap[opI].nodeID;
+		IDType nodeI = opIDMap.nodeID[opI];
 		if (nodeI <= 0 ) {
 			cout << "ERROR: Invalid node ID for op " << opI << "\n";
 			return -1;
@@ -937,9 +1026,9 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 		if (i > 0 && opI > 0) {
 			IDType prevNodei = -1;
 
-			for(; (i > 0 && i <= opI); i = opIDMap[i].nextOpInTask) {
+			for(; (i > 0 && i <= opI); i = opIDMap.nextOpInTask[i]) {
 
-				IDType nodei = opIDMap[i].nodeID;
+				IDType nodei = opIDMap.nodeID[i];
 				if (nodei <= 0) {
 					cout << "ERROR: Invalid node ID for op " << i << "\n";
 					return -1;
@@ -947,12 +1036,13 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 				// If prevNodei = nodei, then we would have added the edge already
 				if (prevNodei == nodei) continue;
 				// If op has no outgoing edges, then skip
-				if (graph->opAdjList.find(nodei) == graph->opAdjList.end())
+				fifoAtomicNoPreUnits.readsEdgesFrom(nodei);
+				// If op has no outgoing edges, then skip
+				if (graph->numOfSuccessors(nodei) == 0)
 					continue;
-				HBGraph::adjListNode* currNode = graph->opAdjList[nodei]->head;
-				for (; currNode != NULL; currNode = currNode->next) {
-					// Check if the op in currNode is enq
-					IDType destNode = currNode->nodeID;
+				for (IDType succ = graph->numOfSuccessors(nodei); succ-- > 0; ) {
+					// Check if the op in destNode is enq
+					IDType destNode = graph->successor(nodei, succ);
 					if (nodeIDMap.find(destNode) == nodeIDMap.end()) {
 						cout << "ERROR: Cannot find entry for node " << destNode << " in nodeIDMap\n";
 						return -1;
@@ -963,17 +1053,17 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 					IDType destOp = *(nodeIDMap[destNode].opSet.begin());
 
 					// Get opType of destOp
-					if (opIDMap.find(destOp) == opIDMap.end()) {
+					if (!opIDMap.exists(destOp)) {
 						cout << "ERROR: Cannot find entry for op " << destOp << " in opIDMap\n";
 						return -1;
 					}
-					std::string destOpType = opIDMap[destOp].opType;
-					if (destOpType.compare("enq") != 0) continue;
+					OpType destOpType = opIDMap.opType[destOp];
+					if (destOpType != ENQ_OP) continue;
 
 					IDType tempenqOp = destOp;
 
-					std::string taskName = enqToTaskEnqueued[tempenqOp].taskEnqueued;
-					if (taskName.compare("") == 0) {
+					TaskIDType taskName = enqToTaskEnqueued[tempenqOp].taskEnqueued;
+					if (taskName == NOTASK) {
 #ifdef GRAPHDEBUGFULL
 						cout << "DEBUG: Cannot find task enqueued in op " << tempenqOp << endl;
 #endif
@@ -981,11 +1071,11 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 					}
 
 					// NO-PRE does not apply if the two tasks are in different threads
-					if (opIDMap[i].threadID != enqToTaskEnqueued[tempenqOp].targetThread) continue;
+					if (opIDMap.threadID[i] != enqToTaskEnqueued[tempenqOp].targetThread) continue;
 
 					// NO-PRE does not apply if the first op is an enq and it does not have the same priority
 					// as the second enqop.
-					if (opIDMap[i].opType.compare("enq") == 0) {
+					if (opIDMap.opType[i] == ENQ_OP) {
 						if (enqToTaskEnqueued.find(i) == enqToTaskEnqueued.end()) {
 							cout << "ERROR: Cannot find entry for op " << i << " in enqToTaskEnqueued\n";
 							return -1;
@@ -1009,11 +1099,11 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 					IDType opJ = taskIDMap[taskName].deqOpID;
 					if (opJ <= 0) {
 #ifdef GRAPHDEBUGFULL
-						cout << "DEBUG: Cannot find deq op of task " << taskName << endl;
+						cout << "DEBUG: Cannot find deq op of task " << taskNames.name(taskName) << endl;
 #endif
 #ifdef EXTRARULES
 						cout << "DEBUG: Instead adding the edge to the first op of task "
-							 << taskName << "\n";
+							 << taskNames.name(taskName) << "\n";
 
 						opJ = taskIDMap[taskName].firstOpInTaskID;
 #endif
@@ -1022,12 +1112,12 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 					if (opJ <= 0) {
 #ifdef GRAPHDEBUGFULL
 						cout << "DEBUG: Skipping NOPRE edge from end op " << opI
-							 << " of task " << it->first << " to deq op of task " << taskName << "\n";
+							 << " of task " << taskNames.name(it->first) << " to deq op of task " << taskNames.name(taskName) << "\n";
 #endif
 						continue;
 					}
 
-					IDType nodeJ = opIDMap[opJ].nodeID;
+					IDType nodeJ = opIDMap.nodeID[opJ];
 					if (nodeJ <= 0) {
 						cout << "ERROR: Invalid node ID for op " << opJ << "\n";
 						return -1;
@@ -1035,10 +1125,8 @@ int UAFDetector::add_FifoAtomic_NoPre_Edges() {
 						int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, true);
 						if (addEdgeRetValue == 1) {
 							flag = true;
-#ifdef GRAPHDEBUG
-							cout << "R6: NO-PRE edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-								 << "\n";
-#endif
+							DIAG(DIAG_RULES, DIAG_DETAILS, "R6: NO-PRE edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+								 << "\n");
 #ifdef GRAPHDEBUGFULL
 						} else if (addEdgeRetValue == 0) {
 							cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -1078,12 +1166,12 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 			opI = pauseOp;
 
 			if (opI > 0 && resetOp > 0) {
-				IDType threadOfPauseOp = opIDMap[opI].threadID;
+				IDType threadOfPauseOp = opIDMap.threadID[opI];
 				if (threadOfPauseOp < 0) {
 					cout << "ERROR: Cannot find thread ID of pause op " << opI << "\n";
 					return -1;
 				}
-				IDType threadOfResetOp = opIDMap[resetOp].threadID;
+				IDType threadOfResetOp = opIDMap.threadID[resetOp];
 				if (threadOfResetOp < 0) {
 					cout << "ERROR: Cannot find thread ID of reset op " << resetOp << "\n";
 					return -1;
@@ -1092,8 +1180,8 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 				if (threadOfPauseOp != threadOfResetOp) {
 #ifdef ADVANCEDRULES
 					opJ = resetOp;
-					IDType nodeI = opIDMap[opI].nodeID;
-					IDType nodeJ = opIDMap[opJ].nodeID;
+					IDType nodeI = opIDMap.nodeID[opI];
+					IDType nodeJ = opIDMap.nodeID[opJ];
 					if (nodeI <= 0) {
 						cout << "ERROR: Invalid node ID for op " << opI << "\n";
 						return -1;
@@ -1104,10 +1192,8 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 						int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, false);
 						if (addEdgeRetValue == 1) {
 							flag = true;
-#ifdef GRAPHDEBUG
-							cout << "PAUSE-MT edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-								 << "\n";
-#endif
+							DIAG(DIAG_RULES, DIAG_DETAILS, "PAUSE-MT edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+								 << "\n");
 #ifdef GRAPHDEBUGFULL
 						} else if (addEdgeRetValue == 0) {
 							cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -1119,19 +1205,19 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 					}
 #endif
 				} else {
-					std::string taskOfResetOp = opIDMap[resetOp].taskID;
-					std::string taskOfPauseOp = opIDMap[pauseOp].taskID;
-					if (taskOfResetOp.compare("") != 0 && taskOfPauseOp.compare("") != 0 &&
-							taskOfResetOp.compare(taskOfPauseOp) != 0) {
+					TaskIDType taskOfResetOp = opIDMap.taskID[resetOp];
+					TaskIDType taskOfPauseOp = opIDMap.taskID[pauseOp];
+					if (taskOfResetOp != NOTASK && taskOfPauseOp != NOTASK &&
+							taskOfResetOp != taskOfPauseOp) {
 						opJ = taskIDMap[taskOfResetOp].deqOpID;
 						if (opJ <= 0) {
 #ifdef GRAPHDEBUGFULL
-							cout << "DEBUG: Cannot find deq of task " << taskOfResetOp << "\n";
+							cout << "DEBUG: Cannot find deq of task " << taskNames.name(taskOfResetOp) << "\n";
 							cout << "DEBUG: Skipping PAUSE-ST/MT for this task\n";
 #endif
 						} else {
-							IDType nodeI = opIDMap[opI].nodeID;
-							IDType nodeJ = opIDMap[opJ].nodeID;
+							IDType nodeI = opIDMap.nodeID[opI];
+							IDType nodeJ = opIDMap.nodeID[opJ];
 							if (nodeI <= 0) {
 								cout << "ERROR: Invalid node ID for op " << opI << "\n";
 								return -1;
@@ -1142,10 +1228,8 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 								int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, true);
 								if (addEdgeRetValue == 1) {
 									flag = true;
-#ifdef GRAPHDEBUG
-									cout << "R8: PAUSE-ST edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-										 << "\n";
-#endif
+									DIAG(DIAG_RULES, DIAG_DETAILS, "R8: PAUSE-ST edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+										 << "\n");
 #ifdef GRAPHDEBUGFULL
 								} else if (addEdgeRetValue == 0) {
 									cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -1156,18 +1240,18 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 								}
 							}
 						}
-					} else if (taskOfResetOp.compare("") == 0) {
+					} else if (taskOfResetOp == NOTASK) {
 #ifdef GRAPHDEBUGFULL
 						cout << "DEBUG: Cannot find task of reset op " << resetOp << "\n";
 						cout << "DEBUG: Skipping PAUSE-ST/MT for this task\n";
 #endif
-					} else if (taskOfPauseOp.compare("") == 0) {
+					} else if (taskOfPauseOp == NOTASK) {
 						cout << "ERROR: Cannot find task of pause op " << pauseOp << "\n";
 						return -1;
-					} else if (taskOfResetOp.compare(taskOfPauseOp) == 0) {
+					} else if (taskOfResetOp == taskOfPauseOp) {
 #ifdef GRAPHDEBUGFULL
 						cout << "DEBUG: Pause op " << pauseOp << " and reset op " << resetOp
-							 << " are in the same task " << taskOfResetOp << "\n";
+							 << " are in the same task " << taskNames.name(taskOfResetOp) << "\n";
 #endif
 #ifdef EXTRARULES
 #ifdef GRAPHDEBUGFULL
@@ -1175,8 +1259,8 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 #endif
 
 						opJ = resetOp;
-						IDType nodeI = opIDMap[opI].nodeID;
-						IDType nodeJ = opIDMap[opJ].nodeID;
+						IDType nodeI = opIDMap.nodeID[opI];
+						IDType nodeJ = opIDMap.nodeID[opJ];
 						if (nodeI <= 0) {
 							cout << "ERROR: Invalid node ID for op " << opI << "\n";
 							return -1;
@@ -1187,10 +1271,8 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 							int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ);
 							if (addEdgeRetValue == 1) {
 								flag = true;
-#ifdef GRAPHDEBUG
-								cout << "R8: PAUSE-ST edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-									 << "\n";
-#endif
+								DIAG(DIAG_RULES, DIAG_DETAILS, "R8: PAUSE-ST edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+									 << "\n");
 							} else if (addEdgeRetValue == 0) {
 								cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
 							} else if (addEdgeRetValue == -1) {
@@ -1221,12 +1303,12 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 			// R9: RESUME-ST/MT
 			if (resetOp > 0 && resumeOp > 0) {
 
-				IDType threadOfResumeOp = opIDMap[resumeOp].threadID;
+				IDType threadOfResumeOp = opIDMap.threadID[resumeOp];
 				if (threadOfResumeOp < 0) {
 					cout << "ERROR: Cannot find thread ID of resume op " << resumeOp << "\n";
 					return -1;
 				}
-				IDType threadOfResetOp = opIDMap[resetOp].threadID;
+				IDType threadOfResetOp = opIDMap.threadID[resetOp];
 				if (threadOfResetOp < 0) {
 					cout << "ERROR: Cannot find thread ID of reset op " << resetOp << "\n";
 					return -1;
@@ -1237,8 +1319,8 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 
 				if (threadOfResetOp != threadOfResumeOp) {
 #ifdef ADVANCEDRULES
-					IDType nodeI = opIDMap[opI].nodeID;
-					IDType nodeJ = opIDMap[opJ].nodeID;
+					IDType nodeI = opIDMap.nodeID[opI];
+					IDType nodeJ = opIDMap.nodeID[opJ];
 					if (nodeI <= 0) {
 						cout << "ERROR: Invalid node ID for op " << opI << "\n";
 						return -1;
@@ -1249,10 +1331,8 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 						int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, false);
 						if (addEdgeRetValue == 1) {
 							flag = true;
-#ifdef GRAPHDEBUG
-							cout << "RESUME-MT edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-								 << "\n";
-#endif
+							DIAG(DIAG_RULES, DIAG_DETAILS, "RESUME-MT edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+								 << "\n");
 #ifdef GRAPHDEBUGFULL
 						} else if (addEdgeRetValue == 0) {
 							cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -1264,19 +1344,19 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 					}
 #endif
 				} else {
-					std::string taskOfResetOp = opIDMap[resetOp].taskID;
-					std::string taskOfResumeOp = opIDMap[resumeOp].taskID;
-					if (taskOfResetOp.compare("") != 0 && taskOfResumeOp.compare("") != 0 &&
-							taskOfResetOp.compare(taskOfResumeOp) != 0) {
+					TaskIDType taskOfResetOp = opIDMap.taskID[resetOp];
+					TaskIDType taskOfResumeOp = opIDMap.taskID[resumeOp];
+					if (taskOfResetOp != NOTASK && taskOfResumeOp != NOTASK &&
+							taskOfResetOp != taskOfResumeOp) {
 						opI = taskIDMap[taskOfResetOp].endOpID;
 						if (opI <= 0) {
 #ifdef GRAPHDEBUGFULL
-							cout << "DEBUG: Cannot find end of task " << taskOfResetOp << "\n";
+							cout << "DEBUG: Cannot find end of task " << taskNames.name(taskOfResetOp) << "\n";
 							cout << "DEBUG: Skipping RESUME-ST/MT for this task\n";
 #endif
 						} else {
-							IDType nodeI = opIDMap[opI].nodeID;
-							IDType nodeJ = opIDMap[opJ].nodeID;
+							IDType nodeI = opIDMap.nodeID[opI];
+							IDType nodeJ = opIDMap.nodeID[opJ];
 							if (nodeI <= 0) {
 								cout << "ERROR: Invalid node ID for op " << opI << "\n";
 								return -1;
@@ -1287,10 +1367,8 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 								int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, true);
 								if (addEdgeRetValue == 1) {
 									flag = true;
-#ifdef GRAPHDEBUG
-									cout << "R9: RESUME-ST edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-										 << "\n";
-#endif
+									DIAG(DIAG_RULES, DIAG_DETAILS, "R9: RESUME-ST edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+										 << "\n");
 #ifdef GRAPHDEBUGFULL
 								} else if (addEdgeRetValue == 0) {
 									cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -1301,18 +1379,18 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 								}
 							}
 						}
-					} else if (taskOfResetOp.compare("") == 0) {
+					} else if (taskOfResetOp == NOTASK) {
 #ifdef GRAPHDEBUGFULL
 						cout << "DEBUG: Cannot find task of reset op " << resetOp << "\n";
 						cout << "DEBUG: Skipping PAUSE-ST/MT for this task\n";
 #endif
-					} else if (taskOfResumeOp.compare("") == 0) {
+					} else if (taskOfResumeOp == NOTASK) {
 						cout << "ERROR: Cannot find task of resume op " << resumeOp << "\n";
 						return -1;
-					} else if (taskOfResetOp.compare(taskOfResumeOp) == 0) {
+					} else if (taskOfResetOp == taskOfResumeOp) {
 #ifdef GRAPHDEBUGFULL
 						cout << "DEBUG: Resume op " << resumeOp << " and reset op " << resetOp
-							 << " are in the same task " << taskOfResetOp << "\n";
+							 << " are in the same task " << taskNames.name(taskOfResetOp) << "\n";
 #endif
 #ifdef EXTRARULES
 #ifdef GRAPHDEBUGFULL
@@ -1321,8 +1399,8 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 
 						opI = resetOp;
 						opJ = resumeOp;
-						IDType nodeI = opIDMap[opI].nodeID;
-						IDType nodeJ = opIDMap[opJ].nodeID;
+						IDType nodeI = opIDMap.nodeID[opI];
+						IDType nodeJ = opIDMap.nodeID[opJ];
 						if (nodeI <= 0) {
 							cout << "ERROR: Invalid node ID for op " << opI << "\n";
 							return -1;
@@ -1333,10 +1411,8 @@ int UAFDetector::add_PauseSTMT_ResumeSTMT_Edges() {
 							int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ);
 							if (addEdgeRetValue == 1) {
 								flag = true;
-#ifdef GRAPHDEBUG
-								cout << "R9: RESUME-ST edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-									 << "\n";
-#endif
+								DIAG(DIAG_RULES, DIAG_DETAILS, "R9: RESUME-ST edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+									 << "\n");
 							} else if (addEdgeRetValue == 0) {
 								cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
 							} else if (addEdgeRetValue == -1) {
@@ -1382,8 +1458,8 @@ int UAFDetector::add_WaitNotify_Edges() {
 		IDType opJ = it->second;
 
 		if (opI > 0 && opJ > 0) {
-			IDType threadI = opIDMap[opI].threadID;
-			IDType threadJ = opIDMap[opJ].threadID;
+			IDType threadI = opIDMap.threadID[opI];
+			IDType threadJ = opIDMap.threadID[opJ];
 			if (threadI < 0) {
 				cout << "ERROR: Cannot find threadID of op " << opI << "\n";
 				return -1;
@@ -1395,8 +1471,8 @@ int UAFDetector::add_WaitNotify_Edges() {
 
 			if (threadI == threadJ) continue;
 
-			IDType nodeI = opIDMap[opI].nodeID;
-			IDType nodeJ = opIDMap[opJ].nodeID;
+			IDType nodeI = opIDMap.nodeID[opI];
+			IDType nodeJ = opIDMap.nodeID[opJ];
 			if (nodeI <= 0) {
 				cout << "ERROR: Invalid node ID for op " << opI << "\n";
 				return -1;
@@ -1407,10 +1483,8 @@ int UAFDetector::add_WaitNotify_Edges() {
 				int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, false);
 				if (addEdgeRetValue == 1) {
 					flag = true;
-#ifdef GRAPHDEBUG
-					cout << "NOTIFY-WAIT edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-						 << "\n";
-#endif
+					DIAG(DIAG_RULES, DIAG_DETAILS, "NOTIFY-WAIT edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+						 << "\n");
 #ifdef GRAPHDEBUGFULL
 				} else if (addEdgeRetValue == 0) {
 					cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -1441,8 +1515,8 @@ int UAFDetector::add_WaitNotify_Edges() {
 			IDType opJ = *waitIt;
 
 			if (opI > 0 && opJ > 0) {
-				IDType threadI = opIDMap[opI].threadID;
-				IDType threadJ = opIDMap[opJ].threadID;
+				IDType threadI = opIDMap.threadID[opI];
+				IDType threadJ = opIDMap.threadID[opJ];
 				if (threadI < 0) {
 					cout << "ERROR: Cannot find threadID of op " << opI << "\n";
 					return -1;
@@ -1454,8 +1528,8 @@ int UAFDetector::add_WaitNotify_Edges() {
 
 				if (threadI == threadJ) continue;
 
-				IDType nodeI = opIDMap[opI].nodeID;
-				IDType nodeJ = opIDMap[opJ].nodeID;
+				IDType nodeI = opIDMap.nodeID[opI];
+				IDType nodeJ = opIDMap.nodeID[opJ];
 				if (nodeI <= 0) {
 					cout << "ERROR: Invalid node ID for op " << opI << "\n";
 					return -1;
@@ -1463,16 +1537,12 @@ int UAFDetector::add_WaitNotify_Edges() {
 					cout << "ERROR: Invalid node ID for op " << opJ << "\n";
 					return -1;
 				} else {
-#ifdef GRAPHDEBUG
-					cout << "DEBUG: Adding edge from " << nodeI << " to " << nodeJ << "\n";
-#endif
+					DIAG(DIAG_RULES, DIAG_DETAILS, "DEBUG: Adding edge from " << nodeI << " to " << nodeJ << "\n");
 					int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, false);
 					if (addEdgeRetValue == 1) {
 						flag = true;
-#ifdef GRAPHDEBUG
-						cout << "NOTIFYALL-WAIT edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-							 << "\n";
-#endif
+						DIAG(DIAG_RULES, DIAG_DETAILS, "NOTIFYALL-WAIT edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+							 << "\n");
 #ifdef GRAPHDEBUGFULL
 					} else if (addEdgeRetValue == 0) {
 						cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -1505,7 +1575,10 @@ int UAFDetector::add_WaitNotify_Edges() {
 int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 	bool flag = false;
 
-	for (map<std::string, UAFDetector::taskDetails>::iterator it = taskIDMap.begin(); it != taskIDMap.end(); it++) {
+	size_t unit = 0;
+	for (UAFDetector::taskMap::iterator it = taskIDMap.begin(); it != taskIDMap.end(); it++, unit++) {
+		if (!fifoNestedUnits.mustEvaluate(unit, graph))
+			continue;
 
 		IDType opI, opJ;
 		IDType threadI, threadJ;
@@ -1519,8 +1592,8 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 		enqI = it->second.enqOpID;
 
 		if (opI > 0 && enqI > 0) {
-			threadI = opIDMap[opI].threadID;
-			nodeEnqI = opIDMap[enqI].nodeID;
+			threadI = opIDMap.threadID[opI];
+			nodeEnqI = opIDMap.nodeID[enqI];
 			if (threadI < 0) {
 				cout << "ERROR: Cannot find thread ID of op " << opI << "\n";
 				return -1;
@@ -1530,11 +1603,12 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 				return -1;
 			}
 			// If there are no edges from enq, skip
-			if (graph->opAdjList.find(nodeEnqI) == graph->opAdjList.end()) continue;
-			HBGraph::adjListNode* currNode = graph->opAdjList[nodeEnqI]->head;
-			for (; currNode != NULL; currNode = currNode->next) {
-				// Check if the op in currNode is enq
-				IDType destNode = currNode->nodeID;
+			fifoNestedUnits.readsEdgesFrom(nodeEnqI);
+			// If there are no edges from enq, skip
+			if (graph->numOfSuccessors(nodeEnqI) == 0) continue;
+			for (IDType succ = graph->numOfSuccessors(nodeEnqI); succ-- > 0; ) {
+				// Check if the op in destNode is enq
+				IDType destNode = graph->successor(nodeEnqI, succ);
 				if (nodeIDMap.find(destNode) == nodeIDMap.end()) {
 					cout << "ERROR: Cannot find entry for node " << destNode << " in nodeIDMap\n";
 					return -1;
@@ -1545,12 +1619,12 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 				IDType destOp = *(nodeIDMap[destNode].opSet.begin());
 
 				// Get opType of destOp
-				if (opIDMap.find(destOp) == opIDMap.end()) {
+				if (!opIDMap.exists(destOp)) {
 					cout << "ERROR: Cannot find entry for op " << destOp << " in opIDMap\n";
 					return -1;
 				}
-				std::string destOpType = opIDMap[destOp].opType;
-				if (destOpType.compare("enq") != 0) continue;
+				OpType destOpType = opIDMap.opType[destOp];
+				if (destOpType != ENQ_OP) continue;
 
 				IDType enqJ = destOp;
 				threadJ = enqToTaskEnqueued[enqJ].targetThread;
@@ -1584,20 +1658,20 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 				if (enqToTaskEnqueued[enqI].priority != enqToTaskEnqueued[enqJ].priority)
 					continue;
 
-				std::string taskJ = enqToTaskEnqueued[enqJ].taskEnqueued;
+				TaskIDType taskJ = enqToTaskEnqueued[enqJ].taskEnqueued;
 #ifdef SANITYCHECK
-				assert(taskJ.compare("") != 0);
+				assert(taskJ != NOTASK);
 #endif
 				opJ = taskIDMap[taskJ].deqOpID;
 				if (opJ <= 0) {
 #ifdef GRAPHDEBUGFULL
-					cout << "DEBUG: Cannot find deq of task " << taskJ << endl;
+					cout << "DEBUG: Cannot find deq of task " << taskNames.name(taskJ) << endl;
 					cout << "DEBUG: Skipping FIFO-NESTED-1 edge from pause op " << opI << "\n";
 #endif
 					continue;
 				}
-				IDType nodeI = opIDMap[opI].nodeID;
-				IDType nodeJ = opIDMap[opJ].nodeID;
+				IDType nodeI = opIDMap.nodeID[opI];
+				IDType nodeJ = opIDMap.nodeID[opJ];
 				if (nodeI <= 0) {
 					cout << "ERROR: Invalid node ID for op " << opI << "\n";
 					return -1;
@@ -1608,10 +1682,8 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 					int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, true);
 					if (addEdgeRetValue == 1) {
 						flag = true;
-#ifdef GRAPHDEBUG
-						cout << "R12: FIFO-NESTED-1 edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "
-							 << graph->numOfOpEdges << "\n";
-#endif
+						DIAG(DIAG_RULES, DIAG_DETAILS, "R12: FIFO-NESTED-1 edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "
+							 << graph->numOfOpEdges << "\n");
 #ifdef GRAPHDEBUGFULL
 					} else if (addEdgeRetValue == 0) {
 						cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -1624,12 +1696,12 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 			}
 		} else if (opI <= 0) {
 #ifdef GRAPHDEBUGFULL
-			cout << "DEBUG: Cannot find first pause of task " << it->first << "\n";
+			cout << "DEBUG: Cannot find first pause of task " << taskNames.name(it->first) << "\n";
 			cout << "DEBUG: Skipping FIFO-NESTED-1 edge for this task\n";
 #endif
 		} else if (enqI <= 0) {
 #ifdef GRAPHDEBUGFULL
-			cout << "DEBUG: Cannot find enq of task " << it->first << "\n";
+			cout << "DEBUG: Cannot find enq of task " << taskNames.name(it->first) << "\n";
 			cout << "DEBUG: Skipping FIFO-NESTED-1 edge for this task\n";
 #endif
 		}
@@ -1642,7 +1714,7 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 		if (opL > 0) {
 			if (opI <= 0) {
 #ifdef GRAPHDEBUGFULL
-				cout << "DEBUG: Cannot find end op of task " << it->first << "\n";
+				cout << "DEBUG: Cannot find end op of task " << taskNames.name(it->first) << "\n";
 				cout << "DEBUG: Skipping FIFO-NESTED-2 edge for this task\n";
 #endif
 #ifdef EXTRARULES
@@ -1650,15 +1722,16 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 #endif
 			}
 			if (opI > 0) {
-				IDType nodeL = opIDMap[opL].nodeID;
-				threadI = opIDMap[opI].threadID;
+				IDType nodeL = opIDMap.nodeID[opL];
+				threadI = opIDMap.threadID[opI];
 				if (nodeL > 0 && threadI > 0) {
 					// If there are no edges from resume, skip
-					if (graph->opAdjList.find(nodeL) == graph->opAdjList.end()) continue;
-					HBGraph::adjListNode* currNode = graph->opAdjList[nodeL]->head;
-					for (; currNode != NULL; currNode = currNode->next) {
-						// Check if the op in currNode is enq
-						IDType destNode = currNode->nodeID;
+					fifoNestedUnits.readsEdgesFrom(nodeL);
+					// If there are no edges from resume, skip
+					if (graph->numOfSuccessors(nodeL) == 0) continue;
+					for (IDType succ = graph->numOfSuccessors(nodeL); succ-- > 0; ) {
+						// Check if the op in destNode is enq
+						IDType destNode = graph->successor(nodeL, succ);
 						if (nodeIDMap.find(destNode) == nodeIDMap.end()) {
 							cout << "ERROR: Cannot find entry for node " << destNode << " in nodeIDMap\n";
 							return -1;
@@ -1669,12 +1742,12 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 						IDType destOp = *(nodeIDMap[destNode].opSet.begin());
 
 						// Get opType of destOp
-						if (opIDMap.find(destOp) == opIDMap.end()) {
+						if (!opIDMap.exists(destOp)) {
 							cout << "ERROR: Cannot find entry for op " << destOp << " in opIDMap\n";
 							return -1;
 						}
-						std::string destOpType = opIDMap[destOp].opType;
-						if (destOpType.compare("enq") != 0) continue;
+						OpType destOpType = opIDMap.opType[destOp];
+						if (destOpType != ENQ_OP) continue;
 
 						IDType enqJ = destOp;
 						threadJ = enqToTaskEnqueued[enqJ].targetThread;
@@ -1688,22 +1761,22 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 						// Rule applies only if enqJ posts to the same thread as end op opI
 						if (threadI != threadJ) continue;
 
-						std::string taskJ = enqToTaskEnqueued[enqJ].taskEnqueued;
+						TaskIDType taskJ = enqToTaskEnqueued[enqJ].taskEnqueued;
 #ifdef SANITYCHECK
-						assert(taskJ.compare("") != 0);
+						assert(taskJ != NOTASK);
 #endif
 						opJ = taskIDMap[taskJ].deqOpID;
 						if (opJ <= 0) {
 #ifdef GRAPHDEBUGFULL
-							cout << "DEBUG: Cannot find deq of task " << taskJ << endl;
+							cout << "DEBUG: Cannot find deq of task " << taskNames.name(taskJ) << endl;
 #ifdef EXTRARULES
 							opJ = taskIDMap[taskJ].firstOpInTaskID;
 #endif
 #endif
 						}
 						if (opJ > 0) {
-							IDType nodeI = opIDMap[opI].nodeID;
-							IDType nodeJ = opIDMap[opJ].nodeID;
+							IDType nodeI = opIDMap.nodeID[opI];
+							IDType nodeJ = opIDMap.nodeID[opJ];
 							if (nodeI <= 0) {
 								cout << "ERROR: Invalid node ID for op " << opI << "\n";
 								return -1;
@@ -1714,10 +1787,8 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 								int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, true);
 								if (addEdgeRetValue == 1) {
 									flag = true;
-#ifdef GRAPHDEBUG
-									cout << "R13: FIFO-NESTED-2 edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-										 << "\n";
-#endif
+									DIAG(DIAG_RULES, DIAG_DETAILS, "R13: FIFO-NESTED-2 edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+										 << "\n");
 #ifdef GRAPHDEBUGFULL
 								} else if (addEdgeRetValue == 0) {
 									cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -1729,13 +1800,13 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 							}
 						} else {
 #ifdef GRAPHDEBUGFULL
-							cout << "DEBUG: Cannot find deq op (or first op) of task " << taskJ << "\n";
-							cout << "DEBUG: Skipping FIFO-NESTED-2 edge from op " << opI << " to task " << taskJ << "\n";
+							cout << "DEBUG: Cannot find deq op (or first op) of task " << taskNames.name(taskJ) << "\n";
+							cout << "DEBUG: Skipping FIFO-NESTED-2 edge from op " << opI << " to task " << taskNames.name(taskJ) << "\n";
 #endif
 						}
 					}
 				} else if (nodeL <= 0) {
-					cout << "ERROR: Cannot find node of resume op " << opL << " of task " << it->first << "\n";
+					cout << "ERROR: Cannot find node of resume op " << opL << " of task " << taskNames.name(it->first) << "\n";
 					return -1;
 				} else if (threadI < 0) {
 					cout << "ERROR: Cannot find thread of op " << opI << "\n";
@@ -1743,13 +1814,13 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 				}
 			} else {
 #ifdef GRAPHDEBUGFULL
-				cout << "DEBUG: Cannot find end op (or last op) of task " << it->first << "\n";
+				cout << "DEBUG: Cannot find end op (or last op) of task " << taskNames.name(it->first) << "\n";
 				cout << "DEBUG: Skipping FIFO-NESTED-2 edge for this task\n";
 #endif
 			}
 		} else {
 #ifdef GRAPHDEBUGFULL
-			cout << "DEBUG: Cannot find last resume of task " << it->first << "\n";
+			cout << "DEBUG: Cannot find last resume of task " << taskNames.name(it->first) << "\n";
 			cout << "DEBUG: Skipping FIFO-NESTED-2 edge for this task\n";
 #endif
 		}
@@ -1762,8 +1833,8 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 			if (resumeOp == -1) continue;
 
 			// FIFO-NESTED-GEN
-			IDType nodeOfResumeOp = opIDMap[resumeOp].nodeID;
-			threadI = opIDMap[resumeOp].threadID;
+			IDType nodeOfResumeOp = opIDMap.nodeID[resumeOp];
+			threadI = opIDMap.threadID[resumeOp];
 
 #ifdef SANITYCHECK
 			if (nodeOfResumeOp <= 0) {
@@ -1779,11 +1850,12 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 #ifdef ADVANCEDRULES
 			if (nodeOfResumeOp > 0 && threadI >= 0) {
 				// If there are no edges from resume, skip
-				if (graph->opAdjList.find(nodeOfResumeOp) == graph->opAdjList.end()) continue;
-				HBGraph::adjListNode* currNode = graph->opAdjList[nodeOfResumeOp]->head;
-				for (; currNode != NULL; currNode = currNode->next) {
-					// Check if the op in currNode is enq
-					IDType destNode = currNode->nodeID;
+				fifoNestedUnits.readsEdgesFrom(nodeOfResumeOp);
+				// If there are no edges from resume, skip
+				if (graph->numOfSuccessors(nodeOfResumeOp) == 0) continue;
+				for (IDType succ = graph->numOfSuccessors(nodeOfResumeOp); succ-- > 0; ) {
+					// Check if the op in destNode is enq
+					IDType destNode = graph->successor(nodeOfResumeOp, succ);
 					if (nodeIDMap.find(destNode) == nodeIDMap.end()) {
 						cout << "ERROR: Cannot find entry for node " << destNode << " in nodeIDMap\n";
 						return -1;
@@ -1794,12 +1866,12 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 					IDType destOp = *(nodeIDMap[destNode].opSet.begin());
 
 					// Get opType of destOp
-					if (opIDMap.find(destOp) == opIDMap.end()) {
+					if (!opIDMap.exists(destOp)) {
 						cout << "ERROR: Cannot find entry for op " << destOp << " in opIDMap\n";
 						return -1;
 					}
-					std::string destOpType = opIDMap[destOp].opType;
-					if (destOpType.compare("enq") != 0) continue;
+					OpType destOpType = opIDMap.opType[destOp];
+					if (destOpType != ENQ_OP) continue;
 
 					IDType enqJ = destOp;
 					threadJ = enqToTaskEnqueued[enqJ].targetThread;
@@ -1825,9 +1897,9 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 						continue;
 					}
 
-					std::string taskEnqueued = enqToTaskEnqueued[enqJ].taskEnqueued;
+					TaskIDType taskEnqueued = enqToTaskEnqueued[enqJ].taskEnqueued;
 #ifdef SANITYCHECK
-					if (taskEnqueued.compare("") == 0) {
+					if (taskEnqueued == NOTASK) {
 						cout << "ERROR: Cannot find task enqueued in enq op " << enqJ << endl;
 						return -1;
 					}
@@ -1835,15 +1907,15 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 					opJ = taskIDMap[taskEnqueued].deqOpID;
 					if (opJ <= 0) {
 #ifdef GRAPHDEBUGFULL
-						cout << "DEBUG: Cannot find deq op of task " << taskEnqueued << endl;
+						cout << "DEBUG: Cannot find deq op of task " << taskNames.name(taskEnqueued) << endl;
 #ifdef EXTRARULES
 						opJ = taskIDMap[taskEnqueued].firstOpInTaskID;
 #endif
 #endif
 					}
 					if (opJ > 0) {
-						IDType nodeI = opIDMap[opI].nodeID;
-						IDType nodeJ = opIDMap[opJ].nodeID;
+						IDType nodeI = opIDMap.nodeID[opI];
+						IDType nodeJ = opIDMap.nodeID[opJ];
 						if (nodeI <= 0) {
 							cout << "ERROR: Invalid node ID for op " << opI << "\n";
 							return -1;
@@ -1854,10 +1926,8 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 							int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, true);
 							if (addEdgeRetValue == 1) {
 								flag = true;
-#ifdef GRAPHDEBUG
-								cout << "FIFO-NESTED-GEN edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-									 << "\n";
-#endif
+								DIAG(DIAG_RULES, DIAG_DETAILS, "FIFO-NESTED-GEN edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+									 << "\n");
 #ifdef GRAPHDEBUGFULL
 							} else if (addEdgeRetValue == 0) {
 								cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -1869,7 +1939,7 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 						}
 					} else {
 #ifdef GRAPHDEBUGFULL
-						cout << "DEBUG: Cannot find deq op (or first op) of task " << taskEnqueued << "\n";
+						cout << "DEBUG: Cannot find deq op (or first op) of task " << taskNames.name(taskEnqueued) << "\n";
 						cout << "DEBUG: Skipping FIFO-NESTED-GEN edge from op " << opI << "\n";
 #endif
 					}
@@ -1888,10 +1958,10 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 			IDType resetOp = prIt->resetOp;
 
 			if (enqK > 0 && resetOp > 0) {
-				IDType nodeK = opIDMap[enqK].nodeID;
+				IDType nodeK = opIDMap.nodeID[enqK];
 
-				std::string taskOfResetOp = opIDMap[resetOp].taskID;
-				if (taskOfResetOp.compare("") == 0) {
+				TaskIDType taskOfResetOp = opIDMap.taskID[resetOp];
+				if (taskOfResetOp == NOTASK) {
 #ifdef GRAPHDEBUGFULL
 					cout << "DEBUG: Cannot find task of op " << resetOp << endl;
 					cout << "DEBUG: Skipping ENQRESET-ST-1 edge for resume op " << resumeOp << "\n";
@@ -1902,7 +1972,7 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 				IDType enqN = taskIDMap[taskOfResetOp].enqOpID;
 				if (enqN <= 0) {
 #ifdef GRAPHDEBUGFULL
-					cout << "DEBUG: Cannot find enq of reset task " << taskOfResetOp << endl;
+					cout << "DEBUG: Cannot find enq of reset task " << taskNames.name(taskOfResetOp) << endl;
 					cout << "DEBUG: Skipping ENQRESET-ST-1 edge for resume op " << resumeOp << "\n";
 #endif
 					continue;
@@ -1934,11 +2004,12 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 					continue;
 
 				// If there are no edges from enq, skip
-				if (graph->opAdjList.find(nodeK) == graph->opAdjList.end()) continue;
-				HBGraph::adjListNode* currNode = graph->opAdjList[nodeK]->head;
-				for (; currNode != NULL; currNode = currNode->next) {
-					// Check if the op in currNode is enq
-					IDType destNode = currNode->nodeID;
+				fifoNestedUnits.readsEdgesFrom(nodeK);
+				// If there are no edges from enq, skip
+				if (graph->numOfSuccessors(nodeK) == 0) continue;
+				for (IDType succ = graph->numOfSuccessors(nodeK); succ-- > 0; ) {
+					// Check if the op in destNode is enq
+					IDType destNode = graph->successor(nodeK, succ);
 					if (nodeIDMap.find(destNode) == nodeIDMap.end()) {
 						cout << "ERROR: Cannot find entry for node " << destNode << " in nodeIDMap\n";
 						return -1;
@@ -1949,12 +2020,12 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 					IDType destOp = *(nodeIDMap[destNode].opSet.begin());
 
 					// Get opType of destOp
-					if (opIDMap.find(destOp) == opIDMap.end()) {
+					if (!opIDMap.exists(destOp)) {
 						cout << "ERROR: Cannot find entry for op " << destOp << " in opIDMap\n";
 						return -1;
 					}
-					std::string destOpType = opIDMap[destOp].opType;
-					if (destOpType.compare("enq") != 0) continue;
+					OpType destOpType = opIDMap.opType[destOp];
+					if (destOpType != ENQ_OP) continue;
 
 					IDType enqL = destOp;
 					// We need to check if enqK < enqL < enqN.
@@ -2001,8 +2072,8 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 							enqToTaskEnqueued[enqL].priority != enqToTaskEnqueued[enqN].priority)
 						continue;
 
-					IDType nodeEnqL = opIDMap[enqL].nodeID;
-					IDType nodeEnqN = opIDMap[enqN].nodeID;
+					IDType nodeEnqL = opIDMap.nodeID[enqL];
+					IDType nodeEnqN = opIDMap.nodeID[enqN];
 					if (nodeEnqL <= 0) {
 						cout << "ERROR: Invalid node ID for op " << enqL << "\n";
 						return -1;
@@ -2010,17 +2081,18 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 						cout << "ERROR: Invalid node ID for op " << enqN << "\n";
 						return -1;
 					} else {
+						fifoNestedUnits.readsEdgesFrom(nodeEnqL);
 						int retValue2 = graph->opEdgeExists(nodeEnqL, nodeEnqN);
 						if (retValue2 == 1) {
-							std::string taskEnqueuedInL = enqToTaskEnqueued[enqL].taskEnqueued;
+							TaskIDType taskEnqueuedInL = enqToTaskEnqueued[enqL].taskEnqueued;
 #ifdef SANITYCHECK
-							assert(taskEnqueuedInL.compare("") != 0);
+							assert(taskEnqueuedInL != NOTASK);
 #endif
 							opI = taskIDMap[taskEnqueuedInL].endOpID;
 
 							if (opI <= 0) {
 #ifdef GRAPHDEBUGFULL
-								cout << "DEBUG: Cannot find end op of task " << taskEnqueuedInL << "\n";
+								cout << "DEBUG: Cannot find end op of task " << taskNames.name(taskEnqueuedInL) << "\n";
 #ifdef EXTRARULES
 								opI = taskIDMap[taskEnqueuedInL].lastOpInTaskID;
 #endif
@@ -2030,8 +2102,8 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 							if (opI > 0) {
 								opJ = resumeOp;
 
-								IDType nodeI = opIDMap[opI].nodeID;
-								IDType nodeJ = opIDMap[opJ].nodeID;
+								IDType nodeI = opIDMap.nodeID[opI];
+								IDType nodeJ = opIDMap.nodeID[opJ];
 								if (nodeI <= 0) {
 									cout << "ERROR: Invalid node ID for op " << opI << "\n";
 									return -1;
@@ -2042,10 +2114,8 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 									int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, true);
 									if (addEdgeRetValue == 1) {
 										flag = true;
-#ifdef GRAPHDEBUG
-										cout << "R10: ENQRESET-ST-1 edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-											 << "\n";
-#endif
+										DIAG(DIAG_RULES, DIAG_DETAILS, "R10: ENQRESET-ST-1 edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+											 << "\n");
 #ifdef GRAPHDEBUGFULL
 									} else if (addEdgeRetValue == 0) {
 										cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -2057,8 +2127,8 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 								}
 							} else {
 #ifdef GRAPHDEBUGFULL
-								cout << "DEBUG: Cannot find end op (or last op) of task " << taskEnqueuedInL << "\n";
-								cout << "DEBUG: Skipping ENQRESET-ST-1 edge from end of task " << taskEnqueuedInL << "\n";
+								cout << "DEBUG: Cannot find end op (or last op) of task " << taskNames.name(taskEnqueuedInL) << "\n";
+								cout << "DEBUG: Skipping ENQRESET-ST-1 edge from end of task " << taskNames.name(taskEnqueuedInL) << "\n";
 #endif
 							}
 						} else if (retValue2 == -1) {
@@ -2069,7 +2139,7 @@ int UAFDetector::add_FifoNested_1_2_Gen_EnqResetST_1_Edges() {
 				}
 			} else if (enqK <= 0) {
 #ifdef GRAPHDEBUGFULL
-				cout << "DEBUG: Cannot find enq op of task " << it->first << "\n";
+				cout << "DEBUG: Cannot find enq op of task " << taskNames.name(it->first) << "\n";
 				cout << "DEBUG: Skipping ENQRESET-ST-1 edge for this task\n";
 #endif
 			} else if (resetOp <= 0) {
@@ -2092,10 +2162,13 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 
 	IDType opI, opJ;
 
+	size_t unit = 0;
 	for (map<std::string, UAFDetector::nestingLoopDetails>::iterator it = nestingLoopMap.begin();
 			it != nestingLoopMap.end(); it++) {
 		for (vector<UAFDetector::pauseResumeResetTuple>::iterator prrIt = it->second.pauseResumeResetSet.begin();
-				prrIt != it->second.pauseResumeResetSet.end(); prrIt++) {
+				prrIt != it->second.pauseResumeResetSet.end(); prrIt++, unit++) {
+			if (!enqResetUnits.mustEvaluate(unit, graph))
+				continue;
 
 			IDType opK = prrIt->resetOp;
 			if (opK <= 0) {
@@ -2118,8 +2191,8 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 				continue;
 			}
 
-			IDType threadK = opIDMap[opK].threadID;
-			IDType threadM = opIDMap[opM].threadID;
+			IDType threadK = opIDMap.threadID[opK];
+			IDType threadM = opIDMap.threadID[opM];
 
 			if (threadK < 0) {
 				cout << "ERROR: Cannot find thread of reset op " << opK << "\n";
@@ -2134,13 +2207,13 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 			if (threadK != threadM)
 				continue;
 
-			std::string taskK = opIDMap[opK].taskID;
-			std::string taskM = opIDMap[opM].taskID;
+			TaskIDType taskK = opIDMap.taskID[opK];
+			TaskIDType taskM = opIDMap.taskID[opM];
 #ifdef SANITYCHECK
-			assert(taskK.compare("") != 0);
-			assert(taskM.compare("") != 0);
+			assert(taskK != NOTASK);
+			assert(taskM != NOTASK);
 #endif
-			if (taskK.compare("") == 0) {
+			if (taskK == NOTASK) {
 #ifdef GRAPHDEBUGFULL
 				cout << "DEBUG: Reset op " << opK << " is not contained in a task\n";
 				cout << "DEBUG: Skipping ENQRESET-ST-2/3 edges concerning this reset op\n";
@@ -2148,7 +2221,7 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 				continue;
 			}
 
-			if (taskM.compare("") == 0) {
+			if (taskM == NOTASK) {
 				cout << "ERROR: Cannot find task of resume op " << opM << "\n";
 				return -1;
 			}
@@ -2158,23 +2231,21 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 
 			IDType lastResumeOftaskM = taskIDMap[taskM].lastResumeOpID;
 			if (lastResumeOftaskM <= 0) {
-				cout << "ERROR: Cannot find last resume of task " << taskM << " but we saw a resume op " << opM << "\n";
+				cout << "ERROR: Cannot find last resume of task " << taskNames.name(taskM) << " but we saw a resume op " << opM << "\n";
 				return -1;
 			}
 
 			// taskM needs to be the parent of taskK
-			if (taskM.compare(taskIDMap[taskK].parentTask) != 0)
+			if (taskM != taskIDMap[taskK].parentTask)
 				continue;
 
 			IDType enqOfReset = taskIDMap[taskK].enqOpID;
 			if (enqOfReset <= 0) {
-#ifdef GRAPHDEBUG
-				cout << "DEBUG: Cannot find enq of task " << taskK << "\n";
-#endif
+				DIAG(DIAG_RULES, DIAG_DETAILS, "DEBUG: Cannot find enq of task " << taskNames.name(taskK) << "\n");
 				continue;
 			}
 
-			IDType nodeEnqOfReset = opIDMap[enqOfReset].nodeID;
+			IDType nodeEnqOfReset = opIDMap.nodeID[enqOfReset];
 #ifdef SANITYCHECK
 			if (nodeEnqOfReset <= 0) {
 				cout << "ERROR: Cannot find node of op " << enqOfReset << "\n";
@@ -2183,11 +2254,12 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 #endif
 
 			// If there are no edges from enq of reset, skip
-			if (graph->opAdjList.find(nodeEnqOfReset) == graph->opAdjList.end()) continue;
-			HBGraph::adjListNode* currNode = graph->opAdjList[nodeEnqOfReset]->head;
-			for (; currNode != NULL; currNode = currNode->next) {
-				// Check if the op in currNode is enq
-				IDType destNode = currNode->nodeID;
+			enqResetUnits.readsEdgesFrom(nodeEnqOfReset);
+			// If there are no edges from enq of reset, skip
+			if (graph->numOfSuccessors(nodeEnqOfReset) == 0) continue;
+			for (IDType succ = graph->numOfSuccessors(nodeEnqOfReset); succ-- > 0; ) {
+				// Check if the op in destNode is enq
+				IDType destNode = graph->successor(nodeEnqOfReset, succ);
 				if (nodeIDMap.find(destNode) == nodeIDMap.end()) {
 					cout << "ERROR: Cannot find entry for node " << destNode << " in nodeIDMap\n";
 					return -1;
@@ -2198,18 +2270,18 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 				IDType destOp = *(nodeIDMap[destNode].opSet.begin());
 
 				// Get opType of destOp
-				if (opIDMap.find(destOp) == opIDMap.end()) {
+				if (!opIDMap.exists(destOp)) {
 					cout << "ERROR: Cannot find entry for op " << destOp << " in opIDMap\n";
 					return -1;
 				}
-				std::string destOpType = opIDMap[destOp].opType;
-				if (destOpType.compare("enq") != 0) continue;
+				OpType destOpType = opIDMap.opType[destOp];
+				if (destOpType != ENQ_OP) continue;
 
 				IDType opL = destOp;
 				if (opL == enqOfReset)
 					continue;
 				IDType threadL = enqToTaskEnqueued[opL].targetThread;
-				IDType threadK = opIDMap[opK].threadID;
+				IDType threadK = opIDMap.threadID[opK];
 
 				if (threadL < 0) {
 					cout << "ERROR: Cannot find thread of op " << opL << "\n";
@@ -2246,8 +2318,8 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 #ifdef GRAPHDEBUGFULL
 				cout << "DEBUG: checking op edge (" << opK << ", " << opL << ")\n";
 #endif
-				IDType nodeK = opIDMap[enqOfReset].nodeID;
-				IDType nodeL = opIDMap[opL].nodeID;
+				IDType nodeK = opIDMap.nodeID[enqOfReset];
+				IDType nodeL = opIDMap.nodeID[opL];
 				if (nodeK <= 0) {
 					cout << "ERROR: Invalid node ID for op " << enqOfReset << "\n";
 					return -1;
@@ -2255,14 +2327,12 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 					cout << "ERROR: Invalid node ID for op " << opL << "\n";
 					return -1;
 				} else if (nodeK == nodeL) {
-#ifdef GRAPHDEBUG
-					cout << "DEBUG: Comparing same enq ops: " << opL << "\n";
-#endif
+					DIAG(DIAG_RULES, DIAG_DETAILS, "DEBUG: Comparing same enq ops: " << opL << "\n");
 					continue;
 				} else {
-					std::string taskL = enqToTaskEnqueued[opL].taskEnqueued;
+					TaskIDType taskL = enqToTaskEnqueued[opL].taskEnqueued;
 #ifdef SANITYCHECK
-					if (taskL.compare("") == 0) {
+					if (taskL == NOTASK) {
 						cout << "ERROR: Cannot find task enqueued in enq op " << opL << "\n";
 						return -1;
 					}
@@ -2271,7 +2341,7 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 
 					if (opJ <= 0) {
 #ifdef GRAPHDEBUGFULL
-						cout << "DEBUG: Cannot find deq of task " << taskL << "\n";
+						cout << "DEBUG: Cannot find deq of task " << taskNames.name(taskL) << "\n";
 #ifdef EXTRARULES
 						opJ = taskIDMap[taskL].firstOpInTaskID;
 #endif
@@ -2284,7 +2354,7 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 
 						if (opI <= 0) {
 #ifdef GRAPHDEBUGFULL
-							cout << "DEBUG: Cannot find end of task " << taskM << "\n";
+							cout << "DEBUG: Cannot find end of task " << taskNames.name(taskM) << "\n";
 #ifdef EXTRARULES
 							opI = taskIDMap[taskM].lastOpInTaskID;
 #endif
@@ -2295,8 +2365,8 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 #ifdef GRAPHDEBUGFULL
 							cout << "DEBUG: checking op edge (" << opI << ", " << opJ << ")\n";
 #endif
-							IDType nodeI = opIDMap[opI].nodeID;
-							IDType nodeJ = opIDMap[opJ].nodeID;
+							IDType nodeI = opIDMap.nodeID[opI];
+							IDType nodeJ = opIDMap.nodeID[opJ];
 							if (nodeI <= 0) {
 								cout << "ERROR: Invalid node ID for op " << opI << "\n";
 								return -1;
@@ -2307,10 +2377,8 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 								int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, true);
 								if (addEdgeRetValue == 1) {
 									flag = true;
-#ifdef GRAPHDEBUG
-									cout << "R11: ENQRESET-ST-2 edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-										 << "\n";
-#endif
+									DIAG(DIAG_RULES, DIAG_DETAILS, "R11: ENQRESET-ST-2 edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+										 << "\n");
 #ifdef GRAPHDEBUGFULL
 								} else if (addEdgeRetValue == 0) {
 									cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -2322,12 +2390,12 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 							}
 						} else if (opI <= 0) {
 #ifdef GRAPHDEBUGFULL
-							cout << "DEBUG: Cannot find end of task " << taskM << "\n";
+							cout << "DEBUG: Cannot find end of task " << taskNames.name(taskM) << "\n";
 							cout << "DEBUG: Skipping ENQRESET-ST-2 edge from end of task\n";
 #endif
 						} else if (opJ <= 0) {
 #ifdef GRAPHDEBUGFULL
-							cout << "DEBUG: Cannot find deq of task " << taskL << "\n";
+							cout << "DEBUG: Cannot find deq of task " << taskNames.name(taskL) << "\n";
 							cout << "DEBUG: Skipping ENQRESET-ST-2 edge from deq of task\n";
 #endif
 						}
@@ -2363,8 +2431,8 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 #ifdef GRAPHDEBUGFULL
 							cout << "DEBUG: checking op edge (" << opI << ", " << opJ << ")\n";
 #endif
-							IDType nodeI = opIDMap[opI].nodeID;
-							IDType nodeJ = opIDMap[opJ].nodeID;
+							IDType nodeI = opIDMap.nodeID[opI];
+							IDType nodeJ = opIDMap.nodeID[opJ];
 							if (nodeI <= 0) {
 								cout << "ERROR: Invalid node ID for op " << opI << "\n";
 								return -1;
@@ -2375,10 +2443,8 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 								int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, true);
 								if (addEdgeRetValue == 1) {
 									flag = true;
-#ifdef GRAPHDEBUG
-									cout << "ENQRESET-ST-3 edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
-										 << "\n";
-#endif
+									DIAG(DIAG_RULES, DIAG_DETAILS, "ENQRESET-ST-3 edge (" << nodeI << ", " << nodeJ << ") -- #op-edges "   << graph->numOfOpEdges
+										 << "\n");
 #ifdef GRAPHDEBUGFULL
 								} else if (addEdgeRetValue == 0) {
 									cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -2390,7 +2456,7 @@ int UAFDetector::add_EnqReset_ST_2_3_Edges() {
 							}
 						} else if (opJ <= 0) {
 #ifdef GRAPHDEBUGFULL
-							cout << "DEBUG: Cannot find deq op (or first op) of task " << taskL << "\n";
+							cout << "DEBUG: Cannot find deq op (or first op) of task " << taskNames.name(taskL) << "\n";
 							cout << "DEBUG: Skipping ENQRESET-ST-3 edge from op " << opI << " to this task\n";
 #endif
 						}
@@ -2411,17 +2477,10 @@ int UAFDetector::addTransSTOrMTEdges() {
 
 	// Adding TRANS-ST/MT Edges
 	std::set<IDType> processedNodes;
-	for (std::map<IDType, UAFDetector::opDetails>::iterator oIt = opIDMap.begin();
-			oIt != opIDMap.end(); oIt++) {
-		IDType opI = oIt->first;
-#ifdef SANITYCHECK
-		assert(opI > 0);
-#endif
-		if (opIDMap.find(opI) == opIDMap.end()) {
-			cout << "ERROR: Cannot find entry for op " << opI << " in opIDMap\n";
-			return -1;
-		}
-		IDType nodeI = opIDMap[opI].nodeID;
+	for (IDType opI = 1; opI <= opIDMap.maxOpID(); opI++) {
+		if (!opIDMap.exists(opI))
+			continue;
+		IDType nodeI = opIDMap.nodeID[opI];
 		if (nodeI <= 0) {
 			cout << "ERROR: Cannot find node of op " << opI << "\n";
 			return -1;
@@ -2429,25 +2488,23 @@ int UAFDetector::addTransSTOrMTEdges() {
 		if (processedNodes.find(nodeI) != processedNodes.end()) continue;
 		processedNodes.insert(nodeI);
 
-		IDType threadI = opIDMap[opI].threadID;
+		IDType threadI = opIDMap.threadID[opI];
 
 		// If there are no edges from op, skip
-		if (graph->opAdjList.find(nodeI) == graph->opAdjList.end()) continue;
-		HBGraph::adjListNode* currNode1 = graph->opAdjList[nodeI]->head;
-		for (; currNode1 != NULL; currNode1 = currNode1->next) {
-			IDType nodeK = currNode1->nodeID;
+		if (graph->numOfSuccessors(nodeI) == 0) continue;
+		for (IDType succ1 = graph->numOfSuccessors(nodeI); succ1-- > 0; ) {
+			IDType nodeK = graph->successor(nodeI, succ1);
 			// Find thread of nodeK
 			IDType opK = *(nodeIDMap[nodeK].opSet.begin());
-			IDType threadK = opIDMap[opK].threadID;
+			IDType threadK = opIDMap.threadID[opK];
 			bool edgeType1 = graph->isSTEdge(nodeI, nodeK);
 
-			if (graph->opAdjList.find(nodeK) == graph->opAdjList.end()) continue;
-			HBGraph::adjListNode* currNode2 = graph->opAdjList[nodeK]->head;
-			for (; currNode2 != NULL; currNode2 = currNode2->next) {
-				IDType nodeJ = currNode2->nodeID;
+			if (graph->numOfSuccessors(nodeK) == 0) continue;
+			for (IDType succ2 = graph->numOfSuccessors(nodeK); succ2-- > 0; ) {
+				IDType nodeJ = graph->successor(nodeK, succ2);
 				// Find thread of nodeJ
 				IDType opJ = *(nodeIDMap[nodeJ].opSet.begin());
-				IDType threadJ = opIDMap[opJ].threadID;
+				IDType threadJ = opIDMap.threadID[opJ];
 				bool edgeType2 = graph->isSTEdge(nodeK, nodeJ);
 
 #ifdef ADVANCEDRULES
@@ -2469,9 +2526,7 @@ int UAFDetector::addTransSTOrMTEdges() {
 					// threadI == threadJ and the contributing edges are not ST
 //							validTransEdge = false;
 					// Not a valid transitive edge
-#ifdef GRAPHDEBUG
-					cout << "Not a valid transitive edge " << nodeI << ", " << nodeJ << "\n";
-#endif
+					DIAG(DIAG_RULES, DIAG_DETAILS, "Not a valid transitive edge " << nodeI << ", " << nodeJ << "\n");
 					continue;
 				}
 #else
@@ -2491,10 +2546,8 @@ int UAFDetector::addTransSTOrMTEdges() {
 				int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, transEdgeType);
 				if (addEdgeRetValue == 1) {
 					flag = true;
-#ifdef GRAPHDEBUG
-					cout << "R7: TRANS-ST/MT Edge (" << nodeI << ", " << nodeJ << ") -- #opEdges " << graph->numOfOpEdges
-						 << "\n";
-#endif
+					DIAG(DIAG_RULES, DIAG_DETAILS, "R7: TRANS-ST/MT Edge (" << nodeI << ", " << nodeJ << ") -- #opEdges " << graph->numOfOpEdges
+						 << "\n");
 #ifdef GRAPHDEBUGFULL
 				} else if (addEdgeRetValue == 0) {
 					cout << "DEBUG: Edge (" << nodeI << ", " << nodeJ << ") already implied in the graph\n";
@@ -2513,6 +2566,400 @@ int UAFDetector::addTransSTOrMTEdges() {
 		return 0;
 }
 
+void UAFDetector::initThreadMasks() {
+	IDType numOfNodes = graph->totalOps;
+	threadIndexOfNode.assign(numOfNodes + 1, 0);
+
+	map<IDType, IDType> indexOfThread;
+	for (IDMap<IDType, setOfOps>::iterator it = nodeIDMap.begin(); it != nodeIDMap.end(); it++) {
+		if (it->first < 1 || it->first > numOfNodes || it->second.opSet.empty())
+			continue;
+		IDType thread = opIDMap.threadID[*(it->second.opSet.begin())];
+		if (indexOfThread.find(thread) == indexOfThread.end()) {
+			IDType index = indexOfThread.size() + 1;
+			indexOfThread[thread] = index;
+		}
+		threadIndexOfNode[it->first] = indexOfThread[thread];
+	}
+
+	if (!threadMasks.allocate(indexOfThread.size() + 1, numOfNodes + 1, 1)) {
+		cout << "ERROR: Cannot allocate memory for threadMasks\n";
+		return;
+	}
+	for (IDType node = 1; node <= numOfNodes; node++)
+		threadMasks.set(threadIndexOfNode[node], node, 0);
+}
+
+// Nodes of a tile of addTransSTOrMTEdgesByRows()
+static const IDType transTileSize = 64;
+
+// Rows addTransSTOrMTEdgesBySweep() asks to be read in at a time
+static const IDType sweepReadAheadRows = 1024;
+
+/*
+ * Same edges as addTransSTOrMTEdges(), computed over the rows of the bit
+ * matrix: the row of nodeI gets the OR of the rows of its successors nodeK,
+ * masked by the threads of nodeI/nodeK/nodeJ the rule allows:
+ *  - same thread (nodeI, nodeK, nodeJ on one thread, both edges ST): ST edge
+ *  - ADVANCEDRULES, cross thread (nodeJ not on the thread of nodeI): MT edge
+ * Rows are processed in tiles of transTileSize nodes, taking the successors
+ * of the tile a word (64 nodes) at a time so that their rows stay in cache
+ * while they are ORed into every row of the tile. Unlike addTransSTOrMTEdges(),
+ * which adds one step of the rule per call, sweeps are repeated until the
+ * graph is closed under the rule.
+ *
+ * Only what changed since the graph was last closed is visited again: a node
+ * without new edges only gets the rows of its successors with new edges (it
+ * already has the rest), and the call returns at once if no node has new
+ * edges.
+ *
+ * With numOfClosureThreads > 1 the tiles of a sweep are done concurrently
+ * against the graph as it was at the start of the sweep, and their edges are
+ * added once all tiles are done, in the order of the tiles. The edges and
+ * the order they are added in do not depend on the number of threads (they
+ * can differ from a single thread, which adds the edges of each tile before
+ * doing the next one, but the closed graph is the same). The threads of
+ * closureWorkers are started once and do the sweeps of every pass.
+ */
+int UAFDetector::addTransSTOrMTEdgesByRows() {
+	IDType numOfNodes = graph->totalOps;
+	IDType numOfTiles = (numOfNodes + transTileSize - 1) / transTileSize;
+	unsigned numOfWorkers = (numOfClosureThreads > 1 ? numOfClosureThreads : 1);
+
+	if (threadIndexOfNode.empty())
+		initThreadMasks();
+	if (!threadMasks.isAllocated())
+		return -1;
+
+	// per worker, plane 0: ST rows of the ST successors on the same thread
+	//             plane 1: rows of all successors (ADVANCEDRULES)
+	vector<BitMatrix> reached(numOfWorkers);
+	for (unsigned i = 0; i < numOfWorkers; i++) {
+		if (!reached[i].allocate(transTileSize, numOfNodes + 1, 2)) {
+			cout << "ERROR: Cannot allocate memory for TRANS-ST/MT rows\n";
+			return -1;
+		}
+	}
+
+	// nodes with edges added since changedSince (or in this sweep)
+	BitMatrix changed;
+	if (!changed.allocate(1, numOfNodes + 1, 1)) {
+		cout << "ERROR: Cannot allocate memory for TRANS-ST/MT rows\n";
+		return -1;
+	}
+
+	bool flag = false;
+	unsigned long long changedSince = transClosedAt;
+	vector<transEdge> edges;
+	vector<vector<transEdge> > edgesOfTile;
+	while (true) {
+		unsigned long long sweepStart = graph->edgeSerial + 1;
+
+		bool anyChanged = false;
+		changed.clearRow(0, 0);
+		for (IDType node = 1; node <= numOfNodes; node++) {
+			if (graph->lastEdgeFrom[node] > 0 && graph->lastEdgeFrom[node] >= changedSince) {
+				changed.set(0, node, 0);
+				anyChanged = true;
+			}
+		}
+		if (!anyChanged)
+			break;
+
+		if (numOfWorkers == 1) {
+			for (IDType tile = 0; tile < numOfTiles; tile++) {
+				IDType firstNode = tile * transTileSize + 1;
+				IDType lastNode = (firstNode + transTileSize - 1 < numOfNodes ? firstNode + transTileSize - 1 : numOfNodes);
+				edges.clear();
+				findTransEdgesOfTile(firstNode, lastNode, changed, reached[0], edges);
+				if (addTransEdges(edges, changed, flag) == -1)
+					return -1;
+			}
+		} else {
+			edgesOfTile.assign(numOfTiles, vector<transEdge>());
+			atomic<IDType> nextTile(0);
+			if (closureWorkers == NULL)
+				closureWorkers = new WorkerPool(numOfWorkers);
+			closureWorkers->run([&](unsigned worker) {
+				findTransEdgesOfTiles(&nextTile, numOfTiles, &changed, &reached[worker], &edgesOfTile);
+			});
+
+			for (IDType tile = 0; tile < numOfTiles; tile++) {
+				if (addTransEdges(edgesOfTile[tile], changed, flag) == -1)
+					return -1;
+				vector<transEdge>().swap(edgesOfTile[tile]);
+			}
+		}
+
+		changedSince = sweepStart;
+	}
+	transClosedAt = graph->edgeSerial + 1;
+
+	if (flag)
+		return 1;
+	else
+		return 0;
+}
+
+void UAFDetector::findTransEdgesOfTile(IDType firstNode, IDType lastNode, BitMatrix& changed,
+		BitMatrix& reached, vector<transEdge>& edges) {
+	typedef BitMatrix::wordType wordType;
+
+	BitMatrix& matrix = graph->opMatrix;
+	size_t numOfWords = matrix.wordsPerPlane;
+	const wordType* changedNodes = changed.rowWords(0, 0);
+	// true if a row was ORed into the reached rows of the node of the tile
+	bool reachedAny[transTileSize];
+
+	for (IDType nodeI = firstNode; nodeI <= lastNode; nodeI++) {
+		reached.clearRow(nodeI - firstNode, 0);
+		reached.clearRow(nodeI - firstNode, 1);
+		reachedAny[nodeI - firstNode] = false;
+	}
+
+	for (size_t w = 0; w < numOfWords; w++) {
+		for (IDType nodeI = firstNode; nodeI <= lastNode; nodeI++) {
+			const wordType* maskI = threadMasks.rowWords(threadIndexOfNode[nodeI], 0);
+			// all successors of a changed node, else the changed ones
+			wordType visit = (changed.get(0, nodeI, 0) ? ~(wordType) 0 : changedNodes[w]);
+
+			wordType successors = matrix.rowWords(nodeI, HBGraph::EDGETYPES)[w] & maskI[w] & visit;
+			if (successors != 0)
+				reachedAny[nodeI - firstNode] = true;
+			while (successors != 0) {
+				IDType nodeK = w * BitMatrix::bitsPerWord + __builtin_ctzll(successors);
+				successors &= successors - 1;
+				BitMatrix::orWords(reached.rowWords(nodeI - firstNode, 0),
+						matrix.rowWords(nodeK, HBGraph::EDGETYPES), numOfWords);
+			}
+#ifdef ADVANCEDRULES
+			successors = matrix.rowWords(nodeI, HBGraph::EDGES)[w] & visit;
+			if (successors != 0)
+				reachedAny[nodeI - firstNode] = true;
+			while (successors != 0) {
+				IDType nodeK = w * BitMatrix::bitsPerWord + __builtin_ctzll(successors);
+				successors &= successors - 1;
+				BitMatrix::orWords(reached.rowWords(nodeI - firstNode, 1),
+						matrix.rowWords(nodeK, HBGraph::EDGES), numOfWords);
+			}
+#endif
+		}
+	}
+
+	for (IDType nodeI = firstNode; nodeI <= lastNode; nodeI++) {
+		if (!reachedAny[nodeI - firstNode])
+			continue;
+		const wordType* maskI = threadMasks.rowWords(threadIndexOfNode[nodeI], 0);
+		const wordType* sameThread = reached.rowWords(nodeI - firstNode, 0);
+#ifdef ADVANCEDRULES
+		const wordType* crossThread = reached.rowWords(nodeI - firstNode, 1);
+#endif
+
+		for (size_t w = 0; w < numOfWords; w++) {
+			wordType existing = matrix.rowWords(nodeI, HBGraph::EDGES)[w];
+			wordType newST = sameThread[w] & maskI[w] & ~existing;
+			wordType newMT = 0;
+#ifdef ADVANCEDRULES
+			newMT = crossThread[w] & ~maskI[w] & ~existing;
+#endif
+			wordType newEdges = newST | newMT;
+			while (newEdges != 0) {
+				IDType nodeJ = w * BitMatrix::bitsPerWord + __builtin_ctzll(newEdges);
+				newEdges &= newEdges - 1;
+				if (nodeJ == nodeI)
+					continue;
+
+				bool transEdgeType = (newST >> (nodeJ % BitMatrix::bitsPerWord)) & 1;
+				edges.push_back(transEdge(nodeI, nodeJ, transEdgeType));
+			}
+		}
+	}
+}
+
+void UAFDetector::findTransEdgesOfTiles(atomic<IDType>* nextTile, IDType numOfTiles, BitMatrix* changed,
+		BitMatrix* reached, vector<vector<transEdge> >* edgesOfTile) {
+	IDType numOfNodes = graph->totalOps;
+	for (IDType tile = (*nextTile)++; tile < numOfTiles; tile = (*nextTile)++) {
+		IDType firstNode = tile * transTileSize + 1;
+		IDType lastNode = (firstNode + transTileSize - 1 < numOfNodes ? firstNode + transTileSize - 1 : numOfNodes);
+		findTransEdgesOfTile(firstNode, lastNode, *changed, *reached, (*edgesOfTile)[tile]);
+	}
+}
+
+int UAFDetector::addTransEdges(const vector<transEdge>& edges, BitMatrix& changed, bool& flag) {
+	for (size_t i = 0; i < edges.size(); i++) {
+		IDType nodeI = edges[i].source;
+		IDType nodeJ = edges[i].destination;
+		int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, edges[i].edgeType);
+		if (addEdgeRetValue == 1) {
+			flag = true;
+			changed.set(0, nodeI, 0);
+			DIAG(DIAG_RULES, DIAG_DETAILS, "R7: TRANS-ST/MT Edge (" << nodeI << ", " << nodeJ << ") -- #opEdges " << graph->numOfOpEdges
+				 << "\n");
+		} else if (addEdgeRetValue == -1) {
+			cout << "ERROR: While adding TRANS-ST/MT edge " << nodeI << " to " << nodeJ << endl;
+			return -1;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Same edges as addTransSTOrMTEdgesByRows(), for a graph whose edges all go
+ * from a node to a later node (HBGraph::forwardEdgesOnly, the nodes are
+ * numbered in trace order). Nodes are visited from the last one down, so the
+ * rows of the successors of nodeI are already closed when nodeI is visited,
+ * and one sweep closes the graph under the same thread rule. The cross thread
+ * rule of ADVANCEDRULES also combines edges into earlier nodes, so with it
+ * sweeps are repeated until no edge is added.
+ *
+ * As in addTransSTOrMTEdgesByRows(), a node without new edges only gets the
+ * rows of its successors with new edges (since the graph was last closed, or
+ * in this sweep). Once an edge goes to an earlier node, addEdges() closes the
+ * graph with addTransSTOrMTEdgesByRows() instead.
+ */
+int UAFDetector::addTransSTOrMTEdgesBySweep() {
+	typedef BitMatrix::wordType wordType;
+
+	IDType numOfNodes = graph->totalOps;
+	BitMatrix& matrix = graph->opMatrix;
+	size_t numOfWords = matrix.wordsPerPlane;
+
+	if (!graph->forwardEdgesOnly) {
+		cout << "ERROR: Closing the graph in one sweep needs an upper triangular matrix\n";
+		return -1;
+	}
+	if (threadIndexOfNode.empty())
+		initThreadMasks();
+	if (!threadMasks.isAllocated())
+		return -1;
+
+	// plane 0: ST rows of the ST successors on the same thread
+	// plane 1: rows of all successors (ADVANCEDRULES)
+	BitMatrix reached;
+	if (!reached.allocate(1, numOfNodes + 1, 2)) {
+		cout << "ERROR: Cannot allocate memory for TRANS-ST/MT rows\n";
+		return -1;
+	}
+	wordType* sameThread = reached.rowWords(0, 0);
+#ifdef ADVANCEDRULES
+	wordType* crossThread = reached.rowWords(0, 1);
+#endif
+
+	// nodes with edges added since changedSince (or in this sweep)
+	BitMatrix changed;
+	if (!changed.allocate(1, numOfNodes + 1, 1)) {
+		cout << "ERROR: Cannot allocate memory for TRANS-ST/MT rows\n";
+		return -1;
+	}
+	const wordType* changedNodes = changed.rowWords(0, 0);
+
+	bool flag = false;
+	unsigned long long changedSince = transClosedAt;
+	while (true) {
+		unsigned long long sweepStart = graph->edgeSerial + 1;
+
+		bool anyChanged = false;
+		changed.clearRow(0, 0);
+		for (IDType node = 1; node <= numOfNodes; node++) {
+			if (graph->lastEdgeFrom[node] > 0 && graph->lastEdgeFrom[node] >= changedSince) {
+				changed.set(0, node, 0);
+				anyChanged = true;
+			}
+		}
+		if (!anyChanged)
+			break;
+
+		for (IDType nodeI = numOfNodes; nodeI >= 1; nodeI--) {
+			// the sweep goes backwards, which the read ahead of a file
+			// backed matrix does not follow
+			if (nodeI % sweepReadAheadRows == 0)
+				matrix.willNeedRows(max(nodeI - sweepReadAheadRows, 1), nodeI - 1);
+
+			// words of the rows of nodeI from firstWord, the only ones kept
+			size_t firstWord = matrix.firstWordOfRow(nodeI);
+			const wordType* edgesI = matrix.rowWords(nodeI, HBGraph::EDGES) - firstWord;
+			const wordType* typesI = matrix.rowWords(nodeI, HBGraph::EDGETYPES) - firstWord;
+			const wordType* maskI = threadMasks.rowWords(threadIndexOfNode[nodeI], 0);
+			// all successors of a changed node, else the changed ones
+			bool visitAll = changed.get(0, nodeI, 0);
+
+			bool reachedAny = false;
+			for (size_t w = firstWord; w < numOfWords; w++) {
+				wordType visit = (visitAll ? ~(wordType) 0 : changedNodes[w]);
+
+				wordType successors = typesI[w] & maskI[w] & visit;
+				while (successors != 0) {
+					IDType nodeK = w * BitMatrix::bitsPerWord + __builtin_ctzll(successors);
+					successors &= successors - 1;
+					if (!reachedAny) {
+						reached.clearRow(0, 0);
+						reached.clearRow(0, 1);
+						reachedAny = true;
+					}
+					size_t firstWordK = matrix.firstWordOfRow(nodeK);
+					BitMatrix::orWords(sameThread + firstWordK, matrix.rowWords(nodeK, HBGraph::EDGETYPES),
+							numOfWords - firstWordK);
+				}
+#ifdef ADVANCEDRULES
+				successors = edgesI[w] & visit;
+				while (successors != 0) {
+					IDType nodeK = w * BitMatrix::bitsPerWord + __builtin_ctzll(successors);
+					successors &= successors - 1;
+					if (!reachedAny) {
+						reached.clearRow(0, 0);
+						reached.clearRow(0, 1);
+						reachedAny = true;
+					}
+					size_t firstWordK = matrix.firstWordOfRow(nodeK);
+					BitMatrix::orWords(crossThread + firstWordK, matrix.rowWords(nodeK, HBGraph::EDGES),
+							numOfWords - firstWordK);
+				}
+#endif
+			}
+			if (!reachedAny)
+				continue;
+
+			for (size_t w = firstWord; w < numOfWords; w++) {
+				wordType newST = sameThread[w] & maskI[w] & ~edgesI[w];
+				wordType newMT = 0;
+#ifdef ADVANCEDRULES
+				newMT = crossThread[w] & ~maskI[w] & ~edgesI[w];
+#endif
+				wordType newEdges = newST | newMT;
+				while (newEdges != 0) {
+					IDType nodeJ = w * BitMatrix::bitsPerWord + __builtin_ctzll(newEdges);
+					newEdges &= newEdges - 1;
+
+					bool transEdgeType = (newST >> (nodeJ % BitMatrix::bitsPerWord)) & 1;
+					int addEdgeRetValue = graph->addOpEdge(nodeI, nodeJ, transEdgeType);
+					if (addEdgeRetValue == 1) {
+						flag = true;
+						changed.set(0, nodeI, 0);
+						DIAG(DIAG_RULES, DIAG_DETAILS, "R7: TRANS-ST/MT Edge (" << nodeI << ", " << nodeJ << ") -- #opEdges " << graph->numOfOpEdges
+							 << "\n");
+					} else if (addEdgeRetValue == -1) {
+						cout << "ERROR: While adding TRANS-ST/MT edge " << nodeI << " to " << nodeJ << endl;
+						return -1;
+					}
+				}
+			}
+		}
+
+		changedSince = sweepStart;
+#ifndef ADVANCEDRULES
+		// the same thread rule is closed after one sweep
+		break;
+#endif
+	}
+	transClosedAt = graph->edgeSerial + 1;
+
+	if (flag)
+		return 1;
+	else
+		return 0;
+}
+
 int UAFDetector::filterInput(std::string inFileName, std::string outFileName) {
 	ifstream inFile;
 	inFile.open(inFileName.c_str(), ios_base::in);
@@ -2632,8 +3079,8 @@ int UAFDetector::filterInput(std::string inFileName, std::string outFileName) {
 			return -1;
 		}
 
-		IDType useNode = opIDMap[useOp].nodeID;
-		IDType freeNode = opIDMap[freeOp].nodeID;
+		IDType useNode = opIDMap.nodeID[useOp];
+		IDType freeNode = opIDMap.nodeID[freeOp];
 		bool useToFree = false;
 		bool freeToUse = false;
 		if (useNode == freeNode && freeOp < useOp) {
@@ -2674,36 +3121,36 @@ int UAFDetector::filterInput(std::string inFileName, std::string outFileName) {
 void UAFDetector::getRaceKind(UAFDetector::raceDetails &race) {
 	assert(race.op1 > 0 && race.op2 > 0);
 
-	race.op1Task = opIDMap[race.op1].taskID;
-	race.op2Task = opIDMap[race.op2].taskID;
+	race.op1Task = opIDMap.taskID[race.op1];
+	race.op2Task = opIDMap.taskID[race.op2];
 
-	if (race.op1Task.compare("") == 0 || race.op2Task.compare("") == 0) {
-		if (opIDMap[race.op1].threadID != opIDMap[race.op2].threadID)
+	if (race.op1Task == NOTASK || race.op2Task == NOTASK) {
+		if (opIDMap.threadID[race.op1] != opIDMap.threadID[race.op2])
 			race.raceType = NOTASKRACE_MULTITHREADED;
 		else
 			race.raceType = NOTASKRACE_SINGLETHREADED;
 		return;
 	}
 
-	if (race.op1Task.compare(race.op2Task) == 0) {
+	if (race.op1Task == race.op2Task) {
 		cout << "ERROR: Racing ops are in the same task\n";
 		cout << "ERROR: Op: " << race.op1 << ", " << race.op2 << "\n";
 		return;
 	}
 
-	if (opIDMap[race.op1].threadID != opIDMap[race.op2].threadID) {
+	if (opIDMap.threadID[race.op1] != opIDMap.threadID[race.op2]) {
 		race.raceType = MULTITHREADED;
 		return;
 	}
 
-	if ((taskIDMap[race.op1Task].parentTask.compare("") != 0) && (taskIDMap[race.op2Task].parentTask.compare("") != 0)
-			&& (taskIDMap[race.op1Task].parentTask.compare(taskIDMap[race.op2Task].parentTask) == 0)) {
+	if ((taskIDMap[race.op1Task].parentTask != NOTASK) && (taskIDMap[race.op2Task].parentTask != NOTASK)
+			&& (taskIDMap[race.op1Task].parentTask == taskIDMap[race.op2Task].parentTask)) {
 		race.raceType = NESTED_NESTED;
-	} else if (taskIDMap[race.op1Task].parentTask.compare("") != 0 &&
-			taskIDMap[race.op1Task].parentTask.compare(taskIDMap[race.op2Task].parentTask) != 0) {
+	} else if (taskIDMap[race.op1Task].parentTask != NOTASK &&
+			taskIDMap[race.op1Task].parentTask != taskIDMap[race.op2Task].parentTask) {
 		race.raceType = NESTED_PRIMARY;
-	} else if (taskIDMap[race.op2Task].parentTask.compare("") != 0 &&
-			taskIDMap[race.op2Task].parentTask.compare(taskIDMap[race.op1Task].parentTask) != 0) {
+	} else if (taskIDMap[race.op2Task].parentTask != NOTASK &&
+			taskIDMap[race.op2Task].parentTask != taskIDMap[race.op1Task].parentTask) {
 		race.raceType = NESTED_PRIMARY;
 	} else if (!(taskIDMap[race.op1Task].atomic)) {
 		race.raceType = NONATOMIC_WITH_OTHER;
@@ -2715,11 +3162,11 @@ void UAFDetector::getRaceKind(UAFDetector::raceDetails &race) {
 	IDType op2Deq = taskIDMap[race.op2Task].deqOpID;
 
 	if (op1Deq <= 0) {
-		cout << "ERROR: Cannot find deq of task " << race.op1Task << "\n";
+		cout << "ERROR: Cannot find deq of task " << taskNames.name(race.op1Task) << "\n";
 		return;
 	}
 	if (op2Deq <= 0) {
-		cout << "ERROR: Cannot find deq of task " << race.op2Task << "\n";
+		cout << "ERROR: Cannot find deq of task " << taskNames.name(race.op2Task) << "\n";
 		return;
 	}
 
@@ -2729,8 +3176,8 @@ void UAFDetector::getRaceKind(UAFDetector::raceDetails &race) {
 		return;
 	}
 
-	IDType nodeDeq1 = opIDMap[op1Deq].nodeID;
-	IDType nodeDeq2 = opIDMap[op2Deq].nodeID;
+	IDType nodeDeq1 = opIDMap.nodeID[op1Deq];
+	IDType nodeDeq2 = opIDMap.nodeID[op2Deq];
 	if (nodeDeq1 <= 0) {
 		cout << "ERROR: Cannot find node for deq op " << op1Deq << "\n";
 		return;
@@ -2751,7 +3198,7 @@ void UAFDetector::getRaceKind(UAFDetector::raceDetails &race) {
 		race.raceType = NESTED_WITH_TASKS_ORDERED;
 	}
 
-	if (opIDMap[race.op1].threadID != opIDMap[race.op2].threadID)
+	if (opIDMap.threadID[race.op1] != opIDMap.threadID[race.op2])
 		race.raceType = MULTITHREADED;
 	else
 		race.raceType = SINGLETHREADED;
@@ -2809,7 +3256,7 @@ IDType  UAFDetector::findUAF() {
 		IDType allocID = freeIt->second.allocOpID;
 		IDType nodeAlloc = -1;
 
-		IDType nodeFree = opIDMap[freeID].nodeID;
+		IDType nodeFree = opIDMap.nodeID[freeID];
 		if (nodeFree <= 0) {
 			cout << "ERROR: Invalid node ID for op " << freeID << "\n";
 			return -1;
@@ -2820,7 +3267,7 @@ IDType  UAFDetector::findUAF() {
 			cout << "DEBUG: Cannot find alloc for free op " << freeID << endl;
 #endif
 		} else {
-			nodeAlloc = opIDMap[allocID].nodeID;
+			nodeAlloc = opIDMap.nodeID[allocID];
 			if (nodeAlloc <= 0) {
 				cout << "ERROR: Invalid node ID for op " << allocID << "\n";
 				return -1;
@@ -2833,21 +3280,21 @@ IDType  UAFDetector::findUAF() {
 			raceDetails uaf;
 			uaf.allocID = allocID;
 
-			IDType nodeRead = opIDMap[readID].nodeID;
+			IDType nodeRead = opIDMap.nodeID[readID];
 			if (nodeRead <= 0) {
 				cout << "ERROR: Invalid node ID for op " << readID << "\n";
 				return -1;
 			}
 			if (nodeFree == nodeRead && freeID < readID) {
 #if 0
-				cout << "Definite UAF between read op " << readID << " (read at address " << readSet[readID].startingAddress
-					 << " in task " << opIDMap[readID].taskID << " in thread " << opIDMap[readID].threadID << ") "
-					 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << freeSet[freeID].startingAddress
-					 << " in task " << opIDMap[freeID].taskID << " in thread " << opIDMap[freeID].threadID << ")\n";
+				cout << "Definite UAF between read op " << readID << " (read at address " << addressToString(readSet[readID].startingAddress)
+					 << " in task " << opIDMap.taskID[readID] << " in thread " << opIDMap.threadID[readID] << ") "
+					 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << addressToString(freeSet[freeID].startingAddress)
+					 << " in task " << opIDMap.taskID[freeID] << " in thread " << opIDMap.threadID[freeID] << ")\n";
 				if (allocID > 0) {
 					cout << "Memory originally allocated at " << allocID << " (allocated " << allocSet[allocID].range << " bytes from address "
-						 << allocSet[allocID].startingAddress << " in task " << opIDMap[allocID].taskID
-						 << " in thread " << opIDMap[allocID].threadID << ")\n";
+						 << addressToString(allocSet[allocID].startingAddress) << " in task " << opIDMap.taskID[allocID]
+						 << " in thread " << opIDMap.threadID[allocID] << ")\n";
 				}
 #endif
 
@@ -2871,22 +3318,20 @@ IDType  UAFDetector::findUAF() {
 				continue;
 #endif
 			} else if (nodeFree == nodeRead) {
-#ifdef RACEDEBUG
-				cout << "DEBUG: Free op " << freeID << " and read op " << readID << " in the same node, but read before free\n";
-				cout << "DEBUG: Skipping this read while detecting races\n";
-#endif
+				DIAG(DIAG_DETECTION, DIAG_DETAILS, "DEBUG: Free op " << freeID << " and read op " << readID << " in the same node, but read before free\n");
+				DIAG(DIAG_DETECTION, DIAG_DETAILS, "DEBUG: Skipping this read while detecting races\n");
 				continue;
 			}
 			if (graph->opEdgeExists(nodeFree, nodeRead) == 1) {
 #if 0
-				cout << "Definite UAF between read op " << readID << " (read at address " << readSet[readID].startingAddress
-					 << " in task " << opIDMap[readID].taskID << " in thread " << opIDMap[readID].threadID << ") "
-					 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << freeSet[freeID].startingAddress
-					 << " in task " << opIDMap[freeID].taskID << " in thread " << opIDMap[freeID].threadID << ")\n";
+				cout << "Definite UAF between read op " << readID << " (read at address " << addressToString(readSet[readID].startingAddress)
+					 << " in task " << opIDMap.taskID[readID] << " in thread " << opIDMap.threadID[readID] << ") "
+					 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << addressToString(freeSet[freeID].startingAddress)
+					 << " in task " << opIDMap.taskID[freeID] << " in thread " << opIDMap.threadID[freeID] << ")\n";
 				if (allocID > 0) {
 					cout << "Memory originally allocated at " << allocID << " (allocated " << allocSet[allocID].range << " bytes from address "
-						 << allocSet[allocID].startingAddress << " in task " << opIDMap[allocID].taskID
-						 << " in thread " << opIDMap[allocID].threadID << ")\n";
+						 << addressToString(allocSet[allocID].startingAddress) << " in task " << opIDMap.taskID[allocID]
+						 << " in thread " << opIDMap.threadID[allocID] << ")\n";
 				}
 #endif
 
@@ -2926,10 +3371,10 @@ IDType  UAFDetector::findUAF() {
 					else if (nodeAlloc != nodeRead && graph->opEdgeExists(nodeAlloc, nodeRead))
 						edgeExists = true;
 					if (edgeExists &&
-							opIDMap[allocID].taskID.compare(opIDMap[readID].taskID) == 0
-							&& taskIDMap[opIDMap[allocID].taskID].atomic) {
+							opIDMap.taskID[allocID] == opIDMap.taskID[readID]
+							&& taskIDMap[opIDMap.taskID[allocID]].atomic) {
 
-						if (opIDMap[freeID].threadID == opIDMap[readID].threadID) {
+						if (opIDMap.threadID[freeID] == opIDMap.threadID[readID]) {
 #ifdef UNIQUERACE
 							if (!falsePositiveForFree) {
 								falsePositives++;
@@ -2949,14 +3394,14 @@ IDType  UAFDetector::findUAF() {
 				}
 #endif
 #if 0
-				cout << "Potential UAF between read op " << readID << " (read at address " << readSet[readID].startingAddress
-					 << " in task " << opIDMap[readID].taskID << " in thread " << opIDMap[readID].threadID << ") "
-					 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << freeSet[freeID].startingAddress
-					 << " in task " << opIDMap[freeID].taskID << " in thread " << opIDMap[freeID].threadID << ")\n";
+				cout << "Potential UAF between read op " << readID << " (read at address " << addressToString(readSet[readID].startingAddress)
+					 << " in task " << opIDMap.taskID[readID] << " in thread " << opIDMap.threadID[readID] << ") "
+					 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << addressToString(freeSet[freeID].startingAddress)
+					 << " in task " << opIDMap.taskID[freeID] << " in thread " << opIDMap.threadID[freeID] << ")\n";
 				if (allocID > 0) {
 					cout << "Memory originally allocated at " << allocID << " (allocated " << allocSet[allocID].range << " bytes from address "
-						 << allocSet[allocID].startingAddress << " in task " << opIDMap[allocID].taskID
-						 << " in thread " << opIDMap[allocID].threadID << ")\n";
+						 << addressToString(allocSet[allocID].startingAddress) << " in task " << opIDMap.taskID[allocID]
+						 << " in thread " << opIDMap.threadID[allocID] << ")\n";
 				}
 #endif
 
@@ -2986,21 +3431,21 @@ IDType  UAFDetector::findUAF() {
 			raceDetails uaf;
 			uaf.allocID = allocID;
 
-			IDType nodeWrite = opIDMap[writeID].nodeID;
+			IDType nodeWrite = opIDMap.nodeID[writeID];
 			if (nodeWrite <= 0) {
 				cout << "ERROR: Invalid node ID for op " << writeID << "\n";
 				return -1;
 			}
 			if (nodeFree == nodeWrite && freeID < writeID) {
 #if 0
-				cout << "Definite UAF between write op " << writeID << " (write at address " << writeSet[writeID].startingAddress
-					 << " in task " << opIDMap[writeID].taskID << " in thread " << opIDMap[writeID].threadID << ") "
-					 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << freeSet[freeID].startingAddress
-					 << " in task " << opIDMap[freeID].taskID << " in thread " << opIDMap[freeID].threadID << ")\n";
+				cout << "Definite UAF between write op " << writeID << " (write at address " << addressToString(writeSet[writeID].startingAddress)
+					 << " in task " << opIDMap.taskID[writeID] << " in thread " << opIDMap.threadID[writeID] << ") "
+					 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << addressToString(freeSet[freeID].startingAddress)
+					 << " in task " << opIDMap.taskID[freeID] << " in thread " << opIDMap.threadID[freeID] << ")\n";
 				if (allocID > 0) {
 					cout << "Memory originally allocated at " << allocID << " (allocated " << allocSet[allocID].range << " bytes from address "
-						 << allocSet[allocID].startingAddress << " in task " << opIDMap[allocID].taskID << " in thread "
-						 << opIDMap[allocID].threadID << ")\n";
+						 << addressToString(allocSet[allocID].startingAddress) << " in task " << opIDMap.taskID[allocID] << " in thread "
+						 << opIDMap.threadID[allocID] << ")\n";
 				}
 #endif
 
@@ -3025,22 +3470,20 @@ IDType  UAFDetector::findUAF() {
 				continue;
 #endif
 			} else if (nodeFree == nodeWrite) {
-#ifdef RACEDEBUG
-				cout << "DEBUG: Free op " << freeID << " and write op " << writeID << " in the same node, but write before free\n";
-				cout << "DEBUG: Skipping this write while detecting races\n";
-#endif
+				DIAG(DIAG_DETECTION, DIAG_DETAILS, "DEBUG: Free op " << freeID << " and write op " << writeID << " in the same node, but write before free\n");
+				DIAG(DIAG_DETECTION, DIAG_DETAILS, "DEBUG: Skipping this write while detecting races\n");
 				continue;
 			}
 			if (graph->opEdgeExists(nodeFree, nodeWrite) == 1) {
 #if 0
-				cout << "Definite UAF between write op " << writeID << " (write at address " << writeSet[writeID].startingAddress
-					 << " in task " << opIDMap[writeID].taskID << " in thread " << opIDMap[writeID].threadID << ") "
-					 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << freeSet[freeID].startingAddress
-					 << " in task " << opIDMap[freeID].taskID << " in thread " << opIDMap[freeID].threadID << ")\n";
+				cout << "Definite UAF between write op " << writeID << " (write at address " << addressToString(writeSet[writeID].startingAddress)
+					 << " in task " << opIDMap.taskID[writeID] << " in thread " << opIDMap.threadID[writeID] << ") "
+					 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << addressToString(freeSet[freeID].startingAddress)
+					 << " in task " << opIDMap.taskID[freeID] << " in thread " << opIDMap.threadID[freeID] << ")\n";
 				if (allocID > 0) {
 					cout << "Memory originally allocated at " << allocID << " (allocated " << allocSet[allocID].range << " bytes from address "
-						 << allocSet[allocID].startingAddress << " in task " << opIDMap[allocID].taskID
-						 << " in thread " << opIDMap[allocID].threadID << ")\n";
+						 << addressToString(allocSet[allocID].startingAddress) << " in task " << opIDMap.taskID[allocID]
+						 << " in thread " << opIDMap.threadID[allocID] << ")\n";
 				}
 #endif
 
@@ -3082,9 +3525,9 @@ IDType  UAFDetector::findUAF() {
 					else if (nodeAlloc != nodeWrite && graph->opEdgeExists(nodeAlloc, nodeWrite))
 						edgeExists = true;
 					if (edgeExists &&
-							opIDMap[allocID].taskID.compare(opIDMap[writeID].taskID) == 0
-							&& taskIDMap[opIDMap[allocID].taskID].atomic) {
-						if (opIDMap[freeID].threadID == opIDMap[writeID].threadID) {
+							opIDMap.taskID[allocID] == opIDMap.taskID[writeID]
+							&& taskIDMap[opIDMap.taskID[allocID]].atomic) {
+						if (opIDMap.threadID[freeID] == opIDMap.threadID[writeID]) {
 #ifdef UNIQUERACE
 							if (!falsePositiveForFree) {
 								falsePositives++;
@@ -3103,14 +3546,14 @@ IDType  UAFDetector::findUAF() {
 #endif
 
 #if 0
-				cout << "Potential UAF between write op " << writeID << " (write at address " << writeSet[writeID].startingAddress
-					 << " in task " << opIDMap[writeID].taskID << " in thread " << opIDMap[writeID].threadID << ") "
-					 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << freeSet[freeID].startingAddress
-					 << " in task " << opIDMap[freeID].taskID << " in thread " << opIDMap[freeID].threadID << ")\n";
+				cout << "Potential UAF between write op " << writeID << " (write at address " << addressToString(writeSet[writeID].startingAddress)
+					 << " in task " << opIDMap.taskID[writeID] << " in thread " << opIDMap.threadID[writeID] << ") "
+					 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << addressToString(freeSet[freeID].startingAddress)
+					 << " in task " << opIDMap.taskID[freeID] << " in thread " << opIDMap.threadID[freeID] << ")\n";
 				if (allocID > 0) {
 					cout << "Memory originally allocated at " << allocID << " (allocated " << allocSet[allocID].range << " bytes from address "
-						 << allocSet[allocID].startingAddress << " in task " << opIDMap[allocID].taskID
-						 << " in thread " << opIDMap[allocID].threadID << ")\n";
+						 << addressToString(allocSet[allocID].startingAddress) << " in task " << opIDMap.taskID[allocID]
+						 << " in thread " << opIDMap.threadID[allocID] << ")\n";
 				}
 #endif
 
@@ -3151,18 +3594,18 @@ IDType UAFDetector::findDataRaces() {
 #endif
 		for (set<IDType>::iterator writeIt = allocIt->second.writeOps.begin(); writeIt != allocIt->second.writeOps.end(); writeIt++) {
 
-			std::string writeAddress1 = writeSet[*writeIt].startingAddress;
+			AddressType writeAddress1 = writeSet[*writeIt].startingAddress;
 
-			IDType nodeWrite = opIDMap[*writeIt].nodeID;
+			IDType nodeWrite = opIDMap.nodeID[*writeIt];
 
 			// write-write races
 			for (set<IDType>::iterator write2It = allocIt->second.writeOps.begin(); write2It != allocIt->second.writeOps.end(); write2It++) {
 				if (*write2It == *writeIt) continue;
 
-				std::string writeAddress2 = writeSet[*write2It].startingAddress;
-				if (writeAddress1.compare(writeAddress2) != 0) continue;
+				AddressType writeAddress2 = writeSet[*write2It].startingAddress;
+				if (writeAddress1 != writeAddress2) continue;
 
-				IDType nodeWrite2 = opIDMap[*write2It].nodeID;
+				IDType nodeWrite2 = opIDMap.nodeID[*write2It];
 				if (nodeWrite <= 0) {
 					cout << "ERROR: Invalid node ID for op " << *writeIt << "\n";
 					return -1;
@@ -3172,9 +3615,7 @@ IDType UAFDetector::findDataRaces() {
 					return -1;
 				}
 				if (nodeWrite == nodeWrite2) {
-#ifdef RACEDEBUG
-					cout << "DEBUG: Write ops " << *writeIt << " and " *write2It << " are in the same node, so no race\n";
-#endif
+					DIAG(DIAG_DETECTION, DIAG_DETAILS, "DEBUG: Write ops " << *writeIt << " and " << *write2It << " are in the same node, so no race\n");
 					continue;
 				}
 				UAFDetector::raceDetails dataRace;
@@ -3182,11 +3623,11 @@ IDType UAFDetector::findDataRaces() {
 
 				if (graph->opEdgeExists(nodeWrite, nodeWrite2) == 0 && graph->opEdgeExists(nodeWrite2, nodeWrite) == 0) {
 #if 0
-					cout << "Potential data race between write ops " << *writeIt << " (in task " << opIDMap[*writeIt].taskID
-						 << " in thread " << opIDMap[*writeIt].threadID
-						 << ") and " << *write2It << " (in task " << opIDMap[*write2It].taskID
-						 << " in thread " << opIDMap[*write2It].threadID << ") on address "
-						 << writeAddress1 << endl;
+					cout << "Potential data race between write ops " << *writeIt << " (in task " << opIDMap.taskID[*writeIt]
+						 << " in thread " << opIDMap.threadID[*writeIt]
+						 << ") and " << *write2It << " (in task " << opIDMap.taskID[*write2It]
+						 << " in thread " << opIDMap.threadID[*write2It] << ") on address "
+						 << addressToString(writeAddress1) << endl;
 #endif
 
 					dataRace.op1 = *writeIt;
@@ -3219,18 +3660,16 @@ IDType UAFDetector::findDataRaces() {
 			for (set<IDType>::iterator readIt = allocIt->second.readOps.begin(); readIt != allocIt->second.readOps.end(); readIt++) {
 				if (*readIt == *writeIt) continue;
 
-				std::string readAddress = readSet[*readIt].startingAddress;
-				if (writeAddress1.compare(readAddress) != 0) continue;
+				AddressType readAddress = readSet[*readIt].startingAddress;
+				if (writeAddress1 != readAddress) continue;
 
-				IDType nodeRead = opIDMap[*readIt].nodeID;
+				IDType nodeRead = opIDMap.nodeID[*readIt];
 				if (nodeRead <= 0) {
 					cout << "ERROR: Invalid node ID for op " << *readIt << "\n";
 					return -1;
 				}
 				if (nodeWrite == nodeRead) {
-#ifdef RACEDEBUG
-					cout << "DEBUG: Read op " << *readIt << " and write op " << *writeIt << " are in the same node, so no race\n";
-#endif
+					DIAG(DIAG_DETECTION, DIAG_DETAILS, "DEBUG: Read op " << *readIt << " and write op " << *writeIt << " are in the same node, so no race\n");
 					continue;
 				}
 				UAFDetector::raceDetails dataRace;
@@ -3238,11 +3677,11 @@ IDType UAFDetector::findDataRaces() {
 
 				if (graph->opEdgeExists(nodeWrite, nodeRead) == 0 && graph->opEdgeExists(nodeRead, nodeWrite) == 0) {
 #if 0
-					cout << "Potential data race between read op " << *readIt << " (in task " << opIDMap[*readIt].taskID
-						 << " in thread " << opIDMap[*readIt].threadID
-						 << ") and write op " << *writeIt << "(in task " << opIDMap[*writeIt].taskID
-						 << " in thread " << opIDMap[*writeIt].threadID << ") on address "
-						 << readAddress << "\n";
+					cout << "Potential data race between read op " << *readIt << " (in task " << opIDMap.taskID[*readIt]
+						 << " in thread " << opIDMap.threadID[*readIt]
+						 << ") and write op " << *writeIt << "(in task " << opIDMap.taskID[*writeIt]
+						 << " in thread " << opIDMap.threadID[*writeIt] << ") on address "
+						 << addressToString(readAddress) << "\n";
 #endif
 
 					dataRace.op1 = *writeIt;
@@ -3288,24 +3727,23 @@ IDType  UAFDetector::findUAFUsingNodes() {
 		IDType allocID = freeIt->second.allocOpID;
 		IDType nodeAlloc = -1;
 
-		IDType nodeFree = opIDMap[freeID].nodeID;
+		IDType nodeFree = opIDMap.nodeID[freeID];
 		if (nodeFree <= 0) {
 			cout << "ERROR: Invalid node ID for op " << freeID << "\n";
 			return -1;
 		}
 
-		long long freeStartAddress, freeEndAddress;
-		std::stringstream freeStream;
-		freeStream << freeSet[freeID].startingAddress;
-		freeStream >> std::hex >> freeStartAddress;
-		freeEndAddress = freeStartAddress + freeSet[freeID].range - 1;
+		// freed block is [freeStartAddress, freeEndAddress)
+		AddressType freeStartAddress, freeEndAddress;
+		freeStartAddress = freeSet[freeID].startingAddress;
+		freeEndAddress = freeStartAddress + freeSet[freeID].range;
 
 		if (allocID == -1) {
 #ifdef GRAPHDEBUGFULL
 			cout << "DEBUG: Cannot find alloc for free op " << freeID << endl;
 #endif
 		} else {
-			nodeAlloc = opIDMap[allocID].nodeID;
+			nodeAlloc = opIDMap.nodeID[allocID];
 			if (nodeAlloc <= 0) {
 				cout << "ERROR: Invalid node ID for op " << allocID << "\n";
 				return -1;
@@ -3330,30 +3768,20 @@ IDType  UAFDetector::findUAFUsingNodes() {
 					accessIt != nodeIDMap[nodeAccess].opSet.end(); accessIt++) {
 				IDType accessID = *accessIt;
 
-				if (opIDMap[accessID].opType.compare("read") == 0) {
-					std::string readAddress = readSet[accessID].startingAddress;
-					long long readAddressInt;
-					std::stringstream readStream;
-					readStream << readAddress;
-					readStream >> std::hex >> readAddressInt;
+				if (opIDMap.opType[accessID] == READ_OP) {
+					AddressType readAddress = readSet[accessID].startingAddress;
 
-					if (readAddressInt < freeStartAddress || freeEndAddress < readAddressInt)
+					if (readAddress < freeStartAddress || readAddress >= freeEndAddress)
 						continue;
 
-				} else if (opIDMap[accessID].opType.compare("write") == 0) {
-					std::string writeAddress = writeSet[accessID].startingAddress;
-					long long writeAddressInt;
-					std::stringstream writeStream;
-					writeStream << writeAddress;
-					writeStream >> std::hex >> writeAddressInt;
+				} else if (opIDMap.opType[accessID] == WRITE_OP) {
+					AddressType writeAddress = writeSet[accessID].startingAddress;
 
-					if (writeAddressInt < freeStartAddress || freeEndAddress < writeAddressInt)
+					if (writeAddress < freeStartAddress || writeAddress >= freeEndAddress)
 						continue;
 
 				} else {
-#ifdef RACEDEBUG
-					cout << "DEBUG: Op " << accessID << " is neither read nor write\n";
-#endif
+					DIAG(DIAG_DETECTION, DIAG_DETAILS, "DEBUG: Op " << accessID << " is neither read nor write\n");
 					continue;
 				}
 
@@ -3362,14 +3790,14 @@ IDType  UAFDetector::findUAFUsingNodes() {
 
 				if (nodeFree == nodeAccess && freeID < accessID) {
 #if 0
-					cout << "Definite UAF between read op " << accessID << " (read at address " << readSet[accessID].startingAddress
-						 << " in task " << opIDMap[accessID].taskID << " in thread " << opIDMap[accessID].threadID << ") "
-						 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << freeSet[freeID].startingAddress
-						 << " in task " << opIDMap[freeID].taskID << " in thread " << opIDMap[freeID].threadID << ")\n";
+					cout << "Definite UAF between read op " << accessID << " (read at address " << addressToString(readSet[accessID].startingAddress)
+						 << " in task " << opIDMap.taskID[accessID] << " in thread " << opIDMap.threadID[accessID] << ") "
+						 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << addressToString(freeSet[freeID].startingAddress)
+						 << " in task " << opIDMap.taskID[freeID] << " in thread " << opIDMap.threadID[freeID] << ")\n";
 					if (allocID > 0) {
 						cout << "Memory originally allocated at " << allocID << " (allocated " << allocSet[allocID].range << " bytes from address "
-							 << allocSet[allocID].startingAddress << " in task " << opIDMap[allocID].taskID
-							 << " in thread " << opIDMap[allocID].threadID << ")\n";
+							 << addressToString(allocSet[allocID].startingAddress) << " in task " << opIDMap.taskID[allocID]
+							 << " in thread " << opIDMap.threadID[allocID] << ")\n";
 					}
 #endif
 
@@ -3389,22 +3817,20 @@ IDType  UAFDetector::findUAFUsingNodes() {
 					continue;
 
 				} else if (nodeFree == nodeAccess) {
-#ifdef RACEDEBUG
-					cout << "DEBUG: Free op " << freeID << " and read op " << readID << " in the same node, but read before free\n";
-					cout << "DEBUG: Skipping this read while detecting races\n";
-#endif
+					DIAG(DIAG_DETECTION, DIAG_DETAILS, "DEBUG: Free op " << freeID << " and access op " << accessID << " in the same node, but access before free\n");
+					DIAG(DIAG_DETECTION, DIAG_DETAILS, "DEBUG: Skipping this access while detecting races\n");
 					continue;
 				}
 				if (graph->opEdgeExists(nodeFree, nodeAccess) == 1) {
 #if 0
-					cout << "Definite UAF between read op " << accessID << " (read at address " << readSet[accessID].startingAddress
-						 << " in task " << opIDMap[accessID].taskID << " in thread " << opIDMap[accessID].threadID << ") "
-						 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << freeSet[freeID].startingAddress
-						 << " in task " << opIDMap[freeID].taskID << " in thread " << opIDMap[freeID].threadID << ")\n";
+					cout << "Definite UAF between read op " << accessID << " (read at address " << addressToString(readSet[accessID].startingAddress)
+						 << " in task " << opIDMap.taskID[accessID] << " in thread " << opIDMap.threadID[accessID] << ") "
+						 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << addressToString(freeSet[freeID].startingAddress)
+						 << " in task " << opIDMap.taskID[freeID] << " in thread " << opIDMap.threadID[freeID] << ")\n";
 					if (allocID > 0) {
 						cout << "Memory originally allocated at " << allocID << " (allocated " << allocSet[allocID].range << " bytes from address "
-							 << allocSet[allocID].startingAddress << " in task " << opIDMap[allocID].taskID
-							 << " in thread " << opIDMap[allocID].threadID << ")\n";
+							 << addressToString(allocSet[allocID].startingAddress) << " in task " << opIDMap.taskID[allocID]
+							 << " in thread " << opIDMap.threadID[allocID] << ")\n";
 					}
 #endif
 
@@ -3439,10 +3865,10 @@ IDType  UAFDetector::findUAFUsingNodes() {
 						else if (nodeAlloc != nodeAccess && graph->opEdgeExists(nodeAlloc, nodeAccess))
 							edgeExists = true;
 						if (edgeExists &&
-								opIDMap[allocID].taskID.compare(opIDMap[accessID].taskID) == 0
-								&& taskIDMap[opIDMap[allocID].taskID].atomic) {
+								opIDMap.taskID[allocID] == opIDMap.taskID[accessID]
+								&& taskIDMap[opIDMap.taskID[allocID]].atomic) {
 
-							if (opIDMap[freeID].threadID == opIDMap[accessID].threadID) {
+							if (opIDMap.threadID[freeID] == opIDMap.threadID[accessID]) {
 								falsePositives++;
 								uaf.raceType = SINGLETHREADED_ALLOC_MEMOP_IN_SAME_TASK_FP;
 //								cout << "False positive!!\n";
@@ -3454,14 +3880,14 @@ IDType  UAFDetector::findUAFUsingNodes() {
 					}
 #endif
 #if 0
-					cout << "Potential UAF between read op " << accessID << " (read at address " << readSet[accessID].startingAddress
-						 << " in task " << opIDMap[accessID].taskID << " in thread " << opIDMap[accessID].threadID << ") "
-						 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << freeSet[freeID].startingAddress
-						 << " in task " << opIDMap[freeID].taskID << " in thread " << opIDMap[freeID].threadID << ")\n";
+					cout << "Potential UAF between read op " << accessID << " (read at address " << addressToString(readSet[accessID].startingAddress)
+						 << " in task " << opIDMap.taskID[accessID] << " in thread " << opIDMap.threadID[accessID] << ") "
+						 << " and free op " << freeID << " (freed " << freeSet[freeID].range << " bytes from address " << addressToString(freeSet[freeID].startingAddress)
+						 << " in task " << opIDMap.taskID[freeID] << " in thread " << opIDMap.threadID[freeID] << ")\n";
 					if (allocID > 0) {
 						cout << "Memory originally allocated at " << allocID << " (allocated " << allocSet[allocID].range << " bytes from address "
-							 << allocSet[allocID].startingAddress << " in task " << opIDMap[allocID].taskID
-							 << " in thread " << opIDMap[allocID].threadID << ")\n";
+							 << addressToString(allocSet[allocID].startingAddress) << " in task " << opIDMap.taskID[allocID]
+							 << " in thread " << opIDMap.threadID[allocID] << ")\n";
 					}
 #endif
 
@@ -3494,11 +3920,10 @@ IDType UAFDetector::findDataRacesUsingNodes() {
 		if (allocIt->second.writeOps.size() == 0)
 			continue;
 
-		long long allocStartAddress, allocEndAddress;
-		std::stringstream allocStream;
-		allocStream << allocSet[allocIt->first].startingAddress;
-		allocStream >> std::hex >> allocStartAddress;
-		allocEndAddress = allocStartAddress + allocSet[allocIt->first].range - 1;
+		// allocated block is [allocStartAddress, allocEndAddress)
+		AddressType allocStartAddress, allocEndAddress;
+		allocStartAddress = allocSet[allocIt->first].startingAddress;
+		allocEndAddress = allocStartAddress + allocSet[allocIt->first].range;
 
 		for (set<IDType>::iterator nodeIt1 = allocIt->second.nodes.begin(); nodeIt1 != allocIt->second.nodes.end(); nodeIt1++) {
 			if (nodeIDMap.find(*nodeIt1) == nodeIDMap.end()) {
@@ -3523,50 +3948,40 @@ IDType UAFDetector::findDataRacesUsingNodes() {
 				for (set<IDType>::iterator op1It = nodeIDMap[node1].opSet.begin();
 						op1It != nodeIDMap[node1].opSet.end(); op1It++) {
 
-					std::string op1Address;
+					AddressType op1Address;
 					IDType op1 = *op1It;
-					if (opIDMap[op1].opType.compare("write") == 0) {
+					if (opIDMap.opType[op1] == WRITE_OP) {
 						op1Address = writeSet[op1].startingAddress;
-					} else if (opIDMap[op1].opType.compare("read") == 0) {
+					} else if (opIDMap.opType[op1] == READ_OP) {
 						op1Address = readSet[op1].startingAddress;
 					} else {
 //						cout << "DEBUG: Op for node " << *nodeIt1 << " is neither read nor write\n";
 						continue;
 					}
 
-					long long op1AddressInt;
-					std::stringstream op1Stream;
-					op1Stream << op1Address;
-					op1Stream >> std::hex >> op1AddressInt;
-
-					if (op1AddressInt < allocStartAddress || allocEndAddress < op1AddressInt)
+					if (op1Address < allocStartAddress || op1Address >= allocEndAddress)
 						continue;
 
 					for (set<IDType>::iterator op2It = nodeIDMap[*nodeIt2].opSet.begin();
 							op2It != nodeIDMap[*nodeIt2].opSet.end(); op2It++) {
 
-						std::string op2Address;
+						AddressType op2Address;
 						IDType op2 = *op2It;
-						if (opIDMap[op2].opType.compare("write") == 0)
+						if (opIDMap.opType[op2] == WRITE_OP)
 							op2Address = writeSet[op2].startingAddress;
-						else if (opIDMap[op2].opType.compare("read") == 0)
+						else if (opIDMap.opType[op2] == READ_OP)
 							op2Address = readSet[op2].startingAddress;
 						else {
 //							cout << "DEBUG: Op for node " << *nodeIt2 << " is neither read nor write\n";
 							continue;
 						}
-						long long op2AddressInt;
-						std::stringstream op2Stream;
-						op2Stream << op2Address;
-						op2Stream >> std::hex >> op2AddressInt;
-
-						if (op2AddressInt < allocStartAddress || allocEndAddress < op2AddressInt)
+						if (op2Address < allocStartAddress || op2Address >= allocEndAddress)
 							continue;
 
-						if (op1Address.compare(op2Address) != 0) continue;
+						if (op1Address != op2Address) continue;
 
-						if (opIDMap[*op1It].opType.compare("read") == 0 &&
-								opIDMap[*op2It].opType.compare("read") == 0)
+						if (opIDMap.opType[*op1It] == READ_OP &&
+								opIDMap.opType[*op2It] == READ_OP)
 							continue;
 
 						UAFDetector::raceDetails dataRace;
@@ -3727,15 +4142,15 @@ void UAFDetector::initLog(std::string traceFileName) {
 #endif
 }
 
-std::string UAFDetector::findPreviousTaskOfOp(IDType op) {
+TaskIDType UAFDetector::findPreviousTaskOfOp(IDType op) {
 	IDType tempOp = op;
-	while (opIDMap[tempOp].taskID.compare("") == 0) {
-		tempOp = opIDMap[tempOp].prevOpInThread;
+	while (opIDMap.taskID[tempOp] == NOTASK) {
+		tempOp = opIDMap.prevOpInThread[tempOp];
 		if (tempOp == -1) break;
 	}
-	if (tempOp == -1) return "";
+	if (tempOp == -1) return NOTASK;
 
-	return opIDMap[tempOp].taskID;
+	return opIDMap.taskID[tempOp];
 }
 
 #if 0
@@ -3972,10 +4387,10 @@ void UAFDetector::log(IDType op1ID, IDType op2ID, IDType opAllocID,
 
 //	cout << "Enter log(.): race: " << op1ID << " & " << op2ID << "\n";
 
-	IDType op1ThreadID = opIDMap[op1ID].threadID;
-	IDType op2ThreadID = opIDMap[op2ID].threadID;
-	std::string op1TaskID = opIDMap[op1ID].taskID;
-	std::string op2TaskID = opIDMap[op2ID].taskID;
+	IDType op1ThreadID = opIDMap.threadID[op1ID];
+	IDType op2ThreadID = opIDMap.threadID[op2ID];
+	TaskIDType op1TaskID = opIDMap.taskID[op1ID];
+	TaskIDType op2TaskID = opIDMap.taskID[op2ID];
 
 	if (op1ThreadID < 0) {
 		cout << "ERROR: Cannot find threadID of op " << op1ID << "\n";
@@ -3990,14 +4405,14 @@ void UAFDetector::log(IDType op1ID, IDType op2ID, IDType opAllocID,
 		return;
 #endif
 
-	if (op1TaskID.compare("") == 0)
+	if (op1TaskID == NOTASK)
 		op1TaskID = findPreviousTaskOfOp(op1ID);
-	if (op2TaskID.compare("") == 0)
+	if (op2TaskID == NOTASK)
 		op2TaskID = findPreviousTaskOfOp(op2ID);
 
 	IDType allocThreadID = -1;
 	if (opAllocID > 0) {
-		allocThreadID = opIDMap[opAllocID].threadID;
+		allocThreadID = opIDMap.threadID[opAllocID];
 	}
 
 	std::string line1, lines23, line4, line5;
@@ -4024,29 +4439,29 @@ void UAFDetector::log(IDType op1ID, IDType op2ID, IDType opAllocID,
 
 	// Finding the enq path
 	IDType enqID;
-	std::string tempTaskID = "";
+	TaskIDType tempTaskID = NOTASK;
 
-	std::set<std::string> enqPathTasks1, enqPathTasks2;
+	std::set<TaskIDType> enqPathTasks1, enqPathTasks2;
 	// op1
 	enqID = taskIDMap[op1TaskID].enqOpID;
 	if (enqID != -1) {
-		tempTaskID = opIDMap[enqID].taskID;
+		tempTaskID = opIDMap.taskID[enqID];
 
-		if (tempTaskID.compare("") != 0 &&
-				taskIDMap[tempTaskID].parentTask.compare("") != 0) {
+		if (tempTaskID != NOTASK &&
+				taskIDMap[tempTaskID].parentTask != NOTASK) {
 			enqPathTasks1.insert(taskIDMap[tempTaskID].parentTask);
 		}
 	}
 
 	str << enqID << " ";
 
-	while (enqID != -1 && tempTaskID.compare("") != 0) {
+	while (enqID != -1 && tempTaskID != NOTASK) {
 		enqID = taskIDMap[tempTaskID].enqOpID;
 		if (enqID != -1) {
-			tempTaskID = opIDMap[enqID].taskID;
+			tempTaskID = opIDMap.taskID[enqID];
 
-			if (tempTaskID.compare("") != 0 &&
-					taskIDMap[tempTaskID].parentTask.compare("") != 0) {
+			if (tempTaskID != NOTASK &&
+					taskIDMap[tempTaskID].parentTask != NOTASK) {
 				enqPathTasks1.insert(taskIDMap[tempTaskID].parentTask);
 			}
 		}
@@ -4064,22 +4479,22 @@ void UAFDetector::log(IDType op1ID, IDType op2ID, IDType opAllocID,
 	// op2
 	enqID = taskIDMap[op2TaskID].enqOpID;
 	if (enqID != -1) {
-		tempTaskID = opIDMap[enqID].taskID;
+		tempTaskID = opIDMap.taskID[enqID];
 
-		if (tempTaskID.compare("") != 0 &&
-				taskIDMap[tempTaskID].parentTask.compare("") != 0) {
+		if (tempTaskID != NOTASK &&
+				taskIDMap[tempTaskID].parentTask != NOTASK) {
 			enqPathTasks2.insert(taskIDMap[tempTaskID].parentTask);
 		}
 	}
 
 	str << enqID << " ";
-	while (enqID != -1 && tempTaskID.compare("") != 0) {
+	while (enqID != -1 && tempTaskID != NOTASK) {
 		enqID = taskIDMap[tempTaskID].enqOpID;
 		if (enqID != -1) {
-			tempTaskID = opIDMap[enqID].taskID;
+			tempTaskID = opIDMap.taskID[enqID];
 
-			if (tempTaskID.compare("") != 0 &&
-					taskIDMap[tempTaskID].parentTask.compare("") != 0) {
+			if (tempTaskID != NOTASK &&
+					taskIDMap[tempTaskID].parentTask != NOTASK) {
 				enqPathTasks2.insert(taskIDMap[tempTaskID].parentTask);
 			}
 		}
@@ -4093,37 +4508,12 @@ void UAFDetector::log(IDType op1ID, IDType op2ID, IDType opAllocID,
 
 	if (logAll) {
 //		cout << "logAll\n";
-		std::string accessAddress, allocAddress;
-		if (opIDMap[op1ID].opType.compare("read") == 0) {
-			accessAddress = readSet[op1ID].startingAddress;
-		} else if (opIDMap[op1ID].opType.compare("write") == 0) {
-			accessAddress = writeSet[op1ID].startingAddress;
-		} else {
-			cout << "ERROR: Racing op " << op1ID << " is neither read nor write\n";
-			opIDMap[op1ID].printOpDetails();
-			return;
-		}
-
-		allocAddress = allocSet[opAllocID].startingAddress;
-		long long allocAddressInt, accessAddressInt;
-		str << allocAddress;
-		str >> std::hex >> allocAddressInt;
-		str.str("");
-		str.clear();
-
-		str << accessAddress;
-		str >> std::hex >> accessAddressInt;
-		str.str("");
-		str.clear();
-
-//		int offset = accessAddressInt - allocAddressInt;
-
 		if (uafOrRace) {
 //			cout << "logall uaf: " << op1ID << " & " << op2ID << "\n";
 #if 0
 			uafAllLogger.streamObject << op1ID << " "
 					<< op1ThreadID << " " << op2ID << " " << op2ThreadID
-					<< " " << opAllocID << " " << accessAddress << " "
+					<< " " << opAllocID << " " << addressToString(accessAddress) << " "
 					<< offset << "\n";
 			uafAllLogger.writeLog();
 
@@ -4139,9 +4529,21 @@ void UAFDetector::log(IDType op1ID, IDType op2ID, IDType opAllocID,
 			uafAllLogger.writeLog(mtLine);
 		} else {
 #ifdef DATARACE
+			AddressType accessAddress;
+			if (opIDMap.opType[op1ID] == READ_OP) {
+				accessAddress = readSet[op1ID].startingAddress;
+			} else if (opIDMap.opType[op1ID] == WRITE_OP) {
+				accessAddress = writeSet[op1ID].startingAddress;
+			} else {
+				cout << "ERROR: Racing op " << op1ID << " is neither read nor write\n";
+				opIDMap.printOpDetails(op1ID, taskNames);
+				return;
+			}
+			long long offset = accessAddress - allocSet[opAllocID].startingAddress;
+
 			raceAllLogger.streamObject << op1ID << " "
 					<< op1ThreadID << " " << op2ID << " " << op2ThreadID
-					<< " " << opAllocID << " " << accessAddress << " "
+					<< " " << opAllocID << " " << addressToString(accessAddress) << " "
 					<< offset << "\n";
 			raceAllLogger.writeLog();
 
@@ -4263,10 +4665,10 @@ void UAFDetector::log(IDType op1ID, IDType op2ID, IDType opAllocID,
 #endif
 //		IDType deq1 = -1;
 //		IDType deq2 = -1;
-//		if (taskIDMap[opIDMap[op1ID].taskID].parentTask.compare("") != 0)
-//			deq1 = taskIDMap[taskIDMap[opIDMap[op1ID].taskID].parentTask].deqOpID;
-//		if (taskIDMap[opIDMap[op2ID].taskID].parentTask.compare("") != 0)
-//			deq2 = taskIDMap[taskIDMap[opIDMap[op2ID].taskID].parentTask].deqOpID;
+//		if (taskIDMap[opIDMap.taskID[op1ID]].parentTask != NOTASK)
+//			deq1 = taskIDMap[taskIDMap[opIDMap.taskID[op1ID]].parentTask].deqOpID;
+//		if (taskIDMap[opIDMap.taskID[op2ID]].parentTask != NOTASK)
+//			deq2 = taskIDMap[taskIDMap[opIDMap.taskID[op2ID]].parentTask].deqOpID;
 
 	} else if (raceType == NESTED_WITH_TASKS_ORDERED) {
 		if (uafOrRace)
@@ -4304,10 +4706,10 @@ void UAFDetector::log(IDType op1ID, IDType op2ID, IDType opAllocID,
 #endif
 //		IDType deq1 = -1;
 //		IDType deq2 = -1;
-//		if (!(taskIDMap[opIDMap[op1ID].taskID].atomic))
-//			deq1 = taskIDMap[opIDMap[op1ID].taskID].deqOpID;
-//		if (!(taskIDMap[opIDMap[op2ID].taskID].atomic))
-//			deq2 = taskIDMap[opIDMap[op2ID].taskID].deqOpID;
+//		if (!(taskIDMap[opIDMap.taskID[op1ID]].atomic))
+//			deq1 = taskIDMap[opIDMap.taskID[op1ID]].deqOpID;
+//		if (!(taskIDMap[opIDMap.taskID[op2ID]].atomic))
+//			deq2 = taskIDMap[opIDMap.taskID[op2ID]].deqOpID;
 
 	} else {
 		if (uafOrRace)
@@ -4324,12 +4726,12 @@ void UAFDetector::log(IDType op1ID, IDType op2ID, IDType opAllocID,
 	allLogger->writeLog(line4);
 	allLogger->writeLog(line5);
 
-	if (opIDMap[op1ID].threadID != opIDMap[op2ID].threadID) {
-		for (std::set<std::string>::iterator it1 = enqPathTasks1.begin();
+	if (opIDMap.threadID[op1ID] != opIDMap.threadID[op2ID]) {
+		for (std::set<TaskIDType>::iterator it1 = enqPathTasks1.begin();
 				it1 != enqPathTasks1.end(); it1++) {
-			for (std::set<std::string>::iterator it2 = enqPathTasks2.begin();
+			for (std::set<TaskIDType>::iterator it2 = enqPathTasks2.begin();
 					it2 != enqPathTasks2.end(); it2++) {
-				if ((*it1).compare(*it2) == 0) {
+				if ((*it1) == *it2) {
 					raceType = MULTITHREADED_FROM_SAME_NESTING_LOOP;
 					if (uafOrRace)
 						raceLogger = &uafMultithreadedSameNestingLoopLogger;
@@ -13,10 +13,18 @@
 #include <vector>
 #include <cassert>
 #include <climits>
+#include <stdint.h>
+#include <atomic>
+#include <unordered_map>
 
 #include <config.h>
 #include <debugconfig.h>
 #include <logging/Logger.h>
+#include <racedetector/TaskNameTable.h>
+#include <racedetector/IDMap.h>
+#include <racedetector/BitMatrix.h>
+#include <racedetector/ChainIndex.h>
+#include <racedetector/WorkerPool.h>
 
 #ifndef UAFDETECTOR_H_
 #define UAFDETECTOR_H_
@@ -45,6 +53,60 @@ enum RaceKindByThread {
 	BOTH_SINGLETHREADED
 };
 
+// Kinds of operations that can appear in a trace, one byte each in the op
+// tables and stacks. The values are stored in binary (.srb) traces, do not
+// renumber them.
+enum OpType : uint8_t {
+	INVALID_OP = 0,
+	THREADINIT_OP = 1,
+	THREADEXIT_OP = 2,
+	FORK_OP = 3,
+	JOIN_OP = 4,
+	ENTERLOOP_OP = 5,
+	EXITLOOP_OP = 6,
+	ENQ_OP = 7,
+	DEQ_OP = 8,
+	END_OP = 9,
+	PAUSE_OP = 10,
+	RESUME_OP = 11,
+	PERMIT_OP = 12,
+	REVOKE_OP = 13,
+	RESET_OP = 14,
+	ALLOC_OP = 15,
+	FREE_OP = 16,
+	INC_OP = 17,
+	DEC_OP = 18,
+	WAIT_OP = 19,
+	NOTIFY_OP = 20,
+	NOTIFYALL_OP = 21,
+	READ_OP = 22,
+	WRITE_OP = 23
+};
+
+// Returns the name of the op as written in the trace ("" for INVALID_OP)
+const char* opTypeToString(OpType type);
+
+// Memory addresses used in the trace
+typedef uint64_t AddressType;
+
+// Returns the address in hex as "0x..." (lower case, no leading zeros)
+std::string addressToString(AddressType address);
+
+// How UAFDetector::addEdges closes the graph under TRANS-ST/MT
+enum ClosureKind {
+	CLOSURE_PAIRS,	// one step over the adjacency lists per iteration
+	CLOSURE_ROWS,	// OR successor rows of the bit matrix into predecessor rows
+	CLOSURE_SWEEP,	// same, in one sweep from the last node, over an upper triangular matrix
+					// (CLOSURE_ROWS once an edge goes to an earlier node)
+	CLOSURE_LAZY	// none: HBGraph finds the TRANS-ST/MT edges that are read (closeRowsOnDemand)
+};
+
+// How HBGraph answers opEdgeExists/isSTEdge once the graph is closed
+enum HBRepresentation {
+	HB_MATRIX,		// the bit matrix
+	HB_CHAINS		// a ChainIndex built from the matrix, which is then freed
+};
+
 class UAFDetector {
 public:
 	UAFDetector();
@@ -58,8 +120,8 @@ public:
 	class opDetails {
 	public:
 		IDType threadID;
-		std::string taskID;
-		std::string opType;
+		TaskIDType taskID;
+		OpType opType;
 		IDType nodeID;
 
 		IDType nextOpInThread;
@@ -68,24 +130,135 @@ public:
 
 		opDetails() {
 			threadID = -1;
-			taskID = "";
-			opType = "";
+			taskID = NOTASK;
+			opType = INVALID_OP;
 			nodeID = -1;
 			nextOpInThread = -1;
 			nextOpInTask = -1;
 			prevOpInThread = -1;
 		}
 
-		void printOpDetails() {
-			cout << "threadID " << threadID << " taskID " << taskID
-				 << " opType " << opType << " node " << nodeID << "\n";
-			cout << "next-op-in-thread " << nextOpInThread << " prev-op-in-thread " << prevOpInThread
+		void printOpDetails(const TaskNameTable& taskNames, std::ostream& out = cout) {
+			out << "threadID " << threadID << " taskID " << taskNames.name(taskID)
+				 << " opType " << opTypeToString(opType) << " node " << nodeID << "\n";
+			out << "next-op-in-thread " << nextOpInThread << " prev-op-in-thread " << prevOpInThread
 				 << " next-op-in-task " << nextOpInTask;
 		}
 	};
 
+	// One field of opTable, indexed by op ID. Op IDs that have no value yet,
+	// including -1 (no op), read as the default value of the field.
+	template<typename T>
+	class opColumn {
+	public:
+		opColumn(T value) {
+			defaultValue = value;
+		}
+
+		T& operator[](IDType op) {
+#ifdef SANITYCHECK
+			assert(op >= -1);
+#endif
+			if (op + 1 >= (IDType) values.size())
+				values.resize(op + 2, defaultValue);
+			return values[op + 1];
+		}
+
+		T get(IDType op) const {
+			if (op < -1 || op + 1 >= (IDType) values.size())
+				return defaultValue;
+			return values[op + 1];
+		}
+
+		void reserve(IDType numOfOps) {
+			values.reserve(numOfOps + 2);
+		}
+
+	private:
+		vector<T> values;	// values[op+1] is the value of op
+		T defaultValue;
+	};
+
+	// Details of ops, stored field by field: opIDMap.nodeID[op] is the node
+	// of op, etc. An op is in the table once insert() has been called for it.
+	class opTable {
+	public:
+		opColumn<IDType> threadID;
+		opColumn<TaskIDType> taskID;
+		opColumn<OpType> opType;
+		opColumn<IDType> nodeID;
+
+		opColumn<IDType> nextOpInThread;
+		opColumn<IDType> prevOpInThread;
+		opColumn<IDType> nextOpInTask;
+
+		opTable() : threadID(-1), taskID(NOTASK), opType(INVALID_OP), nodeID(-1),
+				nextOpInThread(-1), prevOpInThread(-1), nextOpInTask(-1) {
+			count = 0;
+			lastOp = 0;
+		}
+
+		bool exists(IDType op) const {
+			return opType.get(op) != INVALID_OP;
+		}
+
+		void insert(IDType op, const opDetails& details) {
+			if (!exists(op))
+				count++;
+			if (op > lastOp)
+				lastOp = op;
+			threadID[op] = details.threadID;
+			taskID[op] = details.taskID;
+			opType[op] = details.opType;
+			nodeID[op] = details.nodeID;
+			nextOpInThread[op] = details.nextOpInThread;
+			prevOpInThread[op] = details.prevOpInThread;
+			nextOpInTask[op] = details.nextOpInTask;
+		}
+
+		opDetails get(IDType op) const {
+			opDetails details;
+			details.threadID = threadID.get(op);
+			details.taskID = taskID.get(op);
+			details.opType = opType.get(op);
+			details.nodeID = nodeID.get(op);
+			details.nextOpInThread = nextOpInThread.get(op);
+			details.prevOpInThread = prevOpInThread.get(op);
+			details.nextOpInTask = nextOpInTask.get(op);
+			return details;
+		}
+
+		// Makes room for ops 1 to numOfOps
+		void reserve(IDType numOfOps) {
+			threadID.reserve(numOfOps);
+			taskID.reserve(numOfOps);
+			opType.reserve(numOfOps);
+			nodeID.reserve(numOfOps);
+			nextOpInThread.reserve(numOfOps);
+			prevOpInThread.reserve(numOfOps);
+			nextOpInTask.reserve(numOfOps);
+		}
+
+		// Ops in the table are between 1 and maxOpID()
+		IDType maxOpID() const {
+			return lastOp;
+		}
+
+		size_t size() const {
+			return count;
+		}
+
+		void printOpDetails(IDType op, const TaskNameTable& taskNames, std::ostream& out = cout) const {
+			get(op).printOpDetails(taskNames, out);
+		}
+
+	private:
+		size_t count;
+		IDType lastOp;
+	};
+
 	// Maps operationID to its threadID, taskID and type.
-	map<IDType, opDetails> opIDMap;
+	opTable opIDMap;
 
 	class setOfOps {
 	public:
@@ -93,14 +266,14 @@ public:
 		setOfOps() {
 			opSet = set<IDType>();
 		}
-		void printDetails() {
+		void printDetails(std::ostream& out = cout) {
 			for (set<IDType>::iterator it = opSet.begin(); it != opSet.end(); it++) {
-				cout << *it << " ";
+				out << *it << " ";
 			}
 		}
 	};
 	// Maps node ID to set of opID
-	map<IDType, setOfOps> nodeIDMap;
+	IDMap<IDType, setOfOps> nodeIDMap;
 
 	// Stores pause-resume pair
 	class pauseResumeResetTuple {
@@ -115,8 +288,8 @@ public:
 			resetOp = -1;
 		}
 
-		void printPauseResumeResetTupleDetails() const {
-			cout << "Pause: " << pauseOp << " Resume: " << resumeOp
+		void printPauseResumeResetTupleDetails(std::ostream& out = cout) const {
+			out << "Pause: " << pauseOp << " Resume: " << resumeOp
 			     << " Reset: " << resetOp;
 		}
 	};
@@ -136,7 +309,7 @@ public:
 		IDType firstOpInTaskID;
 		IDType lastOpInTaskID;
 
-		std::string parentTask; // ID of immediate parent task
+		TaskIDType parentTask; // ID of immediate parent task
 		bool atomic;
 		IDType priority;
 
@@ -152,30 +325,36 @@ public:
 			firstOpInTaskID = -1;
 			lastOpInTaskID = -1;
 
-			parentTask = "";
+			parentTask = NOTASK;
 			atomic = true;
 			priority = INT_MAX;
 
 		}
 
-		void printTaskDetails() {
-			cout << "priority " << priority << " first-pause " << firstPauseOpID
+		void printTaskDetails(const TaskNameTable& taskNames, std::ostream& out = cout) {
+			out << "priority " << priority << " first-pause " << firstPauseOpID
 				 << " last-resume " << lastResumeOpID << " deq " << deqOpID
 				 << " end " << endOpID << " enq " << enqOpID << " first-op-in-task " << firstOpInTaskID
-				 << " parent task " << parentTask << " atomic " << (atomic? "true": "false");
+				 << " parent task " << taskNames.name(parentTask) << " atomic " << (atomic? "true": "false");
 
-			cout << "\nPauseResumeResetSequence: ";
+			out << "\nPauseResumeResetSequence: ";
 			for (vector<pauseResumeResetTuple>::iterator it = pauseResumeResetSequence.begin();
 					it != pauseResumeResetSequence.end(); it++) {
-				cout << "(";
-				it->printPauseResumeResetTupleDetails();
-				cout << ")\n";
+				out << "(";
+				it->printPauseResumeResetTupleDetails(out);
+				out << ")\n";
 			}
 		}
 	};
 
+	// Task details indexed by task ID
+	typedef IDMap<TaskIDType, taskDetails> taskMap;
+
 	// Maps task ID to its enq-op, deq-op, etc.
-	map<std::string, taskDetails> taskIDMap;
+	taskMap taskIDMap;
+
+	// Names of the tasks in taskIDMap, opDetails, etc.
+	TaskNameTable taskNames;
 
 	class nestingLoopDetails {
 	public:
@@ -185,12 +364,12 @@ public:
 			pauseResumeResetSet = vector<pauseResumeResetTuple>();
 		}
 
-		void printNestingLoopDetails() {
-			cout << "Pause-Resume-Reset: ";
+		void printNestingLoopDetails(std::ostream& out = cout) {
+			out << "Pause-Resume-Reset: ";
 			for (vector<pauseResumeResetTuple>::iterator it =
 			    pauseResumeResetSet.begin(); it != pauseResumeResetSet.end(); it++) {
-				it->printPauseResumeResetTupleDetails();
-				cout << "\n";
+				it->printPauseResumeResetTupleDetails(out);
+				out << "\n";
 			}
 		}
 	};
@@ -221,8 +400,8 @@ public:
 			lastOpInThreadID = -1;
 		}
 
-		void printThreadDetails() {
-			cout << " first-op " << firstOpID << " threadinit " << threadinitOpID << " threadexit " << threadexitOpID
+		void printThreadDetails(std::ostream& out = cout) {
+			out << " first-op " << firstOpID << " threadinit " << threadinitOpID << " threadexit " << threadexitOpID
 				 << " fork " << forkOpID << " join " << joinOpID << " enterloop " << enterloopID << " exitloop " << exitloopID
 				 << " lastOpInThread " << lastOpInThreadID;
 		}
@@ -234,18 +413,18 @@ public:
 
 	class enqOpDetails {
 	public:
-		std::string taskEnqueued;
+		TaskIDType taskEnqueued;
 		IDType targetThread;
 		IDType priority;
 
 		enqOpDetails() {
-			taskEnqueued = "";
+			taskEnqueued = NOTASK;
 			targetThread = -1;
 			priority = INT_MAX;
 		}
 
-		void printEnqDetails() {
-			cout << "Task enqueued " << taskEnqueued << " (priority "
+		void printEnqDetails(const TaskNameTable& taskNames, std::ostream& out = cout) {
+			out << "Task enqueued " << taskNames.name(taskEnqueued) << " (priority "
 				 << priority << ") to target thread " << targetThread;
 		}
 	};
@@ -258,24 +437,25 @@ public:
 
 	class memoryOpDetails {
 	public:
-		std::string startingAddress;
+		AddressType startingAddress;
 		IDType range;
 
 		memoryOpDetails() {
-			startingAddress = "";
+			startingAddress = 0;
 			range = -1;
 		}
 
-		void printMemOpDetails() {
-			cout << "starting address: " << startingAddress << " range: " << range;
+		void printMemOpDetails(std::ostream& out = cout) {
+			out << "starting address: " << addressToString(startingAddress) << " range: " << range;
 		}
 	};
 
 	// maps the op ID of a memory operation to the starting address and range of memory block involved.
+	// Reads and writes are most of the ops and are kept by op ID, allocs and frees in sparse maps.
 	map<IDType, memoryOpDetails> allocSet;
 	map<IDType, memoryOpDetails> freeSet;
-	map<IDType, memoryOpDetails> readSet;
-	map<IDType, memoryOpDetails> writeSet;
+	IDMap<IDType, memoryOpDetails> readSet;
+	IDMap<IDType, memoryOpDetails> writeSet;
 
 	class allocOpDetails {
 	public:
@@ -291,19 +471,19 @@ public:
 			nodes = set<IDType>();
 		}
 
-		void printDetails() {
-			cout << "read ops: ";
+		void printDetails(std::ostream& out = cout) {
+			out << "read ops: ";
 			for (set<IDType>::iterator it = readOps.begin(); it != readOps.end(); it++)
-				cout << *it << " ";
-			cout << "\nwrite ops: ";
+				out << *it << " ";
+			out << "\nwrite ops: ";
 			for (set<IDType>::iterator it = writeOps.begin(); it != writeOps.end(); it++)
-				cout << *it << " ";
-			cout << "\nfree ops: ";
+				out << *it << " ";
+			out << "\nfree ops: ";
 			for (set<IDType>::iterator it = freeOps.begin(); it != freeOps.end(); it++)
-				cout << *it << " ";
-			cout << "\nnodes: ";
+				out << *it << " ";
+			out << "\nnodes: ";
 			for (set<IDType>::iterator it = nodes.begin(); it != nodes.end(); it++)
-				cout << *it << " ";
+				out << *it << " ";
 		}
 	};
 
@@ -324,17 +504,17 @@ public:
 			nodes = set<IDType>();
 		}
 
-		void printDetails() {
-			cout << "alloc op: " << allocOpID << endl;
-			cout << "read ops: ";
+		void printDetails(std::ostream& out = cout) {
+			out << "alloc op: " << allocOpID << endl;
+			out << "read ops: ";
 			for (set<IDType>::iterator it = readOps.begin(); it != readOps.end(); it++)
-				cout << *it << " ";
-			cout << "\nwrite ops: ";
+				out << *it << " ";
+			out << "\nwrite ops: ";
 			for (set<IDType>::iterator it = writeOps.begin(); it != writeOps.end(); it++)
-				cout << *it << " ";
-			cout << "\nnodes: ";
+				out << *it << " ";
+			out << "\nnodes: ";
 			for (set<IDType>::iterator it = nodes.begin(); it != nodes.end(); it++)
-				cout << *it << " ";
+				out << *it << " ";
 		}
 	};
 
@@ -350,8 +530,8 @@ public:
 			lockID = "";
 		}
 
-		void printDetails() {
-			cout << "thread: " << threadID << " lockID: " << lockID;
+		void printDetails(std::ostream& out = cout) {
+			out << "thread: " << threadID << " lockID: " << lockID;
 		}
 	};
 
@@ -380,7 +560,17 @@ public:
 
 	HBGraph* graph;
 
-	void initGraph(IDType countOfOps);
+	// CLOSURE_ROWS by default
+	ClosureKind closure;
+	// HB_MATRIX by default
+	HBRepresentation representation;
+	// threads closing the graph under TRANS-ST/MT with CLOSURE_ROWS (1 by default)
+	unsigned numOfClosureThreads;
+	// directory of the file keeping the bit matrix of the graph (in memory if empty)
+	string matrixDirectory;
+
+	// Returns -1 if the graph cannot be allocated
+	int initGraph(IDType countOfOps);
 	void outputAllConflictingOps(string outUAFFileName, string outUAFUniqueFileName,
 			string outRaceFileName, string outRaceUniqueFileName);
 	int filterInput(string inFileName, string outFileName);
@@ -412,6 +602,79 @@ private:
 	int add_FifoNested_1_2_Gen_EnqResetST_1_Edges();
 	int add_EnqReset_ST_2_3_Edges();
 	int addTransSTOrMTEdges();
+	int addTransSTOrMTEdgesByRows();
+	int addTransSTOrMTEdgesBySweep();
+
+	// A TRANS-ST/MT edge found by findTransEdgesOfTile()
+	class transEdge {
+	public:
+		IDType source;
+		IDType destination;
+		bool edgeType;
+
+		transEdge(IDType source, IDType destination, bool edgeType) {
+			this->source = source;
+			this->destination = destination;
+			this->edgeType = edgeType;
+		}
+	};
+
+	// Appends to edges the TRANS-ST/MT edges missing from the nodes of the
+	// tile firstNode..lastNode. Only reads the graph, so tiles can be done
+	// concurrently, each with its own reached matrix.
+	void findTransEdgesOfTile(IDType firstNode, IDType lastNode, BitMatrix& changed,
+			BitMatrix& reached, std::vector<transEdge>& edges);
+	// Worker of a parallel sweep: does the tiles handed out by nextTile
+	void findTransEdgesOfTiles(std::atomic<IDType>* nextTile, IDType numOfTiles, BitMatrix* changed,
+			BitMatrix* reached, std::vector<std::vector<transEdge> >* edgesOfTile);
+	// Adds edges to the graph, marking their sources in changed
+	int addTransEdges(const std::vector<transEdge>& edges, BitMatrix& changed, bool& flag);
+	// Threads of the parallel sweeps, started by the first one and stopped
+	// once the graph is closed
+	WorkerPool* closureWorkers;
+
+	// Semi-naive evaluation of the rules in addEdges(). A rule visits its
+	// tasks (or nesting loops) as units, numbered in the order it visits
+	// them. For each unit it records the nodes whose edges it read, and visits
+	// the unit again only once one of them has new edges: otherwise the rule
+	// would only find the edges it added last time.
+	class ruleUnits {
+	public:
+		// Returns true if unit has to be evaluated, and starts recording
+		// the nodes it reads
+		bool mustEvaluate(size_t unit, const HBGraph* graph);
+
+		void readsEdgesFrom(IDType node) {
+			current->readNodes.push_back(node);
+		}
+
+	private:
+		class unitDetails {
+		public:
+			unsigned long long evaluatedAt;	// edgeSerial + 1 when last evaluated, 0 if never
+			std::vector<IDType> readNodes;
+
+			unitDetails() {
+				evaluatedAt = 0;
+			}
+		};
+
+		std::vector<unitDetails> units;
+		unitDetails* current;
+	};
+
+	ruleUnits fifoAtomicNoPreUnits, fifoNestedUnits, enqResetUnits;
+
+	// edgeSerial + 1 when the graph was last closed under TRANS-ST/MT by
+	// addTransSTOrMTEdgesByRows(): only the rows of nodes with edges added
+	// since then have to be visited again
+	unsigned long long transClosedAt;
+
+	// thread of each node, as an index into threadMasks (0 if unknown)
+	std::vector<IDType> threadIndexOfNode;
+	// row t: the nodes of thread index t
+	BitMatrix threadMasks;
+	void initThreadMasks();
 
 	unsigned long long uafCount, raceCount;
 	unsigned long long uniqueUafCount, uniqueRaceCount;
@@ -442,14 +705,14 @@ private:
 	public:
 		IDType op1;
 		IDType op2;
-		std::string op1Task, op2Task;
+		TaskIDType op1Task, op2Task;
 		IDType allocID;
 		bool uafOrRace; // true if uaf, false if race
 		RaceKind raceType;
 
 		raceDetails() {
 			op1 = -1; op2 = -1;
-			op1Task = ""; op2Task = "";
+			op1Task = NOTASK; op2Task = NOTASK;
 			allocID = -1;
 			uafOrRace = true;
 			raceType = UNKNOWN;
@@ -523,54 +786,45 @@ private:
 	void log(IDType op1ID, IDType op2ID, IDType opAllocID,
 			bool uafOrRace, RaceKind raceType, bool logAll=false, RaceKindByThread raceTypeByThread=BOTH_MULTITHREADED);
 
-	std::string findPreviousTaskOfOp(IDType op);
+	TaskIDType findPreviousTaskOfOp(IDType op);
 	void insertRace(raceDetails race);
 };
 
 class HBGraph {
-public:
-
-	class adjListNode {
-	public:
-		IDType nodeID;
-		adjListNode* next;
-
-		adjListNode() {
-			nodeID = -1;
-			next = NULL;
-		}
-
-		adjListNode(IDType op) {
-			nodeID = op;
-			next = NULL;
-		}
-	};
-
-private:
-	class adjListType {
-	public:
-		adjListNode* head;
-
-		adjListType() {
-			head = NULL;
-		}
-	};
-
 public:
 	HBGraph();
-	HBGraph(IDType countOfOps,
-			map<IDType, UAFDetector::opDetails> opMap,
-			map<IDType, UAFDetector::setOfOps> nodeMap);
+	// With upperTriangular, opMatrix keeps only the upper triangle until an
+	// edge goes to an earlier node (see forwardEdgesOnly). With
+	// matrixDirectory, opMatrix is kept in a new file in that directory
+	// rather than in memory. Check isAllocated().
+	HBGraph(IDType countOfOps, bool upperTriangular = false, const std::string& matrixDirectory = "");
 	virtual ~HBGraph();
 
 	IDType totalOps;
-	bool** opAdjMatrix;
-	bool** opEdgeTypeMatrix; // true if edge is st-edge, false if edge is dt-edge
-	std::map<IDType, adjListType*> opAdjList;
+	// plane EDGES: bit (i, j) is set if there is an edge from node i to node j
+	// plane EDGETYPES: bit (i, j) is set if that edge is an st-edge (not a dt-edge)
+	enum { EDGES = 0, EDGETYPES = 1 };
+	BitMatrix opMatrix;
+
+	// False if opMatrix could not be allocated
+	bool isAllocated() const {
+		return opMatrix.isAllocated();
+	}
+
+	// true while opMatrix is upper triangular: every edge so far goes from a
+	// node to a later node (addOpEdge() expands it on the first edge back)
+	bool forwardEdgesOnly;
 
+	// Replaces opMatrix once the graph is closed (see freezeToChains)
+	ChainIndex* chainIndex;
 
 	unsigned long long numOfOpEdges;
 
+	// no of edges added so far (not decreased by removeOpEdge), and the
+	// value it had when the last edge from each node was added (0 if none)
+	unsigned long long edgeSerial;
+	std::vector<unsigned long long> lastEdgeFrom;
+
 	// Return -1 if error, 1 if the edge was newly added, 0 if edge already present.
 	int addOpEdge(IDType sourceOp, IDType destinationOp, bool edgeType);
 	// True if ST edge, false if MT edge
@@ -582,22 +836,111 @@ public:
 
 	void printGraph();
 
-private:
-	map<IDType, UAFDetector::opDetails> opIDMap;
-	map<IDType, UAFDetector::setOfOps> nodeIDMap;
+	// Successors of node, in the order their edges were added: successor(node, i)
+	// for i from 0 to numOfSuccessors(node)-1. Edges added while iterating are
+	// appended, so iterating from the last index down visits the edges present
+	// when the iteration started, the latest first.
+	IDType numOfSuccessors(IDType node) {
+		if (!frozenBegin.empty())
+			return frozenBegin[node+1] - frozenBegin[node];
+		if (lazyThreadOfNode != NULL && !rowIsClosed(node))
+			closeRow(node);
+		return opSuccessors[node].size();
+	}
 
-	bool opEdgeExistsinList(IDType source, IDType destination) {
-		// The arguments are nodes, not ops!
+	IDType successor(IDType node, IDType i) const {
+		if (!frozenBegin.empty())
+			return frozenSuccessors[frozenBegin[node] + i];
+		return opSuccessors[node][i];
+	}
 
-		if (opAdjList.find(source) == opAdjList.end()) return false;
-		adjListNode* currNode = opAdjList[source]->head;
-		while (currNode != NULL) {
-			if (currNode->nodeID == destination)
-				return true;
-			currNode = currNode->next;
-		}
-		return false;
+	// Moves the successors into one array (CSR), indexed by frozenBegin.
+	// No edges can be added after this.
+	void freezeSuccessors();
+
+	// Builds chainIndex from opMatrix and frees opMatrix. No edges can be
+	// added after this. threadOfNode[n] is the thread of node n, from 0 to
+	// numOfThreads-1.
+	void freezeToChains(const std::vector<IDType>& threadOfNode, IDType numOfThreads);
+
+	// From now on, TRANS-ST/MT edges (without ADVANCEDRULES: ST paths between
+	// nodes of one thread) are not added by UAFDetector but found when they
+	// are read: opEdgeExists() searches the ST edges of the thread, only up
+	// to the destination, and caches the answer; numOfSuccessors() closes the
+	// row of the node first. threadOfNode and threadMasks are those of
+	// UAFDetector.
+	// This relies on every edge going to a later node (no node reaches an
+	// earlier one, and there are no cycles): addOpEdge() stops closing rows
+	// on demand on the first edge back, and UAFDetector has to close the
+	// graph itself from then on (see closesRowsOnDemand()).
+	void closeRowsOnDemand(const std::vector<IDType>* threadOfNode, BitMatrix* threadMasks);
+
+	bool closesRowsOnDemand() const {
+		return lazyThreadOfNode != NULL;
+	}
+
+	// Rows closed on demand stay closed until the edges added so far are
+	// committed: UAFDetector commits them once per pass of its rules, which
+	// (as with the other closures) may read edges missing until the next
+	// pass.
+	void commitEdges();
+
+	// True if the edges read from node may have changed since edgeSerial was
+	// since - 1: it has new edges, or (rows closed on demand) a node it reaches
+	// on its thread may have, as of the last commitEdges()
+	bool edgesChangedSince(IDType node, unsigned long long since) const {
+		if (lastEdgeFrom[node] >= since)
+			return true;
+		return lazyThreadOfNode != NULL && !unchangedSince(node, since);
+	}
+
+private:
+	// Closing rows on demand (closeRowsOnDemand)
+	const std::vector<IDType>* lazyThreadOfNode;	// NULL unless rows are closed on demand
+	BitMatrix* lazyThreadMasks;
+	// Edges added from the nodes of a thread (index), up to the last
+	// commitEdges(). An edge from a node can only change what the earlier
+	// nodes of the thread reach, so an edge is dropped once a later one has
+	// a source at least as late: the sources left decrease, and the first
+	// one from a serial on is the latest source since then.
+	class threadEdges {
+	public:
+		std::vector<unsigned long long> serials;	// edgeSerial of the edges
+		std::vector<IDType> sources;
+	};
+	std::vector<threadEdges> edgesOfThread;
+	// edges added since the last commitEdges(): (edgeSerial, source)
+	std::vector<std::pair<unsigned long long, IDType> > uncommittedEdges;
+	// edgeSerial + 1 when the row of the node was closed (0 if never)
+	std::vector<unsigned long long> rowClosedAt;
+	// (source << 32 | destination) -> edgeSerial + 1 when the destination was not reachable
+	std::unordered_map<unsigned long long, unsigned long long> unreachableAt;
+	// plane 0: nodes visited by reachesOnThread(), plane 1: rows ORed by
+	// closeRow(), plane 2: nodes on the stack of closeRow()
+	BitMatrix lazyScratch;
+	std::vector<std::pair<IDType, bool> > lazyStack;
+
+	// True if no edge committed since edgeSerial was since - 1 changes what node reaches
+	bool unchangedSince(IDType node, unsigned long long since) const;
+
+	bool rowIsClosed(IDType node) const {
+		return unchangedSince(node, rowClosedAt[node]);
 	}
+	// Adds the TRANS-ST/MT edges missing from node (and from the nodes it
+	// reaches). Returns -1 if it finds a cycle.
+	int closeRow(IDType node);
+	void stopClosingRowsOnDemand();
+	// 1 if destination is reached from source by ST edges between nodes of
+	// their thread, 0 if not, -1 if the search gave up (SEARCHLIMIT nodes)
+	int reachesOnThread(IDType sourceNode, IDType destinationNode);
+	// Adds an ST edge found by closeRow() or opEdgeExists()
+	void addDerivedEdge(IDType sourceNode, IDType destinationNode);
+
+	// successors of each node while edges are being added
+	std::vector<std::vector<IDType> > opSuccessors;
+	// once frozen: successors of node n are frozenSuccessors[frozenBegin[n] .. frozenBegin[n+1]-1]
+	std::vector<size_t> frozenBegin;
+	std::vector<IDType> frozenSuccessors;
 };
 
 #endif /* UAFDETECTOR_H_ */
@@ -0,0 +1,58 @@
+/*
+ * WorkerPool.cpp
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <racedetector/WorkerPool.h>
+
+#include <debugconfig.h>
+
+using namespace std;
+
+WorkerPool::WorkerPool(unsigned numOfThreads) {
+	job = NULL;
+	jobNumber = 0;
+	running = 0;
+	stopping = false;
+	for (unsigned i = 0; i < numOfThreads; i++)
+		threads.push_back(thread(&WorkerPool::work, this, i));
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		unique_lock<mutex> guard(lock);
+		stopping = true;
+	}
+	jobReady.notify_all();
+	for (unsigned i = 0; i < threads.size(); i++)
+		threads[i].join();
+}
+
+void WorkerPool::run(const function<void(unsigned)>& newJob) {
+	unique_lock<mutex> guard(lock);
+	job = &newJob;
+	jobNumber++;
+	running = threads.size();
+	jobReady.notify_all();
+	jobDone.wait(guard, [this] { return running == 0; });
+	job = NULL;
+}
+
+void WorkerPool::work(unsigned index) {
+	unsigned long long lastJob = 0;
+	unique_lock<mutex> guard(lock);
+	while (true) {
+		jobReady.wait(guard, [this, lastJob] { return stopping || jobNumber != lastJob; });
+		if (stopping)
+			return;
+		lastJob = jobNumber;
+
+		const function<void(unsigned)>* current = job;
+		guard.unlock();
+		(*current)(index);
+		guard.lock();
+		if (--running == 0)
+			jobDone.notify_one();
+	}
+}
@@ -0,0 +1,55 @@
+/*
+ * WorkerPool.h
+ *
+ *  Created on: 17-Oct-2026
+ */
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include <config.h>
+
+#ifndef WORKERPOOL_H_
+#define WORKERPOOL_H_
+
+/*
+ * Threads started once and kept waiting between jobs, so that work split in
+ * many short rounds (e.g. the sweeps of a closure) does not start and join
+ * threads for each round.
+ */
+class WorkerPool {
+public:
+	// Starts numOfThreads threads
+	WorkerPool(unsigned numOfThreads);
+	// Stops and joins the threads
+	virtual ~WorkerPool();
+
+	unsigned size() const {
+		return threads.size();
+	}
+
+	// Calls job(i) on thread i, for each thread, and returns once all calls
+	// have returned
+	void run(const std::function<void(unsigned)>& job);
+
+private:
+	std::vector<std::thread> threads;
+	std::mutex lock;
+	std::condition_variable jobReady;
+	std::condition_variable jobDone;
+	const std::function<void(unsigned)>* job;
+	unsigned long long jobNumber;	// jobs handed out so far
+	unsigned running;				// threads still running the current job
+	bool stopping;
+
+	void work(unsigned index);
+
+	// not copyable
+	WorkerPool(const WorkerPool&);
+	WorkerPool& operator=(const WorkerPool&);
+};
+
+#endif /* WORKERPOOL_H_ */